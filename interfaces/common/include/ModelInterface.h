@@ -449,13 +449,35 @@ public:
     std::vector<double> ComputeDouble(const std::vector<double>& inputData);
     std::vector<float> ComputeFloat(const std::vector<float>& inputData);
 
+    // Same as above, but reads the input from, and writes the output to, caller-owned buffers (for example numpy arrays)
+    // without copying or allocating anything.
+    void ComputeDoubleBuffers(const double* inputBuffer, size_t inputLength, double* outputBuffer, size_t outputLength);
+    void ComputeFloatBuffers(const float* inputBuffer, size_t inputLength, float* outputBuffer, size_t outputLength);
+
+    // Start jitting in the background and return immediately. Until IsJitReady returns true, callers that can't wait
+    // can compute the uncompiled Map instead; the Compute calls above block until jitting is done.
+    void StartJitting();
+    bool IsJitReady();
+
+    // Replace the weights with those of a retrained map with the same structure, keeping the compiled code. Both maps
+    // must be compiled with the swappableWeights option. No thread may compute the map until this returns.
+    void UpdateWeights(const CompiledMap& retrainedMap);
+
 private:
     template <typename ElementType>
     ell::api::CallbackForwarder<ElementType, ElementType>& GetCallbackForwarder();
 
+    template <typename ElementType>
+    std::vector<ElementType> Compute(const std::vector<ElementType>& inputData);
+
+    template <typename ElementType>
+    void ComputeBuffers(const ElementType* inputBuffer, size_t inputLength, ElementType* outputBuffer, size_t outputLength);
+
     std::shared_ptr<ell::model::IRCompiledMap> _map;
     ell::api::math::TensorShape _inputShape;
     ell::api::math::TensorShape _outputShape;
+    size_t _inputSize = 0;
+    size_t _outputSize = 0;
     ell::api::CallbackForwarder<double, double> forwarderDouble;
     ell::api::CallbackForwarder<float, float> forwarderFloat;
 
@@ -475,6 +497,10 @@ struct MapCompilerOptions
 {
     bool useBlas = true;
     bool profile = false;
+    std::string objectCachePath; // directory where the JIT caches machine code between runs (empty: no cache)
+    int jitThreads = 1; // number of threads the JIT uses to generate machine code, each for a part of the model
+    bool lazyJit = false; // have the JIT compile each function when it is first needed, instead of the whole model up front
+    bool swappableWeights = false; // keep the weights in their own JIT module, so CompiledMap.UpdateWeights can replace them
 };
 
 //
@@ -483,6 +509,7 @@ struct MapCompilerOptions
 struct ModelOptimizerOptions
 {
     bool fuseLinearFunctionNodes = true;
+    bool fuseConvolutionLayers = true;
 };
 
 } // namespace ELL_API
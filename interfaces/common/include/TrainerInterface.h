@@ -70,6 +70,12 @@ struct ProtoNNTrainerParameters
 
     ///<summary>Whether to output diagnostic messages during the training process</summary>
     bool verbose = false;
+
+    ///<summary>The number of threads used for training (0 means one per hardware thread)</summary>
+    size_t numThreads = 1;
+
+    ///<summary>The number of examples in each SGD mini-batch</summary>
+    size_t batchSize = 256;
 };
 
 class ProtoNNPredictor
@@ -137,6 +137,44 @@ import numpy as np
 }
 %enddef
 
+// Typemaps that pass numpy arrays (or anything else that exposes a contiguous buffer) to C++ without copying them
+%define TYPEMAP_BUFFER_ARGUMENT(BUFFER_TYPE, FORMAT_CHAR, BUFFER_NAME, LENGTH_NAME, FLAGS)
+%typemap(in) (BUFFER_TYPE* BUFFER_NAME, size_t LENGTH_NAME)
+             (Py_buffer view_ = {})
+{
+    int res = PyObject_GetBuffer($input, &view_, PyBUF_ANY_CONTIGUOUS | PyBUF_FORMAT | FLAGS);
+    if (res < 0)
+    {
+        PyErr_Clear();
+        SWIG_exception_fail(SWIG_TypeError, "Expected a contiguous array");
+    }
+    const char* format = view_.format == nullptr ? "B" : view_.format;
+    if (format[0] == '<' || format[0] == '=' || format[0] == '@')
+    {
+        ++format;
+    }
+    if (format[0] != FORMAT_CHAR || view_.itemsize != sizeof(BUFFER_TYPE))
+    {
+        PyBuffer_Release(&view_);
+        SWIG_exception_fail(SWIG_TypeError, "Expected an array of BUFFER_TYPE");
+    }
+    $1 = ($1_ltype) view_.buf;
+    $2 = ($2_ltype) (view_.len / view_.itemsize);
+}
+%typemap(freearg) (BUFFER_TYPE* BUFFER_NAME, size_t LENGTH_NAME)
+{
+    if (view_$argnum.obj != nullptr)
+    {
+        PyBuffer_Release(&view_$argnum);
+    }
+}
+%enddef
+
+%define TYPEMAP_COMPUTE_BUFFERS(ELEMENT_TYPE, FORMAT_CHAR)
+TYPEMAP_BUFFER_ARGUMENT(const ELEMENT_TYPE, FORMAT_CHAR, inputBuffer, inputLength, 0)
+TYPEMAP_BUFFER_ARGUMENT(ELEMENT_TYPE, FORMAT_CHAR, outputBuffer, outputLength, PyBUF_WRITABLE)
+%enddef
+
 %{
 
 template<typename VectorType>
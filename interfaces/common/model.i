@@ -30,6 +30,18 @@ WRAP_CALLABLES_AS_COMPILED_MAP_CALLBACKS(FloatCallbackBase, FloatCallbackBase, f
 %naturalvar ELL_API::PortMemoryLayout::offset;
 %naturalvar ELL_API::PortMemoryLayout::order;
 
+// Caller-owned buffers for CompiledMap::ComputeDoubleBuffers / ComputeFloatBuffers
+#if defined(SWIGPYTHON)
+TYPEMAP_COMPUTE_BUFFERS(double, 'd')
+TYPEMAP_COMPUTE_BUFFERS(float, 'f')
+#elif defined(SWIGCSHARP)
+%include "arrays_csharp.i"
+%apply double FIXED[] { const double* inputBuffer, double* outputBuffer }
+%apply float FIXED[] { const float* inputBuffer, float* outputBuffer }
+%csmethodmodifiers ELL_API::CompiledMap::ComputeDoubleBuffers "public unsafe";
+%csmethodmodifiers ELL_API::CompiledMap::ComputeFloatBuffers "public unsafe";
+#endif
+
 // Include the C++ code to be wrapped
 %include "ModelInterface.h"
 %include "ModelBuilderInterface.h"
@@ -134,6 +134,27 @@ def CompiledMap_Compute(self, inputData: 'Vector', dtype: 'numpy.dtype') -> "std
 
 CompiledMap.Compute = CompiledMap_Compute
 
+# CompiledMap.ComputeInto, for maps without source nodes: reads the input from, and writes the output to, numpy arrays
+# owned by the caller, without copying or allocating
+def CompiledMap_ComputeInto(self, inputData: 'numpy.ndarray', outputData: 'numpy.ndarray'):
+    """
+    CompiledMap_ComputeInto(CompiledMap self, numpy.ndarray inputData, numpy.ndarray outputData)
+
+    Parameters
+    ----------
+    inputData: contiguous numpy.ndarray of numpy.float or numpy.float32, with as many elements as the map's input
+    outputData: contiguous numpy.ndarray of the same type, with as many elements as the map's output
+
+    """
+    if inputData.dtype == np.float:
+        self.ComputeDoubleBuffers(inputData, outputData)
+    elif inputData.dtype == np.float32:
+        self.ComputeFloatBuffers(inputData, outputData)
+    else:
+        raise TypeError("Invalid type, expected numpy.float or numpy.float32")
+
+CompiledMap.ComputeInto = CompiledMap_ComputeInto
+
 # Map.Compute, parameterized on numpy.dtype
 def Map_Compute(self, inputData: 'Vector<ElementType>', dtype: 'numpy.dtype') -> "std::vector< ElementType,std::allocator< ElementType > >":
     """
@@ -766,7 +766,12 @@ CompiledMap Map::Compile(const std::string& targetDevice,
     settings.sinkFunctionName = sinkFunctionName;
     settings.compilerSettings.targetDevice.deviceName = targetDevice;
     settings.compilerSettings.useBlas = compilerSettings.useBlas;
+    settings.objectCachePath = compilerSettings.objectCachePath;
+    settings.jitThreads = compilerSettings.jitThreads;
+    settings.lazyJit = compilerSettings.lazyJit;
+    settings.swappableWeights = compilerSettings.swappableWeights;
     settings.optimizerSettings.fuseLinearFunctionNodes = optimizerSettings.fuseLinearFunctionNodes;
+    settings.optimizerSettings.fuseConvolutionLayers = optimizerSettings.fuseConvolutionLayers;
 
     ell::model::IRMapCompiler compiler(settings);
 
@@ -787,6 +792,8 @@ CompiledMap::CompiledMap(ell::model::IRCompiledMap map, ell::api::math::TensorSh
     _outputShape(outputShape)
 {
     _map = std::make_shared<ell::model::IRCompiledMap>(std::move(map));
+    _inputSize = _map->GetInputSize();
+    _outputSize = _map->GetOutputSize();
 }
 
 CompiledMap::~CompiledMap()
@@ -818,20 +825,65 @@ bool CompiledMap::HasSourceNodes()
 
 std::vector<double> CompiledMap::ComputeDouble(const std::vector<double>& inputData)
 {
-    if (_map != nullptr)
+    return Compute(inputData);
+}
+
+std::vector<float> CompiledMap::ComputeFloat(const std::vector<float>& inputData)
+{
+    return Compute(inputData);
+}
+
+void CompiledMap::ComputeDoubleBuffers(const double* inputBuffer, size_t inputLength, double* outputBuffer, size_t outputLength)
+{
+    ComputeBuffers(inputBuffer, inputLength, outputBuffer, outputLength);
+}
+
+void CompiledMap::ComputeFloatBuffers(const float* inputBuffer, size_t inputLength, float* outputBuffer, size_t outputLength)
+{
+    ComputeBuffers(inputBuffer, inputLength, outputBuffer, outputLength);
+}
+
+void CompiledMap::StartJitting()
+{
+    _map->StartJitting();
+}
+
+bool CompiledMap::IsJitReady()
+{
+    return _map->IsJitReady();
+}
+
+void CompiledMap::UpdateWeights(const CompiledMap& retrainedMap)
+{
+    _map->UpdateWeights(*retrainedMap._map);
+}
+
+template <typename ElementType>
+std::vector<ElementType> CompiledMap::Compute(const std::vector<ElementType>& inputData)
+{
+    if (_map == nullptr)
     {
-        return _map->Compute<double>(inputData);
+        return {};
     }
-    return {};
+
+    // write straight into the result, rather than into the map's output cache followed by a copy
+    std::vector<ElementType> result(_outputSize);
+    ComputeBuffers(inputData.data(), inputData.size(), result.data(), result.size());
+    return result;
 }
 
-std::vector<float> CompiledMap::ComputeFloat(const std::vector<float>& inputData)
+template <typename ElementType>
+void CompiledMap::ComputeBuffers(const ElementType* inputBuffer, size_t inputLength, ElementType* outputBuffer, size_t outputLength)
 {
-    if (_map != nullptr)
+    if (_map == nullptr)
+    {
+        return;
+    }
+    if (inputLength != _inputSize || outputLength != _outputSize)
     {
-        return _map->Compute<float>(inputData);
+        throw std::invalid_argument("array sizes don't match the map's input and output sizes");
     }
-    return {};
+    _map->Compute(inputBuffer, outputBuffer);
 }
 
 void CompiledMap::WriteIR(const std::string& filePath)
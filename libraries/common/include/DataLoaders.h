@@ -12,18 +12,71 @@
 
 #include <data/include/Dataset.h>
 #include <data/include/ExampleIterator.h>
+#include <data/include/MappedDataset.h>
+#include <data/include/ShardedDataset.h>
 
 #include <model/include/Map.h>
 
 #include <utilities/include/StringUtil.h>
 
 #include <istream>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace ell
 {
 namespace common
 {
+    /// <summary> A dataset returned by `LoadTransformedDataset`. A binary dataset that the map leaves unchanged stays
+    /// memory-mapped, and its examples are read straight from the file; any other dataset is held in memory. </summary>
+    class LoadedDataset
+    {
+    public:
+        /// <summary> Constructs a LoadedDataset that holds an in-memory dataset. </summary>
+        ///
+        /// <param name="dataset"> The dataset. </param>
+        LoadedDataset(data::AutoSupervisedDataset dataset);
+
+        /// <summary> Constructs a LoadedDataset that reads its examples from a memory-mapped binary dataset. </summary>
+        ///
+        /// <param name="dataset"> The mapped dataset. </param>
+        LoadedDataset(data::MappedDataset dataset);
+
+        /// <summary> Returns the number of examples in the dataset. </summary>
+        ///
+        /// <returns> The number of examples. </returns>
+        size_t NumExamples() const;
+
+        /// <summary> Returns the maximal size of any example. </summary>
+        ///
+        /// <returns> The number of features. </returns>
+        size_t NumFeatures() const;
+
+        /// <summary> Returns an AnyDataset that represents a range of examples, which can be given to a trainer. </summary>
+        ///
+        /// <param name="fromIndex"> Zero-based index of the first example. </param>
+        /// <param name="size"> The number of examples, or zero to go to the end of the dataset. </param>
+        ///
+        /// <returns> The AnyDataset. </returns>
+        data::AnyDataset GetAnyDataset(size_t fromIndex = 0, size_t size = 0) const;
+
+        /// <summary> Returns an iterator over the examples of the dataset. </summary>
+        ///
+        /// <returns> The example iterator. </returns>
+        data::AutoSupervisedExampleIterator GetExampleIterator() const;
+
+        /// <summary> Returns true if the examples are read from a memory-mapped file. </summary>
+        ///
+        /// <returns> True if the dataset is memory-mapped. </returns>
+        bool IsMapped() const { return _mappedDataset != nullptr; }
+
+    private:
+        // Held by pointer so that the AnyDatasets handed out stay valid when the LoadedDataset is moved
+        std::unique_ptr<data::AutoSupervisedDataset> _dataset;
+        std::unique_ptr<data::MappedDataset> _mappedDataset;
+    };
+
     /// <summary> Gets an ExampleIterator from an input stream. </summary>
     ///
     /// <typeparam name="TextLineIteratorType"> Line iterator type. </typeparam>
@@ -49,14 +102,16 @@ namespace common
     /// <returns> The data iterator. </returns>
     data::AutoSupervisedMultiClassExampleIterator GetAutoSupervisedMultiClassExampleIterator(std::istream& stream);
 
-    /// <summary> Gets an AutoSupervisedDataset dataset from data load arguments. </summary>
+    /// <summary> Gets an AutoSupervisedDataset dataset from data load arguments. The text is parsed in parallel,
+    /// in chunks of complete lines, and the examples keep their order in the stream. </summary>
     ///
     /// <param name="stream"> Input stream to load data from. </param>
     ///
     /// <returns> The dataset. </returns>
     data::AutoSupervisedDataset GetDataset(std::istream& stream);
 
-    /// <summary> Gets a dataset from data load arguments. </summary>
+    /// <summary> Gets a dataset from data load arguments. The text is parsed in parallel, in chunks of complete
+    /// lines, and the examples keep their order in the stream. </summary>
     ///
     /// <param name="stream"> Input stream to load data from. </param>
     ///
@@ -76,6 +131,65 @@ namespace common
     template <typename ExampleType, typename MapType>
     auto TransformDataset(data::Dataset<ExampleType>& input, const MapType& map);
 
+    /// <summary>
+    /// Gets a new dataset by running the examples of a memory-mapped binary dataset through a map.
+    /// </summary>
+    ///
+    /// <typeparam name="MapType"> Map type. </typeparam>
+    /// <param name="input"> Input dataset. </param>
+    /// <param name="map"> Map to run input dataset on. </param>
+    ///
+    /// <returns> The transformed dataset. </returns>
+    template <typename MapType>
+    data::AutoSupervisedDataset TransformDataset(const data::MappedDataset& input, const MapType& map);
+
+    /// <summary>
+    /// Gets a new dataset by running the examples of a loaded dataset through a map, one example at a time.
+    /// </summary>
+    ///
+    /// <typeparam name="MapType"> Map type. </typeparam>
+    /// <param name="input"> Input dataset. </param>
+    /// <param name="map"> Map to run input dataset on. </param>
+    ///
+    /// <returns> The transformed dataset. </returns>
+    template <typename MapType>
+    data::AutoSupervisedDataset TransformDataset(const LoadedDataset& input, const MapType& map);
+
+    /// <summary> Returns true if a map passes its single input through to its output unchanged. </summary>
+    ///
+    /// <param name="map"> The map. </param>
+    ///
+    /// <returns> True if the map is an identity map. </returns>
+    bool IsIdentityMap(const model::Map& map);
+
+    /// <summary>
+    /// Loads a dataset from a file in either the text or the binary dataset format, and runs it through a map.
+    /// Binary datasets are memory-mapped rather than parsed. If the map is an identity map, a binary dataset isn't
+    /// copied into memory at all: the returned dataset reads its examples straight from the file.
+    /// </summary>
+    ///
+    /// <typeparam name="MapType"> Map type. </typeparam>
+    /// <param name="filename"> The path of the data file. </param>
+    /// <param name="map"> Map to run the dataset on. </param>
+    ///
+    /// <returns> The transformed dataset. </returns>
+    template <typename MapType>
+    LoadedDataset LoadTransformedDataset(const std::string& filename, const MapType& map);
+
+    /// <summary>
+    /// Makes a sharded dataset from a list of files, each in either the text or the binary dataset format. The files
+    /// are loaded and run through a copy of the map one at a time, as the dataset is streamed.
+    /// </summary>
+    ///
+    /// <typeparam name="MapType"> Map type. </typeparam>
+    /// <param name="filenames"> The paths of the shard files. </param>
+    /// <param name="map"> Map to run the dataset on. </param>
+    /// <param name="parameters"> The streaming parameters. </param>
+    ///
+    /// <returns> The sharded dataset. </returns>
+    template <typename MapType>
+    data::ShardedDataset<data::AutoSupervisedExample> LoadTransformedShardedDataset(const std::vector<std::string>& filenames, const MapType& map, const data::ShardedDatasetParameters& parameters = {});
+
     /// <summary>
     /// The map is first compiled, then a new dataset is returned
     /// by running an existing dataset through the compiled map.
@@ -102,6 +216,8 @@ namespace common
 
 #include <nodes/include/ClockNode.h> // for nodes::TimeTickType
 
+#include <utilities/include/Files.h>
+
 namespace ell
 {
 namespace common
@@ -127,6 +243,73 @@ namespace common
         });
     }
 
+    template <typename MapType>
+    data::AutoSupervisedDataset TransformDataset(const data::MappedDataset& input, const MapType& map)
+    {
+        data::AutoSupervisedDataset result;
+        for (size_t index = 0; index < input.NumExamples(); ++index)
+        {
+            auto example = input.GetExample(index);
+            auto transformedDataVector = map.template Compute<data::DoubleDataVector>(data::SparseDoubleDataVector(example.GetIterator()));
+            result.AddExample(data::AutoSupervisedExample(std::move(transformedDataVector), example.GetMetadata()));
+        }
+        return result;
+    }
+
+    template <typename MapType>
+    data::AutoSupervisedDataset TransformDataset(const LoadedDataset& input, const MapType& map)
+    {
+        data::AutoSupervisedDataset result;
+        auto exampleIterator = input.GetExampleIterator();
+        while (exampleIterator.IsValid())
+        {
+            auto example = exampleIterator.Get();
+            auto transformedDataVector = map.template Compute<data::DoubleDataVector>(example.GetDataVector());
+            result.AddExample(data::AutoSupervisedExample(std::move(transformedDataVector), example.GetMetadata()));
+            exampleIterator.Next();
+        }
+        return result;
+    }
+
+    namespace detail
+    {
+        template <typename MapType>
+        data::AutoSupervisedDataset LoadTransformedInMemoryDataset(const std::string& filename, const MapType& map)
+        {
+            if (data::IsBinaryDatasetFile(filename))
+            {
+                data::MappedDataset dataset(filename);
+                return TransformDataset(dataset, map);
+            }
+
+            auto stream = utilities::OpenIfstream(filename);
+            auto parsedDataset = GetDataset(stream);
+            return TransformDataset(parsedDataset, map);
+        }
+    } // namespace detail
+
+    template <typename MapType>
+    LoadedDataset LoadTransformedDataset(const std::string& filename, const MapType& map)
+    {
+        // Running an identity map would only copy the examples, unless it truncates them to its input size
+        if (data::IsBinaryDatasetFile(filename) && IsIdentityMap(map))
+        {
+            data::MappedDataset dataset(filename);
+            if (dataset.NumFeatures() <= map.GetInputSize(0))
+            {
+                return LoadedDataset(std::move(dataset));
+            }
+        }
+        return LoadedDataset(detail::LoadTransformedInMemoryDataset(filename, map));
+    }
+
+    template <typename MapType>
+    data::ShardedDataset<data::AutoSupervisedExample> LoadTransformedShardedDataset(const std::vector<std::string>& filenames, const MapType& map, const data::ShardedDatasetParameters& parameters)
+    {
+        auto loadShard = [filenames, map](size_t shardIndex) { return detail::LoadTransformedInMemoryDataset(filenames[shardIndex], map); };
+        return data::ShardedDataset<data::AutoSupervisedExample>(filenames.size(), loadShard, parameters);
+    }
+
     namespace detail
     {
         // Context used by callback functions
@@ -30,23 +30,35 @@ namespace common
     struct MapCompilerArguments
     {
         using PreferredConvolutionMethod = model::PreferredConvolutionMethod;
+        using ParallelLoopSchedule = emitters::ParallelLoopSchedule;
 
         std::string compiledFunctionName; // defaults to output filename
         std::string compiledModuleName;
 
         // ELL codegen options
         bool profile = false;
+        bool reusePortBuffers = false;
+        bool reentrant = false;
+        std::string objectCachePath;
+        int jitThreads = 1;
+        bool lazyJit = false;
+        bool swappableWeights = false;
         bool optimize = true;
         bool useBlas = false;
         bool fuseLinearOperations = true;
+        bool fuseConvolutionLayers = true;
         bool optimizeReorderDataNodes = true;
+        bool quantize = false;
         bool enableVectorization = true;
         int vectorWidth = 4;
         bool parallelize = true;
         bool useThreadPool = true;
         int maxThreads = 4;
+        ParallelLoopSchedule parallelLoopSchedule = ParallelLoopSchedule::fixedBlocks; // known schedules: blocks, dynamic
+        int parallelLoopChunkSize = 0;
         bool debug = false;
-        PreferredConvolutionMethod convolutionMethod = PreferredConvolutionMethod::automatic; // known methods: auto, unrolled, simple, diagonal, winograd
+        PreferredConvolutionMethod convolutionMethod = PreferredConvolutionMethod::automatic; // known methods: auto, unrolled, simple, diagonal, winograd, autotune
+        std::string convolutionTuningCache = ""; // file of autotuned convolution methods, keyed by layer shape
         utilities::Optional<bool> positionIndependentCode = false; // for generating -fPIC object code
 
         // target machine options
@@ -9,6 +9,8 @@
 #include "DataLoadArguments.h"
 #include "DataLoaders.h"
 
+#include <data/include/MappedDataset.h>
+
 #include <utilities/include/CStringParser.h>
 #include <utilities/include/Files.h>
 
@@ -98,13 +100,21 @@ namespace common
                 return parseErrorMessages;
             }
 
-            auto stream = utilities::OpenIfstream(GetDataFilePath());
-            auto exampleIterator = GetAutoSupervisedExampleIterator(stream);
-            while (exampleIterator.IsValid())
+            if (data::IsBinaryDatasetFile(GetDataFilePath()))
+            {
+                // binary datasets store their dimension in the file header
+                parsedDataDimension = data::MappedDataset(GetDataFilePath()).NumFeatures();
+            }
+            else
             {
-                auto size = exampleIterator.Get().GetDataVector().PrefixLength();
-                parsedDataDimension = std::max(parsedDataDimension, size);
-                exampleIterator.Next();
+                auto stream = utilities::OpenIfstream(GetDataFilePath());
+                auto exampleIterator = GetAutoSupervisedExampleIterator(stream);
+                while (exampleIterator.IsValid())
+                {
+                    auto size = exampleIterator.Get().GetDataVector().PrefixLength();
+                    parsedDataDimension = std::max(parsedDataDimension, size);
+                    exampleIterator.Next();
+                }
             }
         }
         else if (dataDimension != "")
@@ -15,9 +15,13 @@
 
 #include <data/include/AutoDataVector.h>
 #include <data/include/GeneralizedSparseParsingIterator.h>
+#include <data/include/ParallelParsingExampleIterator.h>
 #include <data/include/SingleLineParsingExampleIterator.h>
 #include <data/include/WeightLabel.h>
 
+#include <model/include/InputNodeBase.h>
+#include <model/include/OutputNodeBase.h>
+
 #include <memory>
 #include <stdexcept>
 
@@ -38,12 +42,61 @@ namespace common
 
     data::AutoSupervisedDataset GetDataset(std::istream& stream)
     {
-        return data::MakeDataset(GetExampleIterator<data::SequentialLineIterator, data::LabelParser, data::AutoDataVectorParser<data::GeneralizedSparseParsingIterator>>(stream));
+        return data::MakeDataset(data::MakeParallelParsingExampleIterator(stream, data::LabelParser(), data::AutoDataVectorParser<data::GeneralizedSparseParsingIterator>()));
     }
 
     data::AutoSupervisedMultiClassDataset GetMultiClassDataset(std::istream& stream)
     {
-        return data::MakeDataset(GetExampleIterator<data::SequentialLineIterator, data::ClassIndexParser, data::AutoDataVectorParser<data::GeneralizedSparseParsingIterator>>(stream));
+        return data::MakeDataset(data::MakeParallelParsingExampleIterator(stream, data::ClassIndexParser(), data::AutoDataVectorParser<data::GeneralizedSparseParsingIterator>()));
+    }
+
+    bool IsIdentityMap(const model::Map& map)
+    {
+        if (map.GetNumInputs() != 1 || map.GetNumOutputs() != 1 || !map.GetOutput(0).IsFullPortOutput() || map.GetInputSize(0) != map.GetOutputSize(0))
+        {
+            return false;
+        }
+
+        // Input ports always reference a whole output port, so a model that holds only its input node and output
+        // nodes copies the input to the output
+        bool isIdentity = true;
+        map.GetModel().Visit([&isIdentity](const model::Node& node) {
+            isIdentity = isIdentity && (dynamic_cast<const model::InputNodeBase*>(&node) != nullptr || dynamic_cast<const model::OutputNodeBase*>(&node) != nullptr);
+        });
+        return isIdentity;
+    }
+
+    //
+    // LoadedDataset
+    //
+    LoadedDataset::LoadedDataset(data::AutoSupervisedDataset dataset) :
+        _dataset(std::make_unique<data::AutoSupervisedDataset>(std::move(dataset)))
+    {
+    }
+
+    LoadedDataset::LoadedDataset(data::MappedDataset dataset) :
+        _mappedDataset(std::make_unique<data::MappedDataset>(std::move(dataset)))
+    {
+    }
+
+    size_t LoadedDataset::NumExamples() const
+    {
+        return IsMapped() ? _mappedDataset->NumExamples() : _dataset->NumExamples();
+    }
+
+    size_t LoadedDataset::NumFeatures() const
+    {
+        return IsMapped() ? _mappedDataset->NumFeatures() : _dataset->NumFeatures();
+    }
+
+    data::AnyDataset LoadedDataset::GetAnyDataset(size_t fromIndex, size_t size) const
+    {
+        return IsMapped() ? _mappedDataset->GetAnyDataset(fromIndex, size) : _dataset->GetAnyDataset(fromIndex, size);
+    }
+
+    data::AutoSupervisedExampleIterator LoadedDataset::GetExampleIterator() const
+    {
+        return GetAnyDataset().GetExampleIterator<data::AutoSupervisedExample>();
     }
 } // namespace common
 } // namespace ell
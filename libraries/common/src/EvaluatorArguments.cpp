@@ -27,6 +27,13 @@ namespace common
             "aze",
             "Add an evaluation using the constant zero predictor",
             true);
+
+        parser.AddOption(
+            numThreads,
+            "evaluationThreads",
+            "et",
+            "Number of threads used to evaluate the examples (0 means one per hardware thread)",
+            1);
     }
 } // namespace common
 } // namespace ell
@@ -55,6 +55,30 @@ namespace common
                          "st",
                          "Use the sorting trainer instead of the histogram trainer",
                          false);
+
+        parser.AddOption(binnedTrainer,
+                         "binnedTrainer",
+                         "bt",
+                         "Use the binned trainer, which bucketizes the features once and finds splits from per-node histograms, instead of the histogram trainer",
+                         false);
+
+        parser.AddOption(maxBinsPerFeature,
+                         "maxBinsPerFeature",
+                         "mbpf",
+                         "The maximum number of bins per feature used by the binned trainer (at most 256)",
+                         256);
+
+        parser.AddOption(binningSampleSize,
+                         "binningSampleSize",
+                         "bss",
+                         "The number of examples the binned trainer samples to choose the bins of each feature (0 means all)",
+                         100000);
+
+        parser.AddOption(numThreads,
+                         "numThreads",
+                         "nt",
+                         "The number of threads used by the binned trainer (0 means one per hardware thread)",
+                         0);
     }
 } // namespace common
 } // namespace ell
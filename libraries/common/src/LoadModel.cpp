@@ -31,6 +31,7 @@
 #include <nodes/include/ExtremalValueNode.h>
 #include <nodes/include/FFTNode.h>
 #include <nodes/include/FilterBankNode.h>
+#include <nodes/include/FlatForestPredictorNode.h>
 #include <nodes/include/ForestPredictorNode.h>
 #include <nodes/include/GRUNode.h>
 #include <nodes/include/HammingWindowNode.h>
@@ -46,6 +47,7 @@
 #include <nodes/include/MultiplexerNode.h>
 #include <nodes/include/NeuralNetworkPredictorNode.h>
 #include <nodes/include/ProtoNNPredictorNode.h>
+#include <nodes/include/QuantizedFullyConnectedLayerNode.h>
 #include <nodes/include/RNNNode.h>
 #include <nodes/include/ReceptiveFieldMatrixNode.h>
 #include <nodes/include/ReinterpretLayoutNode.h>
@@ -96,6 +98,11 @@ namespace common
         context.GetTypeFactory().AddType<model::Node, nodes::ArgMaxNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::ArgMinNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::BinaryOperationNode<ElementType>>();
+        context.GetTypeFactory().AddType<model::Node, nodes::BroadcastBinaryFunctionNode<ElementType, nodes::BiasActivationFunction<ElementType, nodes::HardSigmoidActivationFunction<ElementType>>>>();
+        context.GetTypeFactory().AddType<model::Node, nodes::BroadcastBinaryFunctionNode<ElementType, nodes::BiasActivationFunction<ElementType, nodes::LeakyReLUActivationFunction<ElementType>>>>();
+        context.GetTypeFactory().AddType<model::Node, nodes::BroadcastBinaryFunctionNode<ElementType, nodes::BiasActivationFunction<ElementType, nodes::ReLUActivationFunction<ElementType>>>>();
+        context.GetTypeFactory().AddType<model::Node, nodes::BroadcastBinaryFunctionNode<ElementType, nodes::BiasActivationFunction<ElementType, nodes::SigmoidActivationFunction<ElementType>>>>();
+        context.GetTypeFactory().AddType<model::Node, nodes::BroadcastBinaryFunctionNode<ElementType, nodes::BiasActivationFunction<ElementType, nodes::TanhActivationFunction<ElementType>>>>();
         context.GetTypeFactory().AddType<model::Node, nodes::BroadcastUnaryFunctionNode<ElementType, nodes::HardSigmoidActivationFunction<ElementType>>>();
         context.GetTypeFactory().AddType<model::Node, nodes::BroadcastUnaryFunctionNode<ElementType, nodes::LeakyReLUActivationFunction<ElementType>>>();
         context.GetTypeFactory().AddType<model::Node, nodes::BroadcastUnaryFunctionNode<ElementType, nodes::ReLUActivationFunction<ElementType>>>();
@@ -152,6 +159,7 @@ namespace common
         context.GetTypeFactory().AddType<model::Node, nodes::ParametricReLUActivationLayerNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::PoolingLayerNode<ElementType, MeanPoolingFunction>>();
         context.GetTypeFactory().AddType<model::Node, nodes::PoolingLayerNode<ElementType, MaxPoolingFunction>>();
+        context.GetTypeFactory().AddType<model::Node, nodes::QuantizedFullyConnectedLayerNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::RegionDetectionLayerNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::ScalingLayerNode<ElementType>>();
         context.GetTypeFactory().AddType<model::Node, nodes::SoftmaxLayerNode<ElementType>>();
@@ -251,6 +259,7 @@ namespace common
         context.GetTypeFactory().AddType<model::Node, nodes::ReinterpretLayoutNode<bool>>();
 
         context.GetTypeFactory().AddType<model::Node, nodes::SimpleForestPredictorNode>();
+        context.GetTypeFactory().AddType<model::Node, nodes::FlatForestPredictorNode>();
 
         context.GetTypeFactory().AddType<model::Node, nodes::SingleElementThresholdNode>();
 
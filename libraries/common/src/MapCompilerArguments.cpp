@@ -36,6 +36,48 @@ namespace common
             "Emit profiling code",
             false);
 
+        parser.AddOption(
+            reusePortBuffers,
+            "reusePortBuffers",
+            "",
+            "Share intermediate buffers between node outputs whose lifetimes don't overlap, to reduce memory use",
+            false);
+
+        parser.AddOption(
+            reentrant,
+            "reentrant",
+            "",
+            "Keep the model's state in a context allocated by the caller, so several threads can run the model at once",
+            false);
+
+        parser.AddOption(
+            objectCachePath,
+            "objectCache",
+            "",
+            "Directory in which to cache the machine code generated by the JIT, so later runs can skip code generation",
+            "");
+
+        parser.AddOption(
+            jitThreads,
+            "jitThreads",
+            "",
+            "Number of threads the JIT uses to generate machine code, each compiling a part of the model",
+            1);
+
+        parser.AddOption(
+            lazyJit,
+            "lazyJit",
+            "",
+            "Have the JIT compile each function when it is first needed, instead of the whole model up front",
+            false);
+
+        parser.AddOption(
+            swappableWeights,
+            "swappableWeights",
+            "",
+            "Keep the model's weights in a separate JIT module that a retrained model's weights can replace (JIT only)",
+            false);
+
         parser.AddOption(
             optimize,
             "optimize",
@@ -57,6 +99,13 @@ namespace common
             "Fuse sequences of linear operations with constant coefficients into a single operation",
             true);
 
+        parser.AddOption(
+            fuseConvolutionLayers,
+            "fuseConvLayers",
+            "",
+            "Fold batch normalization and scaling into convolution weights, and apply the following bias and activation in a single operation",
+            true);
+
         parser.AddOption(
             optimizeReorderDataNodes,
             "optimizeReorderDataNodes",
@@ -64,6 +113,13 @@ namespace common
             "Optimize sequences of reordering nodes",
             true);
 
+        parser.AddOption(
+            quantize,
+            "quantize",
+            "",
+            "Run fully-connected layers that have been calibrated for quantization in 8-bit integer arithmetic",
+            false);
+
         parser.AddOption(
             convolutionMethod,
             "convolutionMethod",
@@ -73,9 +129,17 @@ namespace common
               { "simple", PreferredConvolutionMethod::simple },
               { "diagonal", PreferredConvolutionMethod::diagonal },
               { "winograd", PreferredConvolutionMethod::winograd },
+              { "autotune", PreferredConvolutionMethod::autotune },
               { "auto", PreferredConvolutionMethod::automatic } },
             "auto");
 
+        parser.AddOption(
+            convolutionTuningCache,
+            "convolutionTuningCache",
+            "",
+            "File used to store and reuse the per-layer results of '--convolutionMethod autotune'",
+            "");
+
         parser.AddOption(
             enableVectorization,
             "vectorize",
@@ -111,6 +175,22 @@ namespace common
             "Maximum num of parallel threads",
             4);
 
+        parser.AddOption(
+            parallelLoopSchedule,
+            "parallelSchedule",
+            "",
+            "How parallel loops divide their iterations among tasks (if parallelization enabled)",
+            { { "blocks", ParallelLoopSchedule::fixedBlocks },
+              { "dynamic", ParallelLoopSchedule::dynamicChunks } },
+            "blocks");
+
+        parser.AddOption(
+            parallelLoopChunkSize,
+            "parallelChunkSize",
+            "",
+            "Number of loop iterations each task claims at a time with the dynamic parallel schedule (0 = auto)",
+            0);
+
         parser.AddOption(
             debug,
             "debug",
@@ -208,11 +288,24 @@ namespace common
         settings.compilerSettings.useBlas = useBlas;
         settings.compilerSettings.allowVectorInstructions = enableVectorization;
         settings.compilerSettings.parallelize = parallelize;
+        settings.compilerSettings.useThreadPool = useThreadPool;
+        settings.compilerSettings.maxThreads = maxThreads;
+        settings.compilerSettings.parallelLoopSchedule = parallelLoopSchedule;
+        settings.compilerSettings.parallelLoopChunkSize = parallelLoopChunkSize;
         settings.compilerSettings.vectorWidth = vectorWidth;
         settings.optimizerSettings.fuseLinearFunctionNodes = fuseLinearOperations;
+        settings.optimizerSettings.fuseConvolutionLayers = fuseConvolutionLayers;
         settings.optimizerSettings.optimizeReorderDataNodes = optimizeReorderDataNodes;
+        settings.optimizerSettings.quantizeNeuralNetworkLayers = quantize;
         settings.optimizerSettings.preferredConvolutionMethod = convolutionMethod;
+        settings.optimizerSettings.convolutionTuningCachePath = convolutionTuningCache;
         settings.profile = profile;
+        settings.reusePortBuffers = reusePortBuffers;
+        settings.reentrant = reentrant;
+        settings.objectCachePath = objectCachePath;
+        settings.jitThreads = jitThreads;
+        settings.lazyJit = lazyJit;
+        settings.swappableWeights = swappableWeights;
         settings.compilerSettings.profile = profile;
         settings.compilerSettings.positionIndependentCode = positionIndependentCode;
 
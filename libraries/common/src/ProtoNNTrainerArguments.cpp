@@ -74,6 +74,18 @@ namespace common
                          "nInnerIter",
                          "Number of inner iterations",
                          1);
+
+        parser.AddOption(numThreads,
+                         "numThreads",
+                         "nt",
+                         "Number of threads used for training (0 = one per hardware thread)",
+                         1);
+
+        parser.AddOption(batchSize,
+                         "batchSize",
+                         "bs",
+                         "Number of examples in each SGD mini-batch",
+                         256);
     }
 } // namespace common
 } // namespace ell
@@ -9,4 +9,6 @@ namespace ell
 {
 void TestLoadDataset(const std::string& examplePath);
 void TestLoadMappedDataset(const std::string& examplePath);
+void TestLoadBinaryDataset(const std::string& examplePath);
+void TestLoadTransformedShardedDataset(const std::string& examplePath);
 } // namespace ell
\ No newline at end of file
@@ -14,7 +14,10 @@
 
 #include <utilities/include/Files.h>
 
+#include <cstdio>
 #include <iostream>
+#include <string>
+#include <vector>
 
 namespace ell
 {
@@ -37,4 +40,90 @@ void TestLoadMappedDataset(const std::string& examplePath)
     auto dataset = common::GetDataset(stream);
     dataset = common::TransformDataset(dataset, map);
 }
+
+void TestLoadBinaryDataset(const std::string& examplePath)
+{
+    auto stream = utilities::OpenIfstream(utilities::JoinPaths(examplePath, { "data", "testData.txt" }));
+    auto dataset = common::GetDataset(stream);
+
+    const std::string filename("testData.elldata");
+    {
+        auto binaryStream = utilities::OpenBinaryOfstream(filename);
+        data::WriteBinaryDataset(dataset.GetExampleIterator(), binaryStream);
+    }
+
+    // an identity map leaves the binary dataset memory-mapped
+    common::MapLoadArguments identityArgs;
+    identityArgs.defaultInputSize = dataset.NumFeatures();
+    auto identityDataset = common::LoadTransformedDataset(filename, common::LoadMap(identityArgs));
+
+    bool sameExamples = identityDataset.NumExamples() == dataset.NumExamples();
+    auto exampleIterator = identityDataset.GetExampleIterator();
+    for (size_t index = 0; sameExamples && exampleIterator.IsValid(); ++index, exampleIterator.Next())
+    {
+        auto example = exampleIterator.Get();
+        sameExamples = testing::IsEqual(example.GetDataVector().ToArray(dataset.NumFeatures()), dataset[index].GetDataVector().ToArray(dataset.NumFeatures())) &&
+                       example.GetMetadata().label == dataset[index].GetMetadata().label;
+    }
+    testing::ProcessTest("Testing LoadTransformedDataset keeps binary data mapped", identityDataset.IsMapped() && sameExamples);
+
+    // a map that truncates the examples runs over them, and the result is held in memory
+    common::MapLoadArguments truncatingArgs;
+    truncatingArgs.defaultInputSize = dataset.NumFeatures() - 1;
+    auto truncatedDataset = common::LoadTransformedDataset(filename, common::LoadMap(truncatingArgs));
+    testing::ProcessTest("Testing LoadTransformedDataset transforms binary data", !truncatedDataset.IsMapped() && truncatedDataset.NumExamples() == dataset.NumExamples());
+
+    std::remove(filename.c_str());
+}
+
+void TestLoadTransformedShardedDataset(const std::string& examplePath)
+{
+    const auto dataFilename = utilities::JoinPaths(examplePath, { "data", "testData.txt" });
+    auto stream = utilities::OpenIfstream(dataFilename);
+    auto dataset = common::GetDataset(stream);
+
+    // split the examples into a text shard, which gets the first lines of the data file, and a binary shard
+    auto splitIndex = dataset.NumExamples() / 2;
+    const std::vector<std::string> filenames = { "testShard0.txt", "testShard1.elldata" };
+    {
+        auto lineStream = utilities::OpenIfstream(dataFilename);
+        auto textStream = utilities::OpenOfstream(filenames[0]);
+        std::string line;
+        for (size_t index = 0; index < splitIndex && std::getline(lineStream, line); ++index)
+        {
+            textStream << line << '\n';
+        }
+    }
+    {
+        auto binaryStream = utilities::OpenBinaryOfstream(filenames[1]);
+        data::WriteBinaryDataset(dataset.GetExampleIterator(splitIndex), binaryStream);
+    }
+
+    // a map that truncates the examples is run over every example of both shards
+    common::MapLoadArguments truncatingArgs;
+    truncatingArgs.defaultInputSize = dataset.NumFeatures() - 1;
+    auto map = common::LoadMap(truncatingArgs);
+    data::ShardedDatasetParameters parameters;
+    parameters.permuteShards = false;
+    parameters.permuteExamples = false;
+    auto shardedDataset = common::LoadTransformedShardedDataset(filenames, map, parameters);
+
+    size_t numExamples = 0;
+    bool sameExamples = true;
+    auto exampleIterator = shardedDataset.GetExampleIterator();
+    for (; exampleIterator.IsValid(); exampleIterator.Next(), ++numExamples)
+    {
+        auto example = exampleIterator.Get();
+        sameExamples = sameExamples && numExamples < dataset.NumExamples() &&
+                       example.GetDataVector().PrefixLength() <= dataset.NumFeatures() - 1 &&
+                       testing::IsEqual(example.GetDataVector().ToArray(dataset.NumFeatures() - 1), dataset[numExamples].GetDataVector().ToArray(dataset.NumFeatures() - 1)) &&
+                       example.GetMetadata().label == dataset[numExamples].GetMetadata().label;
+    }
+    testing::ProcessTest("Testing LoadTransformedShardedDataset", shardedDataset.NumShards() == 2 && numExamples == dataset.NumExamples() && sameExamples);
+
+    for (const auto& filename : filenames)
+    {
+        std::remove(filename.c_str());
+    }
+}
 } // namespace ell
@@ -43,6 +43,8 @@ int main(int argc, char* argv[])
 
         TestLoadDataset(examplePath);
         TestLoadMappedDataset(examplePath);
+        TestLoadBinaryDataset(examplePath);
+        TestLoadTransformedShardedDataset(examplePath);
     }
     catch (const utilities::Exception& exception)
     {
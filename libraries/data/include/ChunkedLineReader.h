@@ -0,0 +1,55 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ChunkedLineReader.h (data)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <istream>
+#include <string>
+
+namespace ell
+{
+namespace data
+{
+    /// <summary> Reads a long text in large blocks that always end on a line boundary, so that each block can be
+    /// split into lines and parsed independently of the others. </summary>
+    class ChunkedLineReader
+    {
+    public:
+        /// <summary> Constructs a chunked line reader. </summary>
+        ///
+        /// <param name="stream"> The input stream. </param>
+        /// <param name="chunkSize"> The number of bytes to read from the stream at a time. A chunk is longer than this
+        /// only when it contains a single line that is longer than this. </param>
+        /// <param name="delim"> The line delimiter. </param>
+        ChunkedLineReader(std::istream& stream, size_t chunkSize, char delim = '\n');
+
+        ChunkedLineReader(const ChunkedLineReader&) = delete;
+
+        /// <summary> Reads the next chunk of complete lines. The last line of the text is included even if it doesn't
+        /// end with a delimiter. </summary>
+        ///
+        /// <param name="chunk"> [out] The string that receives the chunk. Its capacity is reused. </param>
+        ///
+        /// <returns> true if a chunk was read, false if the end of the stream was reached. </returns>
+        bool ReadChunk(std::string& chunk);
+
+        /// <summary> Gets the line delimiter. </summary>
+        ///
+        /// <returns> The delimiter. </returns>
+        char GetDelimiter() const { return _delim; }
+
+    private:
+        std::istream& _stream;
+        size_t _chunkSize;
+        char _delim;
+        bool _isAtEnd = false;
+        std::string _remainder;
+    };
+} // namespace data
+} // namespace ell
@@ -29,6 +29,8 @@ namespace data
     template <typename ExampleType>
     class Dataset;
 
+    class MappedDataset;
+
     /// <summary> Polymorphic interface for datasets, enables dynamic_cast operations. </summary>
     struct DatasetBase
     {
@@ -292,6 +294,8 @@ namespace data
 
 #pragma region implementation
 
+#include "MappedDataset.h"
+
 #include <utilities/include/Exception.h>
 #include <utilities/include/Logger.h>
 
@@ -315,7 +319,8 @@ namespace data
         // all Dataset types for which GetAnyDataset() is called must be listed below, in the variadic template argument.
         using Invoker = utilities::AbstractInvoker<DatasetBase,
                                                    Dataset<data::AutoSupervisedExample>,
-                                                   Dataset<data::DenseSupervisedExample>>;
+                                                   Dataset<data::DenseSupervisedExample>,
+                                                   MappedDataset>;
 
         return Invoker::Invoke<ExampleIterator<ExampleType>>(getExampleIterator, _pDataset);
     }
@@ -0,0 +1,474 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     MappedDataset.h (data)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "AutoDataVector.h"
+#include "Dataset.h"
+#include "Example.h"
+#include "ExampleIterator.h"
+#include "IndexValue.h"
+#include "SparseDataVector.h"
+#include "WeightLabel.h"
+
+#include <math/include/Vector.h>
+
+#include <utilities/include/MemoryMappedFile.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ell
+{
+namespace data
+{
+    /// <summary> The header at the start of a binary dataset file.
+    ///
+    /// A binary dataset file holds a sequence of example records followed by a table of the file offset of each
+    /// record. Each record is a `BinaryExampleHeader`, followed by the example's nonzero indices as `uint32_t`s
+    /// (padded to a multiple of 8 bytes), followed by the corresponding values as `double`s. The values are omitted
+    /// when they are all 1. All values are stored in the byte order of the machine that wrote the file. </summary>
+    struct BinaryDatasetHeader
+    {
+        /// <summary> Identifies the file as a binary dataset. </summary>
+        char magic[8];
+
+        /// <summary> The version of the file format. </summary>
+        uint64_t version;
+
+        /// <summary> The number of examples in the file. </summary>
+        uint64_t numExamples;
+
+        /// <summary> The size of the longest example data vector (the largest nonzero index plus one). </summary>
+        uint64_t numFeatures;
+
+        /// <summary> The file offset of the table of example record offsets. </summary>
+        uint64_t offsetsPosition;
+    };
+
+    /// <summary> The header of each example record in a binary dataset file. </summary>
+    struct BinaryExampleHeader
+    {
+        /// <summary> Flag that indicates that all of an example's nonzero values are 1, so they aren't stored. </summary>
+        static constexpr uint32_t binaryValuesFlag = 1;
+
+        double weight;
+        double label;
+        uint32_t numNonZeros;
+        uint32_t flags;
+    };
+
+    /// <summary> Writes examples to a stream in the binary dataset format, one at a time, so that datasets larger
+    /// than memory can be converted. </summary>
+    class BinaryDatasetWriter
+    {
+    public:
+        /// <summary> Constructor. </summary>
+        ///
+        /// <param name="stream"> The stream to write to. It must be a seekable binary stream, since the file header is
+        /// written last. </param>
+        BinaryDatasetWriter(std::ostream& stream);
+
+        BinaryDatasetWriter(const BinaryDatasetWriter&) = delete;
+        BinaryDatasetWriter& operator=(const BinaryDatasetWriter&) = delete;
+
+        /// <summary> Appends an example with `WeightLabel` metadata. </summary>
+        ///
+        /// <typeparam name="ExampleType"> The example type. </typeparam>
+        /// <param name="example"> The example to write. </param>
+        template <typename ExampleType>
+        void AddExample(const ExampleType& example);
+
+        /// <summary> Appends an example. </summary>
+        ///
+        /// <param name="metadata"> The example's weight and label. </param>
+        /// <param name="indices"> The indices of the example's nonzero elements, in increasing order. </param>
+        /// <param name="values"> The values of the example's nonzero elements. </param>
+        void AddExample(const WeightLabel& metadata, const std::vector<uint32_t>& indices, const std::vector<double>& values);
+
+        /// <summary> Writes the table of example offsets and the file header. No examples can be added afterwards. </summary>
+        void Finish();
+
+        /// <summary> Gets the number of examples written so far. </summary>
+        ///
+        /// <returns> The number of examples. </returns>
+        size_t NumExamples() const { return _offsets.size(); }
+
+    private:
+        std::ostream& _stream;
+        std::streamoff _startPosition;
+        std::vector<uint64_t> _offsets;
+        uint64_t _numFeatures = 0;
+        bool _isFinished = false;
+
+        // scratch space reused between examples
+        std::vector<uint32_t> _indices;
+        std::vector<double> _values;
+    };
+
+    /// <summary> Writes a sequence of examples to a stream in the binary dataset format. </summary>
+    ///
+    /// <typeparam name="ExampleType"> The example type. </typeparam>
+    /// <param name="exampleIterator"> The examples to write. </param>
+    /// <param name="stream"> The stream to write to. </param>
+    ///
+    /// <returns> The number of examples written. </returns>
+    template <typename ExampleType>
+    size_t WriteBinaryDataset(ExampleIterator<ExampleType> exampleIterator, std::ostream& stream);
+
+    /// <summary> An index-value iterator over the nonzero elements of an example stored in a mapped binary dataset. </summary>
+    class MappedIndexValueIterator : public IIndexValueIterator
+    {
+    public:
+        /// <summary> Constructor. </summary>
+        ///
+        /// <param name="indices"> Pointer to the indices of the nonzero elements. </param>
+        /// <param name="values"> Pointer to the values of the nonzero elements, or nullptr if they are all 1. </param>
+        /// <param name="size"> The number of nonzero elements. </param>
+        MappedIndexValueIterator(const uint32_t* indices, const double* values, size_t size) :
+            _indices(indices),
+            _values(values),
+            _size(size) {}
+
+        /// <summary> Returns true if the iterator is currently pointing to a valid element. </summary>
+        bool IsValid() const { return _current < _size; }
+
+        /// <summary> Proceeds to the next element. </summary>
+        void Next() { ++_current; }
+
+        /// <summary> Returns the current index-value pair. </summary>
+        IndexValue Get() const { return { _indices[_current], _values == nullptr ? 1.0 : _values[_current] }; }
+
+    private:
+        const uint32_t* _indices;
+        const double* _values;
+        size_t _size;
+        size_t _current = 0;
+    };
+
+    /// <summary> A read-only view of the data vector of an example stored in a mapped binary dataset. It reads the
+    /// indices and values in place, so it is only valid as long as the dataset it came from. </summary>
+    class MappedDataVector
+    {
+    public:
+        /// <summary> Constructor. </summary>
+        ///
+        /// <param name="indices"> Pointer to the indices of the nonzero elements, in increasing order. </param>
+        /// <param name="values"> Pointer to the values of the nonzero elements, or nullptr if they are all 1. </param>
+        /// <param name="size"> The number of nonzero elements. </param>
+        MappedDataVector(const uint32_t* indices, const double* values, size_t size) :
+            _indices(indices),
+            _values(values),
+            _size(size) {}
+
+        /// <summary> Gets the number of nonzero elements. </summary>
+        ///
+        /// <returns> The number of nonzeros. </returns>
+        size_t NumNonZeros() const { return _size; }
+
+        /// <summary> Gets the size of the data vector (the largest nonzero index plus one). </summary>
+        ///
+        /// <returns> The prefix length. </returns>
+        size_t PrefixLength() const { return _size == 0 ? 0 : _indices[_size - 1] + 1; }
+
+        /// <summary> Gets a pointer to the indices of the nonzero elements in the mapped file. </summary>
+        ///
+        /// <returns> The indices. </returns>
+        const uint32_t* GetIndices() const { return _indices; }
+
+        /// <summary> Gets a pointer to the values of the nonzero elements in the mapped file. </summary>
+        ///
+        /// <returns> The values, or nullptr if they are all 1. </returns>
+        const double* GetValues() const { return _values; }
+
+        /// <summary> Gets an iterator over the nonzero elements. </summary>
+        ///
+        /// <returns> The index-value iterator. </returns>
+        MappedIndexValueIterator GetIterator() const { return { _indices, _values, _size }; }
+
+        /// <summary> Computes the squared 2-norm. </summary>
+        ///
+        /// <returns> The squared 2-norm. </returns>
+        double Norm2Squared() const;
+
+        /// <summary> Computes the dot product with another vector. Elements past the end of the other vector are
+        /// ignored. </summary>
+        ///
+        /// <param name="vector"> The other vector. </param>
+        ///
+        /// <returns> The dot product. </returns>
+        double Dot(math::UnorientedConstVectorBase<double> vector) const;
+
+        /// <summary> Computes the dot product with another vector. Elements past the end of the other vector are
+        /// ignored. </summary>
+        ///
+        /// <param name="vector"> The other vector. </param>
+        ///
+        /// <returns> The dot product. </returns>
+        float Dot(math::UnorientedConstVectorBase<float> vector) const;
+
+        /// <summary> Adds this data vector to another vector. Elements past the end of the other vector are
+        /// ignored. </summary>
+        ///
+        /// <param name="vector"> [in,out] The vector that this data vector is added to. </param>
+        void AddTo(math::RowVectorReference<double> vector) const;
+
+        /// <summary> Copies the contents of the data vector into a std::vector of size PrefixLength(). </summary>
+        ///
+        /// <returns> The std::vector. </returns>
+        std::vector<double> ToArray() const { return ToArray(PrefixLength()); }
+
+        /// <summary> Copies the contents of the data vector into a std::vector of a given size. </summary>
+        ///
+        /// <param name="size"> The size of the std::vector. </param>
+        ///
+        /// <returns> The std::vector. </returns>
+        std::vector<double> ToArray(size_t size) const;
+
+        /// <summary> Copies the data vector into a data vector that owns its data. </summary>
+        ///
+        /// <typeparam name="ReturnType"> The data vector type to create. </typeparam>
+        ///
+        /// <returns> The new data vector. </returns>
+        template <typename ReturnType>
+        ReturnType CopyAs() const
+        {
+            return ReturnType(GetIterator());
+        }
+
+    private:
+        double GetValue(size_t position) const { return _values == nullptr ? 1.0 : _values[position]; }
+
+        const uint32_t* _indices;
+        const double* _values;
+        size_t _size;
+    };
+
+    /// <summary> A view of an example stored in a mapped binary dataset. It points directly into the mapped file, so
+    /// it is only valid as long as the dataset it came from. </summary>
+    class MappedExample
+    {
+    public:
+        using DataVectorType = MappedDataVector;
+        using MetadataType = WeightLabel;
+
+        /// <summary> Constructor. Throws an exception if the record doesn't fit in the bytes available to it. </summary>
+        ///
+        /// <param name="record"> Pointer to the example's record in the mapped file. </param>
+        /// <param name="maxRecordSize"> The number of bytes from the start of the record to the end of the example records. </param>
+        MappedExample(const char* record, size_t maxRecordSize);
+
+        /// <summary> Gets the example's weight and label. </summary>
+        ///
+        /// <returns> The metadata. </returns>
+        WeightLabel GetMetadata() const { return { _header->weight, _header->label }; }
+
+        /// <summary> Gets the number of nonzero elements in the example's data vector. </summary>
+        ///
+        /// <returns> The number of nonzeros. </returns>
+        size_t NumNonZeros() const { return _dataVector.NumNonZeros(); }
+
+        /// <summary> Gets the size of the example's data vector (the largest nonzero index plus one). </summary>
+        ///
+        /// <returns> The prefix length of the data vector. </returns>
+        size_t PrefixLength() const { return _dataVector.PrefixLength(); }
+
+        /// <summary> Gets a view of the example's data vector, which reads the mapped file in place. </summary>
+        ///
+        /// <returns> The data vector view. </returns>
+        const MappedDataVector& GetDataVector() const { return _dataVector; }
+
+        /// <summary> Gets an iterator over the nonzero elements of the example's data vector. </summary>
+        ///
+        /// <returns> The index-value iterator. </returns>
+        MappedIndexValueIterator GetIterator() const { return _dataVector.GetIterator(); }
+
+        /// <summary> Copies the example into an example that owns its data vector. </summary>
+        ///
+        /// <typeparam name="ExampleType"> The example type to create. Its metadata type must be `WeightLabel`. </typeparam>
+        ///
+        /// <returns> The new example. </returns>
+        template <typename ExampleType>
+        ExampleType CopyAs() const;
+
+    private:
+        const BinaryExampleHeader* _header;
+        MappedDataVector _dataVector;
+    };
+
+    /// <summary> A read-only dataset backed by a memory-mapped binary dataset file. Opening the dataset only reads the
+    /// file header; the operating system pages example records in as they are accessed, so datasets larger than memory
+    /// can be used. </summary>
+    class MappedDataset : public DatasetBase
+    {
+    public:
+        /// <summary> Opens a binary dataset file. Throws an exception if the file isn't a valid binary dataset. </summary>
+        ///
+        /// <param name="filepath"> The path of the file. </param>
+        MappedDataset(const std::string& filepath);
+
+        MappedDataset(MappedDataset&&) = default;
+        MappedDataset& operator=(MappedDataset&&) = default;
+
+        /// <summary> Returns the number of examples in the dataset. </summary>
+        ///
+        /// <returns> The number of examples. </returns>
+        size_t NumExamples() const { return _header->numExamples; }
+
+        /// <summary> Returns the maximal size of any example. </summary>
+        ///
+        /// <returns> The number of features. </returns>
+        size_t NumFeatures() const { return _header->numFeatures; }
+
+        /// <summary> Returns a view of an example. Throws an exception if the example's record lies outside the file. </summary>
+        ///
+        /// <param name="index"> Zero-based index of the example. </param>
+        ///
+        /// <returns> The example view. </returns>
+        MappedExample GetExample(size_t index) const;
+
+        /// <summary> Returns a view of an example. </summary>
+        ///
+        /// <param name="index"> Zero-based index of the example. </param>
+        ///
+        /// <returns> The example view. </returns>
+        MappedExample operator[](size_t index) const { return GetExample(index); }
+
+        /// <summary> Returns an iterator over a range of examples. With `MappedExample` as the example type, the
+        /// iterator returns views into the file and nothing is copied or allocated per example; with any other
+        /// example type, each example is copied out of the file as it is visited. </summary>
+        ///
+        /// <typeparam name="IteratorExampleType"> The example type returned by the iterator. </typeparam>
+        /// <param name="fromIndex"> Zero-based index of the first example. </param>
+        /// <param name="size"> The number of examples to iterate over, or zero to iterate to the end of the dataset. </param>
+        ///
+        /// <returns> The example iterator. </returns>
+        template <typename IteratorExampleType = AutoSupervisedExample>
+        ExampleIterator<IteratorExampleType> GetExampleIterator(size_t fromIndex = 0, size_t size = 0) const;
+
+        /// <summary> Returns an AnyDataset that represents a range of examples, which can be given to a trainer. </summary>
+        ///
+        /// <param name="fromIndex"> Zero-based index of the first example. </param>
+        /// <param name="size"> The number of examples, or zero to go to the end of the dataset. </param>
+        ///
+        /// <returns> The AnyDataset. </returns>
+        AnyDataset GetAnyDataset(size_t fromIndex = 0, size_t size = 0) const { return AnyDataset(this, fromIndex, size); }
+
+    private:
+        template <typename IteratorExampleType>
+        class MappedExampleIterator : public IExampleIterator<IteratorExampleType>
+        {
+        public:
+            MappedExampleIterator(const MappedDataset& dataset, size_t fromIndex, size_t endIndex) :
+                _dataset(dataset),
+                _current(fromIndex),
+                _end(endIndex) {}
+
+            bool IsValid() const override { return _current < _end; }
+
+            void Next() override { ++_current; }
+
+            IteratorExampleType Get() const override { return _dataset.GetIteratorExample<IteratorExampleType>(_current); }
+
+        private:
+            const MappedDataset& _dataset;
+            size_t _current;
+            size_t _end;
+        };
+
+        template <typename ExampleType, utilities::IsSame<ExampleType, MappedExample> Concept = true>
+        ExampleType GetIteratorExample(size_t index) const;
+
+        template <typename ExampleType, utilities::IsDifferent<ExampleType, MappedExample> Concept = true>
+        ExampleType GetIteratorExample(size_t index) const;
+
+        size_t CorrectRangeSize(size_t fromIndex, size_t size) const;
+
+        utilities::MemoryMappedFile _file;
+        const BinaryDatasetHeader* _header = nullptr;
+        const uint64_t* _offsets = nullptr;
+    };
+
+    /// <summary> Returns true if a file starts with the binary dataset header. </summary>
+    ///
+    /// <param name="filepath"> The path of the file. </param>
+    ///
+    /// <returns> True if the file is a binary dataset. </returns>
+    bool IsBinaryDatasetFile(const std::string& filepath);
+} // namespace data
+} // namespace ell
+
+#pragma region implementation
+
+namespace ell
+{
+namespace data
+{
+    template <typename ExampleType>
+    void BinaryDatasetWriter::AddExample(const ExampleType& example)
+    {
+        _indices.clear();
+        _values.clear();
+        auto dataVector = example.GetDataVector().template CopyAs<SparseDoubleDataVector>();
+        auto iterator = GetIterator<SparseDoubleDataVector, IterationPolicy::skipZeros>(dataVector);
+        while (iterator.IsValid())
+        {
+            auto indexValue = iterator.Get();
+            _indices.push_back(static_cast<uint32_t>(indexValue.index));
+            _values.push_back(indexValue.value);
+            iterator.Next();
+        }
+        AddExample(example.GetMetadata(), _indices, _values);
+    }
+
+    template <typename ExampleType>
+    size_t WriteBinaryDataset(ExampleIterator<ExampleType> exampleIterator, std::ostream& stream)
+    {
+        BinaryDatasetWriter writer(stream);
+        while (exampleIterator.IsValid())
+        {
+            writer.AddExample(exampleIterator.Get());
+            exampleIterator.Next();
+        }
+        writer.Finish();
+        return writer.NumExamples();
+    }
+
+    template <typename ExampleType>
+    ExampleType MappedExample::CopyAs() const
+    {
+        using DataVectorType = typename ExampleType::DataVectorType;
+        return ExampleType(DataVectorType(GetIterator()), GetMetadata());
+    }
+
+    template <typename ExampleType, utilities::IsSame<ExampleType, MappedExample> Concept>
+    ExampleType MappedDataset::GetIteratorExample(size_t index) const
+    {
+        return GetExample(index);
+    }
+
+    template <typename ExampleType, utilities::IsDifferent<ExampleType, MappedExample> Concept>
+    ExampleType MappedDataset::GetIteratorExample(size_t index) const
+    {
+        return GetExample(index).template CopyAs<ExampleType>();
+    }
+
+    template <typename IteratorExampleType>
+    ExampleIterator<IteratorExampleType> MappedDataset::GetExampleIterator(size_t fromIndex, size_t size) const
+    {
+        size = CorrectRangeSize(fromIndex, size);
+        return ExampleIterator<IteratorExampleType>(std::make_unique<MappedExampleIterator<IteratorExampleType>>(*this, fromIndex, fromIndex + size));
+    }
+} // namespace data
+} // namespace ell
+
+#pragma endregion implementation
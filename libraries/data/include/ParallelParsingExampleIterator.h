@@ -0,0 +1,212 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ParallelParsingExampleIterator.h (data)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ChunkedLineReader.h"
+#include "Example.h"
+#include "ExampleIterator.h"
+#include "TextLine.h"
+
+#include <utilities/include/ThreadPool.h>
+
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ell
+{
+namespace data
+{
+    /// <summary> Parameters that control parallel parsing. </summary>
+    struct ParallelParsingParameters
+    {
+        /// <summary> The number of parsing threads. '0' means one thread per hardware thread. </summary>
+        size_t numThreads = 0;
+
+        /// <summary> The number of bytes of text each thread parses at a time. </summary>
+        size_t chunkSize = 1 << 22;
+    };
+
+    /// <summary>
+    /// An Example iterator that reads a text stream in large chunks of complete lines, and parses a batch of chunks
+    /// in parallel (one chunk per thread) while preserving the order of the examples. Each line is parsed the same way
+    /// as in SingleLineParsingExampleIterator: the metadata parser is applied first and the datavector parser second.
+    /// The parsers' Parse functions are called concurrently, so they must not modify shared state.
+    /// </summary>
+    ///
+    /// <typeparam name="MetadataParserType"> Metadata parser type. </typeparam>
+    /// <typeparam name="DataVectorParserType"> DataVector parser type. </typeparam>
+    template <typename MetadataParserType, typename DataVectorParserType>
+    class ParallelParsingExampleIterator : public IExampleIterator<ParserExample<DataVectorParserType, MetadataParserType>>
+    {
+    public:
+        using ExampleType = ParserExample<DataVectorParserType, MetadataParserType>;
+
+        /// <summary> Constructs a ParallelParsingExampleIterator. </summary>
+        ///
+        /// <param name="stream"> The input stream. </param>
+        /// <param name="metadataParser"> The metadata parser. </param>
+        /// <param name="dataVectorParser"> The data vector parser. </param>
+        /// <param name="parameters"> The parallel parsing parameters. </param>
+        ParallelParsingExampleIterator(std::istream& stream, MetadataParserType metadataParser, DataVectorParserType dataVectorParser, const ParallelParsingParameters& parameters);
+
+        /// <summary> Returns true if the iterator is currently pointing to a valid iterate. </summary>
+        ///
+        /// <returns> true if the iterator is valid, false otherwise. </returns>
+        bool IsValid() const override { return _chunkIndex < _numChunks; }
+
+        /// <summary> Proceeds to the next example. </summary>
+        void Next() override;
+
+        /// <summary> Gets the current example. </summary>
+        ///
+        /// <returns> A SupervisedExample. </returns>
+        ExampleType Get() const override { return _chunkExamples[_chunkIndex][_exampleIndex]; }
+
+    private:
+        void ReadBatch();
+        void SkipEmptyChunks();
+        void ParseChunk(const std::string& chunk, std::vector<ExampleType>& examples) const;
+
+        ChunkedLineReader _reader;
+        MetadataParserType _metadataParser;
+        DataVectorParserType _dataVectorParser;
+        std::unique_ptr<utilities::ThreadPool> _threadPool;
+
+        // one text buffer and one example buffer per thread, reused from batch to batch
+        std::vector<std::string> _chunks;
+        std::vector<std::vector<ExampleType>> _chunkExamples;
+        size_t _numChunks = 0;
+        size_t _chunkIndex = 0;
+        size_t _exampleIndex = 0;
+    };
+
+    /// <summary>
+    /// Helper function that creates a ParallelParsingExampleIterator from a stream, a metadata parser, and a
+    /// datavector parser.
+    /// </summary>
+    ///
+    /// <typeparam name="MetadataParserType"> Metadata parser type. </typeparam>
+    /// <typeparam name="DataVectorParserType"> Data vector parser type. </typeparam>
+    /// <param name="stream"> The input stream. </param>
+    /// <param name="metadataParser"> The metadata parser. </param>
+    /// <param name="dataVectorParser"> The data vector parser. </param>
+    /// <param name="parameters"> The parallel parsing parameters. </param>
+    ///
+    /// <returns> The parallel parsing example iterator. </returns>
+    template <typename MetadataParserType, typename DataVectorParserType>
+    auto MakeParallelParsingExampleIterator(std::istream& stream, MetadataParserType metadataParser, DataVectorParserType dataVectorParser, const ParallelParsingParameters& parameters = {});
+} // namespace data
+} // namespace ell
+
+#pragma region implementation
+
+#include <algorithm>
+#include <cstring>
+
+namespace ell
+{
+namespace data
+{
+    template <typename MetadataParserType, typename DataVectorParserType>
+    ParallelParsingExampleIterator<MetadataParserType, DataVectorParserType>::ParallelParsingExampleIterator(std::istream& stream, MetadataParserType metadataParser, DataVectorParserType dataVectorParser, const ParallelParsingParameters& parameters) :
+        _reader(stream, parameters.chunkSize),
+        _metadataParser(std::move(metadataParser)),
+        _dataVectorParser(std::move(dataVectorParser)),
+        _threadPool(std::make_unique<utilities::ThreadPool>(parameters.numThreads))
+    {
+        _chunks.resize(_threadPool->NumThreads());
+        _chunkExamples.resize(_threadPool->NumThreads());
+        ReadBatch();
+        SkipEmptyChunks();
+    }
+
+    template <typename MetadataParserType, typename DataVectorParserType>
+    void ParallelParsingExampleIterator<MetadataParserType, DataVectorParserType>::Next()
+    {
+        ++_exampleIndex;
+        SkipEmptyChunks();
+    }
+
+    template <typename MetadataParserType, typename DataVectorParserType>
+    void ParallelParsingExampleIterator<MetadataParserType, DataVectorParserType>::SkipEmptyChunks()
+    {
+        while (_chunkIndex < _numChunks && _exampleIndex >= _chunkExamples[_chunkIndex].size())
+        {
+            ++_chunkIndex;
+            _exampleIndex = 0;
+            if (_chunkIndex == _numChunks)
+            {
+                ReadBatch();
+            }
+        }
+    }
+
+    template <typename MetadataParserType, typename DataVectorParserType>
+    void ParallelParsingExampleIterator<MetadataParserType, DataVectorParserType>::ReadBatch()
+    {
+        // reading is sequential, parsing is parallel
+        _numChunks = 0;
+        while (_numChunks < _chunks.size() && _reader.ReadChunk(_chunks[_numChunks]))
+        {
+            ++_numChunks;
+        }
+
+        _threadPool->ParallelFor(_numChunks, [this](size_t index) {
+            ParseChunk(_chunks[index], _chunkExamples[index]);
+        });
+
+        _chunkIndex = 0;
+        _exampleIndex = 0;
+    }
+
+    template <typename MetadataParserType, typename DataVectorParserType>
+    void ParallelParsingExampleIterator<MetadataParserType, DataVectorParserType>::ParseChunk(const std::string& chunk, std::vector<ExampleType>& examples) const
+    {
+        const auto delim = _reader.GetDelimiter();
+        examples.clear();
+        examples.reserve(std::count(chunk.begin(), chunk.end(), delim) + 1);
+
+        const char* begin = chunk.data();
+        const char* end = begin + chunk.size();
+        while (begin < end)
+        {
+            auto lineEnd = static_cast<const char*>(std::memchr(begin, delim, end - begin));
+            if (lineEnd == nullptr)
+            {
+                lineEnd = end;
+            }
+
+            // skip lines that contain just whitespace or just a comment
+            TextLine line(std::string(begin, lineEnd));
+            line.TrimLeadingWhitespace();
+            if (!line.IsEndOfContent())
+            {
+                auto metaData = _metadataParser.Parse(line);
+                auto dataVector = _dataVectorParser.Parse(line);
+                examples.emplace_back(std::move(dataVector), std::move(metaData));
+            }
+            begin = lineEnd + 1;
+        }
+    }
+
+    template <typename MetadataParserType, typename DataVectorParserType>
+    auto MakeParallelParsingExampleIterator(std::istream& stream, MetadataParserType metadataParser, DataVectorParserType dataVectorParser, const ParallelParsingParameters& parameters)
+    {
+        using ExampleType = ParserExample<DataVectorParserType, MetadataParserType>;
+        using IteratorType = ParallelParsingExampleIterator<MetadataParserType, DataVectorParserType>;
+        auto iterator = std::make_unique<IteratorType>(stream, std::move(metadataParser), std::move(dataVectorParser), parameters);
+        return ExampleIterator<ExampleType>(std::move(iterator));
+    }
+} // namespace data
+} // namespace ell
+
+#pragma endregion implementation
@@ -0,0 +1,223 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ShardedDataset.h (data)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Dataset.h"
+#include "ExampleIterator.h"
+
+#include <utilities/include/ThreadPool.h>
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace ell
+{
+namespace data
+{
+    /// <summary> Parameters that control how a sharded dataset is streamed. </summary>
+    struct ShardedDatasetParameters
+    {
+        /// <summary> The number of shards loaded in the background while the current shard is consumed. At most this
+        /// many shards, plus the current one, are held in memory at any time. </summary>
+        size_t numPrefetchShards = 1;
+
+        /// <summary> Whether to visit the shards in a random order. </summary>
+        bool permuteShards = true;
+
+        /// <summary> Whether to randomly permute the examples within each shard. </summary>
+        bool permuteExamples = true;
+
+        /// <summary> The random seed string. </summary>
+        std::string randomSeedString = "ShardedDataset";
+    };
+
+    /// <summary>
+    /// A dataset that is too big to hold in memory, stored as a sequence of shards that each fit in memory. Each call
+    /// to GetExampleIterator starts a new pass over the data, which loads the shards one at a time, in a new random
+    /// order, while the next shards are loaded on a background thread.
+    /// </summary>
+    ///
+    /// <typeparam name="ExampleType"> The example type. </typeparam>
+    template <typename ExampleType>
+    class ShardedDataset
+    {
+    public:
+        /// <summary> A function that loads a shard, given its index. It is called on a background thread, one shard at a time. </summary>
+        using ShardLoaderType = std::function<Dataset<ExampleType>(size_t shardIndex)>;
+
+        /// <summary> Constructs a sharded dataset. </summary>
+        ///
+        /// <param name="numShards"> The number of shards. </param>
+        /// <param name="shardLoader"> The function that loads a shard. </param>
+        /// <param name="parameters"> The streaming parameters. </param>
+        ShardedDataset(size_t numShards, ShardLoaderType shardLoader, const ShardedDatasetParameters& parameters = {});
+
+        /// <summary> Returns the number of shards. </summary>
+        ///
+        /// <returns> The number of shards. </returns>
+        size_t NumShards() const { return _numShards; }
+
+        /// <summary> Starts a new pass over the data. </summary>
+        ///
+        /// <returns> An example iterator that streams the examples of all the shards. </returns>
+        ExampleIterator<ExampleType> GetExampleIterator();
+
+    private:
+        class ShardedExampleIterator : public IExampleIterator<ExampleType>
+        {
+        public:
+            ShardedExampleIterator(ShardLoaderType shardLoader, std::vector<size_t> shardOrder, std::vector<std::default_random_engine::result_type> shardSeeds, const ShardedDatasetParameters& parameters);
+
+            bool IsValid() const override { return _exampleIndex < _shard.NumExamples(); }
+            void Next() override;
+            ExampleType Get() const override { return _shard[_exampleIndex]; }
+
+        private:
+            void Prefetch();
+            void NextShard();
+
+            ShardLoaderType _shardLoader;
+            std::vector<size_t> _shardOrder;
+            std::vector<std::default_random_engine::result_type> _shardSeeds;
+            bool _permuteExamples;
+            size_t _numPrefetchShards;
+
+            size_t _numRequestedShards = 0;
+            std::deque<std::future<Dataset<ExampleType>>> _pendingShards;
+            Dataset<ExampleType> _shard;
+            size_t _exampleIndex = 0;
+
+            // declared last so that it is destroyed first, after finishing the loads that are still in flight
+            std::unique_ptr<utilities::ThreadPool> _threadPool;
+        };
+
+        size_t _numShards;
+        ShardLoaderType _shardLoader;
+        ShardedDatasetParameters _parameters;
+        std::default_random_engine _random;
+    };
+} // namespace data
+} // namespace ell
+
+#pragma region implementation
+
+#include <utilities/include/Exception.h>
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+namespace ell
+{
+namespace data
+{
+    template <typename ExampleType>
+    ShardedDataset<ExampleType>::ShardedDataset(size_t numShards, ShardLoaderType shardLoader, const ShardedDatasetParameters& parameters) :
+        _numShards(numShards),
+        _shardLoader(std::move(shardLoader)),
+        _parameters(parameters)
+    {
+        if (_shardLoader == nullptr)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::nullReference, "ShardedDataset requires a shard loader");
+        }
+        std::seed_seq seed(_parameters.randomSeedString.begin(), _parameters.randomSeedString.end());
+        _random = std::default_random_engine(seed);
+    }
+
+    template <typename ExampleType>
+    ExampleIterator<ExampleType> ShardedDataset<ExampleType>::GetExampleIterator()
+    {
+        std::vector<size_t> shardOrder(_numShards);
+        std::iota(shardOrder.begin(), shardOrder.end(), 0);
+        if (_parameters.permuteShards)
+        {
+            std::shuffle(shardOrder.begin(), shardOrder.end(), _random);
+        }
+
+        // the seeds are drawn here rather than on the loading thread, so the order of the examples is reproducible
+        std::vector<std::default_random_engine::result_type> shardSeeds(_numShards);
+        for (auto& seed : shardSeeds)
+        {
+            seed = _random();
+        }
+
+        auto iterator = std::make_unique<ShardedExampleIterator>(_shardLoader, std::move(shardOrder), std::move(shardSeeds), _parameters);
+        return ExampleIterator<ExampleType>(std::move(iterator));
+    }
+
+    template <typename ExampleType>
+    ShardedDataset<ExampleType>::ShardedExampleIterator::ShardedExampleIterator(ShardLoaderType shardLoader, std::vector<size_t> shardOrder, std::vector<std::default_random_engine::result_type> shardSeeds, const ShardedDatasetParameters& parameters) :
+        _shardLoader(std::move(shardLoader)),
+        _shardOrder(std::move(shardOrder)),
+        _shardSeeds(std::move(shardSeeds)),
+        _permuteExamples(parameters.permuteExamples),
+        _numPrefetchShards(std::max<size_t>(parameters.numPrefetchShards, 1)),
+        _threadPool(std::make_unique<utilities::ThreadPool>(1))
+    {
+        Prefetch();
+        NextShard();
+    }
+
+    template <typename ExampleType>
+    void ShardedDataset<ExampleType>::ShardedExampleIterator::Next()
+    {
+        ++_exampleIndex;
+        if (_exampleIndex >= _shard.NumExamples())
+        {
+            NextShard();
+        }
+    }
+
+    template <typename ExampleType>
+    void ShardedDataset<ExampleType>::ShardedExampleIterator::Prefetch()
+    {
+        while (_pendingShards.size() < _numPrefetchShards && _numRequestedShards < _shardOrder.size())
+        {
+            auto shardIndex = _shardOrder[_numRequestedShards];
+            auto seed = _shardSeeds[_numRequestedShards];
+            auto permuteExamples = _permuteExamples;
+            auto shardLoader = _shardLoader;
+            _pendingShards.push_back(_threadPool->Run([shardLoader, shardIndex, seed, permuteExamples]() {
+                auto shard = shardLoader(shardIndex);
+                if (permuteExamples)
+                {
+                    std::default_random_engine random(seed);
+                    shard.RandomPermute(random);
+                }
+                return shard;
+            }));
+            ++_numRequestedShards;
+        }
+    }
+
+    template <typename ExampleType>
+    void ShardedDataset<ExampleType>::ShardedExampleIterator::NextShard()
+    {
+        // release the current shard before waiting for the next one, and skip empty shards
+        _shard = Dataset<ExampleType>();
+        _exampleIndex = 0;
+        while (_shard.NumExamples() == 0 && !_pendingShards.empty())
+        {
+            auto next = std::move(_pendingShards.front());
+            _pendingShards.pop_front();
+            Prefetch();
+            _shard = next.get();
+        }
+    }
+} // namespace data
+} // namespace ell
+
+#pragma endregion implementation
@@ -195,13 +195,35 @@ namespace data
         /// <returns> A double. </returns>
         double Dot(math::UnorientedConstVectorBase<double> vector) const override;
 
+        /// <summary> Computes the Dot product. </summary>
+        ///
+        /// <param name="vector"> The other vector. </param>
+        ///
+        /// <returns> A float. </returns>
+        float Dot(math::UnorientedConstVectorBase<float> vector) const override;
+
         /// <summary> Adds this data vector to a math::RowVector </summary>
         ///
         /// <param name="vector"> [in,out] The vector that this DataVector is added to. </param>
         void AddTo(math::RowVectorReference<double> vector) const override;
 
+        /// <summary> Adds a transformed version of this data vector to a math::RowVector. Hides the generic
+        /// version in DataVectorBase with a loop specialized for binary vectors. </summary>
+        ///
+        /// <typeparam name="policy"> The iteration policy. </typeparam>
+        /// <typeparam name="TransformationType"> Type of lambda that transforms IndexValues. </typeparam>
+        /// <param name="vector"> [in,out] The vector that the transformed DataVector is added to. </param>
+        /// <param name="transformation"> The transformation. </param>
+        template <IterationPolicy policy, typename TransformationType>
+        void AddTransformedTo(math::RowVectorReference<double> vector, TransformationType transformation) const;
+
     private:
         using DataVectorBase<SparseBinaryDataVectorBase<IndexListType>>::AppendElements;
+
+        // calls function(index) on each non-zero element whose index is less than size
+        template <typename FunctionType>
+        void ForEachNonZero(size_t size, FunctionType function) const;
+
         IndexListType _indexList;
     };
 
@@ -333,36 +355,61 @@ namespace data
     }
 
     template <typename IndexListType>
-    double SparseBinaryDataVectorBase<IndexListType>::Dot(math::UnorientedConstVectorBase<double> vector) const
+    template <typename FunctionType>
+    void SparseBinaryDataVectorBase<IndexListType>::ForEachNonZero(size_t size, FunctionType function) const
     {
-        double value = 0.0;
-
-        auto iter = _indexList.GetIterator();
-        while (iter.IsValid())
+        for (auto iter = _indexList.GetIterator(); iter.IsValid(); iter.Next())
         {
-            value += vector[iter.Get()];
-            iter.Next();
+            auto index = iter.Get();
+            if (index >= size)
+            {
+                return;
+            }
+            function(index);
         }
+    }
 
+    template <typename IndexListType>
+    double SparseBinaryDataVectorBase<IndexListType>::Dot(math::UnorientedConstVectorBase<double> vector) const
+    {
+        const double* data = vector.GetConstDataPointer();
+        auto increment = vector.GetIncrement();
+        double value = 0.0;
+        ForEachNonZero(vector.Size(), [&](size_t index) { value += data[index * increment]; });
+        return value;
+    }
+
+    template <typename IndexListType>
+    float SparseBinaryDataVectorBase<IndexListType>::Dot(math::UnorientedConstVectorBase<float> vector) const
+    {
+        const float* data = vector.GetConstDataPointer();
+        auto increment = vector.GetIncrement();
+        float value = 0.0;
+        ForEachNonZero(vector.Size(), [&](size_t index) { value += data[index * increment]; });
         return value;
     }
 
     template <typename IndexListType>
     void SparseBinaryDataVectorBase<IndexListType>::AddTo(math::RowVectorReference<double> vector) const
     {
-        auto iter = _indexList.GetIterator();
-        auto size = vector.Size();
+        double* data = vector.GetDataPointer();
+        auto increment = vector.GetIncrement();
+        ForEachNonZero(vector.Size(), [&](size_t index) { data[index * increment] += 1.0; });
+    }
 
-        while (iter.IsValid())
+    template <typename IndexListType>
+    template <IterationPolicy policy, typename TransformationType>
+    void SparseBinaryDataVectorBase<IndexListType>::AddTransformedTo(math::RowVectorReference<double> vector, TransformationType transformation) const
+    {
+        if constexpr (policy == IterationPolicy::skipZeros)
         {
-            auto index = iter.Get();
-            if (index >= size)
-            {
-                return;
-            }
-
-            vector[index] += 1.0;
-            iter.Next();
+            double* data = vector.GetDataPointer();
+            auto increment = vector.GetIncrement();
+            ForEachNonZero(vector.Size(), [&](size_t index) { data[index * increment] += transformation(IndexValue{ index, 1.0 }); });
+        }
+        else
+        {
+            DataVectorBase<SparseBinaryDataVectorBase<IndexListType>>::template AddTransformedTo<policy>(vector, transformation);
         }
     }
 } // namespace data
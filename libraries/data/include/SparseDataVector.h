@@ -190,6 +190,41 @@ namespace data
         /// <returns> The first index of the suffix of zeros at the end of this vector. </returns>
         size_t PrefixLength() const override;
 
+        /// <summary> Computes the vector squared 2-norm. </summary>
+        ///
+        /// <returns> The squared 2-norm of the vector. </returns>
+        double Norm2Squared() const override;
+
+        /// <summary> Computes the dot product with another vector. </summary>
+        ///
+        /// <param name="vector"> The other vector. </param>
+        ///
+        /// <returns> The dot product. </returns>
+        double Dot(math::UnorientedConstVectorBase<double> vector) const override;
+
+        /// <summary> Computes the dot product with another vector. </summary>
+        ///
+        /// <param name="vector"> The other vector. </param>
+        ///
+        /// <returns> The dot product. </returns>
+        float Dot(math::UnorientedConstVectorBase<float> vector) const override;
+
+        /// <summary> Adds this data vector to a math::RowVector </summary>
+        ///
+        /// <param name="vector"> [in,out] The vector that this DataVector is added to. </param>
+        void AddTo(math::RowVectorReference<double> vector) const override;
+
+        /// <summary> Adds a transformed version of this data vector to a math::RowVector. Hides the generic
+        /// version in DataVectorBase, so that `vector += scalar * dataVector` runs a loop specialized for
+        /// this type. </summary>
+        ///
+        /// <typeparam name="policy"> The iteration policy. </typeparam>
+        /// <typeparam name="TransformationType"> Type of lambda that transforms IndexValues. </typeparam>
+        /// <param name="vector"> [in,out] The vector that the transformed DataVector is added to. </param>
+        /// <param name="transformation"> The transformation. </param>
+        template <IterationPolicy policy, typename TransformationType>
+        void AddTransformedTo(math::RowVectorReference<double> vector, TransformationType transformation) const;
+
         /// <summary> Gets the data vector type (implemented by template specialization). </summary>
         ///
         /// <returns> The data vector type. </returns>
@@ -202,6 +237,12 @@ namespace data
 
     private:
         using DataVectorBase<SparseDataVector<ElementType, IndexListType>>::AppendElements;
+
+        // calls function(index, value) on each non-zero element whose index is less than size, without going
+        // through an IndexValue iterator
+        template <typename FunctionType>
+        void ForEachNonZero(size_t size, FunctionType function) const;
+
         IndexListType _indexList;
         std::vector<ElementType> _values;
     };
@@ -357,6 +398,77 @@ namespace data
         _values.push_back(storedValue);
     }
 
+    template <typename ElementType, typename IndexListType>
+    template <typename FunctionType>
+    void SparseDataVector<ElementType, IndexListType>::ForEachNonZero(size_t size, FunctionType function) const
+    {
+        const ElementType* values = _values.data();
+        for (auto indexIterator = _indexList.GetIterator(); indexIterator.IsValid(); indexIterator.Next(), ++values)
+        {
+            auto index = indexIterator.Get();
+            if (index >= size)
+            {
+                return;
+            }
+            function(index, *values);
+        }
+    }
+
+    template <typename ElementType, typename IndexListType>
+    double SparseDataVector<ElementType, IndexListType>::Norm2Squared() const
+    {
+        double result = 0.0;
+        for (auto value : _values)
+        {
+            result += static_cast<double>(value) * static_cast<double>(value);
+        }
+        return result;
+    }
+
+    template <typename ElementType, typename IndexListType>
+    double SparseDataVector<ElementType, IndexListType>::Dot(math::UnorientedConstVectorBase<double> vector) const
+    {
+        const double* data = vector.GetConstDataPointer();
+        auto increment = vector.GetIncrement();
+        double result = 0.0;
+        ForEachNonZero(vector.Size(), [&](size_t index, ElementType value) { result += static_cast<double>(value) * data[index * increment]; });
+        return result;
+    }
+
+    template <typename ElementType, typename IndexListType>
+    float SparseDataVector<ElementType, IndexListType>::Dot(math::UnorientedConstVectorBase<float> vector) const
+    {
+        const float* data = vector.GetConstDataPointer();
+        auto increment = vector.GetIncrement();
+        float result = 0.0;
+        ForEachNonZero(vector.Size(), [&](size_t index, ElementType value) { result += static_cast<float>(static_cast<double>(value)) * data[index * increment]; });
+        return result;
+    }
+
+    template <typename ElementType, typename IndexListType>
+    void SparseDataVector<ElementType, IndexListType>::AddTo(math::RowVectorReference<double> vector) const
+    {
+        double* data = vector.GetDataPointer();
+        auto increment = vector.GetIncrement();
+        ForEachNonZero(vector.Size(), [&](size_t index, ElementType value) { data[index * increment] += static_cast<double>(value); });
+    }
+
+    template <typename ElementType, typename IndexListType>
+    template <IterationPolicy policy, typename TransformationType>
+    void SparseDataVector<ElementType, IndexListType>::AddTransformedTo(math::RowVectorReference<double> vector, TransformationType transformation) const
+    {
+        if constexpr (policy == IterationPolicy::skipZeros)
+        {
+            double* data = vector.GetDataPointer();
+            auto increment = vector.GetIncrement();
+            ForEachNonZero(vector.Size(), [&](size_t index, ElementType value) { data[index * increment] += transformation(IndexValue{ index, static_cast<double>(value) }); });
+        }
+        else
+        {
+            DataVectorBase<SparseDataVector<ElementType, IndexListType>>::template AddTransformedTo<policy>(vector, transformation);
+        }
+    }
+
     template <typename ElementType, typename IndexListType>
     size_t SparseDataVector<ElementType, IndexListType>::PrefixLength() const
     {
@@ -0,0 +1,56 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ChunkedLineReader.cpp (data)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ChunkedLineReader.h"
+
+#include <utilities/include/Exception.h>
+
+namespace ell
+{
+namespace data
+{
+    ChunkedLineReader::ChunkedLineReader(std::istream& stream, size_t chunkSize, char delim) :
+        _stream(stream),
+        _chunkSize(chunkSize),
+        _delim(delim)
+    {
+        if (_chunkSize == 0)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Chunk size must be positive");
+        }
+    }
+
+    bool ChunkedLineReader::ReadChunk(std::string& chunk)
+    {
+        // start with the partial line left over from the previous chunk
+        chunk.assign(_remainder);
+        _remainder.clear();
+
+        while (!_isAtEnd)
+        {
+            auto oldSize = chunk.size();
+            chunk.resize(oldSize + _chunkSize);
+            _stream.read(&chunk[oldSize], static_cast<std::streamsize>(_chunkSize));
+            auto numRead = static_cast<size_t>(_stream.gcount());
+            chunk.resize(oldSize + numRead);
+            _isAtEnd = numRead < _chunkSize;
+
+            // the remainder never contains a delimiter, so only the new bytes need to be searched
+            auto lastDelim = chunk.rfind(_delim);
+            if (lastDelim != std::string::npos && lastDelim >= oldSize)
+            {
+                _remainder.assign(chunk, lastDelim + 1, std::string::npos);
+                chunk.resize(lastDelim + 1);
+                return true;
+            }
+        }
+
+        return !chunk.empty();
+    }
+} // namespace data
+} // namespace ell
@@ -0,0 +1,270 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     MappedDataset.cpp (data)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "MappedDataset.h"
+
+#include <utilities/include/Exception.h>
+#include <utilities/include/Files.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace ell
+{
+namespace data
+{
+    namespace
+    {
+        const char binaryDatasetMagic[8] = { 'E', 'L', 'L', 'D', 'A', 'T', 'A', '\0' };
+        const uint64_t binaryDatasetVersion = 1;
+
+        // Records are padded so that every record, and every array in it, starts on an 8-byte boundary
+        size_t GetPaddedIndicesSize(size_t numNonZeros)
+        {
+            return ((numNonZeros * sizeof(uint32_t) + 7) / 8) * 8;
+        }
+
+        // Checks that a record fits in the bytes available to it and returns a view of its data vector
+        MappedDataVector GetRecordDataVector(const char* record, size_t maxRecordSize)
+        {
+            if (maxRecordSize < sizeof(BinaryExampleHeader))
+            {
+                throw utilities::DataFormatException(utilities::DataFormatErrors::abruptEnd, "Binary dataset example record is truncated");
+            }
+
+            auto header = reinterpret_cast<const BinaryExampleHeader*>(record);
+            const bool hasValues = (header->flags & BinaryExampleHeader::binaryValuesFlag) == 0;
+            const size_t indicesSize = GetPaddedIndicesSize(header->numNonZeros);
+            const size_t recordSize = sizeof(BinaryExampleHeader) + indicesSize + (hasValues ? header->numNonZeros * sizeof(double) : 0);
+            if (recordSize > maxRecordSize)
+            {
+                throw utilities::DataFormatException(utilities::DataFormatErrors::abruptEnd, "Binary dataset example record is truncated");
+            }
+
+            auto indices = reinterpret_cast<const uint32_t*>(record + sizeof(BinaryExampleHeader));
+            auto values = hasValues ? reinterpret_cast<const double*>(record + sizeof(BinaryExampleHeader) + indicesSize) : nullptr;
+            return { indices, values, header->numNonZeros };
+        }
+
+        template <typename ValueType>
+        void WriteValue(std::ostream& stream, const ValueType& value)
+        {
+            stream.write(reinterpret_cast<const char*>(&value), sizeof(ValueType));
+        }
+
+        template <typename ValueType>
+        void WriteArray(std::ostream& stream, const std::vector<ValueType>& values)
+        {
+            stream.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(ValueType));
+        }
+    } // namespace
+
+    //
+    // BinaryDatasetWriter
+    //
+    BinaryDatasetWriter::BinaryDatasetWriter(std::ostream& stream) :
+        _stream(stream),
+        _startPosition(stream.tellp())
+    {
+        // Reserve space for the header, which is written by `Finish`
+        BinaryDatasetHeader header{};
+        WriteValue(_stream, header);
+    }
+
+    void BinaryDatasetWriter::AddExample(const WeightLabel& metadata, const std::vector<uint32_t>& indices, const std::vector<double>& values)
+    {
+        if (_isFinished)
+        {
+            throw utilities::LogicException(utilities::LogicExceptionErrors::illegalState, "Can't add examples to a binary dataset after it is finished");
+        }
+        if (indices.size() != values.size() || indices.size() > std::numeric_limits<uint32_t>::max())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch, "Binary dataset example indices and values must have the same size");
+        }
+
+        _offsets.push_back(static_cast<uint64_t>(_stream.tellp() - _startPosition));
+
+        BinaryExampleHeader header{};
+        header.weight = metadata.weight;
+        header.label = metadata.label;
+        header.numNonZeros = static_cast<uint32_t>(indices.size());
+        header.flags = std::all_of(values.begin(), values.end(), [](double value) { return value == 1.0; }) ? BinaryExampleHeader::binaryValuesFlag : 0;
+        WriteValue(_stream, header);
+
+        WriteArray(_stream, indices);
+        const char padding[8] = {};
+        _stream.write(padding, GetPaddedIndicesSize(indices.size()) - indices.size() * sizeof(uint32_t));
+        if ((header.flags & BinaryExampleHeader::binaryValuesFlag) == 0)
+        {
+            WriteArray(_stream, values);
+        }
+
+        if (!indices.empty())
+        {
+            _numFeatures = std::max(_numFeatures, static_cast<uint64_t>(indices.back()) + 1);
+        }
+    }
+
+    void BinaryDatasetWriter::Finish()
+    {
+        if (_isFinished)
+        {
+            return;
+        }
+        _isFinished = true;
+
+        BinaryDatasetHeader header{};
+        std::memcpy(header.magic, binaryDatasetMagic, sizeof(header.magic));
+        header.version = binaryDatasetVersion;
+        header.numExamples = _offsets.size();
+        header.numFeatures = _numFeatures;
+        header.offsetsPosition = static_cast<uint64_t>(_stream.tellp() - _startPosition);
+        WriteArray(_stream, _offsets);
+
+        auto endPosition = _stream.tellp();
+        _stream.seekp(_startPosition);
+        WriteValue(_stream, header);
+        _stream.seekp(endPosition);
+        _stream.flush();
+        if (!_stream)
+        {
+            throw utilities::SystemException(utilities::SystemExceptionErrors::fileNotWritable, "Error writing binary dataset");
+        }
+    }
+
+    //
+    // MappedDataVector
+    //
+    double MappedDataVector::Norm2Squared() const
+    {
+        if (_values == nullptr)
+        {
+            return static_cast<double>(_size);
+        }
+
+        double result = 0.0;
+        for (size_t position = 0; position < _size; ++position)
+        {
+            result += _values[position] * _values[position];
+        }
+        return result;
+    }
+
+    double MappedDataVector::Dot(math::UnorientedConstVectorBase<double> vector) const
+    {
+        double result = 0.0;
+        auto size = vector.Size();
+        for (size_t position = 0; position < _size && _indices[position] < size; ++position)
+        {
+            result += GetValue(position) * vector[_indices[position]];
+        }
+        return result;
+    }
+
+    float MappedDataVector::Dot(math::UnorientedConstVectorBase<float> vector) const
+    {
+        float result = 0.0;
+        auto size = vector.Size();
+        for (size_t position = 0; position < _size && _indices[position] < size; ++position)
+        {
+            result += static_cast<float>(GetValue(position)) * vector[_indices[position]];
+        }
+        return result;
+    }
+
+    void MappedDataVector::AddTo(math::RowVectorReference<double> vector) const
+    {
+        auto size = vector.Size();
+        for (size_t position = 0; position < _size && _indices[position] < size; ++position)
+        {
+            vector[_indices[position]] += GetValue(position);
+        }
+    }
+
+    std::vector<double> MappedDataVector::ToArray(size_t size) const
+    {
+        std::vector<double> result(size);
+        for (size_t position = 0; position < _size && _indices[position] < size; ++position)
+        {
+            result[_indices[position]] = GetValue(position);
+        }
+        return result;
+    }
+
+    //
+    // MappedExample
+    //
+    MappedExample::MappedExample(const char* record, size_t maxRecordSize) :
+        _header(reinterpret_cast<const BinaryExampleHeader*>(record)),
+        _dataVector(GetRecordDataVector(record, maxRecordSize))
+    {
+    }
+
+    //
+    // MappedDataset
+    //
+    MappedDataset::MappedDataset(const std::string& filepath) :
+        _file(filepath)
+    {
+        if (_file.Size() < sizeof(BinaryDatasetHeader) || std::memcmp(_file.GetData(), binaryDatasetMagic, sizeof(binaryDatasetMagic)) != 0)
+        {
+            throw utilities::DataFormatException(utilities::DataFormatErrors::badFormat, "File " + filepath + " is not a binary dataset");
+        }
+
+        _header = reinterpret_cast<const BinaryDatasetHeader*>(_file.GetData());
+        if (_header->version != binaryDatasetVersion)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::versionMismatch, "Unsupported binary dataset version in file " + filepath);
+        }
+
+        if (_header->offsetsPosition > _file.Size() || (_file.Size() - _header->offsetsPosition) / sizeof(uint64_t) < _header->numExamples)
+        {
+            throw utilities::DataFormatException(utilities::DataFormatErrors::abruptEnd, "Binary dataset file " + filepath + " is truncated");
+        }
+        if (_header->offsetsPosition < sizeof(BinaryDatasetHeader) || _header->offsetsPosition % sizeof(uint64_t) != 0)
+        {
+            throw utilities::DataFormatException(utilities::DataFormatErrors::badFormat, "Binary dataset file " + filepath + " has a bad offset table position");
+        }
+        _offsets = reinterpret_cast<const uint64_t*>(_file.GetData() + _header->offsetsPosition);
+    }
+
+    MappedExample MappedDataset::GetExample(size_t index) const
+    {
+        if (index >= NumExamples())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::indexOutOfRange, "Binary dataset example index out of range");
+        }
+
+        // Records lie between the file header and the offset table, and start on 8-byte boundaries
+        auto offset = _offsets[index];
+        if (offset < sizeof(BinaryDatasetHeader) || offset >= _header->offsetsPosition || offset % sizeof(uint64_t) != 0)
+        {
+            throw utilities::DataFormatException(utilities::DataFormatErrors::badFormat, "Binary dataset example record offset is out of range");
+        }
+        return MappedExample(_file.GetData() + offset, _header->offsetsPosition - offset);
+    }
+
+    size_t MappedDataset::CorrectRangeSize(size_t fromIndex, size_t size) const
+    {
+        if (size == 0 || fromIndex + size > NumExamples())
+        {
+            return NumExamples() - fromIndex;
+        }
+        return size;
+    }
+
+    bool IsBinaryDatasetFile(const std::string& filepath)
+    {
+        auto stream = utilities::OpenBinaryIfstream(filepath);
+        char magic[sizeof(binaryDatasetMagic)] = {};
+        stream.read(magic, sizeof(magic));
+        return stream.gcount() == sizeof(magic) && std::memcmp(magic, binaryDatasetMagic, sizeof(magic)) == 0;
+    }
+} // namespace data
+} // namespace ell
@@ -15,4 +15,5 @@ void DataVectorCopyAsTests();
 void AutoDataVectorTest();
 void TransformedDataVectorTest();
 void IteratorTests();
+void SparseKernelTests();
 } // namespace ell
\ No newline at end of file
@@ -12,4 +12,6 @@ namespace ell
 {
 void DatasetCastingTests();
 void DatasetSerializationTests();
+void MappedDatasetTests();
+void ShardedDatasetTests();
 } // namespace ell
\ No newline at end of file
@@ -12,4 +12,6 @@ namespace ell
 void DataVectorParseTest();
 void AutoDataVectorParseTest();
 void SingleFileParseTest();
+void ParallelParseTest();
+void ParallelParseThroughputTest();
 } // namespace ell
\ No newline at end of file
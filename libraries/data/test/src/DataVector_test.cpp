@@ -24,6 +24,7 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <vector>
 
 namespace ell
 {
@@ -266,4 +267,80 @@ void IteratorTests()
     IteratorTest<data::SparseByteDataVector>();
     IteratorTest<data::SparseBinaryDataVector>();
 }
-} // namespace ell
\ No newline at end of file
+
+template <typename DataVectorType>
+void SparseKernelTest(const std::vector<data::IndexValue>& entries, size_t size)
+{
+    DataVectorType u(entries);
+    auto a = u.ToArray(size);
+    std::string name = typeid(DataVectorType).name();
+
+    std::vector<double> expectedSum(size);
+    std::vector<double> expectedTransformedSum(size);
+    math::RowVector<double> w(size);
+    math::RowVector<float> wf(size);
+    double expectedDot = 0;
+    double expectedNorm = 0;
+    for (size_t i = 0; i < size; ++i)
+    {
+        w[i] = static_cast<double>(i % 7) - 3;
+        wf[i] = static_cast<float>(w[i]);
+        expectedDot += a[i] * w[i];
+        expectedNorm += a[i] * a[i];
+        expectedSum[i] = w[i] + a[i];
+        expectedTransformedSum[i] = expectedSum[i] - 2 * a[i];
+    }
+    testing::ProcessTest("SparseKernelTest<" + name + ">::Dot()", testing::IsEqual(u.Dot(w), expectedDot));
+    testing::ProcessTest("SparseKernelTest<" + name + ">::Dot(float)", testing::IsEqual(u.Dot(wf), expectedDot));
+
+    u.AddTo(w);
+    testing::ProcessTest("SparseKernelTest<" + name + ">::AddTo()", testing::IsEqual(w.ToArray(), expectedSum));
+
+    w += -2.0 * u;
+    testing::ProcessTest("SparseKernelTest<" + name + ">::AddTransformedTo()", testing::IsEqual(w.ToArray(), expectedTransformedSum));
+
+    if (entries.back().index >= size) // the norm is computed over the entire data vector
+    {
+        return;
+    }
+    testing::ProcessTest("SparseKernelTest<" + name + ">::Norm2Squared()", testing::IsEqual(u.Norm2Squared(), expectedNorm));
+}
+
+void SparseKernelTests()
+{
+    // index gaps that need 1, 2, 4 and 8 byte deltas, long enough to exercise both index decoding paths
+    std::vector<data::IndexValue> entries;
+    for (size_t i = 0; i < 40; ++i)
+    {
+        entries.push_back({ i * 3 + 1, 1 });
+    }
+    entries.push_back({ 300, 2 });
+    entries.push_back({ 20000, -1 });
+    entries.push_back({ 20001, 1 });
+    entries.push_back({ 200000, 3 });
+
+    std::vector<data::IndexValue> shortEntries{ { 0, 1 }, { 70, 1 }, { 20000, 2 } };
+
+    // a weight vector that is shorter than the data vector truncates the sum
+    std::vector<data::IndexValue> hugeEntries{ { 2, 1 }, { 50, 1 }, { 5000000000, 1 } };
+
+    SparseKernelTest<data::SparseDoubleDataVector>(entries, 200001);
+    SparseKernelTest<data::SparseFloatDataVector>(entries, 200001);
+    SparseKernelTest<data::SparseDoubleDataVector>(entries, 20001);
+    SparseKernelTest<data::SparseDoubleDataVector>(shortEntries, 20001);
+    SparseKernelTest<data::SparseFloatDataVector>(hugeEntries, 100);
+
+    for (auto& entry : entries)
+    {
+        entry.value = 1;
+    }
+    for (auto& entry : shortEntries)
+    {
+        entry.value = 1;
+    }
+    SparseKernelTest<data::SparseBinaryDataVector>(entries, 200001);
+    SparseKernelTest<data::SparseBinaryDataVector>(entries, 20001);
+    SparseKernelTest<data::SparseBinaryDataVector>(shortEntries, 20001);
+    SparseKernelTest<data::SparseBinaryDataVector>(hugeEntries, 100);
+}
+} // namespace ell
@@ -11,13 +11,19 @@
 #include <common/include/DataLoaders.h>
 
 #include <data/include/Dataset.h>
+#include <data/include/MappedDataset.h>
+#include <data/include/ShardedDataset.h>
 
 #include <utilities/include/Files.h>
 #include <utilities/include/StringUtil.h>
 
 #include <testing/include/testing.h>
 
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
 #include <sstream>
+#include <vector>
 
 namespace ell
 {
@@ -119,4 +125,191 @@ void DatasetSerializationTests()
     }
     testing::ProcessTest(utilities::FormatString("DatasetSerializationTest data %d errors", errors), errors == 0);
 }
+
+void MappedDatasetTests()
+{
+    data::Dataset<data::AutoSupervisedExample> dataset1;
+    dataset1.AddExample(data::AutoSupervisedExample(data::DoubleDataVector{ 1, 0, 2.5, 0, -3 }, data::WeightLabel{ 1, 1 }));
+    dataset1.AddExample(data::AutoSupervisedExample(data::DoubleDataVector{ 0, 1, 0, 1, 0, 0, 1 }, data::WeightLabel{ 2, -1 }));
+    dataset1.AddExample(data::AutoSupervisedExample(data::DoubleDataVector{}, data::WeightLabel{ 0.5, 1 }));
+
+    // save the dataset in the binary format
+    const std::string filename("dataset1.elldata");
+    {
+        auto stream = utilities::OpenBinaryOfstream(filename);
+        data::WriteBinaryDataset(dataset1.GetExampleIterator(), stream);
+    }
+    testing::ProcessTest("MappedDatasetTest IsBinaryDatasetFile", data::IsBinaryDatasetFile(filename));
+
+    {
+        // map the dataset and make sure it matches the original
+        data::MappedDataset dataset2(filename);
+        testing::ProcessTest("MappedDatasetTest size", dataset1.NumExamples() == dataset2.NumExamples());
+        testing::ProcessTest("MappedDatasetTest features", dataset1.NumFeatures() == dataset2.NumFeatures());
+
+        int errors = 0;
+        if (dataset1.NumExamples() == dataset2.NumExamples())
+        {
+            for (size_t i = 0; i < dataset1.NumExamples(); i++)
+            {
+                auto e1 = dataset1.GetExample(i);
+                auto e2 = dataset2.GetExample(i).CopyAs<data::AutoSupervisedExample>();
+
+                auto sameVector = testing::IsEqual(e1.GetDataVector().ToArray(), e2.GetDataVector().ToArray());
+                auto sameLabel = e1.GetMetadata().label == e2.GetMetadata().label;
+                auto sameWeight = e1.GetMetadata().weight == e2.GetMetadata().weight;
+                if (!(sameVector && sameLabel && sameWeight))
+                {
+                    errors++;
+                }
+            }
+        }
+        testing::ProcessTest(utilities::FormatString("MappedDatasetTest data %d errors", errors), errors == 0);
+
+        // examples with only 0/1 values are stored without their values
+        testing::ProcessTest("MappedDatasetTest binary example", dataset2[1].NumNonZeros() == 3 && dataset2[1].PrefixLength() == 7);
+
+        // casting through AnyDataset copies the examples out of the mapped file
+        data::Dataset<data::DenseSupervisedExample> dataset3(dataset2.GetAnyDataset());
+        auto sameFirstExample = testing::IsEqual(dataset3[0].GetDataVector().ToArray(), dataset1[0].GetDataVector().ToArray());
+        testing::ProcessTest("MappedDatasetTest GetAnyDataset", dataset3.NumExamples() == dataset1.NumExamples() && sameFirstExample);
+
+        // iterating over MappedExamples reads the examples in place
+        auto viewIterator = dataset2.GetExampleIterator<data::MappedExample>();
+        auto sameView = viewIterator.Get().GetDataVector().GetIndices() == dataset2[0].GetDataVector().GetIndices();
+        math::ColumnVector<double> weights{ 1, 2, 3, 4, 5, 6, 7 };
+        int viewErrors = 0;
+        for (size_t i = 0; viewIterator.IsValid(); ++i, viewIterator.Next())
+        {
+            auto example = viewIterator.Get();
+            const auto& view = example.GetDataVector();
+            const auto& copy = dataset1[i].GetDataVector();
+            if (view.Dot(weights) != copy.Dot(weights) || view.Norm2Squared() != copy.Norm2Squared() || !testing::IsEqual(view.ToArray(), copy.ToArray()))
+            {
+                viewErrors++;
+            }
+        }
+        testing::ProcessTest("MappedDatasetTest example views", sameView && viewErrors == 0);
+    }
+
+    // records that run past the end of the example data are rejected instead of being read
+    const std::string truncatedFilename("dataset3.elldata");
+    {
+        auto stream = utilities::OpenBinaryOfstream(truncatedFilename);
+        data::BinaryDatasetWriter writer(stream);
+        writer.AddExample(data::WeightLabel{ 1, 1 }, { 0, 2, 4 }, { 1.5, 2.5, 3.5 });
+        writer.Finish();
+
+        // overwrite the record's nonzero count with a count larger than the file
+        data::BinaryExampleHeader header{};
+        header.weight = 1;
+        header.label = 1;
+        header.numNonZeros = 1000;
+        stream.seekp(sizeof(data::BinaryDatasetHeader));
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+    {
+        data::MappedDataset truncatedDataset(truncatedFilename);
+        bool threw = false;
+        try
+        {
+            truncatedDataset.GetExample(0);
+        }
+        catch (const utilities::DataFormatException&)
+        {
+            threw = true;
+        }
+        testing::ProcessTest("MappedDatasetTest truncated record", threw);
+    }
+
+    // text files aren't mistaken for binary datasets
+    const std::string textFilename("dataset2.txt");
+    {
+        auto stream = utilities::OpenOfstream(textFilename);
+        dataset1.Print(stream);
+    }
+    testing::ProcessTest("MappedDatasetTest text file", !data::IsBinaryDatasetFile(textFilename));
+
+    std::remove(filename.c_str());
+    std::remove(truncatedFilename.c_str());
+    std::remove(textFilename.c_str());
+}
+
+// Streams a sharded dataset in which the label of each example is its index, and returns the labels in the order visited
+std::vector<size_t> GetShardedDatasetPass(data::ShardedDataset<data::AutoSupervisedExample>& dataset)
+{
+    std::vector<size_t> labels;
+    auto iterator = dataset.GetExampleIterator();
+    while (iterator.IsValid())
+    {
+        labels.push_back(static_cast<size_t>(iterator.Get().GetMetadata().label));
+        iterator.Next();
+    }
+    return labels;
+}
+
+void ShardedDatasetTests()
+{
+    std::vector<size_t> shardSizes{ 3, 0, 5, 1, 4 };
+    std::vector<size_t> shardBegins(shardSizes.size());
+    std::partial_sum(shardSizes.begin(), shardSizes.end() - 1, shardBegins.begin() + 1);
+    auto numExamples = shardBegins.back() + shardSizes.back();
+
+    auto loadShard = [shardSizes, shardBegins](size_t shardIndex) {
+        data::AutoSupervisedDataset shard;
+        for (size_t i = 0; i < shardSizes[shardIndex]; ++i)
+        {
+            auto index = static_cast<double>(shardBegins[shardIndex] + i);
+            shard.AddExample(data::AutoSupervisedExample(data::DoubleDataVector{ index }, data::WeightLabel{ 1, index }));
+        }
+        return shard;
+    };
+
+    data::ShardedDataset<data::AutoSupervisedExample> dataset1(shardSizes.size(), loadShard, { 2, true, true, "123" });
+    data::ShardedDataset<data::AutoSupervisedExample> dataset2(shardSizes.size(), loadShard, { 2, true, true, "123" });
+    auto pass1 = GetShardedDatasetPass(dataset1);
+    auto pass2 = GetShardedDatasetPass(dataset1);
+    auto sameSeedPass = GetShardedDatasetPass(dataset2);
+
+    auto sortedPass = pass1;
+    std::sort(sortedPass.begin(), sortedPass.end());
+    std::vector<size_t> allExamples(numExamples);
+    std::iota(allExamples.begin(), allExamples.end(), 0);
+    testing::ProcessTest("ShardedDatasetTest visits every example once", sortedPass == allExamples);
+    testing::ProcessTest("ShardedDatasetTest reshuffles each pass", pass1 != pass2);
+    testing::ProcessTest("ShardedDatasetTest is reproducible", pass1 == sameSeedPass);
+
+    // the examples of each shard are visited together
+    auto getShard = [&shardBegins](size_t index) { return std::upper_bound(shardBegins.begin(), shardBegins.end(), index) - shardBegins.begin(); };
+    size_t numShardChanges = 0;
+    for (size_t i = 1; i < pass1.size(); ++i)
+    {
+        numShardChanges += getShard(pass1[i]) != getShard(pass1[i - 1]) ? 1 : 0;
+    }
+    testing::ProcessTest("ShardedDatasetTest keeps shards together", numShardChanges == 3);
+
+    // without permutation, the examples are visited in their original order
+    data::ShardedDataset<data::AutoSupervisedExample> orderedDataset(shardSizes.size(), loadShard, { 1, false, false, "123" });
+    testing::ProcessTest("ShardedDatasetTest without permutation", GetShardedDatasetPass(orderedDataset) == allExamples);
+
+    // errors thrown while loading a shard in the background reach the caller
+    auto failingLoadShard = [loadShard](size_t shardIndex) {
+        if (shardIndex == 3)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "bad shard");
+        }
+        return loadShard(shardIndex);
+    };
+    data::ShardedDataset<data::AutoSupervisedExample> failingDataset(shardSizes.size(), failingLoadShard, { 2, false, false, "123" });
+    bool threw = false;
+    try
+    {
+        GetShardedDatasetPass(failingDataset);
+    }
+    catch (const utilities::InputException&)
+    {
+        threw = true;
+    }
+    testing::ProcessTest("ShardedDatasetTest loading error", threw);
+}
 } // namespace ell
@@ -11,14 +11,21 @@
 #include <data/include/AutoDataVector.h>
 #include <data/include/Dataset.h>
 #include <data/include/GeneralizedSparseParsingIterator.h>
+#include <data/include/ParallelParsingExampleIterator.h>
 #include <data/include/SequentialLineIterator.h>
 #include <data/include/SingleLineParsingExampleIterator.h>
 #include <data/include/TextLine.h>
 #include <data/include/WeightLabel.h>
 
+#include <utilities/include/MillisecondTimer.h>
+#include <utilities/include/StringUtil.h>
+
 #include <testing/include/testing.h>
 
+#include <algorithm>
+#include <iostream>
 #include <memory>
+#include <random>
 #include <sstream>
 #include <string>
 
@@ -142,4 +149,103 @@ void SingleFileParseTest()
     testing::ProcessTest("SingleFileParse test2", dataset[1].GetMetadata().label == -1 && testing::IsEqual(dataset[1].GetDataVector().ToArray(), { 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 3 }));
     testing::ProcessTest("SingleFileParse test3", dataset[2].GetMetadata().label == 1 && testing::IsEqual(dataset[2].GetDataVector().ToArray(), { 2.7, 0, 0, 0, -0.3, 0, 0, 0, 0, 0, 3.14 }));
 }
-} // namespace ell
\ No newline at end of file
+
+std::string MakeRandomDatasetText(size_t numExamples, size_t numFeatures)
+{
+    std::default_random_engine engine(1234);
+    std::uniform_int_distribution<size_t> indexStep(1, 10);
+    std::uniform_real_distribution<double> value(-1.0, 1.0);
+
+    std::stringstream stream;
+    for (size_t exampleIndex = 0; exampleIndex < numExamples; ++exampleIndex)
+    {
+        if (exampleIndex % 100 == 0)
+        {
+            stream << "// comment\n\n";
+        }
+        stream << (exampleIndex % 2 == 0 ? 1.0 : -1.0);
+        for (auto featureIndex = indexStep(engine); featureIndex < numFeatures; featureIndex += indexStep(engine))
+        {
+            stream << '\t' << featureIndex << ':' << value(engine);
+        }
+        stream << '\n';
+    }
+    return stream.str();
+}
+
+data::AutoSupervisedDataset ParseSequentially(const std::string& text)
+{
+    std::stringstream stream(text);
+    data::SequentialLineIterator textLineIterator(stream);
+    auto exampleIterator = data::MakeSingleLineParsingExampleIterator(std::move(textLineIterator), data::LabelParser(), data::AutoDataVectorParser<data::GeneralizedSparseParsingIterator>());
+    return data::MakeDataset(std::move(exampleIterator));
+}
+
+data::AutoSupervisedDataset ParseInParallel(const std::string& text, const data::ParallelParsingParameters& parameters)
+{
+    std::stringstream stream(text);
+    auto exampleIterator = data::MakeParallelParsingExampleIterator(stream, data::LabelParser(), data::AutoDataVectorParser<data::GeneralizedSparseParsingIterator>(), parameters);
+    return data::MakeDataset(std::move(exampleIterator));
+}
+
+bool IsSameDataset(const data::AutoSupervisedDataset& dataset1, const data::AutoSupervisedDataset& dataset2)
+{
+    if (dataset1.NumExamples() != dataset2.NumExamples())
+    {
+        return false;
+    }
+
+    for (size_t index = 0; index < dataset1.NumExamples(); ++index)
+    {
+        const auto& example1 = dataset1[index];
+        const auto& example2 = dataset2[index];
+        if (example1.GetMetadata().label != example2.GetMetadata().label || !testing::IsEqual(example1.GetDataVector().ToArray(), example2.GetDataVector().ToArray()))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ParallelParseTest()
+{
+    // the last line has no delimiter, and the chunks are small enough to split the text in many places
+    auto text = MakeRandomDatasetText(500, 50) + "1.0\t3:1 7:2";
+    auto sequentialDataset = ParseSequentially(text);
+
+    for (size_t numThreads : { 1, 3 })
+    {
+        for (size_t chunkSize : { 1, 64, 1000, 1 << 20 })
+        {
+            data::ParallelParsingParameters parameters;
+            parameters.numThreads = numThreads;
+            parameters.chunkSize = chunkSize;
+            auto parallelDataset = ParseInParallel(text, parameters);
+            testing::ProcessTest(utilities::FormatString("ParallelParse test, %d threads, chunk size %d", static_cast<int>(numThreads), static_cast<int>(chunkSize)), IsSameDataset(sequentialDataset, parallelDataset));
+        }
+    }
+
+    data::ParallelParsingParameters parameters;
+    parameters.numThreads = 2;
+    testing::ProcessTest("ParallelParse test, empty text", ParseInParallel("", parameters).NumExamples() == 0);
+    testing::ProcessTest("ParallelParse test, only comments", ParseInParallel("// comment\n\n# comment\n", parameters).NumExamples() == 0);
+}
+
+void ParallelParseThroughputTest()
+{
+    auto text = MakeRandomDatasetText(5000, 1000);
+    auto megabytes = static_cast<double>(text.size()) / (1 << 20);
+
+    utilities::MillisecondTimer timer;
+    auto sequentialDataset = ParseSequentially(text);
+    auto sequentialTime = static_cast<double>(timer.Elapsed());
+
+    timer.Start();
+    auto parallelDataset = ParseInParallel(text, {});
+    auto parallelTime = static_cast<double>(timer.Elapsed());
+
+    testing::ProcessTest("ParallelParse throughput test", IsSameDataset(sequentialDataset, parallelDataset));
+    std::cout << "Parsed " << megabytes << " MB: sequential " << sequentialTime << " ms (" << 1000 * megabytes / std::max(sequentialTime, 1.0) << " MB/s), "
+              << "parallel " << parallelTime << " ms (" << 1000 * megabytes / std::max(parallelTime, 1.0) << " MB/s)" << std::endl;
+}
+} // namespace ell
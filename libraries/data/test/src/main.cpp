@@ -24,12 +24,17 @@ int main()
     AutoDataVectorTest();
     TransformedDataVectorTest();
     IteratorTests();
+    SparseKernelTests();
     ExampleCopyAsTests();
     DatasetCastingTests();
     DatasetSerializationTests();
+    MappedDatasetTests();
+    ShardedDatasetTests();
     DataVectorParseTest();
     AutoDataVectorParseTest();
     SingleFileParseTest();
+    ParallelParseTest();
+    ParallelParseThroughputTest();
 
     if (testing::DidTestFail())
     {
@@ -24,6 +24,13 @@ namespace emitters
         atlas
     };
 
+    /// <summary> Strategies for dividing the iterations of a parallel for loop among its tasks. </summary>
+    enum class ParallelLoopSchedule
+    {
+        fixedBlocks = 0, // each task gets one contiguous block of iterations, decided up front
+        dynamicChunks // tasks repeatedly claim small chunks of iterations from a shared counter until none are left
+    };
+
     /// <summary> Standard compiler switches. </summary>
     struct CompilerOptions
     {
@@ -39,6 +46,8 @@ namespace emitters
         bool parallelize = false;
         bool useThreadPool = true;
         int maxThreads = 4;
+        ParallelLoopSchedule parallelLoopSchedule = ParallelLoopSchedule::fixedBlocks;
+        int parallelLoopChunkSize = 0; // number of iterations per chunk for `dynamicChunks` schedules. '0' is the special 'auto' flag
         bool useFastMath = true;
         bool debug = false;
         utilities::Optional<bool> positionIndependentCode;
@@ -43,6 +43,11 @@ namespace emitters
         /// <summary> Gets the function argument names and types. </summary>
         const NamedVariableTypeList& GetArguments() const { return _args; }
 
+        /// <summary> Appends an argument to the end of the argument list. </summary>
+        ///
+        /// <param name="arg"> The name and type of the new argument. </param>
+        void AddArgument(const NamedVariableType& arg) { _args.push_back(arg); }
+
         /// <summary> Indicates if the given function has any associated comments. </summary>
         ///
         /// <returns> `true` if the function has any comments. </returns>
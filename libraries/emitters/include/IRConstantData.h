@@ -0,0 +1,57 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     IRConstantData.h (emitters)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "IRExecutionEngine.h"
+
+#include <memory>
+#include <string>
+
+namespace ell
+{
+namespace emitters
+{
+    /// <summary>
+    /// Moves the constant data of a module (its read-only initialized globals, such as a model's weights) into a new
+    /// module, so that the data can be replaced after the code has been loaded into an execution engine. The globals
+    /// in the new module are named `<dataModuleName>_<index>`, in the order they had in the original module, so two
+    /// modules compiled from models with the same structure get matching data modules. The code reads each one through
+    /// a pointer global named `<dataModuleName>_<index>_address`, loaded once on entry to each function that uses it,
+    /// which `BindConstantData` sets. Since the pointers aren't known until then, move the data before optimizing the
+    /// module, so the optimizer can't fold the data into the code.
+    /// </summary>
+    ///
+    /// <param name="module"> The module to move the data out of. </param>
+    /// <param name="dataModuleName"> The name of the new module. </param>
+    ///
+    /// <returns> The module holding the data. </returns>
+    std::unique_ptr<llvm::Module> MoveConstantDataToModule(llvm::Module& module, const std::string& dataModuleName);
+
+    /// <summary>
+    /// Indicates if one data module can stand in for another: the code they were moved out of is the same, and they
+    /// have the same globals, of the same types.
+    /// </summary>
+    ///
+    /// <param name="module"> The module the data was moved out of. </param>
+    /// <param name="dataModule"> The module returned by `MoveConstantDataToModule`. </param>
+    /// <param name="otherModule"> The module the other data was moved out of. </param>
+    /// <param name="otherDataModule"> The module returned by `MoveConstantDataToModule` for the other data. </param>
+    ///
+    /// <returns> `true` if the data modules are interchangeable. </returns>
+    bool IsCompatibleConstantData(const llvm::Module& module, const llvm::Module& dataModule, const llvm::Module& otherModule, const llvm::Module& otherDataModule);
+
+    /// <summary>
+    /// Points the code loaded in an execution engine at the data in a data module added to it. If some of the data
+    /// can't be found, the code is left pointing at the data it used before.
+    /// </summary>
+    ///
+    /// <param name="engine"> The execution engine holding the code. </param>
+    /// <param name="dataModuleHandle"> The handle returned when the data module was added to the engine. </param>
+    void BindConstantData(IRExecutionEngine& engine, IRExecutionEngine::ModuleHandle dataModuleHandle);
+} // namespace emitters
+} // namespace ell
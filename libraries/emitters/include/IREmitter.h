@@ -913,6 +913,14 @@ namespace emitters
         /// <returns> Pointer to the resulting llvm::StoreInst. </returns>
         llvm::StoreInst* Store(LLVMValue pPointer, LLVMValue pValue);
 
+        /// <summary> Emits an instruction to atomically add a value to the value stored at a given address. </summary>
+        ///
+        /// <param name="pPointer"> Pointer to the address of the value being updated. </param>
+        /// <param name="pValue"> Pointer to the value to add. </param>
+        ///
+        /// <returns> Pointer to the resulting llvm::AtomicRMWInst, which evaluates to the value stored before the update. </returns>
+        llvm::AtomicRMWInst* AtomicAdd(LLVMValue pPointer, LLVMValue pValue);
+
         /// <summary> Emits instruction to create a stack variable. </summary>
         ///
         /// <param name="type"> The variable type. </param>
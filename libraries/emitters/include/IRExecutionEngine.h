@@ -12,10 +12,17 @@
 #include <utilities/include/Exception.h>
 
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
+#include <llvm/ExecutionEngine/ObjectCache.h>
+#include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
 
 #include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <type_traits>
+#include <vector>
 
 namespace ell
 {
@@ -26,10 +33,14 @@ namespace emitters
     /// <summary> Function signature for a basic function that takes no input and returns no output </summary>
     typedef void (*DynamicFunction)(void);
 
-    /// <summary> Wrapper class to setup and manage the LLVM Execution Engine. By default, we use the new "MCJIT" </summary>
+    /// <summary> Wrapper class to setup and manage the LLVM Execution Engine. By default, we use the new "MCJIT". Looking up
+    /// symbols and adding or removing modules can be done from several threads at once. </summary>
     class IRExecutionEngine
     {
     public:
+        /// <summary> Identifies a module added to the execution engine. </summary>
+        using ModuleHandle = size_t;
+
         /// <summary>
         /// Move the primary "owner" module into the execution engine.
         /// </summary>
@@ -44,13 +55,82 @@ namespace emitters
         /// <param name="verify"> Indicates if the execution engine should run a verification pass before running the code. </param>
         IRExecutionEngine(std::unique_ptr<llvm::Module> pModule, bool verify = false);
 
+        /// <summary>
+        /// Inject the primary "owner" module into the execution engine, along with the LLVM context it belongs to. The
+        /// engine owns the context, so code can be generated in it without synchronizing with any other thread.
+        /// </summary>
+        ///
+        /// <param name="pModule"> The module. </param>
+        /// <param name="pContext"> The context of the module. </param>
+        /// <param name="verify"> Indicates if the execution engine should run a verification pass before running the code. </param>
+        IRExecutionEngine(std::unique_ptr<llvm::Module> pModule, std::unique_ptr<llvm::LLVMContext> pContext, bool verify = false);
+
         /// <summary> Destructor </summary>
         ~IRExecutionEngine();
 
-        /// <summary> Add an additional module to the execution engine. </summary>
+        /// <summary>
+        /// Set a cache that the engine consults before generating machine code for a module, and stores the code in
+        /// after generating it. Set the cache before any function is looked up, or the primary module is compiled
+        /// without it.
+        /// </summary>
+        ///
+        /// <param name="cache"> The object cache. </param>
+        void SetObjectCache(std::unique_ptr<llvm::ObjectCache> cache);
+
+        /// <summary>
+        /// Set the number of threads used to generate machine code for the primary module. With more than one thread,
+        /// the module's functions are split across that many modules, which are compiled to object files in parallel
+        /// and linked into the engine. Call this before any function is looked up. The module is compiled whole (on
+        /// one thread) if it has static constructors or destructors, or if an object cache is set, so that its code
+        /// can be cached.
+        /// </summary>
+        ///
+        /// <param name="numThreads"> The number of code generation threads. </param>
+        void SetCodeGenerationThreads(unsigned numThreads);
+
+        /// <summary>
+        /// Compile the primary module one function at a time, as the functions are needed, instead of all at once. The
+        /// module is split into a module per function, and looking up a symbol compiles the module that defines it,
+        /// along with the ones it refers to, directly or not. So the functions that can't be reached from any symbol
+        /// looked up (profiling and other helper functions, say) are never compiled. Everything is compiled while the
+        /// symbol is looked up, so the code can be called from several threads at once right away. Call this before
+        /// any function is looked up. The code generation threads setting doesn't apply; an object cache stores each
+        /// function's code separately. The module's debug info is dropped.
+        /// </summary>
+        ///
+        /// <param name="lazy"> Indicates if functions are compiled lazily. </param>
+        void SetLazyCompilation(bool lazy);
+
+        /// <summary> Gets the LLVM context of the primary module. Modules added to the engine should belong to it. </summary>
+        ///
+        /// <returns> The LLVM context. </returns>
+        llvm::LLVMContext& GetLLVMContext() const { return *_context; }
+
+        /// <summary>
+        /// Add an additional module to the execution engine. Each added module has code of its own, so that it can be
+        /// removed, and it can refer to the functions and globals of the other modules by name, as they can to its
+        /// own. Its static constructors run as it is added.
+        /// </summary>
         ///
         /// <param name="pModule"> The module to add. </param>
-        void AddModule(std::unique_ptr<llvm::Module> pModule);
+        ///
+        /// <returns> A handle that identifies the module. </returns>
+        ModuleHandle AddModule(std::unique_ptr<llvm::Module> pModule);
+
+        /// <summary>
+        /// Remove a module added with `AddModule`, running its static destructors and freeing its code and data.
+        /// Code that refers to the module's functions or globals must not run afterwards.
+        /// </summary>
+        ///
+        /// <param name="handle"> The handle returned when the module was added. </param>
+        void RemoveModule(ModuleHandle handle);
+
+        /// <summary> Gets a module added with `AddModule`. </summary>
+        ///
+        /// <param name="handle"> The handle returned when the module was added. </param>
+        ///
+        /// <returns> The module. </returns>
+        const llvm::Module& GetModule(ModuleHandle handle);
 
         /// <summary>
         /// Return the address of a named function, JITTing code as needed. Returns 0 if not found.
@@ -89,6 +169,17 @@ namespace emitters
         /// <returns> The variable address. </returns>
         uint64_t GetGlobalValueAddress(const std::string& name);
 
+        /// <summary>
+        /// Return the address of a global variable or function defined in a module added with `AddModule`, JITTing
+        /// the module as needed. Returns 0 if the module doesn't define it, even if another module does.
+        /// </summary>
+        ///
+        /// <param name="handle"> The handle returned when the module was added. </param>
+        /// <param name="name"> Name of the requested global value. </param>
+        ///
+        /// <returns> The address. </returns>
+        uint64_t GetGlobalValueAddress(ModuleHandle handle, const std::string& name);
+
         /// <summary> Return the address of a named function. Throws if not found. </summary>
         ///
         /// <param name="name"> Name of the requested function. </param>
@@ -96,7 +187,7 @@ namespace emitters
         /// <returns> The function address. </returns>
         uint64_t ResolveFunctionAddress(const std::string& name);
 
-        /// <summary> Set the address of a named function. </summary>
+        /// <summary> Set the address of a named function that the modules declare. </summary>
         ///
         /// <param name="func"> The function being defined. </param>
         /// <param name="address"> The address of the function being defined. </param>
@@ -118,13 +209,45 @@ namespace emitters
         void RunMain();
 
     private:
+        struct AddedModule
+        {
+            llvm::Module* module;
+            std::unique_ptr<llvm::ExecutionEngine> engine;
+        };
+
+        // with lazy compilation, one of the modules the primary module is split into
+        struct FunctionModule
+        {
+            llvm::Module* module;
+            std::vector<size_t> dependencies; // the modules defining what this one refers to
+            bool compiled;
+        };
+
         void EnsureEngine();
+        std::unique_ptr<llvm::ExecutionEngine> CreateEngine(std::unique_ptr<llvm::Module> pModule);
+        void AddFunctionModules(std::vector<std::unique_ptr<llvm::Module>> functionModules);
+        void GenerateCode(size_t functionModuleIndex);
+        uint64_t FindSymbolAddress(const std::string& name, bool functionsOnly);
+        uint64_t FindLinkedSymbolAddress(const std::string& mangledName);
+        AddedModule& GetAddedModule(ModuleHandle handle);
         void EnsureClockGetTime();
         void PerformInitialization();
         void PerformFinalization();
 
-        std::unique_ptr<llvm::EngineBuilder> _pBuilder;
+        std::unique_ptr<llvm::LLVMContext> _pContext; // declared first, so that the modules are destroyed before it
+        llvm::LLVMContext* _context = nullptr;
+        std::unique_ptr<llvm::Module> _pModule; // the primary module, until the engine is created
+        bool _verify = false;
+        unsigned _numCodeGenerationThreads = 1;
+        bool _lazy = false;
+        std::unique_ptr<llvm::ObjectCache> _pObjectCache; // declared before the engines, which refer to it
         std::unique_ptr<llvm::ExecutionEngine> _pEngine;
+        std::map<ModuleHandle, AddedModule> _addedModules;
+        std::vector<FunctionModule> _functionModules;
+        std::map<std::string, size_t> _functionModuleIndices; // the function module defining each symbol
+        std::map<std::string, uint64_t> _definedFunctions;
+        std::mutex _mutex; // serializes creating the engines, looking up symbols, and adding or removing modules
+        ModuleHandle _nextModuleHandle = 1;
     };
 } // namespace emitters
 } // namespace ell
@@ -785,6 +785,14 @@ namespace emitters
         /// <returns> Pointer to the stored value. </returns>
         LLVMValue StoreZero(LLVMValue pPointer, int numElements = 1);
 
+        /// <summary> Emit instruction to atomically add a value to the integer stored at the pointer location. </summary>
+        ///
+        /// <param name="pPointer"> Pointer to the address of the value being updated. </param>
+        /// <param name="pValue"> Pointer to the value to add. </param>
+        ///
+        /// <returns> Pointer to the value stored before the update. </returns>
+        LLVMValue AtomicAdd(LLVMValue pPointer, LLVMValue pValue);
+
         /// <summary> Emit a binary operation on to values, A and B, which replaces the value in B with the result. </summary>
         ///
         /// <param name="pPointer"> Pointer to the address of the left operator argument. </param>
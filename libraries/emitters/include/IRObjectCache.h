@@ -0,0 +1,69 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     IRObjectCache.h (emitters)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <llvm/ExecutionEngine/ObjectCache.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace ell
+{
+namespace emitters
+{
+    /// <summary>
+    /// An on-disk cache of the machine code the JIT generates for a module, so that a process that JITs the same
+    /// module again can load the code instead of running codegen. Each object file is keyed by a hash of the module's
+    /// bitcode, its target triple and data layout, the host CPU, the LLVM version, and a caller-supplied string that
+    /// describes any other settings that affect code generation. Writing to the cache is best effort: a failure to
+    /// write just means the next process compiles the module again.
+    /// </summary>
+    class IRObjectCache : public llvm::ObjectCache
+    {
+    public:
+        /// <summary> Constructor </summary>
+        ///
+        /// <param name="directory"> The directory that holds the cached object files. It is created if needed. </param>
+        /// <param name="settingsKey"> A string describing the settings that affect code generation, which is added to the key. </param>
+        IRObjectCache(std::string directory, std::string settingsKey = "");
+
+        /// <summary> Called by the JIT after it compiles a module, to store the machine code. </summary>
+        ///
+        /// <param name="module"> The module that was compiled. </param>
+        /// <param name="object"> The compiled object file. </param>
+        void notifyObjectCompiled(const llvm::Module* module, llvm::MemoryBufferRef object) override;
+
+        /// <summary> Called by the JIT before it compiles a module, to look for machine code from an earlier run. </summary>
+        ///
+        /// <param name="module"> The module about to be compiled. </param>
+        ///
+        /// <returns> The cached object file, or `nullptr` if the module isn't in the cache. </returns>
+        std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module* module) override;
+
+        /// <summary> Gets the path of the object file that caches the code for a module, by hashing the module. </summary>
+        ///
+        /// <param name="module"> The module. </param>
+        ///
+        /// <returns> The path of the object file, which may not exist yet. </returns>
+        std::string GetObjectFilePath(const llvm::Module& module) const;
+
+    private:
+        std::string _directory;
+        std::string _settingsKey;
+
+        // Codegen may change a module between the cache miss and notifyObjectCompiled, so the path hashed at the miss
+        // is kept until then. The entry is removed right away, because the JIT frees modules and reuses their addresses.
+        std::mutex _mutex;
+        std::map<const llvm::Module*, std::string> _pendingObjectFilePaths;
+    };
+} // namespace emitters
+} // namespace ell
@@ -53,7 +53,10 @@ namespace emitters
         void EmitLoop(int begin, int end, int increment, const ParallelLoopOptions& options, const std::vector<LLVMValue>& capturedValues, BodyFunction body);
         void EmitLoop(IRLocalScalar begin, IRLocalScalar end, IRLocalScalar increment, const ParallelLoopOptions& options, const std::vector<LLVMValue>& capturedValues, BodyFunction body);
 
+        void EmitDynamicLoop(IRLocalScalar begin, IRLocalScalar end, IRLocalScalar increment, int numTasks, IRLocalScalar numIterations, const std::vector<LLVMValue>& capturedValues, BodyFunction body);
+
         IRFunctionEmitter GetTaskFunction(const std::vector<LLVMValue>& capturedValues, BodyFunction body);
+        IRFunctionEmitter GetDynamicTaskFunction(const std::vector<LLVMValue>& capturedValues, BodyFunction body);
 
         LLVMValue GetIterationVariable();
         LLVMValue LoadIterationVariable();
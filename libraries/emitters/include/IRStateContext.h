@@ -0,0 +1,54 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     IRStateContext.h (emitters)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace ell
+{
+namespace emitters
+{
+    class IRModuleEmitter;
+
+    /// <summary> Gets the name of the function that allocates a state context for a module. </summary>
+    ///
+    /// <param name="moduleName"> The name of the module. </param>
+    ///
+    /// <returns> The name of the `AllocateContext` function. </returns>
+    std::string GetAllocateContextFunctionName(const std::string& moduleName);
+
+    /// <summary> Gets the name of the function that frees a state context allocated for a module. </summary>
+    ///
+    /// <param name="moduleName"> The name of the module. </param>
+    ///
+    /// <returns> The name of the `FreeContext` function. </returns>
+    std::string GetFreeContextFunctionName(const std::string& moduleName);
+
+    /// <summary> Indicates if a module keeps its mutable state in a context struct instead of in globals. </summary>
+    ///
+    /// <param name="moduleEmitter"> The module. </param>
+    ///
+    /// <returns> `true` if `MoveGlobalStateToContext` has been applied to the module. </returns>
+    bool HasStateContext(IRModuleEmitter& moduleEmitter);
+
+    /// <summary>
+    /// Makes a module re-entrant by moving all of its mutable globals into a single context struct that the caller
+    /// allocates, so that many threads can run the same code at once, each with its own context. Constant globals
+    /// (weights, literals) stay shared. The entry points already take a `void* context` first argument, which becomes
+    /// the pointer to the state context; every other function that touches mutable state (directly or through the
+    /// functions it calls) gets a trailing `context` argument. The module also gets two new functions that are
+    /// declared in the header: `void* <module>_AllocateContext()`, which returns a context holding the initial values
+    /// of the globals, and `void <module>_FreeContext(void* context)`.
+    /// </summary>
+    ///
+    /// <param name="moduleEmitter"> The module to transform. It must not be in the middle of emitting a function. </param>
+    /// <param name="entryPointNames"> The names of the functions whose first argument is the state context. </param>
+    void MoveGlobalStateToContext(IRModuleEmitter& moduleEmitter, const std::vector<std::string>& entryPointNames);
+} // namespace emitters
+} // namespace ell
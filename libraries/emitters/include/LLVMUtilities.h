@@ -11,6 +11,7 @@
 
 namespace llvm
 {
+class Constant;
 class Function;
 class FunctionType;
 class GlobalVariable;
@@ -67,5 +68,14 @@ namespace emitters
     ///
     /// <returns> The TypedComparison for comparing values of the given type. </returns>
     emitters::TypedComparison GetComparison(LLVMType type, BinaryPredicateType operation);
+
+    /// <summary>
+    /// Replace each use of a constant expression built on top of a constant (for instance, a GEP into a global) with
+    /// an equivalent instruction, so that afterwards the constant is only used directly by instructions. Throws if
+    /// the constant is used in the initializer of a global.
+    /// </summary>
+    ///
+    /// <param name="constant"> The constant. </param>
+    void ExpandConstantExpressionUses(llvm::Constant* constant);
 } // namespace emitters
 } // namespace ell
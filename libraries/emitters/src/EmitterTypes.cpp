@@ -182,6 +182,18 @@ namespace emitters
         return VariableType::Char8Pointer;
     }
 
+    template <>
+    VariableType GetVariableType<int8_t>()
+    {
+        return VariableType::Char8;
+    }
+
+    template <>
+    VariableType GetVariableType<int8_t*>()
+    {
+        return VariableType::Char8Pointer;
+    }
+
     template <>
     VariableType GetVariableType<bool>()
     {
@@ -0,0 +1,191 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     IRConstantData.cpp (emitters)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "IRConstantData.h"
+#include "EmitterException.h"
+#include "IRExecutionEngine.h"
+#include "LLVMUtilities.h"
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/DerivedTypes.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace ell
+{
+namespace emitters
+{
+    namespace
+    {
+        // Data used in the initializer of another global has to stay where it is
+        bool IsUsedOnlyByCode(const llvm::Constant* constant)
+        {
+            for (auto user : constant->users())
+            {
+                if (llvm::isa<llvm::Instruction>(user))
+                {
+                    continue;
+                }
+
+                auto expression = llvm::dyn_cast<llvm::ConstantExpr>(user);
+                if (expression == nullptr || !IsUsedOnlyByCode(expression))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Data that refers to other globals (a table of pointers, say) has to stay with them
+        bool RefersToGlobals(const llvm::Constant* constant)
+        {
+            if (llvm::isa<llvm::GlobalValue>(constant))
+            {
+                return true;
+            }
+
+            for (const auto& operand : constant->operands())
+            {
+                if (RefersToGlobals(llvm::cast<llvm::Constant>(operand.get())))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool IsConstantData(const llvm::GlobalVariable& global)
+        {
+            return global.isConstant() && global.hasInitializer() && !global.isThreadLocal() && !global.hasAppendingLinkage() && !global.getName().startswith("llvm.") && IsUsedOnlyByCode(&global) && !RefersToGlobals(global.getInitializer());
+        }
+
+        std::string GetAddressGlobalName(const std::string& dataGlobalName)
+        {
+            return dataGlobalName + "_address";
+        }
+
+        // The bitcode of identical modules can differ with the history of their LLVM contexts, so the text is compared
+        std::string GetModuleText(const llvm::Module& module)
+        {
+            std::string text;
+            llvm::raw_string_ostream stream(text);
+            module.print(stream, nullptr);
+            return stream.str();
+        }
+    } // namespace
+
+    std::unique_ptr<llvm::Module> MoveConstantDataToModule(llvm::Module& module, const std::string& dataModuleName)
+    {
+        auto dataModule = std::make_unique<llvm::Module>(dataModuleName, module.getContext());
+        dataModule->setTargetTriple(module.getTargetTriple());
+        dataModule->setDataLayout(module.getDataLayout());
+
+        std::vector<llvm::GlobalVariable*> globals;
+        for (auto& global : module.globals())
+        {
+            if (IsConstantData(global))
+            {
+                globals.push_back(&global);
+            }
+        }
+
+        for (size_t index = 0; index < globals.size(); ++index)
+        {
+            auto global = globals[index];
+            auto dataGlobalName = dataModuleName + "_" + std::to_string(index);
+            auto dataGlobal = new llvm::GlobalVariable(*dataModule, global->getValueType(), true, llvm::GlobalValue::ExternalLinkage, global->getInitializer(), dataGlobalName);
+            dataGlobal->setAlignment(global->getAlignment());
+
+            // the pointer is mutable and visible outside the module, so the optimizer can't assume what it points to
+            auto pointerType = global->getType();
+            auto addressGlobal = new llvm::GlobalVariable(module, pointerType, false, llvm::GlobalValue::ExternalLinkage, llvm::ConstantPointerNull::get(pointerType), GetAddressGlobalName(dataGlobalName));
+
+            ExpandConstantExpressionUses(global);
+            std::map<llvm::Function*, llvm::Value*> addresses;
+            std::vector<llvm::Use*> uses;
+            for (auto& use : global->uses())
+            {
+                uses.push_back(&use);
+            }
+            for (auto use : uses)
+            {
+                auto function = llvm::cast<llvm::Instruction>(use->getUser())->getFunction();
+                auto& address = addresses[function];
+                if (address == nullptr)
+                {
+                    auto& entryBlock = function->getEntryBlock();
+                    llvm::IRBuilder<> builder(&entryBlock, entryBlock.getFirstInsertionPt());
+                    address = builder.CreateLoad(addressGlobal, global->getName());
+                }
+                use->set(address);
+            }
+            global->eraseFromParent();
+        }
+        return dataModule;
+    }
+
+    bool IsCompatibleConstantData(const llvm::Module& module, const llvm::Module& dataModule, const llvm::Module& otherModule, const llvm::Module& otherDataModule)
+    {
+        // the data can only be exchanged between modules with the same code
+        if (GetModuleText(module) != GetModuleText(otherModule))
+        {
+            return false;
+        }
+
+        auto other = otherDataModule.global_begin();
+        for (const auto& global : dataModule.globals())
+        {
+            if (other == otherDataModule.global_end() || other->getName() != global.getName())
+            {
+                return false;
+            }
+
+            // the modules may belong to different LLVM contexts, so the types are compared by their layout
+            const auto& dataLayout = dataModule.getDataLayout();
+            auto type = global.getValueType();
+            auto otherType = other->getValueType();
+            if (type->getTypeID() != otherType->getTypeID() || dataLayout.getTypeAllocSize(type) != dataLayout.getTypeAllocSize(otherType))
+            {
+                return false;
+            }
+            ++other;
+        }
+        return other == otherDataModule.global_end();
+    }
+
+    void BindConstantData(IRExecutionEngine& engine, IRExecutionEngine::ModuleHandle dataModuleHandle)
+    {
+        // find all the data first, so that the code is left pointing at the old data if some is missing
+        std::vector<std::pair<void**, void*>> bindings;
+        for (const auto& global : engine.GetModule(dataModuleHandle).globals())
+        {
+            auto name = global.getName().str();
+            auto address = engine.GetGlobalValueAddress(dataModuleHandle, name);
+            auto pointer = engine.GetGlobalValueAddress(GetAddressGlobalName(name));
+            if (address == 0 || pointer == 0)
+            {
+                throw EmitterException(EmitterError::unexpected, "Couldn't find constant data " + name + " in the execution engine");
+            }
+            bindings.emplace_back(reinterpret_cast<void**>(pointer), reinterpret_cast<void*>(address));
+        }
+
+        for (const auto& binding : bindings)
+        {
+            *binding.first = binding.second;
+        }
+    }
+} // namespace emitters
+} // namespace ell
@@ -997,6 +997,13 @@ namespace emitters
         return _irBuilder.CreateStore(pValue, pPointer);
     }
 
+    llvm::AtomicRMWInst* IREmitter::AtomicAdd(LLVMValue pPointer, LLVMValue pValue)
+    {
+        assert(pPointer != nullptr);
+        assert(pValue != nullptr);
+        return _irBuilder.CreateAtomicRMW(llvm::AtomicRMWInst::Add, pPointer, pValue, llvm::AtomicOrdering::SequentiallyConsistent);
+    }
+
     llvm::AllocaInst* IREmitter::StackAllocate(VariableType type)
     {
         return _irBuilder.CreateAlloca(Type(type), nullptr);
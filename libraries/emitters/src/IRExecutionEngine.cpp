@@ -9,10 +9,24 @@
 #include "IRExecutionEngine.h"
 #include "IRModuleEmitter.h"
 
+#include <llvm/CodeGen/ParallelCG.h>
+#include <llvm/ExecutionEngine/SectionMemoryManager.h>
+#include <llvm/IR/DebugInfo.h>
+#include <llvm/Object/ObjectFile.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Target/TargetMachine.h>
+#include <llvm/Transforms/Utils/Cloning.h>
+#include <llvm/Transforms/Utils/ValueMapper.h>
 
+#include <algorithm>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 namespace ell
 {
@@ -24,19 +38,188 @@ namespace emitters
         throw emitters::EmitterException(emitters::EmitterError::unexpected, msg);
     }
 
+    namespace
+    {
+        using ObjectFile = llvm::object::OwningBinary<llvm::object::ObjectFile>;
+
+        bool CanCompileInParts(const llvm::Module& module)
+        {
+            // static constructors are only run for the modules the engine owns, not for object files
+            return module.getNamedGlobal("llvm.global_ctors") == nullptr && module.getNamedGlobal("llvm.global_dtors") == nullptr;
+        }
+
+        // Splits the module into `numParts` modules and generates an object file for each one on its own thread
+        std::vector<ObjectFile> CompileInParts(std::unique_ptr<llvm::Module> module, unsigned numParts)
+        {
+            llvm::Triple triple(module->getTargetTriple());
+            std::vector<llvm::SmallVector<char, 0>> buffers(numParts);
+            std::vector<std::unique_ptr<llvm::raw_svector_ostream>> streams;
+            std::vector<llvm::raw_pwrite_stream*> streamPointers;
+            for (auto& buffer : buffers)
+            {
+                streams.push_back(std::make_unique<llvm::raw_svector_ostream>(buffer));
+                streamPointers.push_back(streams.back().get());
+            }
+
+            // each thread needs its own target machine, set up the same way as the one the engine uses
+            auto createTargetMachine = [triple]() {
+                llvm::EngineBuilder builder;
+                builder.setEngineKind(llvm::EngineKind::JIT);
+                return std::unique_ptr<llvm::TargetMachine>(builder.selectTarget(triple, "", "", llvm::SmallVector<std::string, 0>{}));
+            };
+            llvm::splitCodeGen(std::move(module), streamPointers, {}, createTargetMachine, llvm::TargetMachine::CGFT_ObjectFile);
+
+            std::vector<ObjectFile> objects;
+            for (auto& buffer : buffers)
+            {
+                auto memoryBuffer = llvm::MemoryBuffer::getMemBufferCopy(llvm::StringRef(buffer.data(), buffer.size()));
+                auto object = llvm::object::ObjectFile::createObjectFile(memoryBuffer->getMemBufferRef());
+                if (!object)
+                {
+                    throw EmitterException(EmitterError::unexpected, "Couldn't load generated object file: " + llvm::toString(object.takeError()));
+                }
+                objects.emplace_back(std::move(object.get()), std::move(memoryBuffer));
+            }
+            return objects;
+        }
+
+        // Creates declarations of the globals that a function cloned into another module refers to
+        class DeclarationMaterializer : public llvm::ValueMaterializer
+        {
+        public:
+            DeclarationMaterializer(llvm::Module& module) :
+                _module(module) {}
+
+            llvm::Value* materialize(llvm::Value* value) override
+            {
+                if (auto function = llvm::dyn_cast<llvm::Function>(value))
+                {
+                    auto declaration = llvm::Function::Create(function->getFunctionType(), llvm::GlobalValue::ExternalLinkage, function->getName(), &_module);
+                    declaration->setCallingConv(function->getCallingConv());
+                    declaration->setAttributes(function->getAttributes());
+                    return declaration;
+                }
+                if (auto global = llvm::dyn_cast<llvm::GlobalVariable>(value))
+                {
+                    auto declaration = new llvm::GlobalVariable(_module, global->getValueType(), global->isConstant(), llvm::GlobalValue::ExternalLinkage, nullptr, global->getName(), nullptr, global->getThreadLocalMode(), global->getType()->getAddressSpace());
+                    declaration->setAlignment(global->getAlignment());
+                    return declaration;
+                }
+                return nullptr;
+            }
+
+        private:
+            llvm::Module& _module;
+        };
+
+        // Moves each function defined in the module into a module of its own, which declares the globals the function
+        // refers to. The global variables stay in the original module.
+        std::vector<std::unique_ptr<llvm::Module>> SplitFunctionsIntoModules(llvm::Module& module)
+        {
+            // the modules refer to each other's symbols by name, so none can be local to a module
+            llvm::StripDebugInfo(module);
+            for (auto& global : module.global_values())
+            {
+                if (global.isDeclaration() || global.hasAppendingLinkage() || global.hasAvailableExternallyLinkage())
+                {
+                    continue;
+                }
+                if (!global.hasName())
+                {
+                    global.setName("unnamed");
+                }
+                global.setLinkage(llvm::GlobalValue::ExternalLinkage);
+            }
+
+            std::vector<llvm::Function*> functions;
+            for (auto& function : module)
+            {
+                if (!function.isDeclaration() && !function.hasAvailableExternallyLinkage())
+                {
+                    functions.push_back(&function);
+                }
+            }
+
+            std::vector<std::unique_ptr<llvm::Module>> functionModules;
+            for (auto function : functions)
+            {
+                auto functionModule = std::make_unique<llvm::Module>(module.getName().str() + "_" + std::to_string(functionModules.size()), module.getContext());
+                functionModule->setTargetTriple(module.getTargetTriple());
+                functionModule->setDataLayout(module.getDataLayout());
+
+                auto clonedFunction = llvm::Function::Create(function->getFunctionType(), function->getLinkage(), function->getName(), functionModule.get());
+                llvm::ValueToValueMapTy valueMap;
+                valueMap[function] = clonedFunction;
+                auto clonedArgument = clonedFunction->arg_begin();
+                for (auto& argument : function->args())
+                {
+                    clonedArgument->setName(argument.getName());
+                    valueMap[&argument] = &*clonedArgument++;
+                }
+                llvm::SmallVector<llvm::ReturnInst*, 4> returns;
+                DeclarationMaterializer materializer(*functionModule);
+                llvm::CloneFunctionInto(clonedFunction, function, valueMap, true, returns, "", nullptr, nullptr, &materializer);
+                functionModules.push_back(std::move(functionModule));
+            }
+
+            // what is left refers only to the functions the static constructors and the global initializers need
+            for (auto function : functions)
+            {
+                function->deleteBody();
+            }
+            for (auto function : functions)
+            {
+                if (function->use_empty())
+                {
+                    function->eraseFromParent();
+                }
+            }
+            return functionModules;
+        }
+
+        // Looks up the symbols that the code refers to with a function, and then in the process
+        class SymbolResolvingMemoryManager : public llvm::SectionMemoryManager
+        {
+        public:
+            SymbolResolvingMemoryManager(std::function<uint64_t(const std::string&)> findSymbol) :
+                _findSymbol(std::move(findSymbol)) {}
+
+            uint64_t getSymbolAddress(const std::string& name) override
+            {
+                if (auto address = _findSymbol(name))
+                {
+                    return address;
+                }
+                return llvm::RTDyldMemoryManager::getSymbolAddressInProcess(name);
+            }
+
+        private:
+            std::function<uint64_t(const std::string&)> _findSymbol;
+        };
+    } // namespace
+
+    //
+    // IRExecutionEngine
+    //
     IRExecutionEngine::IRExecutionEngine(IRModuleEmitter&& module, bool verify) :
         IRExecutionEngine(module.TransferOwnership(), verify)
     {
     }
 
-    IRExecutionEngine::IRExecutionEngine(std::unique_ptr<llvm::Module> pModule, bool verify)
+    IRExecutionEngine::IRExecutionEngine(std::unique_ptr<llvm::Module> pModule, bool verify) :
+        IRExecutionEngine(std::move(pModule), nullptr, verify)
+    {
+    }
+
+    IRExecutionEngine::IRExecutionEngine(std::unique_ptr<llvm::Module> pModule, std::unique_ptr<llvm::LLVMContext> pContext, bool verify) :
+        _pContext(std::move(pContext)),
+        _context(&pModule->getContext()),
+        _pModule(std::move(pModule)),
+        _verify(verify)
     {
         llvm::InitializeNativeTarget();
         llvm::InitializeNativeTargetAsmPrinter();
 
-        _pBuilder = std::make_unique<llvm::EngineBuilder>(std::move(pModule));
-        _pBuilder->setEngineKind(llvm::EngineKind::JIT).setVerifyModules(verify).setUseOrcMCJITReplacement(false);
-
         static bool installed = false;
         if (!installed)
         {
@@ -48,17 +231,92 @@ namespace emitters
 
     IRExecutionEngine::~IRExecutionEngine()
     {
+        // the modules added last go first, since they may refer to the ones added before
+        while (!_addedModules.empty())
+        {
+            auto addedModule = std::prev(_addedModules.end());
+            addedModule->second.engine->runStaticConstructorsDestructors(true);
+            _addedModules.erase(addedModule);
+        }
+
         if (_pEngine)
         {
             PerformFinalization();
         }
     }
 
-    void IRExecutionEngine::AddModule(std::unique_ptr<llvm::Module> pModule)
+    void IRExecutionEngine::SetObjectCache(std::unique_ptr<llvm::ObjectCache> cache)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pObjectCache = std::move(cache);
+        if (_pEngine)
+        {
+            _pEngine->setObjectCache(_pObjectCache.get());
+        }
+        for (auto& addedModule : _addedModules)
+        {
+            addedModule.second.engine->setObjectCache(_pObjectCache.get());
+        }
+    }
+
+    void IRExecutionEngine::SetCodeGenerationThreads(unsigned numThreads)
+    {
+        _numCodeGenerationThreads = std::max(numThreads, 1u);
+    }
+
+    void IRExecutionEngine::SetLazyCompilation(bool lazy)
+    {
+        if (_pEngine)
+        {
+            throw EmitterException(EmitterError::notSupported, "Lazy compilation must be set before the execution engine is used");
+        }
+        _lazy = lazy;
+    }
+
+    IRExecutionEngine::ModuleHandle IRExecutionEngine::AddModule(std::unique_ptr<llvm::Module> pModule)
     {
         assert(pModule != nullptr);
+        std::lock_guard<std::mutex> lock(_mutex);
         EnsureEngine();
-        _pEngine->addModule(std::move(pModule));
+
+        // a module of its own engine, so that its code can be freed along with the engine
+        auto handle = _nextModuleHandle++;
+        auto& addedModule = _addedModules[handle];
+        addedModule.module = pModule.get();
+        try
+        {
+            addedModule.engine = CreateEngine(std::move(pModule));
+            addedModule.engine->runStaticConstructorsDestructors(false);
+        }
+        catch (...)
+        {
+            _addedModules.erase(handle);
+            throw;
+        }
+        return handle;
+    }
+
+    void IRExecutionEngine::RemoveModule(ModuleHandle handle)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        GetAddedModule(handle).engine->runStaticConstructorsDestructors(true);
+        _addedModules.erase(handle);
+    }
+
+    const llvm::Module& IRExecutionEngine::GetModule(ModuleHandle handle)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return *GetAddedModule(handle).module;
+    }
+
+    IRExecutionEngine::AddedModule& IRExecutionEngine::GetAddedModule(ModuleHandle handle)
+    {
+        auto addedModule = _addedModules.find(handle);
+        if (addedModule == _addedModules.end())
+        {
+            throw EmitterException(EmitterError::badFunctionArguments, "Module isn't in the execution engine");
+        }
+        return addedModule->second;
     }
 
     void IRExecutionEngine::PerformInitialization()
@@ -73,14 +331,22 @@ namespace emitters
 
     uint64_t IRExecutionEngine::GetFunctionAddress(const std::string& name)
     {
+        std::lock_guard<std::mutex> lock(_mutex);
         EnsureEngine();
-        return _pEngine->getFunctionAddress(name);
+        return FindSymbolAddress(name, true);
     }
 
     uint64_t IRExecutionEngine::GetGlobalValueAddress(const std::string& name)
     {
+        std::lock_guard<std::mutex> lock(_mutex);
         EnsureEngine();
-        return _pEngine->getGlobalValueAddress(name);
+        return FindSymbolAddress(name, false);
+    }
+
+    uint64_t IRExecutionEngine::GetGlobalValueAddress(ModuleHandle handle, const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return GetAddedModule(handle).engine->getGlobalValueAddress(name);
     }
 
     uint64_t IRExecutionEngine::ResolveFunctionAddress(const std::string& name)
@@ -95,8 +361,9 @@ namespace emitters
 
     void IRExecutionEngine::DefineFunction(LLVMFunction func, uintptr_t address)
     {
-        EnsureEngine();
-        _pEngine->addGlobalMapping(func, (void*)address);
+        // the engines ask for the addresses of the functions the code declares as they link it
+        std::lock_guard<std::mutex> lock(_mutex);
+        _definedFunctions[func->getName().str()] = address;
     }
 
     DynamicFunction IRExecutionEngine::GetMain()
@@ -121,14 +388,144 @@ namespace emitters
         mainFunction();
     }
 
+    uint64_t IRExecutionEngine::FindSymbolAddress(const std::string& name, bool functionsOnly)
+    {
+        auto definedFunction = _definedFunctions.find(name);
+        if (definedFunction != _definedFunctions.end())
+        {
+            return definedFunction->second;
+        }
+
+        auto functionModule = _functionModuleIndices.find(name);
+        if (functionModule != _functionModuleIndices.end())
+        {
+            GenerateCode(functionModule->second);
+        }
+
+        auto address = functionsOnly ? _pEngine->getFunctionAddress(name) : _pEngine->getGlobalValueAddress(name);
+        for (auto addedModule = _addedModules.begin(); address == 0 && addedModule != _addedModules.end(); ++addedModule)
+        {
+            auto& engine = *addedModule->second.engine;
+            address = functionsOnly ? engine.getFunctionAddress(name) : engine.getGlobalValueAddress(name);
+        }
+        return address;
+    }
+
+    uint64_t IRExecutionEngine::FindLinkedSymbolAddress(const std::string& mangledName)
+    {
+        // called by an engine linking code, while the symbol lookup or the module addition that caused it holds the mutex
+        auto prefix = _pEngine->getDataLayout().getGlobalPrefix();
+        auto unprefixed = prefix != '\0' && !mangledName.empty() && mangledName.front() == prefix;
+        return FindSymbolAddress(unprefixed ? mangledName.substr(1) : mangledName, false);
+    }
+
+    void IRExecutionEngine::GenerateCode(size_t functionModuleIndex)
+    {
+        // generate the code of everything the module needs before any of it is linked, so that linking never has to
+        // generate more
+        std::vector<size_t> pendingIndices = { functionModuleIndex };
+        while (!pendingIndices.empty())
+        {
+            auto& functionModule = _functionModules[pendingIndices.back()];
+            pendingIndices.pop_back();
+            if (!functionModule.compiled)
+            {
+                functionModule.compiled = true;
+                _pEngine->generateCodeForModule(functionModule.module);
+                pendingIndices.insert(pendingIndices.end(), functionModule.dependencies.begin(), functionModule.dependencies.end());
+            }
+        }
+    }
+
+    void IRExecutionEngine::AddFunctionModules(std::vector<std::unique_ptr<llvm::Module>> functionModules)
+    {
+        // they go after the engine's own module, which holds the global variables
+        for (auto& functionModule : functionModules)
+        {
+            _functionModules.push_back({ functionModule.get(), {}, false });
+            _pEngine->addModule(std::move(functionModule));
+        }
+
+        for (size_t index = 0; index < _functionModules.size(); ++index)
+        {
+            for (const auto& global : _functionModules[index].module->global_values())
+            {
+                if (!global.isDeclaration())
+                {
+                    _functionModuleIndices[global.getName().str()] = index;
+                }
+            }
+        }
+        for (auto& functionModule : _functionModules)
+        {
+            for (const auto& global : functionModule.module->global_values())
+            {
+                auto definition = _functionModuleIndices.find(global.getName().str());
+                if (global.isDeclaration() && definition != _functionModuleIndices.end())
+                {
+                    functionModule.dependencies.push_back(definition->second);
+                }
+            }
+        }
+    }
+
+    std::unique_ptr<llvm::ExecutionEngine> IRExecutionEngine::CreateEngine(std::unique_ptr<llvm::Module> pModule)
+    {
+        std::string error;
+        llvm::EngineBuilder builder(std::move(pModule));
+        builder.setEngineKind(llvm::EngineKind::JIT).setVerifyModules(_verify).setErrorStr(&error);
+        builder.setMCJITMemoryManager(std::make_unique<SymbolResolvingMemoryManager>([this](const std::string& name) { return FindLinkedSymbolAddress(name); }));
+        std::unique_ptr<llvm::ExecutionEngine> engine(builder.create());
+        if (!engine)
+        {
+            throw EmitterException(EmitterError::unexpected, "Couldn't create the execution engine: " + error);
+        }
+
+        if (_pObjectCache)
+        {
+            engine->setObjectCache(_pObjectCache.get());
+        }
+        return engine;
+    }
+
     void IRExecutionEngine::EnsureEngine()
     {
-        if (!_pEngine)
+        if (_pEngine)
+        {
+            return;
+        }
+
+        std::vector<ObjectFile> objects;
+        std::vector<std::unique_ptr<llvm::Module>> functionModules;
+        if (_lazy)
+        {
+            functionModules = SplitFunctionsIntoModules(*_pModule);
+        }
+        else if (_numCodeGenerationThreads > 1 && !_pObjectCache && CanCompileInParts(*_pModule))
+        {
+            // the engine gets an empty module in place of the primary one, and links in the compiled parts
+            auto pModule = std::make_unique<llvm::Module>(_pModule->getName(), _pModule->getContext());
+            pModule->setTargetTriple(_pModule->getTargetTriple());
+            pModule->setDataLayout(_pModule->getDataLayout());
+            objects = CompileInParts(std::move(_pModule), _numCodeGenerationThreads);
+            _pModule = std::move(pModule);
+        }
+
+        auto pModule = _pModule.get();
+        _pEngine = CreateEngine(std::move(_pModule));
+        for (auto& object : objects)
         {
-            auto pEngine = _pBuilder->create();
-            _pEngine.reset(pEngine);
-            PerformInitialization();
+            _pEngine->addObjectFile(std::move(object));
+        }
+        if (_lazy)
+        {
+            _functionModules.push_back({ pModule, {}, false });
+            AddFunctionModules(std::move(functionModules));
+
+            // the static constructors, and the global initializers, are in the module that holds the global variables
+            GenerateCode(0);
         }
+        PerformInitialization();
     }
 } // namespace emitters
 } // namespace ell
@@ -762,6 +762,11 @@ namespace emitters
         return _pEmitter->Store(pPointer, pValue);
     }
 
+    LLVMValue IRFunctionEmitter::AtomicAdd(LLVMValue pPointer, LLVMValue pValue)
+    {
+        return _pEmitter->AtomicAdd(pPointer, pValue);
+    }
+
     LLVMValue IRFunctionEmitter::StoreZero(LLVMValue pPointer, int numElements /* = 1 */)
     {
         assert(numElements >= 1);
@@ -1087,7 +1092,7 @@ namespace emitters
 
         // full blocks
         If(numFullBlocks > 0, [numFullBlocks, stepSize, range, body](auto& function) {
-            function.For(numFullBlocks, range.blockSize, [stepSize, range, body](IRFunctionEmitter function, auto blockIndex) {
+            function.For(numFullBlocks, [stepSize, range, body](IRFunctionEmitter function, auto blockIndex) {
                 auto index = range.begin + blockIndex * stepSize;
                 body(function, { index, index + range.blockSize, range.blockSize, blockIndex });
             });
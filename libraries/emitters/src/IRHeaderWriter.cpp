@@ -10,6 +10,7 @@
 #include "EmitterException.h"
 #include "IRMetadata.h"
 #include "IRModuleEmitter.h"
+#include "IRStateContext.h"
 
 #include <llvm/IR/Attributes.h>
 #include <llvm/IR/IRPrintingPasses.h>
@@ -330,6 +331,7 @@ namespace emitters
         std::string predictReturnMember;
         std::vector<std::string> predictMethodArgs;
         std::vector<std::string> predictCallArgs;
+        bool hasStateContext = false;
         std::stringstream constructorInit;
         std::stringstream predictPreBody;
         std::stringstream predictPostBody;
@@ -337,6 +339,7 @@ namespace emitters
         std::stringstream cdecls;
         std::stringstream helperMethods;
         std::stringstream resetMethodBody;
+        std::stringstream destructorBody;
     };
 
     static void WriteSourceNodeCallbacks(ModuleCallbackDefinitions& moduleCallbacks, CppWrapperInfo& info)
@@ -492,7 +495,8 @@ namespace emitters
             {
                 // we really want void* on these puppies, but LLVM won't let us...(which is why the argType is int8_t*,
                 // and for our wrapper class, the context will be 'this' so the "C" callbacks can find this object.
-                info.predictCallArgs.push_back("this");
+                // A re-entrant module has no callbacks, and its context holds the model state instead.
+                info.predictCallArgs.push_back(info.hasStateContext ? "_context" : "this");
             }
             else
             {
@@ -605,6 +609,17 @@ namespace emitters
 
         bool hasSourceNodes = !moduleCallbacks.sources.empty();
 
+        info.hasStateContext = HasStateContext(moduleEmitter);
+        if (info.hasStateContext)
+        {
+            // each wrapper owns a state context, so instances can be used on different threads at the same time
+            info.constructorInit << "        _context = " << GetAllocateContextFunctionName(moduleName) << "();\n";
+            info.destructorBody << "        " << GetFreeContextFunctionName(moduleName) << "(_context);\n";
+            info.helperMethods << "    " << className << "(const " << className << "&) = delete;\n";
+            info.helperMethods << "    " << className << "& operator=(const " << className << "&) = delete;\n\n";
+            info.memberDecls << "    void* _context = nullptr;\n";
+        }
+
         if (!hasSourceNodes)
         {
             WriteSimplePredictMethod(predictFunction, info);
@@ -639,6 +654,8 @@ namespace emitters
         ReplaceDelimiter(predictWrapperCode, "CDECLS_IMPL", info.cdecls.str());
         ReplaceDelimiter(predictWrapperCode, "STEPPABLE", hasSourceNodes ? "true" : "false");
         ReplaceDelimiter(predictWrapperCode, "RESET_BODY", info.resetMethodBody.str());
+        ReplaceDelimiter(predictWrapperCode, "RESET_ARGS", info.hasStateContext ? "_context" : "");
+        ReplaceDelimiter(predictWrapperCode, "DESTRUCTOR_IMPL", info.destructorBody.str());
 
         os << predictWrapperCode;
     }
@@ -0,0 +1,139 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     IRObjectCache.cpp (emitters)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "IRObjectCache.h"
+
+#include <utilities/include/Exception.h>
+#include <utilities/include/Files.h>
+
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <cstdio>
+#include <random>
+
+namespace ell
+{
+namespace emitters
+{
+    namespace
+    {
+        // A stream that hashes what is written to it, so the module's bitcode never has to be held in memory
+        class MD5Stream : public llvm::raw_ostream
+        {
+        public:
+            ~MD5Stream() override { flush(); }
+
+            std::string GetHash()
+            {
+                flush();
+                llvm::MD5::MD5Result result;
+                _hash.final(result);
+                llvm::SmallString<32> hashString;
+                llvm::MD5::stringifyResult(result, hashString);
+                return std::string(hashString.str());
+            }
+
+        private:
+            void write_impl(const char* data, size_t size) override
+            {
+                _hash.update(llvm::StringRef(data, size));
+                _size += size;
+            }
+
+            uint64_t current_pos() const override { return _size; }
+
+            llvm::MD5 _hash;
+            uint64_t _size = 0;
+        };
+    } // namespace
+
+    IRObjectCache::IRObjectCache(std::string directory, std::string settingsKey) :
+        _directory(std::move(directory)),
+        _settingsKey(std::move(settingsKey))
+    {
+    }
+
+    std::string IRObjectCache::GetObjectFilePath(const llvm::Module& module) const
+    {
+        MD5Stream stream;
+        stream << LLVM_VERSION_STRING << '\n'
+               << module.getTargetTriple() << '\n'
+               << module.getDataLayoutStr() << '\n'
+               << llvm::sys::getHostCPUName() << '\n'
+               << _settingsKey << '\n';
+        llvm::WriteBitcodeToFile(&module, stream);
+        return utilities::JoinPaths(_directory, module.getName().str() + "-" + stream.GetHash() + ".o");
+    }
+
+    std::unique_ptr<llvm::MemoryBuffer> IRObjectCache::getObject(const llvm::Module* module)
+    {
+        auto path = GetObjectFilePath(*module);
+        if (utilities::FileExists(path))
+        {
+            auto buffer = llvm::MemoryBuffer::getFile(path);
+            if (buffer)
+            {
+                return std::move(buffer.get());
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _pendingObjectFilePaths[module] = path;
+        return nullptr;
+    }
+
+    void IRObjectCache::notifyObjectCompiled(const llvm::Module* module, llvm::MemoryBufferRef object)
+    {
+        std::string path;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto it = _pendingObjectFilePaths.find(module);
+            if (it != _pendingObjectFilePaths.end())
+            {
+                path = std::move(it->second);
+                _pendingObjectFilePaths.erase(it);
+            }
+        }
+        if (path.empty())
+        {
+            path = GetObjectFilePath(*module);
+        }
+
+        try
+        {
+            utilities::EnsureDirectoryExists(_directory);
+
+            // write to a private file first, so that other processes never see a partially written object file
+            std::random_device random;
+            auto temporaryPath = path + "." + std::to_string(random()) + ".tmp";
+            {
+                auto stream = utilities::OpenBinaryOfstream(temporaryPath);
+                stream.write(object.getBufferStart(), object.getBufferSize());
+                if (!stream)
+                {
+                    stream.close();
+                    std::remove(temporaryPath.c_str());
+                    return;
+                }
+            }
+            if (std::rename(temporaryPath.c_str(), path.c_str()) != 0)
+            {
+                std::remove(temporaryPath.c_str());
+            }
+        }
+        catch (const utilities::Exception&)
+        {
+            // the cache is only an optimization, so the compiled code is still used if it can't be saved
+        }
+    }
+} // namespace emitters
+} // namespace ell
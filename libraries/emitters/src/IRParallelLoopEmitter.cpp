@@ -45,7 +45,11 @@ namespace emitters
         // TODO: explicitly check for empty loop?
 
         auto taskSize = Max(1, numIterations / numTasks);
-        if (compilerSettings.parallelize && numTasks > 1)
+        if (compilerSettings.parallelize && numTasks > 1 && compilerSettings.parallelLoopSchedule == ParallelLoopSchedule::dynamicChunks)
+        {
+            EmitDynamicLoop(begin, end, increment, numTasks, numIterations, capturedValues, body);
+        }
+        else if (compilerSettings.parallelize && numTasks > 1)
         {
             auto taskFunction = GetTaskFunction(capturedValues, body);
 
@@ -70,6 +74,30 @@ namespace emitters
         }
     }
 
+    void IRParallelForLoopEmitter::EmitDynamicLoop(IRLocalScalar begin, IRLocalScalar end, IRLocalScalar increment, int numTasks, IRLocalScalar numIterations, const std::vector<LLVMValue>& capturedValues, BodyFunction body)
+    {
+        // Each task claims chunks of iterations from a shared counter until the range is exhausted, so tasks
+        // that get cheap iterations (or start late) keep picking up work instead of leaving cores idle
+        auto& compilerSettings = _functionEmitter.GetModule().GetCompilerOptions();
+        const int chunksPerTask = 4;
+        auto chunkSize = compilerSettings.parallelLoopChunkSize > 0 ? _functionEmitter.LocalScalar<int32_t>(compilerSettings.parallelLoopChunkSize) : Max(1, numIterations / (numTasks * chunksPerTask));
+
+        // The counter lives on the stack of the calling function, which waits for all the tasks to finish
+        auto nextChunk = _functionEmitter.Variable(VariableType::Int32, "nextChunk");
+        _functionEmitter.StoreZero(nextChunk);
+
+        auto taskFunction = GetDynamicTaskFunction(capturedValues, body);
+        std::vector<std::vector<LLVMValue>> taskArgs;
+        for (int taskIndex = 0; taskIndex < numTasks; ++taskIndex)
+        {
+            std::vector<LLVMValue> args{ begin, end, increment, chunkSize, nextChunk };
+            std::copy(capturedValues.begin(), capturedValues.end(), std::back_inserter(args));
+            taskArgs.push_back(args);
+        }
+        auto tasks = _functionEmitter.StartTasks(taskFunction, taskArgs);
+        tasks.WaitAll(_functionEmitter);
+    }
+
     IRFunctionEmitter IRParallelForLoopEmitter::GetTaskFunction(const std::vector<LLVMValue>& capturedValues, BodyFunction body)
     {
         std::string name = "parForTask";
@@ -101,5 +129,55 @@ namespace emitters
         _functionEmitter.GetModule().EndFunction();
         return taskFunction;
     }
+
+    IRFunctionEmitter IRParallelForLoopEmitter::GetDynamicTaskFunction(const std::vector<LLVMValue>& capturedValues, BodyFunction body)
+    {
+        std::string name = "parForDynamicTask";
+
+        // args = begin, end, increment, chunk size, pointer to next chunk index, captured args
+        auto returnType = _functionEmitter.GetModule().GetIREmitter().Type(VariableType::Void);
+        auto argTypes = _functionEmitter.GetModule().GetIREmitter().GetLLVMTypes({ VariableType::Int32, VariableType::Int32, VariableType::Int32, VariableType::Int32, VariableType::Int32Pointer });
+        auto capturedTypes = GetLLVMTypes(capturedValues);
+        std::copy(capturedTypes.begin(), capturedTypes.end(), std::back_inserter(argTypes));
+        auto taskFunction = _functionEmitter.GetModule().BeginFunction(name, returnType, argTypes);
+        {
+            auto arguments = taskFunction.Arguments().begin();
+            auto begin = taskFunction.LocalScalar(&(*arguments++));
+            auto end = taskFunction.LocalScalar(&(*arguments++));
+            auto increment = taskFunction.LocalScalar(&(*arguments++));
+            auto chunkSize = taskFunction.LocalScalar(&(*arguments++));
+            auto nextChunk = &(*arguments++);
+            std::vector<LLVMValue> innerCapturedValues;
+            int numCapturedValues = static_cast<int>(capturedValues.size());
+            for (int index = 0; index < numCapturedValues; ++index)
+            {
+                auto capturedValue = &(*arguments++);
+                capturedValue->setName("captured_" + std::to_string(index));
+                innerCapturedValues.push_back(capturedValue);
+            }
+
+            auto chunkStride = chunkSize * increment;
+            auto chunkStartVar = taskFunction.Variable(VariableType::Int32, "chunkStart");
+            auto claimChunk = [=](IRFunctionEmitter& taskFunction) {
+                auto chunkIndex = taskFunction.LocalScalar(taskFunction.AtomicAdd(nextChunk, taskFunction.Literal<int>(1)));
+                taskFunction.Store(chunkStartVar, begin + chunkIndex * chunkStride);
+            };
+
+            claimChunk(taskFunction);
+            auto hasWork = [=](IRFunctionEmitter& taskFunction) {
+                return taskFunction.Comparison(TypedComparison::lessThan, taskFunction.Load(chunkStartVar), end);
+            };
+            taskFunction.While(hasWork, [=](IRFunctionEmitter& taskFunction) {
+                auto chunkStart = taskFunction.LocalScalar(taskFunction.Load(chunkStartVar));
+                auto chunkEnd = Min(chunkStart + chunkStride, end);
+                taskFunction.For(chunkStart, chunkEnd, increment, [innerCapturedValues, body](IRFunctionEmitter& taskFunction, LLVMValue i) {
+                    body(taskFunction, taskFunction.LocalScalar(i), innerCapturedValues);
+                });
+                claimChunk(taskFunction);
+            });
+        }
+        _functionEmitter.GetModule().EndFunction();
+        return taskFunction;
+    }
 } // namespace emitters
 } // namespace ell
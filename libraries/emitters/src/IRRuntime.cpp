@@ -13,6 +13,8 @@
 
 #include <utilities/include/Unused.h>
 
+#include <algorithm>
+
 namespace ell
 {
 namespace emitters
@@ -22,9 +24,18 @@ namespace emitters
         //
         // Native implementations of matrix operation functions (as opposed to calling out to BLAS)
         //
+        // The number of elements processed together by the register-tiled inner loops. Each tile is unrolled into
+        // independent scalar operations, which LLVM's vectorizer turns into SIMD instructions.
+        int GetTileWidth(IRModuleEmitter& module)
+        {
+            return std::max(1, module.GetCompilerOptions().vectorWidth);
+        }
+
         template <typename ValueType>
         LLVMFunction EmitGEMVFunction(IRModuleEmitter& module, const std::string& functionName, const NamedVariableTypeList& argTypes)
         {
+            const int tileWidth = GetTileWidth(module);
+
             auto function = module.BeginFunction(functionName, VariableType::Int32, argTypes);
             auto arguments = function.Arguments().begin();
             auto order = &(*arguments++);
@@ -39,23 +50,41 @@ namespace emitters
             auto beta = function.LocalScalar(&(*arguments++));
             auto y = function.LocalArray(&(*arguments++));
             auto incy = function.LocalScalar(&(*arguments++));
-            UNUSED(order, transpose, alpha, beta);
-
-            LLVMValue accum = function.Variable(emitters::GetVariableType<ValueType>(), "accum");
-
-            function.For(m, [A, x, y, incx, incy, lda, n, accum](IRFunctionEmitter& function, auto rowIndex) {
-                function.StoreZero(accum);
-                function.For(n, [rowIndex, A, x, incx, lda, accum](IRFunctionEmitter& function, auto columnIndex) {
-                    auto aIndex = (rowIndex * lda) + columnIndex;
-                    auto xIndex = columnIndex * incx;
-                    auto aVal = A[aIndex];
-                    auto xVal = x[xIndex];
-                    auto aTimesX = aVal * xVal;
-                    function.Store(accum, function.Load(accum) + aTimesX);
+            UNUSED(order, transpose);
+
+            // Each row is reduced into `tileWidth` independent partial sums, followed by a scalar loop over the remaining columns
+            auto accumulators = function.LocalArray(function.Variable(emitters::GetVariableType<ValueType>(), tileWidth));
+            auto numTiledColumns = function.LocalScalar((n / tileWidth) * tileWidth);
+            auto zero = function.Literal<ValueType>(0);
+
+            function.For(m, [=](IRFunctionEmitter& function, IRLocalScalar rowIndex) {
+                for (int lane = 0; lane < tileWidth; ++lane)
+                {
+                    accumulators[lane] = zero;
+                }
+
+                auto rowOffset = rowIndex * lda;
+                function.For(function.Literal<int>(0), numTiledColumns, function.Literal<int>(tileWidth), [=](IRFunctionEmitter& function, IRLocalScalar columnIndex) {
+                    for (int lane = 0; lane < tileWidth; ++lane)
+                    {
+                        auto column = columnIndex + lane;
+                        accumulators[lane] = static_cast<IRLocalScalar>(accumulators[lane]) + static_cast<IRLocalScalar>(A[rowOffset + column]) * static_cast<IRLocalScalar>(x[column * incx]);
+                    }
                 });
+                function.For(numTiledColumns, n, [=](IRFunctionEmitter& function, IRLocalScalar column) {
+                    accumulators[0] = static_cast<IRLocalScalar>(accumulators[0]) + static_cast<IRLocalScalar>(A[rowOffset + column]) * static_cast<IRLocalScalar>(x[column * incx]);
+                });
+
+                IRLocalScalar sum = accumulators[0];
+                for (int lane = 1; lane < tileWidth; ++lane)
+                {
+                    sum = sum + static_cast<IRLocalScalar>(accumulators[lane]);
+                }
 
+                // y = alpha * Ax + beta * y, ignoring the previous contents of y when beta is zero
                 auto yIndex = rowIndex * incy;
-                y[yIndex] = function.Load(accum);
+                auto scaledSum = alpha * sum;
+                y[yIndex] = function.Select(beta == static_cast<ValueType>(0), scaledSum, scaledSum + beta * static_cast<IRLocalScalar>(y[yIndex]));
             });
 
             function.Return(function.Literal<int>(0));
@@ -66,9 +95,14 @@ namespace emitters
         template <typename ValueType>
         LLVMFunction EmitGEMMFunction(IRModuleEmitter& module, const std::string& functionName, const NamedVariableTypeList& argTypes)
         {
-            const auto CblasNoTrans = 111;
             const auto CblasTrans = 112;
 
+            // The output is computed in tiles of one row by `tileWidth` columns, held in registers. The matching
+            // panel of B (up to `panelDepth` rows by `tileWidth` columns) is packed into a small contiguous buffer
+            // that stays in L1 cache while it is swept across all the rows of A.
+            const int tileWidth = GetTileWidth(module);
+            const int panelDepth = 128;
+
             auto function = module.BeginFunction(functionName, VariableType::Int32, argTypes);
             auto arguments = function.Arguments().begin();
             auto order = &(*arguments++);
@@ -85,31 +119,86 @@ namespace emitters
             auto beta = function.LocalScalar(&(*arguments++));
             auto C = function.LocalArray(&(*arguments++));
             auto ldc = function.LocalScalar(&(*arguments++));
-            UNUSED(CblasNoTrans, order, alpha, beta);
+            UNUSED(order);
 
             // C = A x B, A: mxk, B: kxn, C: mxn
             // A': kxm, B': nxk
+            // Resolve the transposes into row and column increments up front, so the inner loops don't test them
+            auto one = function.Literal<int>(1);
+            auto aRowIncrement = function.LocalScalar(function.Select(transposeA, one, lda));
+            auto aColumnIncrement = function.LocalScalar(function.Select(transposeA, lda, one));
+            auto bRowIncrement = function.LocalScalar(function.Select(transposeB, one, ldb));
+            auto bColumnIncrement = function.LocalScalar(function.Select(transposeB, ldb, one));
+
+            // C = beta * C, ignoring the previous contents of C when beta is zero
+            function.If(beta == static_cast<ValueType>(0), [C, ldc, m, n](IRFunctionEmitter& function) {
+                        // Clear only the first n entries of each row, since the last row may end before ldc
+                        function.For(m, [=](IRFunctionEmitter& function, IRLocalScalar i) {
+                            function.MemorySet<ValueType>(C, i * ldc, function.Literal<uint8_t>(0), n);
+                        });
+                    })
+                .Else([C, ldc, m, n, beta](IRFunctionEmitter& function) {
+                    function.For(m, [=](IRFunctionEmitter& function, IRLocalScalar i) {
+                        function.For(n, [=](IRFunctionEmitter& function, IRLocalScalar j) {
+                            auto cOffset = (i * ldc) + j;
+                            C[cOffset] = beta * static_cast<IRLocalScalar>(C[cOffset]);
+                        });
+                    });
+                });
+
+            auto packedB = function.LocalArray(function.Variable(emitters::GetVariableType<ValueType>(), panelDepth * tileWidth));
+            auto accumulators = function.LocalArray(function.Variable(emitters::GetVariableType<ValueType>(), tileWidth));
+            auto numTiledColumns = function.LocalScalar((n / tileWidth) * tileWidth);
+            auto zero = function.Literal<ValueType>(0);
+
+            // Accumulate alpha * A x B into C, one block of the shared dimension at a time
+            function.For(IRFunctionEmitter::TiledLoopRange{ function.LocalScalar<int>(0), k, function.LocalScalar<int>(panelDepth) }, [=](IRFunctionEmitter& function, IRFunctionEmitter::BlockInterval kBlock) {
+                function.For(function.Literal<int>(0), numTiledColumns, function.Literal<int>(tileWidth), [=](IRFunctionEmitter& function, IRLocalScalar j) {
+                    // Pack the panel of B
+                    function.For(kBlock.size, [=](IRFunctionEmitter& function, IRLocalScalar p) {
+                        auto bOffset = ((kBlock.begin + p) * bRowIncrement) + (j * bColumnIncrement);
+                        for (int lane = 0; lane < tileWidth; ++lane)
+                        {
+                            packedB[(p * tileWidth) + lane] = B[bOffset + (lane * bColumnIncrement)];
+                        }
+                    });
+
+                    // Sweep it across the rows of A
+                    function.For(m, [=](IRFunctionEmitter& function, IRLocalScalar i) {
+                        for (int lane = 0; lane < tileWidth; ++lane)
+                        {
+                            accumulators[lane] = zero;
+                        }
+
+                        auto aOffset = i * aRowIncrement;
+                        function.For(kBlock.size, [=](IRFunctionEmitter& function, IRLocalScalar p) {
+                            IRLocalScalar a = A[aOffset + ((kBlock.begin + p) * aColumnIncrement)];
+                            for (int lane = 0; lane < tileWidth; ++lane)
+                            {
+                                accumulators[lane] = static_cast<IRLocalScalar>(accumulators[lane]) + (a * static_cast<IRLocalScalar>(packedB[(p * tileWidth) + lane]));
+                            }
+                        });
 
-            // Loop orders:
-            // A*B:   i, k, j
-            // A'*B:  k, i, j
-            // A*B':  i, j, k
-            // A'*B': k, j, i (?)
-
-            // Clear output
-            auto count = ldc * m;
-            function.MemorySet<ValueType>(C, function.Literal<int>(0), function.Literal<uint8_t>(0), count);
-
-            // Accumulate partial values into output
-            function.For(m, [A, B, C, lda, ldb, ldc, transposeA, transposeB, n, k](IRFunctionEmitter& function, auto i) {
-                function.For(k, [i, A, B, C, lda, ldb, ldc, transposeA, transposeB, n](IRFunctionEmitter& function, auto k) {
-                    function.For(n, [i, k, A, B, C, lda, ldb, ldc, transposeA, transposeB](IRFunctionEmitter& function, auto j) {
-                        auto aOffset = function.LocalScalar(function.Select(transposeA, (k * lda) + i, (i * lda) + k));
-                        auto bOffset = function.LocalScalar(function.Select(transposeB, (j * ldb) + k, (k * ldb) + j));
                         auto cOffset = (i * ldc) + j;
+                        for (int lane = 0; lane < tileWidth; ++lane)
+                        {
+                            C[cOffset + lane] = static_cast<IRLocalScalar>(C[cOffset + lane]) + (alpha * static_cast<IRLocalScalar>(accumulators[lane]));
+                        }
+                    });
+                });
 
-                        // accumulate product in C[i, j]
-                        C[cOffset] = C[cOffset] + (A[aOffset] * B[bOffset]);
+                // Remaining columns that don't fill a whole tile
+                function.For(numTiledColumns, n, [=](IRFunctionEmitter& function, IRLocalScalar j) {
+                    function.For(m, [=](IRFunctionEmitter& function, IRLocalScalar i) {
+                        accumulators[0] = zero;
+                        function.For(kBlock.size, [=](IRFunctionEmitter& function, IRLocalScalar p) {
+                            auto aOffset = (i * aRowIncrement) + ((kBlock.begin + p) * aColumnIncrement);
+                            auto bOffset = ((kBlock.begin + p) * bRowIncrement) + (j * bColumnIncrement);
+                            accumulators[0] = static_cast<IRLocalScalar>(accumulators[0]) + (static_cast<IRLocalScalar>(A[aOffset]) * static_cast<IRLocalScalar>(B[bOffset]));
+                        });
+
+                        auto cOffset = (i * ldc) + j;
+                        C[cOffset] = static_cast<IRLocalScalar>(C[cOffset]) + (alpha * static_cast<IRLocalScalar>(accumulators[0]));
                     });
                 });
             });
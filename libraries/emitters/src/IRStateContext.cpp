@@ -0,0 +1,282 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     IRStateContext.cpp (emitters)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "IRStateContext.h"
+#include "EmitterException.h"
+#include "IRModuleEmitter.h"
+#include "LLVMUtilities.h"
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/DataLayout.h>
+#include <llvm/IR/DerivedTypes.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/GlobalVariable.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/Instructions.h>
+#include <llvm/IR/Module.h>
+
+#include <map>
+#include <set>
+#include <vector>
+
+namespace ell
+{
+namespace emitters
+{
+    namespace
+    {
+        bool IsMutableGlobal(const llvm::GlobalVariable& global)
+        {
+            return !global.isConstant() && global.hasInitializer() && !global.isThreadLocal() && !global.hasAppendingLinkage() && !global.getName().startswith("llvm.");
+        }
+
+        // Returns the functions that use any of the given globals, along with every function that calls them
+        std::set<llvm::Function*> GetFunctionsUsingGlobals(const std::vector<llvm::GlobalVariable*>& globals)
+        {
+            std::set<llvm::Function*> result;
+            std::vector<llvm::Function*> worklist;
+            auto add = [&](llvm::Function* function) {
+                if (result.insert(function).second)
+                {
+                    worklist.push_back(function);
+                }
+            };
+
+            for (auto global : globals)
+            {
+                for (auto user : global->users())
+                {
+                    add(llvm::cast<llvm::Instruction>(user)->getFunction());
+                }
+            }
+
+            while (!worklist.empty())
+            {
+                auto function = worklist.back();
+                worklist.pop_back();
+                for (auto& use : function->uses())
+                {
+                    auto call = llvm::dyn_cast<llvm::CallInst>(use.getUser());
+                    if (call == nullptr || call->getCalledFunction() != function)
+                    {
+                        throw EmitterException(EmitterError::notSupported, "Function " + function->getName().str() + " uses mutable state and its address is taken, so it can't be given a state context");
+                    }
+                    add(call->getFunction());
+                }
+            }
+            return result;
+        }
+
+        // Recreates `function` with an extra trailing `i8* context` argument, and moves its body to the new function
+        llvm::Function* AppendContextArgument(IRModuleEmitter& moduleEmitter, llvm::Function* function)
+        {
+            auto& llvmContext = function->getContext();
+            auto oldType = function->getFunctionType();
+            std::vector<llvm::Type*> argTypes(oldType->param_begin(), oldType->param_end());
+            argTypes.push_back(llvm::Type::getInt8PtrTy(llvmContext));
+            auto newType = llvm::FunctionType::get(oldType->getReturnType(), argTypes, oldType->isVarArg());
+
+            auto newFunction = llvm::Function::Create(newType, function->getLinkage(), "", function->getParent());
+            newFunction->copyAttributesFrom(function);
+            newFunction->copyMetadata(function, 0);
+            newFunction->takeName(function);
+            newFunction->getBasicBlockList().splice(newFunction->begin(), function->getBasicBlockList());
+
+            auto newArg = newFunction->arg_begin();
+            for (auto& arg : function->args())
+            {
+                newArg->takeName(&arg);
+                arg.replaceAllUsesWith(&*newArg);
+                ++newArg;
+            }
+            newArg->setName("context");
+
+            // keep the header declaration in sync with the new signature
+            auto& declaration = moduleEmitter.GetFunctionDeclaration(newFunction->getName().str());
+            if (declaration.GetFunctionName() == newFunction->getName().str() && declaration.GetArguments().size() == oldType->getNumParams())
+            {
+                declaration.AddArgument({ "context", VariableType::VoidPointer });
+            }
+            return newFunction;
+        }
+
+        void EmitAllocateContextFunction(IRModuleEmitter& moduleEmitter, llvm::StructType* contextType, const std::vector<llvm::GlobalVariable*>& globals)
+        {
+            auto functionName = GetAllocateContextFunctionName(moduleEmitter.GetModuleName());
+            auto& dataLayout = moduleEmitter.GetTargetDataLayout();
+            auto bytePointerType = llvm::Type::getInt8PtrTy(moduleEmitter.GetLLVMContext());
+
+            moduleEmitter.GetFunctionDeclaration(functionName) = FunctionDeclaration(functionName, VariableType::VoidPointer);
+            auto& function = moduleEmitter.BeginFunction(functionName, bytePointerType, NamedVariableTypeList{});
+            function.IncludeInHeader();
+            auto& emitter = function.GetEmitter();
+
+            auto contextSize = static_cast<int64_t>(dataLayout.getTypeAllocSize(contextType));
+            auto context = function.Malloc(contextType->getPointerTo(), function.Literal<int64_t>(contextSize));
+            emitter.MemorySet(context, emitter.Zero(VariableType::Byte), function.Literal<int64_t>(contextSize));
+            for (size_t index = 0; index < globals.size(); ++index)
+            {
+                auto global = globals[index];
+                if (!global->getInitializer()->isNullValue())
+                {
+                    auto fieldSize = static_cast<int64_t>(dataLayout.getTypeAllocSize(global->getValueType()));
+                    emitter.MemoryCopy(global, emitter.GetStructFieldPointer(context, index), function.Literal<int64_t>(fieldSize));
+                }
+            }
+            moduleEmitter.EndFunction(function.CastPointer(context, bytePointerType));
+        }
+
+        void EmitFreeContextFunction(IRModuleEmitter& moduleEmitter)
+        {
+            auto functionName = GetFreeContextFunctionName(moduleEmitter.GetModuleName());
+            auto& function = moduleEmitter.BeginFunction(functionName, VariableType::Void, NamedVariableTypeList{ { "context", VariableType::VoidPointer } });
+            function.IncludeInHeader();
+            function.Free(function.GetFunctionArgument("context"));
+            moduleEmitter.EndFunction();
+        }
+    } // namespace
+
+    std::string GetAllocateContextFunctionName(const std::string& moduleName)
+    {
+        return moduleName + "_AllocateContext";
+    }
+
+    std::string GetFreeContextFunctionName(const std::string& moduleName)
+    {
+        return moduleName + "_FreeContext";
+    }
+
+    bool HasStateContext(IRModuleEmitter& moduleEmitter)
+    {
+        return moduleEmitter.HasFunction(GetAllocateContextFunctionName(moduleEmitter.GetModuleName()));
+    }
+
+    void MoveGlobalStateToContext(IRModuleEmitter& moduleEmitter, const std::vector<std::string>& entryPointNames)
+    {
+        auto module = moduleEmitter.GetLLVMModule();
+        auto& llvmContext = moduleEmitter.GetLLVMContext();
+
+        std::vector<llvm::GlobalVariable*> globals;
+        for (auto& global : module->globals())
+        {
+            if (IsMutableGlobal(global))
+            {
+                globals.push_back(&global);
+            }
+        }
+
+        for (auto global : globals)
+        {
+            ExpandConstantExpressionUses(global);
+        }
+
+        // The entry points already receive the context as their first argument, the other functions get it appended
+        std::map<llvm::Function*, llvm::Value*> contextArguments;
+        for (const auto& name : entryPointNames)
+        {
+            auto function = moduleEmitter.GetFunction(name);
+            if (function == nullptr || function->arg_empty() || !function->arg_begin()->getType()->isPointerTy())
+            {
+                throw EmitterException(EmitterError::badFunctionDefinition, "Entry point " + name + " must take a context pointer as its first argument");
+            }
+            contextArguments[function] = &*function->arg_begin();
+        }
+
+        std::map<llvm::Function*, llvm::Function*> replacedFunctions;
+        for (auto function : GetFunctionsUsingGlobals(globals))
+        {
+            if (contextArguments.find(function) == contextArguments.end())
+            {
+                auto newFunction = AppendContextArgument(moduleEmitter, function);
+                contextArguments[newFunction] = &*(newFunction->arg_end() - 1);
+                replacedFunctions[function] = newFunction;
+            }
+        }
+
+        // Every caller of a replaced function is itself in the set, so it has a context to pass along
+        for (const auto& replaced : replacedFunctions)
+        {
+            auto oldFunction = replaced.first;
+            auto newFunction = replaced.second;
+            std::vector<llvm::CallInst*> calls;
+            for (auto user : oldFunction->users())
+            {
+                calls.push_back(llvm::cast<llvm::CallInst>(user));
+            }
+            for (auto call : calls)
+            {
+                std::vector<llvm::Value*> args(call->arg_begin(), call->arg_end());
+                args.push_back(contextArguments.at(call->getFunction()));
+                auto newCall = llvm::CallInst::Create(newFunction, args, "", call);
+                newCall->setCallingConv(call->getCallingConv());
+                newCall->setAttributes(call->getAttributes());
+                newCall->setTailCallKind(call->getTailCallKind());
+                newCall->setDebugLoc(call->getDebugLoc());
+                newCall->takeName(call);
+                call->replaceAllUsesWith(newCall);
+                call->eraseFromParent();
+            }
+            oldFunction->eraseFromParent();
+        }
+
+        // Lay the globals out in a struct, and address each one through the context in the functions that use it
+        std::vector<llvm::Type*> fieldTypes;
+        for (auto global : globals)
+        {
+            fieldTypes.push_back(global->getValueType());
+        }
+        auto contextType = llvm::StructType::create(llvmContext, fieldTypes, moduleEmitter.GetModuleName() + "_StateContext");
+
+        std::map<llvm::Function*, llvm::Value*> contextPointers;
+        for (size_t index = 0; index < globals.size(); ++index)
+        {
+            auto global = globals[index];
+            std::map<llvm::Function*, llvm::Value*> fieldPointers;
+            std::vector<llvm::Use*> uses;
+            for (auto& use : global->uses())
+            {
+                uses.push_back(&use);
+            }
+            for (auto use : uses)
+            {
+                auto function = llvm::cast<llvm::Instruction>(use->getUser())->getFunction();
+                auto& fieldPointer = fieldPointers[function];
+                if (fieldPointer == nullptr)
+                {
+                    auto& entryBlock = function->getEntryBlock();
+                    auto& contextPointer = contextPointers[function];
+                    if (contextPointer == nullptr)
+                    {
+                        llvm::IRBuilder<> builder(&entryBlock, entryBlock.getFirstInsertionPt());
+                        contextPointer = builder.CreateBitCast(contextArguments.at(function), contextType->getPointerTo(), "stateContext");
+                    }
+                    llvm::IRBuilder<> builder(llvm::cast<llvm::Instruction>(contextPointer)->getNextNode());
+                    fieldPointer = builder.CreateStructGEP(contextType, contextPointer, static_cast<unsigned>(index), global->getName());
+                }
+                use->set(fieldPointer);
+            }
+        }
+
+        // The initial values live on as read-only templates that AllocateContext copies from
+        EmitAllocateContextFunction(moduleEmitter, contextType, globals);
+        EmitFreeContextFunction(moduleEmitter);
+
+        for (auto global : globals)
+        {
+            if (global->getInitializer()->isNullValue())
+            {
+                global->eraseFromParent();
+            }
+            else
+            {
+                global->setConstant(true);
+            }
+        }
+    }
+} // namespace emitters
+} // namespace ell
@@ -10,6 +10,7 @@
 #include "EmitterException.h"
 #include "IRHeaderWriter.h"
 #include "IRMetadata.h"
+#include "IRStateContext.h"
 
 #include <utilities/include/StringUtil.h>
 
@@ -37,6 +38,7 @@ namespace emitters
                 _function(&predictFunction)
             {
                 _moduleName = moduleEmitter.GetModuleName();
+                _hasStateContext = HasStateContext(moduleEmitter);
                 InitPredictFunctionInfo(moduleEmitter);
             }
 
@@ -50,7 +52,8 @@ namespace emitters
                 );
                 // clang-format on
 
-                auto resetFunctionName = _moduleName + "_Reset";
+                // the reset function of a re-entrant module needs the state context owned by the wrapper
+                auto resetBody = _hasStateContext ? "if _model_wrapper is not None:\n        _model_wrapper.Reset()" : _moduleName + "_Reset()";
                 std::string predictMethodName = TrimPrefix(_functionName, _moduleName + "_");
                 predictMethodName[0] = ::toupper(predictMethodName[0]); // pascal case
 
@@ -62,7 +65,7 @@ namespace emitters
                 ReplaceDelimiter(predictPythonCode, "WRAPPER_CLASS", className);
                 ReplaceDelimiter(predictPythonCode, "PREDICT_METHOD", predictMethodName);
                 ReplaceDelimiter(predictPythonCode, "INPUT_VECTOR_TYPE", inputVectorType);
-                ReplaceDelimiter(predictPythonCode, "RESET_FUNCTION", resetFunctionName);
+                ReplaceDelimiter(predictPythonCode, "RESET_BODY", resetBody);
 
                 os << "%pythoncode %{\n"
                    << predictPythonCode
@@ -115,6 +118,7 @@ namespace emitters
             std::string _functionName;
             std::string _inputType;
             bool _inputIsScalar;
+            bool _hasStateContext;
             LLVMFunction _function;
         };
 
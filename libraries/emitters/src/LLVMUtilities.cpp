@@ -9,10 +9,14 @@
 #include "LLVMUtilities.h"
 #include "EmitterException.h"
 
+#include <llvm/IR/Constants.h>
 #include <llvm/IR/Type.h>
 #include <llvm/IR/DerivedTypes.h>
+#include <llvm/IR/Instructions.h>
 #include <llvm/IR/Value.h>
 
+#include <vector>
+
 namespace ell
 {
 namespace emitters
@@ -62,5 +66,46 @@ namespace emitters
 
         throw EmitterException(EmitterError::valueTypeNotSupported);
     }
+
+    void ExpandConstantExpressionUses(llvm::Constant* constant)
+    {
+        constant->removeDeadConstantUsers();
+        std::vector<llvm::User*> users(constant->user_begin(), constant->user_end());
+        for (auto user : users)
+        {
+            if (llvm::isa<llvm::Instruction>(user))
+            {
+                continue;
+            }
+
+            auto expression = llvm::dyn_cast<llvm::ConstantExpr>(user);
+            if (expression == nullptr)
+            {
+                throw EmitterException(EmitterError::notSupported, "Globals used in the initializer of another global can't be accessed through instructions");
+            }
+
+            // expand the outer expressions first, so the users of this one are all instructions
+            ExpandConstantExpressionUses(expression);
+
+            std::vector<llvm::Use*> uses;
+            for (auto& use : expression->uses())
+            {
+                uses.push_back(&use);
+            }
+            for (auto use : uses)
+            {
+                auto instruction = llvm::cast<llvm::Instruction>(use->getUser());
+                auto insertBefore = instruction;
+                if (auto phi = llvm::dyn_cast<llvm::PHINode>(instruction))
+                {
+                    insertBefore = phi->getIncomingBlock(*use)->getTerminator();
+                }
+                auto expanded = expression->getAsInstruction();
+                expanded->insertBefore(insertBefore);
+                use->set(expanded);
+            }
+            expression->destroyConstant();
+        }
+    }
 } // namespace emitters
 } // namespace ell
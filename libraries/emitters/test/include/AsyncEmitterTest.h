@@ -7,8 +7,10 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include <emitters/include/CompilerOptions.h>
+
 void TestIRAsyncTask(bool parallel);
 
 void TestParallelTasks(bool parallel, bool useThreadPool);
 
-void TestParallelFor(int start, int end, int increment, bool parallel);
+void TestParallelFor(int start, int end, int increment, bool parallel, ell::emitters::ParallelLoopSchedule schedule = ell::emitters::ParallelLoopSchedule::fixedBlocks);
@@ -212,13 +212,14 @@ void TestParallelTasks(bool parallel, bool useThreadPool)
 //
 // TestParallelFor
 //
-void TestParallelFor(int begin, int end, int increment, bool parallel)
+void TestParallelFor(int begin, int end, int increment, bool parallel, ParallelLoopSchedule schedule)
 {
     CompilerOptions options;
     options.optimize = false;
     options.targetDevice.deviceName = "host";
     options.parallelize = parallel;
     options.useThreadPool = true;
+    options.parallelLoopSchedule = schedule;
     IRModuleEmitter module("ParallelForTest", options);
 
     // Function to run test
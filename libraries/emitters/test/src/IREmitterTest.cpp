@@ -22,6 +22,7 @@
 #include <utilities/include/Unused.h>
 #include <utilities/include/StringUtil.h>
 
+#include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/TypeBuilder.h>
 
 #include <functional>
@@ -1160,3 +1161,40 @@ void TestCastToConditionalBool()
     TestCastToConditionalBool<float>();
     TestCastToConditionalBool<double>();
 }
+
+void TestLazyCompilation()
+{
+    auto module = MakeHostModuleEmitter("LazyCompilation");
+    auto int32Type = GetVariableType<int32_t>();
+
+    // this function can't be linked, since nothing defines the function it calls, so it must never be compiled
+    auto undefinedFunction = module.DeclareFunction("LazyCompilation_Undefined", int32Type);
+    auto unreachableFunction = module.BeginFunction("LazyCompilation_Unreachable", int32Type);
+    unreachableFunction.Return(unreachableFunction.Call(undefinedFunction, {}));
+    module.EndFunction();
+
+    auto addOneFunction = module.BeginFunction("LazyCompilation_AddOne", int32Type, NamedVariableTypeList{ { "x", int32Type } });
+    addOneFunction.Return(addOneFunction.Operator(TypedOperator::add, addOneFunction.GetFunctionArgument("x"), addOneFunction.Literal<int>(1)));
+    module.EndFunction();
+
+    IRExecutionEngine jit(std::move(module));
+    jit.SetLazyCompilation(true);
+    auto addOne = jit.GetFunction<int32_t(int32_t)>("LazyCompilation_AddOne");
+    testing::ProcessTest("Testing lazy compilation skips the functions that aren't needed", addOne(1) == 2);
+
+    // a module added to the engine links with the functions of the primary one, and can be removed again
+    auto& context = jit.GetLLVMContext();
+    auto addedModule = std::make_unique<llvm::Module>("LazyCompilation_Added", context);
+    auto functionType = llvm::FunctionType::get(llvm::Type::getInt32Ty(context), { llvm::Type::getInt32Ty(context) }, false);
+    auto addOneDeclaration = llvm::Function::Create(functionType, llvm::Function::ExternalLinkage, "LazyCompilation_AddOne", addedModule.get());
+    auto addTwoFunction = llvm::Function::Create(functionType, llvm::Function::ExternalLinkage, "LazyCompilation_AddTwo", addedModule.get());
+    llvm::IRBuilder<> builder(llvm::BasicBlock::Create(context, "entry", addTwoFunction));
+    builder.CreateRet(builder.CreateCall(addOneDeclaration, { builder.CreateCall(addOneDeclaration, { &*addTwoFunction->arg_begin() }) }));
+
+    auto handle = jit.AddModule(std::move(addedModule));
+    auto addTwo = jit.GetFunction<int32_t(int32_t)>("LazyCompilation_AddTwo");
+    testing::ProcessTest("Testing module added to the execution engine", addTwo(1) == 3);
+
+    jit.RemoveModule(handle);
+    testing::ProcessTest("Testing module removed from the execution engine", jit.GetFunctionAddress("LazyCompilation_AddTwo") == 0);
+}
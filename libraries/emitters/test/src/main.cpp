@@ -53,6 +53,8 @@ void TestIR()
 
     TestCastValue();
     TestCastToConditionalBool();
+
+    TestLazyCompilation();
 }
 
 void TestIRFunction()
@@ -83,6 +85,10 @@ void TestAsyncEmitter()
     TestParallelFor(10, 90, 2, true);
     TestParallelFor(10, 90, 3, true);
     TestParallelFor(30, 40, 11, true);
+    TestParallelFor(0, 100, 1, true, emitters::ParallelLoopSchedule::dynamicChunks);
+    TestParallelFor(0, 100, 2, true, emitters::ParallelLoopSchedule::dynamicChunks);
+    TestParallelFor(10, 90, 3, true, emitters::ParallelLoopSchedule::dynamicChunks);
+    TestParallelFor(30, 40, 11, true, emitters::ParallelLoopSchedule::dynamicChunks);
 }
 
 void TestPosixEmitter()
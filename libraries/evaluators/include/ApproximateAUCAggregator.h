@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ApproximateAUCAggregator.h (evaluators)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ell
+{
+namespace evaluators
+{
+    /// <summary>
+    /// An evaluation aggregator that approximates AUC with a fixed number of histogram bins. Unlike AUCAggregator,
+    /// it uses constant memory, does not sort, and can be merged cheaply. Predictions are mapped monotonically to
+    /// (0, 1) before binning, and pairs of examples that fall in the same bin are counted as misordered, so the
+    /// result is a lower bound on the exact (pessimistic) AUC.
+    /// </summary>
+    class ApproximateAUCAggregator
+    {
+    public:
+        /// <summary> Constructs an ApproximateAUCAggregator. </summary>
+        ///
+        /// <param name="numBins"> The number of histogram bins. </param>
+        ApproximateAUCAggregator(size_t numBins = 4096);
+
+        /// <summary> Updates this aggregator. </summary>
+        ///
+        /// <param name="prediction"> The real valued prediction. </param>
+        /// <param name="label"> The label. </param>
+        /// <param name="weight"> The weight. </param>
+        void Update(double prediction, double label, double weight);
+
+        /// <summary> Returns the current value. </summary>
+        ///
+        /// <returns> The current value. </returns>
+        std::vector<double> GetResult() const;
+
+        /// <summary> Gets the goodness of a result of this aggregator. Higher values are better. </summary>
+        ///
+        /// <param name="result"> A result returned by GetResult. </param>
+        ///
+        /// <returns> The goodness. </returns>
+        double GetGoodness(const std::vector<double>& result) const;
+
+        /// <summary> Resets the aggregator to its initial state. </summary>
+        void Reset();
+
+        /// <summary> Adds the examples seen by another aggregator to this one. </summary>
+        ///
+        /// <param name="other"> The other aggregator, which must have the same number of bins. </param>
+        void Merge(const ApproximateAUCAggregator& other);
+
+        /// <summary> Gets a header that describes the values of this aggregator. </summary>
+        ///
+        /// <returns> The header string vector. </returns>
+        std::vector<std::string> GetValueNames() const;
+
+    private:
+        size_t GetBin(double prediction) const;
+
+        std::vector<double> _positiveWeights;
+        std::vector<double> _negativeWeights;
+    };
+} // namespace evaluators
+} // namespace ell
@@ -31,9 +31,21 @@ namespace evaluators
         /// <returns> The current value. </returns>
         std::vector<double> GetResult() const;
 
+        /// <summary> Gets the goodness of a result of this aggregator. Higher values are better. </summary>
+        ///
+        /// <param name="result"> A result returned by GetResult. </param>
+        ///
+        /// <returns> The goodness. </returns>
+        double GetGoodness(const std::vector<double>& result) const;
+
         /// <summary> Resets the aggregator to its initial state. </summary>
         void Reset();
 
+        /// <summary> Adds the examples seen by another aggregator to this one. </summary>
+        ///
+        /// <param name="other"> The other aggregator. </param>
+        void Merge(const BinaryErrorAggregator& other);
+
         /// <summary> Gets a header that describes the values of this aggregator. </summary>
         ///
         /// <returns> The header string vector. </returns>
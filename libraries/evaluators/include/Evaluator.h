@@ -14,6 +14,7 @@
 #include <data/include/Example.h>
 
 #include <utilities/include/FunctionUtils.h>
+#include <utilities/include/ThreadPool.h>
 
 #include <functional>
 #include <memory>
@@ -38,7 +39,7 @@ namespace evaluators
         /// <param name="predictor"> The predictor. </param>
         virtual void Evaluate(const PredictorType& predictor) = 0;
 
-        /// <summary> Gets the goodness of the most recent evaluation, according to the first aggregator. </summary>
+        /// <summary> Gets the goodness of the most recent evaluation, according to the first aggregator. Higher values are better. </summary>
         ///
         /// <returns> The goodness of the most recent evaluation. </returns>
         virtual double GetGoodness() const = 0;
@@ -54,6 +55,10 @@ namespace evaluators
     {
         size_t evaluationFrequency;
         bool addZeroEvaluation;
+
+        /// <summary> The number of threads that evaluate the examples. Each thread updates its own copy of the
+        /// aggregators, and the copies are merged in a fixed order. '0' means one thread per hardware thread. </summary>
+        size_t numThreads = 1;
     };
 
     /// <summary> Implements an evaluator that holds a data set and a set of evaluation aggregators. </summary>
@@ -78,7 +83,7 @@ namespace evaluators
         /// <param name="predictor"> The predictor. </param>
         void Evaluate(const PredictorType& predictor) override;
 
-        /// <summary> Gets the goodness of the most recent evaluation, according to the first aggregator. </summary>
+        /// <summary> Gets the goodness of the most recent evaluation, according to the first aggregator. Higher values are better. </summary>
         ///
         /// <returns> The goodness of the most recent evaluation. </returns>
         double GetGoodness() const override;
@@ -105,6 +110,16 @@ namespace evaluators
         template <size_t Index>
         using AggregatorType = typename std::tuple_element<Index, std::tuple<AggregatorTypes...>>::type;
 
+        using AggregatorTupleType = std::tuple<AggregatorTypes...>;
+
+        // calls function(blockIndex, begin, end) on contiguous blocks of example indices, one block per thread
+        template <typename BlockFunctionType>
+        void ForEachExampleBlock(BlockFunctionType function);
+
+        // updates the aggregators with getPrediction(exampleIndex, example) for each example in the dataset
+        template <typename PredictionFunctionType>
+        void UpdateAggregators(PredictionFunctionType getPrediction);
+
         struct ElementUpdaterParameters
         {
             double prediction;
@@ -137,13 +152,16 @@ namespace evaluators
         };
 
         template <std::size_t Index>
-        auto GetElementUpdateFunction(const ElementUpdaterParameters& params) -> ElementUpdater<AggregatorType<Index>>;
+        auto GetElementUpdateFunction(AggregatorTupleType& aggregators, const ElementUpdaterParameters& params) -> ElementUpdater<AggregatorType<Index>>;
 
         template <std::size_t Index>
         auto GetElementResetFunction() -> ElementResetter<AggregatorType<Index>>;
 
         template <std::size_t... Sequence>
-        void DispatchUpdate(double prediction, double label, double weight, std::index_sequence<Sequence...>);
+        void DispatchUpdate(AggregatorTupleType& aggregators, double prediction, double label, double weight, std::index_sequence<Sequence...>);
+
+        template <std::size_t... Sequence>
+        void DispatchMerge(AggregatorTupleType& aggregators, const AggregatorTupleType& otherAggregators, std::index_sequence<Sequence...>);
 
         template <std::size_t... Sequence>
         void Aggregate(std::index_sequence<Sequence...>);
@@ -160,6 +178,7 @@ namespace evaluators
         size_t _evaluateCounter = 0;
         typename std::tuple<AggregatorTypes...> _aggregatorTuple;
         std::vector<std::vector<std::vector<double>>> _values;
+        std::unique_ptr<utilities::ThreadPool> _threadPool;
     };
 
     /// <summary> Makes an evaluator. </summary>
@@ -177,6 +196,8 @@ namespace evaluators
 
 #pragma region implementation
 
+#include <algorithm>
+
 namespace ell
 {
 namespace evaluators
@@ -189,6 +210,11 @@ namespace evaluators
     {
         static_assert(sizeof...(AggregatorTypes) > 0, "Evaluator must contains at least one aggregator");
 
+        if (_evaluatorParameters.numThreads != 1)
+        {
+            _threadPool = std::make_unique<utilities::ThreadPool>(_evaluatorParameters.numThreads);
+        }
+
         if (_evaluatorParameters.addZeroEvaluation)
         {
             EvaluateZero();
@@ -204,19 +230,9 @@ namespace evaluators
             return;
         }
 
-        auto iterator = _dataset.GetExampleReferenceIterator();
-
-        while (iterator.IsValid())
-        {
-            const auto& example = iterator.Get();
-
-            double weight = example.GetMetadata().weight;
-            double label = example.GetMetadata().label;
-            double prediction = predictor.Predict(example.GetDataVector());
-
-            DispatchUpdate(prediction, label, weight, std::make_index_sequence<sizeof...(AggregatorTypes)>());
-            iterator.Next();
-        }
+        UpdateAggregators([&predictor](size_t, const ExampleType& example) {
+            return predictor.Predict(example.GetDataVector());
+        });
         Aggregate(std::make_index_sequence<sizeof...(AggregatorTypes)>());
     }
 
@@ -227,7 +243,7 @@ namespace evaluators
         {
             return 0.0;
         }
-        return _values.back()[0][0];
+        return std::get<0>(_aggregatorTuple).GetGoodness(_values.back()[0]);
     }
 
     template <typename T>
@@ -277,19 +293,59 @@ namespace evaluators
     template <typename PredictorType, typename... AggregatorTypes>
     void Evaluator<PredictorType, AggregatorTypes...>::EvaluateZero()
     {
-        auto iterator = _dataset.GetExampleIterator();
+        UpdateAggregators([](size_t, const ExampleType&) { return 0.0; });
+        Aggregate(std::make_index_sequence<sizeof...(AggregatorTypes)>());
+    }
+
+    template <typename PredictorType, typename... AggregatorTypes>
+    template <typename BlockFunctionType>
+    void Evaluator<PredictorType, AggregatorTypes...>::ForEachExampleBlock(BlockFunctionType function)
+    {
+        auto numExamples = _dataset.NumExamples();
+        if (_threadPool == nullptr || numExamples < 2)
+        {
+            function(0, 0, numExamples);
+            return;
+        }
+
+        auto numBlocks = std::min(_threadPool->NumThreads(), numExamples);
+        _threadPool->ParallelFor(numBlocks, [&](size_t block) {
+            function(block, block * numExamples / numBlocks, (block + 1) * numExamples / numBlocks);
+        });
+    }
+
+    template <typename PredictorType, typename... AggregatorTypes>
+    template <typename PredictionFunctionType>
+    void Evaluator<PredictorType, AggregatorTypes...>::UpdateAggregators(PredictionFunctionType getPrediction)
+    {
+        auto updateBlock = [&](AggregatorTupleType& aggregators, size_t begin, size_t end) {
+            for (size_t index = begin; index < end; ++index)
+            {
+                const auto& example = _dataset[index];
+                double weight = example.GetMetadata().weight;
+                double label = example.GetMetadata().label;
+                double prediction = getPrediction(index, example);
+                DispatchUpdate(aggregators, prediction, label, weight, std::make_index_sequence<sizeof...(AggregatorTypes)>());
+            }
+        };
 
-        while (iterator.IsValid())
+        if (_threadPool == nullptr)
         {
-            const auto& example = iterator.Get();
+            updateBlock(_aggregatorTuple, 0, _dataset.NumExamples());
+            return;
+        }
 
-            double weight = example.GetMetadata().weight;
-            double label = example.GetMetadata().label;
+        // each block updates a copy of the (reset) aggregators, and the copies are merged in block order, so the
+        // result does not depend on how the threads are scheduled
+        std::vector<AggregatorTupleType> blockAggregators(_threadPool->NumThreads(), _aggregatorTuple);
+        ForEachExampleBlock([&](size_t block, size_t begin, size_t end) {
+            updateBlock(blockAggregators[block], begin, end);
+        });
 
-            DispatchUpdate(0.0, label, weight, std::make_index_sequence<sizeof...(AggregatorTypes)>());
-            iterator.Next();
+        for (const auto& aggregators : blockAggregators)
+        {
+            DispatchMerge(_aggregatorTuple, aggregators, std::make_index_sequence<sizeof...(AggregatorTypes)>());
         }
-        Aggregate(std::make_index_sequence<sizeof...(AggregatorTypes)>());
     }
 
     template <typename PredictorType, typename... AggregatorTypes>
@@ -323,9 +379,9 @@ namespace evaluators
 
     template <typename PredictorType, typename... AggregatorTypes>
     template <std::size_t Index>
-    auto Evaluator<PredictorType, AggregatorTypes...>::GetElementUpdateFunction(const ElementUpdaterParameters& params) -> ElementUpdater<AggregatorType<Index>>
+    auto Evaluator<PredictorType, AggregatorTypes...>::GetElementUpdateFunction(AggregatorTupleType& aggregators, const ElementUpdaterParameters& params) -> ElementUpdater<AggregatorType<Index>>
     {
-        return { std::get<Index>(_aggregatorTuple), params };
+        return { std::get<Index>(aggregators), params };
     }
 
     template <typename PredictorType, typename... AggregatorTypes>
@@ -337,14 +393,22 @@ namespace evaluators
 
     template <typename PredictorType, typename... AggregatorTypes>
     template <std::size_t... Sequence>
-    void Evaluator<PredictorType, AggregatorTypes...>::DispatchUpdate(double prediction, double label, double weight, std::index_sequence<Sequence...>)
+    void Evaluator<PredictorType, AggregatorTypes...>::DispatchUpdate(AggregatorTupleType& aggregators, double prediction, double label, double weight, std::index_sequence<Sequence...>)
     {
-        // Call (X.Update(), 0) for each X in _aggregatorTuple
+        // Call (X.Update(), 0) for each X in aggregators
         ElementUpdaterParameters params{ prediction, label, weight };
-        utilities::InOrderFunctionEvaluator(GetElementUpdateFunction<Sequence>(params)...);
+        utilities::InOrderFunctionEvaluator(GetElementUpdateFunction<Sequence>(aggregators, params)...);
         // [this, prediction, label, weight]() { std::get<Sequence>(_aggregatorTuple).Update(prediction, label, weight); }...); // GCC bug prevents compilation
     }
 
+    template <typename PredictorType, typename... AggregatorTypes>
+    template <std::size_t... Sequence>
+    void Evaluator<PredictorType, AggregatorTypes...>::DispatchMerge(AggregatorTupleType& aggregators, const AggregatorTupleType& otherAggregators, std::index_sequence<Sequence...>)
+    {
+        // Call X.Merge(Y) for each X in aggregators and the corresponding Y in otherAggregators
+        (std::get<Sequence>(aggregators).Merge(std::get<Sequence>(otherAggregators)), ...);
+    }
+
     template <typename PredictorType, typename... AggregatorTypes>
     template <std::size_t... Sequence>
     void Evaluator<PredictorType, AggregatorTypes...>::Aggregate(std::index_sequence<Sequence...>)
@@ -36,7 +36,7 @@ namespace evaluators
         /// <param name="evaluationRescale"> A rescaling coefficient applied to the current predictions of the entire ensemble, but not recorded in the evaluator. </param>
         virtual void IncrementalEvaluate(const BasePredictorType& basePredictor, double basePredictorWeight = 1.0, double evaluationRescale = 1.0) = 0;
 
-        /// <summary> Gets the goodness of the most recent evaluation, according to the first aggregator. </summary>
+        /// <summary> Gets the goodness of the most recent evaluation, according to the first aggregator. Higher values are better. </summary>
         ///
         /// <returns> The goodness of the most recent evaluation. </returns>
         virtual double GetGoodness() const = 0;
@@ -71,7 +71,7 @@ namespace evaluators
         /// <param name="evaluationRescale"> A rescaling coefficient applied to the current predictions of the entire ensemble, but not recorded in the evaluator. </param>
         void IncrementalEvaluate(const BasePredictorType& basePredictor, double basePredictorWeight = 1.0, double evaluationRescale = 1.0) override;
 
-        /// <summary> Gets the goodness of the most recent evaluation, according to the first aggregator. </summary>
+        /// <summary> Gets the goodness of the most recent evaluation, according to the first aggregator. Higher values are better. </summary>
         ///
         /// <returns> The goodness of the most recent evaluation. </returns>
         double GetGoodness() const override;
@@ -117,29 +117,26 @@ namespace evaluators
         ++BaseClassType::_evaluateCounter;
         bool evaluate = BaseClassType::_evaluateCounter % BaseClassType::_evaluatorParameters.evaluationFrequency == 0 ? true : false;
 
-        auto iterator = BaseClassType::_dataset.GetExampleIterator();
-        size_t index = 0;
-
-        while (iterator.IsValid())
-        {
-            const auto& example = iterator.Get();
-
-            double exampleWeight = example.GetMetadata().weight;
-            double label = example.GetMetadata().label;
+        // each example's cached prediction is only touched by the thread that owns its block
+        auto updatePrediction = [&](size_t index, const typename BaseClassType::ExampleType& example) {
             _predictions[index] += basePredictorWeight * basePredictor.Predict(example.GetDataVector());
+            return _predictions[index] * evaluationRescale;
+        };
 
-            if (evaluate)
-            {
-                BaseClassType::DispatchUpdate(_predictions[index] * evaluationRescale, label, exampleWeight, std::make_index_sequence<sizeof...(AggregatorTypes)>());
-            }
-
-            iterator.Next();
-            ++index;
-        }
         if (evaluate)
         {
+            BaseClassType::UpdateAggregators(updatePrediction);
             BaseClassType::Aggregate(std::make_index_sequence<sizeof...(AggregatorTypes)>());
         }
+        else
+        {
+            BaseClassType::ForEachExampleBlock([&](size_t, size_t begin, size_t end) {
+                for (size_t index = begin; index < end; ++index)
+                {
+                    updatePrediction(index, BaseClassType::_dataset[index]);
+                }
+            });
+        }
     }
 
     template <typename BasePredictorType, typename... AggregatorTypes>
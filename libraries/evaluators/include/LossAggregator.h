@@ -39,9 +39,21 @@ namespace evaluators
         /// <returns> The current value. </returns>
         std::vector<double> GetResult() const;
 
+        /// <summary> Gets the goodness of a result of this aggregator. Higher values are better. </summary>
+        ///
+        /// <param name="result"> A result returned by GetResult. </param>
+        ///
+        /// <returns> The goodness. </returns>
+        double GetGoodness(const std::vector<double>& result) const;
+
         /// <summary> Resets the aggregator to its initial state. </summary>
         void Reset();
 
+        /// <summary> Adds the examples seen by another aggregator to this one. </summary>
+        ///
+        /// <param name="other"> The other aggregator. </param>
+        void Merge(const LossAggregator<LossFunctionType>& other);
+
         /// <summary> Gets a header that describes the values of this aggregator. </summary>
         ///
         /// <returns> The header string vector. </returns>
@@ -85,6 +97,12 @@ namespace evaluators
         return { meanLoss };
     }
 
+    template <typename LossFunctionType>
+    double LossAggregator<LossFunctionType>::GetGoodness(const std::vector<double>& result) const
+    {
+        return -result[0];
+    }
+
     template <typename LossFunctionType>
     void LossAggregator<LossFunctionType>::Reset()
     {
@@ -92,6 +110,13 @@ namespace evaluators
         _sumWeightedLosses = 0.0;
     }
 
+    template <typename LossFunctionType>
+    void LossAggregator<LossFunctionType>::Merge(const LossAggregator<LossFunctionType>& other)
+    {
+        _sumWeights += other._sumWeights;
+        _sumWeightedLosses += other._sumWeightedLosses;
+    }
+
     template <typename LossFunctionType>
     std::vector<std::string> LossAggregator<LossFunctionType>::GetValueNames() const
     {
@@ -54,11 +54,21 @@ namespace evaluators
         return { auc };
     }
 
+    double AUCAggregator::GetGoodness(const std::vector<double>& result) const
+    {
+        return result[0];
+    }
+
     void AUCAggregator::Reset()
     {
         _aggregates.resize(0);
     }
 
+    void AUCAggregator::Merge(const AUCAggregator& other)
+    {
+        _aggregates.insert(_aggregates.end(), other._aggregates.begin(), other._aggregates.end());
+    }
+
     bool AUCAggregator::Aggregate::operator<(const Aggregate& other) const
     {
         // order by prediction (ascending) and then by label (descending) - this will produce the most pessimistic AUC
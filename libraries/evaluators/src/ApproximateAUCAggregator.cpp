@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ApproximateAUCAggregator.cpp (evaluators)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ApproximateAUCAggregator.h"
+
+#include <utilities/include/Exception.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace ell
+{
+namespace evaluators
+{
+    ApproximateAUCAggregator::ApproximateAUCAggregator(size_t numBins) :
+        _positiveWeights(numBins),
+        _negativeWeights(numBins)
+    {
+        if (numBins == 0)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "ApproximateAUCAggregator requires at least one bin");
+        }
+    }
+
+    void ApproximateAUCAggregator::Update(double prediction, double label, double weight)
+    {
+        auto bin = GetBin(prediction);
+        if (label <= 0)
+        {
+            _negativeWeights[bin] += weight;
+        }
+        else
+        {
+            _positiveWeights[bin] += weight;
+        }
+    }
+
+    std::vector<double> ApproximateAUCAggregator::GetResult() const
+    {
+        // same as AUCAggregator, except that a positive is only ordered after the negatives in lower bins
+        double sumPositiveWeights = 0.0;
+        double sumNegativeWeights = 0.0;
+        double sumOrderedWeights = 0.0;
+
+        for (size_t bin = 0; bin < _positiveWeights.size(); ++bin)
+        {
+            sumOrderedWeights += sumNegativeWeights * _positiveWeights[bin];
+            sumPositiveWeights += _positiveWeights[bin];
+            sumNegativeWeights += _negativeWeights[bin];
+        }
+
+        double auc = 0.0;
+        if (sumPositiveWeights > 0 && sumNegativeWeights > 0)
+        {
+            auc = sumOrderedWeights / sumPositiveWeights / sumNegativeWeights;
+        }
+
+        return { auc };
+    }
+
+    double ApproximateAUCAggregator::GetGoodness(const std::vector<double>& result) const
+    {
+        return result[0];
+    }
+
+    void ApproximateAUCAggregator::Reset()
+    {
+        std::fill(_positiveWeights.begin(), _positiveWeights.end(), 0.0);
+        std::fill(_negativeWeights.begin(), _negativeWeights.end(), 0.0);
+    }
+
+    void ApproximateAUCAggregator::Merge(const ApproximateAUCAggregator& other)
+    {
+        if (other._positiveWeights.size() != _positiveWeights.size())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch, "Can't merge ApproximateAUCAggregators with different numbers of bins");
+        }
+
+        for (size_t bin = 0; bin < _positiveWeights.size(); ++bin)
+        {
+            _positiveWeights[bin] += other._positiveWeights[bin];
+            _negativeWeights[bin] += other._negativeWeights[bin];
+        }
+    }
+
+    std::vector<std::string> ApproximateAUCAggregator::GetValueNames() const
+    {
+        return { "AUC" };
+    }
+
+    size_t ApproximateAUCAggregator::GetBin(double prediction) const
+    {
+        // map the real line to (0, 1) with a monotone squashing function that keeps resolution near zero
+        auto squashed = 0.5 * (1.0 + prediction / (1.0 + std::abs(prediction)));
+        auto numBins = _positiveWeights.size();
+        auto bin = static_cast<size_t>(squashed * numBins);
+        return std::min(bin, numBins - 1);
+    }
+} // namespace evaluators
+} // namespace ell
@@ -51,6 +51,12 @@ namespace evaluators
         return { errorRate, precision, recall, f1 };
     }
 
+    double BinaryErrorAggregator::GetGoodness(const std::vector<double>& result) const
+    {
+        // the first value is the error rate
+        return -result[0];
+    }
+
     void BinaryErrorAggregator::Reset()
     {
         _sumTruePositives = 0.0;
@@ -59,6 +65,14 @@ namespace evaluators
         _sumFalseNegatives = 0.0;
     }
 
+    void BinaryErrorAggregator::Merge(const BinaryErrorAggregator& other)
+    {
+        _sumTruePositives += other._sumTruePositives;
+        _sumTrueNegatives += other._sumTrueNegatives;
+        _sumFalsePositives += other._sumFalsePositives;
+        _sumFalseNegatives += other._sumFalseNegatives;
+    }
+
     std::vector<std::string> BinaryErrorAggregator::GetValueNames() const
     {
         return { "ErrorRate", "Precision", "Recall", "F1-Score" };
@@ -12,8 +12,10 @@
 
 #include <predictors/include/LinearPredictor.h>
 
+#include <evaluators/include/ApproximateAUCAggregator.h>
 #include <evaluators/include/AUCAggregator.h>
 #include <evaluators/include/Evaluator.h>
+#include <evaluators/include/IncrementalEvaluator.h>
 #include <evaluators/include/LossAggregator.h>
 
 #include <functions/include/SquaredLoss.h>
@@ -21,6 +23,7 @@
 #include <testing/include/testing.h>
 
 #include <iostream>
+#include <random>
 
 namespace ell
 {
@@ -45,4 +48,89 @@ void TestEvaluators()
     std::cout << "Goodness: " << evaluator->GetGoodness() << std::endl;
     testing::ProcessTest("Evaluator sanity check", !testing::IsEqual(evaluator->GetGoodness(), 0.0, 1e-8));
 }
+
+namespace
+{
+    data::DenseSupervisedDataset GetRandomDataset(size_t numExamples)
+    {
+        using ExampleType = data::DenseSupervisedDataset::DatasetExampleType;
+        std::default_random_engine random(1234);
+        std::normal_distribution<double> normal(0.0, 1.0);
+
+        data::DenseSupervisedDataset dataset;
+        for (size_t i = 0; i < numExamples; ++i)
+        {
+            double label = i % 2 == 0 ? 1.0 : -1.0;
+            double weight = 1.0 + (i % 3);
+            dataset.AddExample(ExampleType{ { normal(random) + 0.5 * label, normal(random) }, data::WeightLabel{ weight, label } });
+        }
+        return dataset;
+    }
+} // namespace
+
+void TestParallelEvaluator()
+{
+    auto dataset = GetRandomDataset(1001);
+    predictors::LinearPredictor<double> predictor({ 1.0, 0.1 }, 0.2);
+
+    using PredictorType = predictors::LinearPredictor<double>;
+    auto sequentialEvaluator = evaluators::Evaluator<PredictorType, evaluators::BinaryErrorAggregator, evaluators::AUCAggregator, evaluators::LossAggregator<functions::SquaredLoss>>(dataset.GetAnyDataset(), { 1, true, 1 }, {}, {}, evaluators::MakeLossAggregator(functions::SquaredLoss()));
+    auto parallelEvaluator = evaluators::Evaluator<PredictorType, evaluators::BinaryErrorAggregator, evaluators::AUCAggregator, evaluators::LossAggregator<functions::SquaredLoss>>(dataset.GetAnyDataset(), { 1, true, 4 }, {}, {}, evaluators::MakeLossAggregator(functions::SquaredLoss()));
+    sequentialEvaluator.Evaluate(predictor);
+    parallelEvaluator.Evaluate(predictor);
+
+    const auto& sequentialValues = sequentialEvaluator.GetValues();
+    const auto& parallelValues = parallelEvaluator.GetValues();
+    bool ok = sequentialValues.size() == 2 && parallelValues.size() == 2;
+    for (size_t i = 0; ok && i < sequentialValues.size(); ++i)
+    {
+        for (size_t j = 0; j < sequentialValues[i].size(); ++j)
+        {
+            ok = ok && testing::IsEqual(sequentialValues[i][j], parallelValues[i][j], 1e-9);
+        }
+    }
+    testing::ProcessTest("Parallel Evaluator matches sequential Evaluator", ok);
+
+    // incremental evaluation only evaluates every other call, but must update the cached predictions on every call
+    auto sequentialIncrementalEvaluator = evaluators::IncrementalEvaluator<PredictorType, evaluators::BinaryErrorAggregator, evaluators::AUCAggregator>(dataset.GetAnyDataset(), { 2, false, 1 }, {}, {});
+    auto parallelIncrementalEvaluator = evaluators::IncrementalEvaluator<PredictorType, evaluators::BinaryErrorAggregator, evaluators::AUCAggregator>(dataset.GetAnyDataset(), { 2, false, 3 }, {}, {});
+    for (int i = 0; i < 4; ++i)
+    {
+        sequentialIncrementalEvaluator.IncrementalEvaluate(predictor, 0.5, 2.0);
+        parallelIncrementalEvaluator.IncrementalEvaluate(predictor, 0.5, 2.0);
+    }
+    testing::ProcessTest("Parallel IncrementalEvaluator matches sequential IncrementalEvaluator", sequentialIncrementalEvaluator.GetValues() == parallelIncrementalEvaluator.GetValues() && parallelIncrementalEvaluator.GetValues().size() == 2);
+}
+
+void TestApproximateAUCAggregator()
+{
+    auto dataset = GetRandomDataset(5000);
+
+    evaluators::AUCAggregator exact;
+    evaluators::ApproximateAUCAggregator approximate;
+    evaluators::ApproximateAUCAggregator firstHalf;
+    evaluators::ApproximateAUCAggregator secondHalf;
+    for (size_t i = 0; i < dataset.NumExamples(); ++i)
+    {
+        const auto& example = dataset[i];
+        auto prediction = example.GetDataVector()[0];
+        auto label = example.GetMetadata().label;
+        auto weight = example.GetMetadata().weight;
+        exact.Update(prediction, label, weight);
+        approximate.Update(prediction, label, weight);
+        (i < dataset.NumExamples() / 2 ? firstHalf : secondHalf).Update(prediction, label, weight);
+    }
+    firstHalf.Merge(secondHalf);
+
+    auto exactAUC = exact.GetResult()[0];
+    auto approximateAUC = approximate.GetResult()[0];
+    testing::ProcessTest("ApproximateAUCAggregator is close to AUCAggregator", approximateAUC <= exactAUC + 1e-12 && testing::IsEqual(exactAUC, approximateAUC, 1e-3));
+    testing::ProcessTest("ApproximateAUCAggregator merge", testing::IsEqual(firstHalf.GetResult()[0], approximateAUC, 1e-12));
+
+    // with a single bin, every pair is tied
+    evaluators::ApproximateAUCAggregator singleBin(1);
+    singleBin.Update(-1.0, -1.0, 1.0);
+    singleBin.Update(1.0, 1.0, 1.0);
+    testing::ProcessTest("ApproximateAUCAggregator ties are pessimistic", testing::IsEqual(singleBin.GetResult()[0], 0.0));
+}
 } // namespace ell
@@ -24,6 +24,8 @@ int main()
     try
     {
         TestEvaluators();
+        TestParallelEvaluator();
+        TestApproximateAUCAggregator();
     }
     catch (const utilities::Exception& exception)
     {
@@ -371,6 +371,43 @@ namespace math
 
     namespace Internal
     {
+        /// <summary> Blocking parameters used by the native matrix-matrix multiplication kernel. A panel of A
+        /// (panelRows x panelDepth) is sized to stay in L2 cache, a sliver of B (panelDepth x registerColumns) is
+        /// sized to stay in L1 cache, and a block of C (registerRows x registerColumns) is kept in registers. </summary>
+        ///
+        /// <typeparam name="ElementType"> Matrix element type. </typeparam>
+        template <typename ElementType>
+        struct GemmBlockSizes
+        {
+            static constexpr size_t registerRows = 4;
+            static constexpr size_t registerColumns = sizeof(ElementType) >= 8 ? 4 : 8;
+            static constexpr size_t panelRows = 16 * registerRows;
+            static constexpr size_t panelDepth = 256;
+            static constexpr size_t panelColumns = 128 * registerColumns;
+        };
+
+        /// <summary> Cache-blocked, register-tiled implementation of C = alpha * A * B + beta * C. Panels of A
+        /// and B are packed into contiguous, zero-padded buffers before they are multiplied, so any combination
+        /// of row and column increments is supported. </summary>
+        ///
+        /// <typeparam name="ElementType"> Matrix element type. </typeparam>
+        /// <param name="m"> Number of rows of A and C. </param>
+        /// <param name="n"> Number of columns of B and C. </param>
+        /// <param name="k"> Number of columns of A and rows of B. </param>
+        /// <param name="alpha"> The scalar that multiplies A * B. </param>
+        /// <param name="A"> Pointer to the first element of A. </param>
+        /// <param name="aRowIncrement"> Distance between consecutive rows of A. </param>
+        /// <param name="aColumnIncrement"> Distance between consecutive columns of A. </param>
+        /// <param name="B"> Pointer to the first element of B. </param>
+        /// <param name="bRowIncrement"> Distance between consecutive rows of B. </param>
+        /// <param name="bColumnIncrement"> Distance between consecutive columns of B. </param>
+        /// <param name="beta"> The scalar that multiplies C. If zero, the original contents of C are ignored. </param>
+        /// <param name="C"> Pointer to the first element of C. </param>
+        /// <param name="cRowIncrement"> Distance between consecutive rows of C. </param>
+        /// <param name="cColumnIncrement"> Distance between consecutive columns of C. </param>
+        template <typename ElementType>
+        void BlockedMultiplyScaleAddUpdate(size_t m, size_t n, size_t k, ElementType alpha, const ElementType* A, size_t aRowIncrement, size_t aColumnIncrement, const ElementType* B, size_t bRowIncrement, size_t bColumnIncrement, ElementType beta, ElementType* C, size_t cRowIncrement, size_t cColumnIncrement);
+
         template <ImplementationType type>
         struct MatrixOperations
         {};
@@ -431,6 +468,9 @@ namespace math
 #include <utilities/include/Exception.h>
 #include <utilities/include/Logger.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace ell
 {
 namespace math
@@ -1093,13 +1133,141 @@ namespace math
         template <typename ElementType, MatrixLayout layoutA, MatrixLayout layoutB, MatrixLayout layoutC>
         void MatrixOperations<ImplementationType::native>::MultiplyScaleAddUpdate(ElementType scalarA, ConstMatrixReference<ElementType, layoutA> matrixA, ConstMatrixReference<ElementType, layoutB> matrixB, ElementType scalarB, MatrixReference<ElementType, layoutC> matrixC)
         {
-            for (size_t i = 0; i < matrixA.NumRows(); ++i)
+            BlockedMultiplyScaleAddUpdate(matrixA.NumRows(),
+                                          matrixB.NumColumns(),
+                                          matrixA.NumColumns(),
+                                          scalarA,
+                                          matrixA.GetConstDataPointer(),
+                                          matrixA.GetRowIncrement(),
+                                          matrixA.GetColumnIncrement(),
+                                          matrixB.GetConstDataPointer(),
+                                          matrixB.GetRowIncrement(),
+                                          matrixB.GetColumnIncrement(),
+                                          scalarB,
+                                          matrixC.GetDataPointer(),
+                                          matrixC.GetRowIncrement(),
+                                          matrixC.GetColumnIncrement());
+        }
+
+        // Packs a panel of A into slivers of `registerRows` rows, each stored column by column and zero-padded
+        template <typename ElementType>
+        void PackGemmPanelA(const ElementType* A, size_t rowIncrement, size_t columnIncrement, size_t numRows, size_t depth, ElementType* packed)
+        {
+            constexpr auto registerRows = GemmBlockSizes<ElementType>::registerRows;
+            for (size_t sliverStart = 0; sliverStart < numRows; sliverStart += registerRows)
+            {
+                auto sliverRows = std::min(registerRows, numRows - sliverStart);
+                for (size_t p = 0; p < depth; ++p)
+                {
+                    for (size_t r = 0; r < registerRows; ++r)
+                    {
+                        *packed++ = r < sliverRows ? A[(sliverStart + r) * rowIncrement + p * columnIncrement] : static_cast<ElementType>(0);
+                    }
+                }
+            }
+        }
+
+        // Packs a panel of B into slivers of `registerColumns` columns, each stored row by row and zero-padded
+        template <typename ElementType>
+        void PackGemmPanelB(const ElementType* B, size_t rowIncrement, size_t columnIncrement, size_t depth, size_t numColumns, ElementType* packed)
+        {
+            constexpr auto registerColumns = GemmBlockSizes<ElementType>::registerColumns;
+            for (size_t sliverStart = 0; sliverStart < numColumns; sliverStart += registerColumns)
+            {
+                auto sliverColumns = std::min(registerColumns, numColumns - sliverStart);
+                for (size_t p = 0; p < depth; ++p)
+                {
+                    for (size_t c = 0; c < registerColumns; ++c)
+                    {
+                        *packed++ = c < sliverColumns ? B[p * rowIncrement + (sliverStart + c) * columnIncrement] : static_cast<ElementType>(0);
+                    }
+                }
+            }
+        }
+
+        // Multiplies a packed sliver of A by a packed sliver of B, and adds the (scaled) result to a block of C.
+        // The accumulator block has a fixed size, so the compiler can keep it in SIMD registers; partial blocks
+        // at the edges of C are handled by zero padding in the packed slivers.
+        template <typename ElementType>
+        void GemmRegisterKernel(size_t depth, ElementType alpha, const ElementType* packedA, const ElementType* packedB, ElementType* C, size_t cRowIncrement, size_t cColumnIncrement, size_t numRows, size_t numColumns)
+        {
+            constexpr auto registerRows = GemmBlockSizes<ElementType>::registerRows;
+            constexpr auto registerColumns = GemmBlockSizes<ElementType>::registerColumns;
+
+            ElementType accumulators[registerRows][registerColumns] = {};
+            for (size_t p = 0; p < depth; ++p)
+            {
+                for (size_t r = 0; r < registerRows; ++r)
+                {
+                    auto a = packedA[r];
+                    for (size_t c = 0; c < registerColumns; ++c)
+                    {
+                        accumulators[r][c] += a * packedB[c];
+                    }
+                }
+                packedA += registerRows;
+                packedB += registerColumns;
+            }
+
+            for (size_t r = 0; r < numRows; ++r)
+            {
+                for (size_t c = 0; c < numColumns; ++c)
+                {
+                    C[r * cRowIncrement + c * cColumnIncrement] += alpha * accumulators[r][c];
+                }
+            }
+        }
+
+        template <typename ElementType>
+        void BlockedMultiplyScaleAddUpdate(size_t m, size_t n, size_t k, ElementType alpha, const ElementType* A, size_t aRowIncrement, size_t aColumnIncrement, const ElementType* B, size_t bRowIncrement, size_t bColumnIncrement, ElementType beta, ElementType* C, size_t cRowIncrement, size_t cColumnIncrement)
+        {
+            using BlockSizes = GemmBlockSizes<ElementType>;
+            auto roundUp = [](size_t size, size_t multiple) { return ((size + multiple - 1) / multiple) * multiple; };
+
+            for (size_t i = 0; i < m; ++i)
+            {
+                for (size_t j = 0; j < n; ++j)
+                {
+                    auto& c = C[i * cRowIncrement + j * cColumnIncrement];
+                    c = beta == 0 ? static_cast<ElementType>(0) : beta * c;
+                }
+            }
+
+            if (k == 0 || alpha == 0)
+            {
+                return;
+            }
+
+            auto maxDepth = std::min(k, BlockSizes::panelDepth);
+            std::vector<ElementType> packedA(roundUp(std::min(m, BlockSizes::panelRows), BlockSizes::registerRows) * maxDepth);
+            std::vector<ElementType> packedB(roundUp(std::min(n, BlockSizes::panelColumns), BlockSizes::registerColumns) * maxDepth);
+            for (size_t jc = 0; jc < n; jc += BlockSizes::panelColumns)
             {
-                for (size_t j = 0; j < matrixB.NumColumns(); ++j)
+                auto numColumns = std::min(BlockSizes::panelColumns, n - jc);
+                for (size_t pc = 0; pc < k; pc += BlockSizes::panelDepth)
                 {
-                    auto row = matrixA.GetRow(i);
-                    auto column = matrixB.GetColumn(j);
-                    matrixC(i, j) = scalarA * Dot(row, column) + scalarB * matrixC(i, j);
+                    auto depth = std::min(BlockSizes::panelDepth, k - pc);
+                    PackGemmPanelB(B + pc * bRowIncrement + jc * bColumnIncrement, bRowIncrement, bColumnIncrement, depth, numColumns, packedB.data());
+                    for (size_t ic = 0; ic < m; ic += BlockSizes::panelRows)
+                    {
+                        auto numRows = std::min(BlockSizes::panelRows, m - ic);
+                        PackGemmPanelA(A + ic * aRowIncrement + pc * aColumnIncrement, aRowIncrement, aColumnIncrement, numRows, depth, packedA.data());
+                        for (size_t jr = 0; jr < numColumns; jr += BlockSizes::registerColumns)
+                        {
+                            for (size_t ir = 0; ir < numRows; ir += BlockSizes::registerRows)
+                            {
+                                GemmRegisterKernel(depth,
+                                                   alpha,
+                                                   packedA.data() + ir * depth,
+                                                   packedB.data() + jr * depth,
+                                                   C + (ic + ir) * cRowIncrement + (jc + jr) * cColumnIncrement,
+                                                   cRowIncrement,
+                                                   cColumnIncrement,
+                                                   std::min(BlockSizes::registerRows, numRows - ir),
+                                                   std::min(BlockSizes::registerColumns, numColumns - jr));
+                            }
+                        }
+                    }
                 }
             }
         }
@@ -190,6 +190,9 @@ void TestVectorMatrixMultiplyScaleAddUpdate();
 template <typename ElementType, math::MatrixLayout layout1, math::MatrixLayout layout2, math::MatrixLayout layout3, math::ImplementationType implementation>
 void TestMatrixMatrixMultiplyScaleAddUpdate();
 
+template <typename ElementType, math::MatrixLayout layout1, math::MatrixLayout layout2, math::MatrixLayout layout3, math::ImplementationType implementation>
+void TestLargeMatrixMatrixMultiplyScaleAddUpdate();
+
 template <typename ElementType, math::MatrixLayout layout>
 void TestMatrixElementwiseMultiplySet();
 
@@ -1521,6 +1524,43 @@ void TestMatrixMatrixMultiplyScaleAddUpdate()
     testing::ProcessTest(implementationName + "::MultiplyScaleAddUpdate(scalar, Matrix, Matrix, scalar, Matrix)", C == R && CCC == R);
 }
 
+template <typename ElementType, math::MatrixLayout layout1, math::MatrixLayout layout2, math::MatrixLayout layout3, math::ImplementationType implementation>
+void TestLargeMatrixMatrixMultiplyScaleAddUpdate()
+{
+    auto implementationName = math::Internal::MatrixOperations<implementation>::GetImplementationName();
+
+    // Sizes chosen to span more than one cache block in each dimension, with partial register blocks at the edges
+    using BlockSizes = math::Internal::GemmBlockSizes<ElementType>;
+    const size_t m = BlockSizes::panelRows + BlockSizes::registerRows + 1;
+    const size_t n = BlockSizes::panelColumns + BlockSizes::registerColumns + 3;
+    const size_t k = BlockSizes::panelDepth + 5;
+
+    math::Matrix<ElementType, layout1> A(m, k);
+    A.Generate([i = 0]() mutable { return static_cast<ElementType>((i++ % 7) - 3); });
+    math::Matrix<ElementType, layout2> B(k, n);
+    B.Generate([i = 0]() mutable { return static_cast<ElementType>((i++ % 5) - 2); });
+    math::Matrix<ElementType, layout3> C(m, n);
+    C.Generate([i = 0]() mutable { return static_cast<ElementType>(i++ % 3); });
+
+    math::Matrix<ElementType, layout3> R(m, n);
+    for (size_t i = 0; i < m; ++i)
+    {
+        for (size_t j = 0; j < n; ++j)
+        {
+            ElementType sum = 0;
+            for (size_t p = 0; p < k; ++p)
+            {
+                sum += A(i, p) * B(p, j);
+            }
+            R(i, j) = 2 * sum - C(i, j);
+        }
+    }
+
+    math::MultiplyScaleAddUpdate<implementation>(static_cast<ElementType>(2), A, B, static_cast<ElementType>(-1), C);
+
+    testing::ProcessTest(implementationName + "::MultiplyScaleAddUpdate(scalar, Matrix, Matrix, scalar, Matrix) with blocking", C == R);
+}
+
 template <typename ElementType, math::MatrixLayout layout>
 void TestMatrixElementwiseMultiplySet()
 {
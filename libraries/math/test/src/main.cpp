@@ -119,6 +119,7 @@ void RunTripleLayoutMatrixImplementationTests()
     TestMatrixScaleAddSetOneMatrixScalar<ElementType, layout1, layout2, layout3, implementation>();
     TestMatrixScaleAddSetScalarMatrixScalar<ElementType, layout1, layout2, layout3, implementation>();
     TestMatrixMatrixMultiplyScaleAddUpdate<ElementType, layout1, layout2, layout3, implementation>();
+    TestLargeMatrixMatrixMultiplyScaleAddUpdate<ElementType, layout1, layout2, layout3, implementation>();
 }
 
 template <typename ElementType, math::MatrixLayout layout1, math::MatrixLayout layout2, math::ImplementationType implementation>
@@ -23,8 +23,12 @@
 #include <utilities/include/Boolean.h>
 #include <utilities/include/TypeName.h>
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <string>
 #include <tuple>
@@ -45,7 +49,7 @@ namespace model
         /// <param name="other"> The compiled map being moved. </param>
         IRCompiledMap(IRCompiledMap&& other);
 
-        ~IRCompiledMap() override = default;
+        ~IRCompiledMap() override;
 
         /// <summary> Output the compiled model to the given file </summary>
         ///
@@ -182,10 +186,67 @@ namespace model
         // Just-in-time compilation functions
         //
 
-        /// <summary> Force jitting to finish so you can time execution without jit cost. </summary>
+        /// <summary> Force jitting to finish so you can time execution without jit cost. Call this before computing the
+        /// map from several threads at once. </summary>
         void FinishJitting() const;
 
-        /// <summary> Set a context object to use in the predict call </summary>
+        /// <summary> Start jitting on a background thread, and return immediately. Until `IsJitReady` returns true,
+        /// callers that can't wait can compute the original (uncompiled) map instead; the calls that need the
+        /// compiled code (`Compute`, `FinishJitting`, `GetJitter`, ...) block until jitting is done, without keeping
+        /// other threads from calling `IsJitReady`. The jitted code is generated from a copy of the map's module in an
+        /// LLVM context of its own, so the map's module can still be used (`GetModule`, `WriteCode`) meanwhile. </summary>
+        void StartJitting() const;
+
+        /// <summary> Indicates if the compiled code is ready to run. This never blocks, even while another thread is
+        /// waiting for jitting to finish or is creating the execution engine. </summary>
+        ///
+        /// <returns> `true` if jitting has finished, `false` if it is running in the background, hasn't started, or
+        /// another thread is busy setting up the jitter. </returns>
+        bool IsJitReady() const;
+
+        /// <summary> Replace the weights of the jitted map with those of a retrained map with the same structure,
+        /// keeping the compiled code and the map's state. Both maps must have been compiled with the same module name
+        /// and the `swappableWeights` option set. This isn't synchronized with `Compute`, and the old weights are freed:
+        /// callers must make sure that no thread is computing the map, with any context, until it returns. </summary>
+        ///
+        /// <param name="retrainedMap"> The retrained map. It can be discarded afterwards. </param>
+        void UpdateWeights(const IRCompiledMap& retrainedMap);
+
+        using Map::Compute;
+
+        /// <summary> Run the map on a single input by calling the predict function directly. The input is read from,
+        /// and the output written to, caller-owned buffers, so nothing is copied or allocated. </summary>
+        ///
+        /// <param name="input"> The input (`GetInputSize()` elements). </param>
+        /// <param name="output"> The buffer that receives the output (`GetOutputSize()` elements). </param>
+        template <typename InputType, typename OutputType>
+        void Compute(const InputType* input, OutputType* output) const;
+
+        /// <summary> Run the map on a single input, using the given state context. The map must have been compiled with
+        /// the `reentrant` option set. Different threads can compute the map at the same time as long as each uses
+        /// its own context. A context from `AllocateContext` means the map is already jitted, so these calls never
+        /// block on the compiler. </summary>
+        ///
+        /// <param name="input"> The input (`GetInputSize()` elements). </param>
+        /// <param name="output"> The buffer that receives the output (`GetOutputSize()` elements). </param>
+        /// <param name="context"> A state context returned by `AllocateContext`. </param>
+        template <typename InputType, typename OutputType>
+        void Compute(const InputType* input, OutputType* output, void* context) const;
+
+        /// <summary> Allocate a state context holding the initial state of the map. The map must have been compiled
+        /// with the `reentrant` option set. This finishes jitting the map, and can be called from several threads at
+        /// once. </summary>
+        ///
+        /// <returns> The new context, which must be released with `FreeContext`. </returns>
+        void* AllocateContext() const;
+
+        /// <summary> Free a state context returned by `AllocateContext`. </summary>
+        ///
+        /// <param name="context"> The context to free. </param>
+        void FreeContext(void* context) const;
+
+        /// <summary> Set a context object to use in the predict call. For a re-entrant map, this is the state context
+        /// used by the calls that don't take one explicitly; if it isn't set, the map allocates its own. </summary>
         void SetContext(void* context) { _context = context; }
 
         /// <summary> Get the context object to use in the predict call </summary>
@@ -212,7 +273,18 @@ namespace model
 
         IRCompiledMap(Map map, const std::string& functionName, const MapCompilerOptions& options, std::unique_ptr<emitters::IRModuleEmitter> module, bool verifyJittedModule);
 
-        void EnsureExecutionEngine() const;
+        // what a background jitting task hands over to the map once it is done
+        struct JitResult
+        {
+            emitters::IRExecutionEngine::ModuleHandle weightsModuleHandle = 0; // 0 if the task didn't add the weights
+            uint64_t predictFunctionAddress = 0;
+        };
+
+        emitters::IRExecutionEngine& EnsureExecutionEngine() const;
+        uint64_t GetPredictFunctionAddress() const;
+        std::unique_ptr<emitters::IRExecutionEngine> CreateExecutionEngine() const;
+        void FinishJitTask() const;
+        void* GetPredictContext() const;
         void SetComputeFunction() const;
         template <typename InputType>
         void SetComputeFunctionForInputType() const;
@@ -222,10 +294,16 @@ namespace model
 
         std::string _moduleName = "ELL";
         std::unique_ptr<emitters::IRModuleEmitter> _module;
+        std::unique_ptr<llvm::Module> _weightsModule; // the constant data, with the `swappableWeights` option
 
-        mutable std::unique_ptr<emitters::IRExecutionEngine> _executionEngine;
+        mutable std::mutex _jitMutex; // guards the engine, the weights module handle, and the background jitting task
+        mutable std::unique_ptr<emitters::IRExecutionEngine> _executionEngine; // never replaced once published, unless background jitting failed
+        mutable std::shared_future<JitResult> _jitTask; // compiles `_executionEngine` in the background
+        mutable std::atomic<uint64_t> _predictFunctionAddress{ 0 }; // set once, so that computing needs no lock
+        mutable emitters::IRExecutionEngine::ModuleHandle _weightsModuleHandle = 0;
         bool _verifyJittedModule = false;
         void* _context = nullptr;
+        mutable void* _stateContext = nullptr; // owned default state context of a re-entrant map
 
         template <typename T>
         using Vector = std::vector<std::conditional_t<std::is_same_v<bool, T>, Boolean, T>>;
@@ -251,7 +329,7 @@ namespace model
         {
             _computeFunctionDefined = true;
             auto outputSize = GetOutput(0).Size();
-            auto functionPointer = _executionEngine->ResolveFunctionAddress(_functionName);
+            auto functionPointer = GetPredictFunctionAddress();
             ComputeFunction<InputType> computeFunction;
             switch (GetOutput(0).GetPortType()) // Switch on output type
             {
@@ -313,6 +391,24 @@ namespace model
         }
     }
 
+    template <typename InputType, typename OutputType>
+    void IRCompiledMap::Compute(const InputType* input, OutputType* output) const
+    {
+        Compute(input, output, GetPredictContext());
+    }
+
+    template <typename InputType, typename OutputType>
+    void IRCompiledMap::Compute(const InputType* input, OutputType* output, void* context) const
+    {
+        if (GetInput(0)->GetOutputPort().GetType() != Port::GetPortType<InputType>() || GetOutput(0).GetPortType() != Port::GetPortType<OutputType>())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch);
+        }
+
+        auto fn = reinterpret_cast<void (*)(void*, const InputType*, OutputType*)>(GetPredictFunctionAddress());
+        fn(context, input, output);
+    }
+
     template <typename ElementType>
     ElementType* IRCompiledMap::GetGlobalValuePointer(const std::string& name)
     {
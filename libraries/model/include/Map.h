@@ -9,6 +9,7 @@
 #pragma once
 
 #include "InputNode.h"
+#include "ModelExecutor.h"
 #include "Node.h"
 #include "PortElements.h"
 
@@ -22,6 +23,7 @@
 #include <utilities/include/TypeTraits.h>
 
 #include <algorithm>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -99,6 +101,16 @@ namespace model
         /// <summary> Reset the state of the model </summary>
         void Reset();
 
+        /// <summary> Sets the options used to compute the map's outputs with the (non-compiled) reference implementation. </summary>
+        ///
+        /// <param name="options"> The execution options. By default, nodes are computed one at a time on the calling thread. </param>
+        void SetComputeOptions(const ModelExecutorOptions& options);
+
+        /// <summary> Gets the options used to compute the map's outputs with the (non-compiled) reference implementation. </summary>
+        ///
+        /// <returns> The execution options. </returns>
+        const ModelExecutorOptions& GetComputeOptions() const { return _computeOptions; }
+
         /// <summary> Returns the number of inputs to the map </summary>
         ///
         /// <returns> The number of inputs to the map </returns>
@@ -441,6 +453,12 @@ namespace model
         std::unordered_map<std::string, PortElementsBase> _outputElementsMap;
         utilities::PropertyBag _metadata;
 
+        ModelExecutorOptions _computeOptions;
+        mutable std::unique_ptr<ModelExecutor> _executor; // created on demand when computing with more than one thread, reset whenever _model is replaced
+
+        template <typename ValueType>
+        std::vector<ValueType> ComputeModelOutput(const PortElementsBase& outputs) const;
+        const ModelExecutor& GetExecutor(const PortElementsBase& outputs) const;
         std::vector<const Node*> GetAllOutputNodes() const;
         std::vector<const Node*> GetDebugSinkNodes() const;
         std::vector<const Node*> GetMatchingNodesByType(const std::string name) const;
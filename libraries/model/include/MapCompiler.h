@@ -120,6 +120,9 @@ namespace model
         friend class CompilableNode;
 
         void CompileNodes(Model& model);
+        void ComputePortLifetimes(const Model& model);
+        emitters::Variable* TryReusePortVariable(const OutputPortBase& port);
+        void ReleaseDeadPortVariables(int nodeIndex);
         emitters::Variable* AllocatePortFunctionArgument(emitters::ModuleEmitter& emitter, const OutputPortBase& port, ArgType argType);
         emitters::Variable* AllocatePortFunctionArgument(emitters::ModuleEmitter& emitter, const PortElementBase& element, ArgType argType);
 
@@ -127,6 +130,17 @@ namespace model
         // map from ports to runtime variables, for all ports in the model
         // stored as a stack, with the top of the stack being the innermost scope
         std::vector<std::unordered_map<const Port*, emitters::Variable*>> _portToVarMaps; // Do we need separate elementToVarMaps?
+
+        // Port buffer reuse (see `MapCompilerOptions::reusePortBuffers`): the index of the last node (in compile order)
+        // that reads each port, the shared buffers currently holding live ports, and the buffers free to be reused
+        struct SharedPortVariable
+        {
+            emitters::Variable* variable;
+            std::vector<const Port*> ports;
+        };
+        std::unordered_map<const Port*, int> _portLastUse;
+        std::vector<SharedPortVariable> _livePortVariables;
+        std::vector<emitters::Variable*> _freePortVariables;
     };
 } // namespace model
 } // namespace ell
@@ -32,6 +32,12 @@ namespace model
         std::string sourceFunctionName;
         std::string sinkFunctionName;
         bool verifyJittedModule = false;
+        bool reusePortBuffers = false; // share global port buffers between ports whose lifetimes don't overlap
+        bool reentrant = false; // keep all mutable state in a caller-allocated context instead of in globals
+        std::string objectCachePath; // directory where the JIT caches machine code between runs (empty: no cache)
+        int jitThreads = 1; // number of threads the JIT uses to generate machine code, each for a part of the module
+        bool lazyJit = false; // have the JIT compile each function when it is first needed, instead of the whole module up front
+        bool swappableWeights = false; // keep the constant data in its own JIT module, which UpdateWeights can replace (JIT only)
 
         // optimizations
         ModelOptimizerOptions optimizerSettings;
@@ -16,8 +16,10 @@
 #include <utilities/include/IIterator.h>
 #include <utilities/include/PropertyBag.h>
 
+#include <cstdint>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -185,6 +187,14 @@ namespace model
         /// <summary> Reset the state of the model </summary>
         void Reset();
 
+        /// <summary> Gets the nodes necessary to compute the given outputs, in dependency order. The schedule is
+        /// computed once per set of outputs and cached until the model is modified, so repeated calls are cheap. </summary>
+        ///
+        /// <param name="outputs"> The outputs to compute. If empty, the schedule covers the entire model. </param>
+        ///
+        /// <returns> A shared pointer to the (immutable) list of nodes to compute. </returns>
+        std::shared_ptr<const std::vector<const Node*>> GetComputeSchedule(const std::vector<const OutputPortBase*>& outputs) const;
+
         /// <summary>
         /// Visits all the nodes in the model in dependency order. No nodes will be visited until all
         /// its inputs have first been visited.
@@ -354,10 +364,12 @@ namespace model
         friend class detail::ModelNodeRouter;
         template <typename ValueType>
         friend class InputPort;
+        friend class InputPortBase;
         friend class ModelTransformer;
         friend class Map;
 
         using IDToNodeMap = std::map<Node::NodeId, std::shared_ptr<Node>, std::less<Node::NodeId>>;
+        using NodeSchedule = std::vector<const Node*>;
         struct ModelData
         {
             // The id->node map acts both as the main container that holds the shared pointers to nodes, and as the index
@@ -365,6 +377,12 @@ namespace model
             // We keep it sorted by id to make visiting all nodes deterministically ordered
             IDToNodeMap idToNodeMap;
             utilities::PropertyBag metadata;
+
+            // Cached compute schedules, keyed by the sorted set of outputs they compute. The cache is valid as long as
+            // `scheduleEditCount` matches the global edit count (see `InvalidateComputeSchedules`).
+            std::mutex scheduleMutex;
+            std::map<std::vector<const OutputPortBase*>, std::shared_ptr<const NodeSchedule>> schedules;
+            uint64_t scheduleEditCount = 0;
         };
 
         Model(const std::shared_ptr<Model::ModelData>& data);
@@ -384,6 +402,9 @@ namespace model
         template <typename Visitor>
         void VisitIteratedNodes(NodeIterator& iter, Visitor&& visitor) const;
 
+        // Called whenever nodes are added or input ports are rewired
+        static void InvalidateComputeSchedules();
+
         std::shared_ptr<ModelData> _data;
     };
 
@@ -506,8 +527,11 @@ namespace model
     template <typename ValueType>
     std::vector<ValueType> Model::ComputeOutput(const OutputPort<ValueType>& outputPort) const
     {
-        auto compute = [](const Node& node) { node.Compute(); };
-        VisitSubmodel({ &outputPort }, compute);
+        auto schedule = GetComputeSchedule({ &outputPort });
+        for (auto node : *schedule)
+        {
+            node->Compute();
+        }
         return outputPort.GetOutput();
     }
 
@@ -522,9 +546,11 @@ namespace model
         }
 
         auto ports = std::vector<const OutputPortBase*>(usedPorts.begin(), usedPorts.end());
-        VisitSubmodel(ports, [](const Node& node) {
-            node.Compute();
-        });
+        auto schedule = GetComputeSchedule(ports);
+        for (auto node : *schedule)
+        {
+            node->Compute();
+        }
 
         // Now construct the output
         auto numElements = elements.Size();
@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ModelExecutor.h (model)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Node.h"
+#include "OutputPort.h"
+#include "PortElements.h"
+
+#include <utilities/include/ThreadPool.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace ell
+{
+namespace model
+{
+    class Model;
+
+    /// <summary> Options for computing a model's nodes with a `ModelExecutor`. </summary>
+    struct ModelExecutorOptions
+    {
+        /// <summary> The number of threads to compute nodes on. '0' means one thread per hardware thread, and '1'
+        /// computes the nodes in order on the calling thread. </summary>
+        size_t numThreads = 1;
+
+        /// <summary> If set, compute the nodes one at a time in schedule order on the calling thread, regardless of `numThreads`. </summary>
+        bool deterministic = false;
+    };
+
+    /// <summary>
+    /// Computes the nodes of a model needed to produce a set of output ports. The dependency graph and the
+    /// topological schedule are built once, when the executor is created. When run with more than one thread,
+    /// each node is handed to a thread pool as soon as all of its parent nodes have finished, so independent
+    /// branches of the model are computed concurrently. Nodes are assumed not to share mutable state with other
+    /// nodes (source and sink nodes with callbacks that aren't thread-safe should use the deterministic mode).
+    /// </summary>
+    class ModelExecutor
+    {
+    public:
+        /// <summary> Constructor </summary>
+        ///
+        /// <param name="model"> The model to compute. It must not be modified while the executor is in use. </param>
+        /// <param name="outputs"> The output ports to compute. If empty, all the nodes in the model are computed. </param>
+        /// <param name="options"> The execution options. </param>
+        ModelExecutor(const Model& model, const std::vector<const OutputPortBase*>& outputs, const ModelExecutorOptions& options = {});
+
+        /// <summary> Computes all the nodes in the schedule. If a node throws, the nodes that depend on it are
+        /// skipped and the exception is rethrown after the running nodes finish. </summary>
+        void Compute() const;
+
+        /// <summary> Computes all the nodes in the schedule and gathers the values of the given elements. </summary>
+        ///
+        /// <param name="elements"> The elements to return, which must refer to the executor's output ports. </param>
+        ///
+        /// <returns> The values of the elements. </returns>
+        template <typename ValueType>
+        std::vector<ValueType> ComputeOutput(const PortElements<ValueType>& elements) const;
+
+        /// <summary> Gets the nodes to compute, in a valid sequential order. </summary>
+        ///
+        /// <returns> The nodes in the schedule. </returns>
+        const std::vector<const Node*>& GetSchedule() const { return _schedule; }
+
+        /// <summary> Gets the output ports the executor was created for. </summary>
+        ///
+        /// <returns> The output ports. </returns>
+        const std::vector<const OutputPortBase*>& GetOutputs() const { return _outputs; }
+
+        /// <summary> Gets the execution options. </summary>
+        ///
+        /// <returns> The execution options. </returns>
+        const ModelExecutorOptions& GetOptions() const { return _options; }
+
+    private:
+        void ComputeSequential() const;
+        void ComputeParallel() const;
+
+        std::vector<const OutputPortBase*> _outputs;
+        ModelExecutorOptions _options;
+
+        std::vector<const Node*> _schedule;
+        std::vector<std::vector<size_t>> _dependents; // for each node in the schedule, the scheduled nodes that read its outputs
+        std::vector<size_t> _numParents; // for each node in the schedule, the number of distinct scheduled nodes it reads from
+
+        std::unique_ptr<utilities::ThreadPool> _threadPool;
+    };
+} // namespace model
+} // namespace ell
+
+#pragma region implementation
+
+namespace ell
+{
+namespace model
+{
+    template <typename ValueType>
+    std::vector<ValueType> ModelExecutor::ComputeOutput(const PortElements<ValueType>& elements) const
+    {
+        Compute();
+
+        auto numElements = elements.Size();
+        std::vector<ValueType> result(numElements);
+        for (size_t index = 0; index < numElements; ++index)
+        {
+            auto element = elements.GetElement(index);
+            result[index] = element.ReferencedPort()->GetOutput()[element.GetIndex()];
+        }
+        return result;
+    }
+} // namespace model
+} // namespace ell
+
+#pragma endregion implementation
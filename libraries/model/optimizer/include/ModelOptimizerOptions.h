@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <string>
+
 namespace ell
 {
 namespace model
@@ -25,16 +27,20 @@ namespace model
         diagonal,
         simple,
         winograd,
-        unrolled
+        unrolled,
+        autotune // benchmark the compatible methods for each layer and use the fastest
     };
 
     struct ModelOptimizerOptions
     {
         // individual optimization settings
         bool fuseLinearFunctionNodes = true;
+        bool fuseConvolutionLayers = true; // fold per-channel scales into convolution weights and fuse bias with activation
         bool optimizeReorderDataNodes = true;
+        bool quantizeNeuralNetworkLayers = false; // run calibrated fully-connected layers in 8-bit integer arithmetic
 
         PreferredConvolutionMethod preferredConvolutionMethod = PreferredConvolutionMethod::automatic;
+        std::string convolutionTuningCachePath; // file of per-layer-shape autotuning results; empty means results aren't persisted
 
         // phase
         OptimizerPhase phase = OptimizerPhase::optimize;
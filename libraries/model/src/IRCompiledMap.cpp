@@ -14,14 +14,22 @@
 #include "Port.h"
 
 #include <emitters/include/EmitterException.h>
+#include <emitters/include/IRConstantData.h>
+#include <emitters/include/IRObjectCache.h>
 #include <emitters/include/IROptimizer.h>
+#include <emitters/include/IRStateContext.h>
 
 #include <utilities/include/Exception.h>
 #include <utilities/include/Files.h>
 
-#include <llvm/Transforms/Utils/Cloning.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/Support/raw_ostream.h>
 
+#include <algorithm>
+#include <chrono>
 #include <sstream>
+#include <utility>
 
 namespace ell
 {
@@ -29,12 +37,64 @@ namespace model
 {
     using utilities::Boolean;
 
+    namespace
+    {
+        // The settings that change the generated machine code, including the ones that leave no trace in the module
+        std::string GetObjectCacheSettingsKey(const MapCompilerOptions& options)
+        {
+            const auto& settings = options.compilerSettings;
+            const auto& device = settings.targetDevice;
+            std::stringstream key;
+            key << options.mapFunctionName << ' ' << options.inlineNodes << options.profile << options.reentrant << ' '
+                << settings.unrollLoops << settings.inlineOperators << settings.allowVectorInstructions << settings.vectorWidth << ' '
+                << settings.useBlas << static_cast<int>(settings.blasType) << settings.optimize << settings.useFastMath << settings.includeDiagnosticInfo << ' '
+                << settings.parallelize << settings.useThreadPool << settings.maxThreads << static_cast<int>(settings.parallelLoopSchedule) << settings.parallelLoopChunkSize << ' '
+                << device.triple << ' ' << device.cpu << ' ' << device.features << ' ' << device.dataLayout;
+            return key.str();
+        }
+
+        // Copies a module into another LLVM context, by way of bitcode
+        std::unique_ptr<llvm::Module> CopyModule(const llvm::Module& module, llvm::LLVMContext& context)
+        {
+            llvm::SmallVector<char, 0> buffer;
+            llvm::raw_svector_ostream stream(buffer);
+            llvm::WriteBitcodeToFile(&module, stream);
+            auto copy = llvm::parseBitcodeFile(llvm::MemoryBufferRef(llvm::StringRef(buffer.data(), buffer.size()), module.getName()), context);
+            if (!copy)
+            {
+                throw emitters::EmitterException(emitters::EmitterError::unexpected, "Couldn't copy module: " + llvm::toString(copy.takeError()));
+            }
+            return std::move(copy.get());
+        }
+
+        // Adds the module holding the weights to the engine, and points the code at them
+        emitters::IRExecutionEngine::ModuleHandle AddWeightsModule(emitters::IRExecutionEngine& executionEngine, std::unique_ptr<llvm::Module> weightsModule)
+        {
+            auto weightsModuleHandle = executionEngine.AddModule(std::move(weightsModule));
+            try
+            {
+                emitters::BindConstantData(executionEngine, weightsModuleHandle);
+            }
+            catch (...)
+            {
+                executionEngine.RemoveModule(weightsModuleHandle);
+                throw;
+            }
+            return weightsModuleHandle;
+        }
+    } // namespace
+
     IRCompiledMap::IRCompiledMap(IRCompiledMap&& other) :
         CompiledMap(std::move(other), other._functionName, other._compilerOptions),
         _moduleName(std::move(other._moduleName)),
         _module(std::move(other._module)),
+        _weightsModule(std::move(other._weightsModule)),
         _executionEngine(std::move(other._executionEngine)),
+        _jitTask(std::move(other._jitTask)),
+        _weightsModuleHandle(other._weightsModuleHandle),
         _verifyJittedModule(other._verifyJittedModule),
+        _context(other._context),
+        _stateContext(std::exchange(other._stateContext, nullptr)),
         _computeFunctionDefined(false)
     {
     }
@@ -49,6 +109,21 @@ namespace model
         _moduleName = _module->GetModuleName();
     }
 
+    IRCompiledMap::~IRCompiledMap()
+    {
+        if (_jitTask.valid())
+        {
+            // the task is compiling the engine this map owns; an error would have been reported by the next call
+            // that needed the compiled code
+            _jitTask.wait();
+        }
+
+        if (_stateContext != nullptr)
+        {
+            FreeContext(_stateContext);
+        }
+    }
+
     bool IRCompiledMap::IsValid() const
     {
         return _module != nullptr && _module->IsValid();
@@ -56,23 +131,211 @@ namespace model
 
     emitters::IRExecutionEngine& IRCompiledMap::GetJitter()
     {
-        EnsureExecutionEngine();
+        return EnsureExecutionEngine();
+    }
+
+    emitters::IRExecutionEngine& IRCompiledMap::EnsureExecutionEngine() const
+    {
+        std::unique_lock<std::mutex> lock(_jitMutex);
+        while (_jitTask.valid())
+        {
+            if (_jitTask.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+            {
+                FinishJitTask();
+                break;
+            }
+
+            // wait without the lock, so that other threads can still ask if jitting is done
+            auto jitTask = _jitTask;
+            lock.unlock();
+            jitTask.wait();
+            lock.lock();
+        }
+
+        if (!_executionEngine)
+        {
+            auto executionEngine = CreateExecutionEngine();
+            if (_weightsModule)
+            {
+                _weightsModuleHandle = AddWeightsModule(*executionEngine, CopyModule(*_weightsModule, executionEngine->GetLLVMContext()));
+            }
+            _executionEngine = std::move(executionEngine);
+        }
+
+        // the engine is only replaced after a failed jitting task, which no caller can be using, so the reference stays
+        // valid after unlocking
         return *_executionEngine;
     }
 
-    void IRCompiledMap::EnsureExecutionEngine() const
+    void IRCompiledMap::FinishJitTask() const
+    {
+        auto jitTask = std::move(_jitTask);
+        JitResult result;
+        try
+        {
+            result = jitTask.get();
+        }
+        catch (...)
+        {
+            // the engine may be left without its weights, so the next call starts over with a new one on its own thread
+            _executionEngine.reset();
+            throw;
+        }
+
+        if (result.weightsModuleHandle != 0)
+        {
+            _weightsModuleHandle = result.weightsModuleHandle;
+        }
+        _predictFunctionAddress = result.predictFunctionAddress;
+    }
+
+    uint64_t IRCompiledMap::GetPredictFunctionAddress() const
+    {
+        auto address = _predictFunctionAddress.load();
+        if (address == 0)
+        {
+            // threads that get here at the same time all resolve the same address
+            auto& executionEngine = EnsureExecutionEngine();
+            address = _predictFunctionAddress.load();
+            if (address == 0)
+            {
+                address = executionEngine.ResolveFunctionAddress(_functionName);
+                _predictFunctionAddress = address;
+            }
+        }
+        return address;
+    }
+
+    std::unique_ptr<emitters::IRExecutionEngine> IRCompiledMap::CreateExecutionEngine() const
+    {
+        // The engine gets a copy of the module in an LLVM context of its own, so generating code (in the background,
+        // or lazily on the threads that compute the map) never touches the context of the map's module.
+        auto context = std::make_unique<llvm::LLVMContext>();
+        auto moduleCopy = CopyModule(*_module->GetLLVMModule(), *context);
+        auto executionEngine = std::make_unique<emitters::IRExecutionEngine>(std::move(moduleCopy), std::move(context), _verifyJittedModule);
+        if (!_compilerOptions.objectCachePath.empty())
+        {
+            executionEngine->SetObjectCache(std::make_unique<emitters::IRObjectCache>(_compilerOptions.objectCachePath, GetObjectCacheSettingsKey(_compilerOptions)));
+        }
+        executionEngine->SetCodeGenerationThreads(static_cast<unsigned>(std::max(_compilerOptions.jitThreads, 1)));
+
+        executionEngine->SetLazyCompilation(_compilerOptions.lazyJit);
+        return executionEngine;
+    }
+
+    void IRCompiledMap::UpdateWeights(const IRCompiledMap& retrainedMap)
     {
+        if (_weightsModule == nullptr || retrainedMap._weightsModule == nullptr)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Both maps must be compiled with the swappableWeights option");
+        }
+        if (!emitters::IsCompatibleConstantData(*_module->GetLLVMModule(), *_weightsModule, *retrainedMap._module->GetLLVMModule(), *retrainedMap._weightsModule))
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "The retrained map's code or weights don't match the structure of this map");
+        }
+
+        // the retrained map's module belongs to its own LLVM context, which goes away with it
+        auto weightsModule = CopyModule(*retrainedMap._weightsModule, _module->GetLLVMContext());
+
+        // the old weights are removed once the code points at the new ones, so a failure leaves the old ones in use
+        auto& executionEngine = EnsureExecutionEngine();
+        auto weightsModuleHandle = AddWeightsModule(executionEngine, CopyModule(*weightsModule, executionEngine.GetLLVMContext()));
+        {
+            std::lock_guard<std::mutex> lock(_jitMutex);
+            std::swap(_weightsModuleHandle, weightsModuleHandle);
+        }
+        _weightsModule = std::move(weightsModule);
+        executionEngine.RemoveModule(weightsModuleHandle);
+    }
+
+    void IRCompiledMap::StartJitting() const
+    {
+        std::lock_guard<std::mutex> lock(_jitMutex);
+        if (_jitTask.valid() || _predictFunctionAddress != 0)
+        {
+            return;
+        }
+
+        // The engine is created and published here, so the background thread only touches the engine and its own
+        // LLVM context. An engine that already exists (for instance because callbacks were defined on it) is compiled
+        // as it is. Until the task is done, every other use of the engine waits for it in `EnsureExecutionEngine`.
+        std::unique_ptr<llvm::Module> weightsModule;
         if (!_executionEngine)
         {
-            auto moduleClone = std::unique_ptr<llvm::Module>(llvm::CloneModule(_module->GetLLVMModule()));
-            _executionEngine = std::make_unique<emitters::IRExecutionEngine>(std::move(moduleClone), _verifyJittedModule);
+            _executionEngine = CreateExecutionEngine();
+            if (_weightsModule)
+            {
+                weightsModule = CopyModule(*_weightsModule, _executionEngine->GetLLVMContext());
+            }
+        }
+
+        _jitTask = std::async(std::launch::async, [executionEngine = _executionEngine.get(), weightsModule = std::move(weightsModule), functionName = _functionName]() mutable {
+            JitResult result;
+            if (weightsModule)
+            {
+                result.weightsModuleHandle = AddWeightsModule(*executionEngine, std::move(weightsModule));
+            }
+            result.predictFunctionAddress = executionEngine->ResolveFunctionAddress(functionName);
+            return result;
+        }).share();
+    }
+
+    bool IRCompiledMap::IsJitReady() const
+    {
+        if (_predictFunctionAddress != 0)
+        {
+            return true;
         }
+
+        // a thread holding the lock may be creating the engine, which takes a while: that counts as not ready
+        std::unique_lock<std::mutex> lock(_jitMutex, std::try_to_lock);
+        return lock.owns_lock() && _jitTask.valid() && _jitTask.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
     }
 
     void IRCompiledMap::FinishJitting() const
     {
         EnsureExecutionEngine();
         SetComputeFunction();
+        GetPredictFunctionAddress();
+        GetPredictContext();
+    }
+
+    void* IRCompiledMap::AllocateContext() const
+    {
+        if (!_compilerOptions.reentrant)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Map was compiled without the reentrant option");
+        }
+
+        // finish jitting the predict function too, so that computing with the new context never waits for the compiler
+        GetPredictFunctionAddress();
+        auto fn = reinterpret_cast<void* (*)()>(EnsureExecutionEngine().ResolveFunctionAddress(emitters::GetAllocateContextFunctionName(_moduleName)));
+        return fn();
+    }
+
+    void IRCompiledMap::FreeContext(void* context) const
+    {
+        if (!_compilerOptions.reentrant)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Map was compiled without the reentrant option");
+        }
+
+        auto fn = reinterpret_cast<void (*)(void*)>(EnsureExecutionEngine().ResolveFunctionAddress(emitters::GetFreeContextFunctionName(_moduleName)));
+        fn(context);
+    }
+
+    void* IRCompiledMap::GetPredictContext() const
+    {
+        if (!_compilerOptions.reentrant || _context != nullptr)
+        {
+            return _context;
+        }
+
+        if (_stateContext == nullptr)
+        {
+            _stateContext = AllocateContext();
+        }
+        return _stateContext;
     }
 
     void IRCompiledMap::SetComputeFunction() const
@@ -118,7 +381,7 @@ namespace model
             temp[index] = static_cast<bool>(inputValues[index]);
         }
 
-        std::get<ComputeFunction<bool>>(_computeInputFunction)(GetContext(), (bool*)temp.data());
+        std::get<ComputeFunction<bool>>(_computeInputFunction)(GetPredictContext(), (bool*)temp.data());
     }
 
     void IRCompiledMap::SetNodeInput(model::InputNode<int>* node, const std::vector<int>& inputValues) const
@@ -130,7 +393,7 @@ namespace model
             throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch);
         }
 
-        std::get<ComputeFunction<int>>(_computeInputFunction)(GetContext(), inputValues.data());
+        std::get<ComputeFunction<int>>(_computeInputFunction)(GetPredictContext(), inputValues.data());
     }
 
     void IRCompiledMap::SetNodeInput(model::InputNode<int64_t>* node, const std::vector<int64_t>& inputValues) const
@@ -142,7 +405,7 @@ namespace model
             throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch);
         }
 
-        std::get<ComputeFunction<int64_t>>(_computeInputFunction)(GetContext(), inputValues.data());
+        std::get<ComputeFunction<int64_t>>(_computeInputFunction)(GetPredictContext(), inputValues.data());
     }
 
     void IRCompiledMap::SetNodeInput(model::InputNode<float>* node, const std::vector<float>& inputValues) const
@@ -154,7 +417,7 @@ namespace model
             throw utilities::InputException(utilities::InputExceptionErrors::typeMismatch);
         }
 
-        std::get<ComputeFunction<float>>(_computeInputFunction)(GetContext(), inputValues.data());
+        std::get<ComputeFunction<float>>(_computeInputFunction)(GetPredictContext(), inputValues.data());
     }
 
     void IRCompiledMap::SetNodeInput(model::InputNode<double>* node, const std::vector<double>& inputValues) const
@@ -169,7 +432,7 @@ namespace model
             throw utilities::InputException(utilities::InputExceptionErrors::nullReference);
         }
 
-        std::get<ComputeFunction<double>>(_computeInputFunction)(GetContext(), inputValues.data());
+        std::get<ComputeFunction<double>>(_computeInputFunction)(GetPredictContext(), inputValues.data());
     }
 
     std::vector<bool> IRCompiledMap::ComputeBoolOutput(const model::PortElementsBase& outputs) const
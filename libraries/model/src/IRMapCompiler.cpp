@@ -17,7 +17,9 @@
 #include <model/optimizer/include/OptimizationPassRegistry.h>
 
 #include <emitters/include/EmitterException.h>
+#include <emitters/include/IRConstantData.h>
 #include <emitters/include/IRMetadata.h>
+#include <emitters/include/IRStateContext.h>
 #include <emitters/include/LLVMUtilities.h>
 #include <emitters/include/Variable.h>
 
@@ -36,6 +38,11 @@ namespace model
         {
             return (node.GetRuntimeTypeName().find("ConvolutionalLayerNode") == 0);
         }
+
+        bool IsFullyConnectedLayerNode(const Node& node)
+        {
+            return (node.GetRuntimeTypeName().find("FullyConnectedLayerNode") == 0);
+        }
     } // namespace
 
     using namespace logging;
@@ -124,12 +131,20 @@ namespace model
 
         EnsureValidMap(map);
 
+        if (GetMapCompilerOptions().reentrant && (GetMapCompilerOptions().profile || GetMapCompilerOptions().compilerSettings.parallelize))
+        {
+            throw emitters::EmitterException(emitters::EmitterError::notSupported, "Re-entrant maps can't be compiled with profiling or parallelization enabled");
+        }
+
         //
         // Temporary special-purpose code to allow the "SetConvolutionMethod" optimization pass to work.
         // When refinement is an integrated part of optimization, then this special-case code will disappear.
         //
         Log() << "Refining the model..." << EOL;
-        model::TransformContext noRefineConvLayerNodesContext{ this, [this](const model::Node& node) { return IsConvolutionalLayerNode(node) || node.IsCompilable(this) ? model::NodeAction::compile : model::NodeAction::refine; } };
+        // Fully-connected layer nodes are also kept whole when quantizing, so the quantization pass can replace them.
+        const bool keepFullyConnectedLayerNodes = GetMapCompilerOptions().optimizerSettings.quantizeNeuralNetworkLayers;
+        auto keepLayerNode = [keepFullyConnectedLayerNodes](const model::Node& node) { return IsConvolutionalLayerNode(node) || (keepFullyConnectedLayerNodes && IsFullyConnectedLayerNode(node)); };
+        model::TransformContext noRefineConvLayerNodesContext{ this, [this, keepLayerNode](const model::Node& node) { return keepLayerNode(node) || node.IsCompilable(this) ? model::NodeAction::compile : model::NodeAction::refine; } };
         map.Refine(noRefineConvLayerNodesContext);
 
         Log() << "Optimizing the model..." << EOL;
@@ -167,6 +182,26 @@ namespace model
         // Finish any profiling stuff we need to do and emit functions
         _profiler.EmitModelProfilerFunctions();
 
+        if (GetMapCompilerOptions().reentrant)
+        {
+            // Callbacks find their object through the context, which now holds the model state instead
+            if (!emitters::GetFunctionsWithTag(GetModule(), emitters::c_callbackFunctionTagName).empty())
+            {
+                throw emitters::EmitterException(emitters::EmitterError::notSupported, "Re-entrant maps can't have source or sink callbacks");
+            }
+
+            Log() << "Moving mutable state into a context struct..." << EOL;
+            emitters::MoveGlobalStateToContext(GetModule(), { GetPredictFunctionName() });
+        }
+
+        // The weights have to leave the module before the optimizer can fold them into the code
+        std::unique_ptr<llvm::Module> weightsModule;
+        if (GetMapCompilerOptions().swappableWeights)
+        {
+            Log() << "Moving the weights into their own module..." << EOL;
+            weightsModule = emitters::MoveConstantDataToModule(*GetModule().GetLLVMModule(), GetModule().GetModuleName() + "_weights");
+        }
+
         auto module = std::make_unique<emitters::IRModuleEmitter>(std::move(_moduleEmitter));
 
         if (GetMapCompilerOptions().compilerSettings.optimize)
@@ -192,7 +227,9 @@ namespace model
             }
         }
 
-        return IRCompiledMap(std::move(map), GetMapCompilerOptions().mapFunctionName, GetMapCompilerOptions(), std::move(module), GetMapCompilerOptions().verifyJittedModule);
+        IRCompiledMap compiledMap(std::move(map), GetMapCompilerOptions().mapFunctionName, GetMapCompilerOptions(), std::move(module), GetMapCompilerOptions().verifyJittedModule);
+        compiledMap._weightsModule = std::move(weightsModule);
+        return compiledMap;
     }
 
     void IRMapCompiler::EmitModelAPIFunctions(const Map& map)
@@ -7,6 +7,7 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "InputPort.h"
+#include "Model.h"
 
 namespace ell
 {
@@ -81,6 +82,7 @@ namespace model
 
     void InputPortBase::SetReferencedPort(const OutputPortBase* input)
     {
+        Model::InvalidateComputeSchedules();
         if (_referencedPort)
         {
             _referencedPort->RemoveReference(this);
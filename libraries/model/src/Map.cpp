@@ -76,7 +76,8 @@ namespace model
         Prune();
     }
 
-    Map::Map(const Map& other)
+    Map::Map(const Map& other) :
+        _computeOptions(other._computeOptions)
     {
         TransformContext context;
         ModelTransformer transformer;
@@ -125,29 +126,58 @@ namespace model
         node->SetInput(inputValues);
     }
 
+    template <typename ValueType>
+    std::vector<ValueType> Map::ComputeModelOutput(const PortElementsBase& outputs) const
+    {
+        if (_computeOptions.numThreads == 1 || _computeOptions.deterministic)
+        {
+            return _model.ComputeOutput<ValueType>(outputs);
+        }
+        return GetExecutor(outputs).ComputeOutput(PortElements<ValueType>(outputs));
+    }
+
+    const ModelExecutor& Map::GetExecutor(const PortElementsBase& outputs) const
+    {
+        std::vector<const OutputPortBase*> ports;
+        for (const auto& range : outputs.GetRanges())
+        {
+            if (std::find(ports.begin(), ports.end(), range.ReferencedPort()) == ports.end())
+            {
+                ports.push_back(range.ReferencedPort());
+            }
+        }
+
+        // The schedule is built once, and rebuilt only if a different set of outputs is requested
+        if (!_executor || _executor->GetOutputs() != ports)
+        {
+            _executor = std::make_unique<ModelExecutor>(_model, ports, _computeOptions);
+        }
+        return *_executor;
+    }
+
     std::vector<bool> Map::ComputeBoolOutput(const PortElementsBase& outputs) const
     {
-        return _model.ComputeOutput<bool>(outputs);
+        return ComputeModelOutput<bool>(outputs);
     }
 
     std::vector<int> Map::ComputeIntOutput(const PortElementsBase& outputs) const
     {
-        return _model.ComputeOutput<int>(outputs);
+        return ComputeModelOutput<int>(outputs);
     }
 
     std::vector<int64_t> Map::ComputeInt64Output(const PortElementsBase& outputs) const
     {
-        return _model.ComputeOutput<int64_t>(outputs);
+        return ComputeModelOutput<int64_t>(outputs);
     }
 
     std::vector<float> Map::ComputeFloatOutput(const PortElementsBase& outputs) const
     {
-        return _model.ComputeOutput<float>(outputs);
+        return ComputeModelOutput<float>(outputs);
     }
 
     std::vector<double> Map::ComputeDoubleOutput(const PortElementsBase& outputs) const
     {
-        return _model.ComputeOutput<double>(outputs);
+        return ComputeModelOutput<double>(outputs);
     }
 
     template <>
@@ -185,6 +215,12 @@ namespace model
         _model.Reset();
     }
 
+    void Map::SetComputeOptions(const ModelExecutorOptions& options)
+    {
+        _computeOptions = options;
+        _executor.reset();
+    }
+
     void Map::AddInput(const std::string& inputName, InputNodeBase* inputNode)
     {
         _inputNodes.push_back(inputNode);
@@ -220,6 +256,8 @@ namespace model
         swap(a._outputNames, b._outputNames);
         swap(a._outputElementsMap, b._outputElementsMap);
         swap(a._metadata, b._metadata);
+        swap(a._computeOptions, b._computeOptions);
+        swap(a._executor, b._executor);
     }
 
     std::vector<const Node*> Map::GetAllOutputNodes() const
@@ -367,6 +405,7 @@ namespace model
         auto minimalModel = transformer.CopySubmodel(m, context);
         FixTransformedIO(transformer);
         _model = std::move(minimalModel.GetModel());
+        _executor.reset();
     }
 
     size_t Map::GetNumInputs() const
@@ -512,6 +551,7 @@ namespace model
         auto refinedModel = transformer.RefineModel(_model, context, maxIterations);
         FixTransformedIO(transformer);
         _model = std::move(refinedModel);
+        _executor.reset();
         Prune();
     }
 
@@ -522,6 +562,7 @@ namespace model
 
         FixTransformedIO(context);
         _model = std::move(optimizedModel);
+        _executor.reset();
         Prune();
     }
     
@@ -537,6 +578,7 @@ namespace model
         auto refinedModel = transformer.TransformModel(_model, context, transformFunction);
         FixTransformedIO(transformer);
         _model = std::move(refinedModel);
+        _executor.reset();
     }
 
     void Map::RenameCallbacks(const std::string& sourceCallbackName, const std::string& sinkCallbackName)
@@ -604,6 +646,7 @@ namespace model
 
         // Unarchive the model
         archiver["model"] >> _model;
+        _executor.reset();
 
         // Unarchive the inputs
         std::vector<utilities::UniqueId> inputIds;
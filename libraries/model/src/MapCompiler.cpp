@@ -17,6 +17,8 @@
 
 #include <utilities/include/Logger.h>
 
+#include <algorithm>
+
 namespace ell
 {
 namespace model
@@ -44,6 +46,11 @@ namespace model
             std::string("Output size: ") + std::to_string(outputSize)
         };
 
+        if (_parameters.reusePortBuffers)
+        {
+            ComputePortLifetimes(map.GetModel());
+        }
+
         OnBeginCompileModel(map.GetModel());
         CompileNodes(map.GetModel());
         OnEndCompileModel(map.GetModel());
@@ -54,7 +61,8 @@ namespace model
 
     void MapCompiler::CompileNodes(Model& model)
     {
-        model.Visit([this](const Node& node) {
+        int nodeIndex = 0;
+        model.Visit([this, &nodeIndex](const Node& node) {
             if (!node.IsCompilable(this))
             {
                 std::string typeName = node.GetRuntimeTypeName();
@@ -68,17 +76,104 @@ namespace model
             OnBeginCompileNode(node);
             compilableNode->CompileNode(*this);
             OnEndCompileNode(node);
+
+            if (_parameters.reusePortBuffers)
+            {
+                ReleaseDeadPortVariables(nodeIndex);
+            }
+            ++nodeIndex;
+        });
+    }
+
+    void MapCompiler::ComputePortLifetimes(const Model& model)
+    {
+        // Nodes are compiled in visit order, so a port is live from the node that produces it until the last node that reads it
+        _portLastUse.clear();
+        _livePortVariables.clear();
+        _freePortVariables.clear();
+
+        int nodeIndex = 0;
+        model.Visit([this, &nodeIndex](const Node& node) {
+            for (auto output : node.GetOutputPorts())
+            {
+                _portLastUse[output] = nodeIndex;
+            }
+            for (auto input : node.GetInputPorts())
+            {
+                auto& lastUse = _portLastUse[&input->GetReferencedPort()];
+                lastUse = std::max(lastUse, nodeIndex);
+            }
+            ++nodeIndex;
         });
     }
 
+    emitters::Variable* MapCompiler::TryReusePortVariable(const OutputPortBase& port)
+    {
+        // Pick the smallest free buffer of the right type that is large enough to hold the port
+        auto varType = PortTypeToVariableType(port.GetType());
+        auto best = _freePortVariables.end();
+        for (auto it = _freePortVariables.begin(); it != _freePortVariables.end(); ++it)
+        {
+            auto pVar = *it;
+            if (pVar->Type() == varType && pVar->Dimension() >= port.Size() && (best == _freePortVariables.end() || pVar->Dimension() < (*best)->Dimension()))
+            {
+                best = it;
+            }
+        }
+
+        if (best == _freePortVariables.end())
+        {
+            return nullptr;
+        }
+
+        auto pVar = *best;
+        _freePortVariables.erase(best);
+        return pVar;
+    }
+
+    void MapCompiler::ReleaseDeadPortVariables(int nodeIndex)
+    {
+        auto isDead = [this, nodeIndex](const Port* port) {
+            auto lastUse = _portLastUse.find(port);
+            return lastUse != _portLastUse.end() && lastUse->second <= nodeIndex;
+        };
+
+        auto it = _livePortVariables.begin();
+        while (it != _livePortVariables.end())
+        {
+            if (std::all_of(it->ports.begin(), it->ports.end(), isDead))
+            {
+                _freePortVariables.push_back(it->variable);
+                it = _livePortVariables.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
     emitters::Variable* MapCompiler::AllocatePortVariable(const OutputPortBase& port)
     {
         auto pModuleEmitter = GetModuleEmitter();
         assert(port.Size() != 0);
 
-        emitters::VariableType varType = PortTypeToVariableType(port.GetType());
-        auto pVar = pModuleEmitter->Variables().AddVectorVariable(emitters::VariableScope::global, varType, port.Size());
-        pModuleEmitter->AllocateVariable(*pVar);
+        // Only ports of the top-level predict function can share buffers; node functions have their own scopes. A padded
+        // port only writes the inside of its buffer, and counts on the padding being zero, so it always gets a fresh one.
+        bool canShare = _parameters.reusePortBuffers && _portToVarMaps.size() == 1;
+        bool canReuse = canShare && !port.GetMemoryLayout().HasPadding();
+        emitters::Variable* pVar = canReuse ? TryReusePortVariable(port) : nullptr;
+        if (pVar == nullptr)
+        {
+            emitters::VariableType varType = PortTypeToVariableType(port.GetType());
+            pVar = pModuleEmitter->Variables().AddVectorVariable(emitters::VariableScope::global, varType, port.Size());
+            pModuleEmitter->AllocateVariable(*pVar);
+        }
+
+        if (canShare)
+        {
+            _livePortVariables.push_back({ pVar, {} });
+        }
         SetVariableForPort(port, pVar);
         return pVar;
     }
@@ -167,6 +262,19 @@ namespace model
     void MapCompiler::SetVariableForPort(const Port& port, emitters::Variable* pVar)
     {
         _portToVarMaps.back()[&port] = pVar;
+
+        // A shared buffer stays live until every port that refers to it (including aliases set up by pass-through nodes) is dead
+        if (_portToVarMaps.size() == 1)
+        {
+            for (auto& liveVar : _livePortVariables)
+            {
+                if (liveVar.variable == pVar)
+                {
+                    liveVar.ports.push_back(&port);
+                    break;
+                }
+            }
+        }
     }
 
     void MapCompiler::SetVariableForElement(const PortElementBase& element, emitters::Variable* pVar)
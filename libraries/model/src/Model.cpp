@@ -16,6 +16,7 @@
 #include <utilities/include/StringUtil.h>
 
 #include <algorithm>
+#include <atomic>
 #include <unordered_map>
 
 namespace ell
@@ -30,6 +31,10 @@ namespace model
         constexpr utilities::ArchiveVersion noMetadataArchiveVersion = { utilities::ArchiveVersionNumbers::v2 };
         constexpr utilities::ArchiveVersion metadataArchiveVersion = { utilities::ArchiveVersionNumbers::v3_model_metadata };
 
+        // Ports don't know which model they belong to, so any edit to any model invalidates every cached schedule.
+        // Edits are rare outside of model construction and transformation, so this is cheap in practice.
+        std::atomic<uint64_t> modelEditCount{ 1 };
+
         //
         // Utility functions
         //
@@ -253,8 +258,38 @@ namespace model
         Visit(reset);
     }
 
+    std::shared_ptr<const std::vector<const Node*>> Model::GetComputeSchedule(const std::vector<const OutputPortBase*>& outputs) const
+    {
+        auto key = outputs;
+        std::sort(key.begin(), key.end());
+        key.erase(std::unique(key.begin(), key.end()), key.end());
+
+        std::lock_guard<std::mutex> lock(_data->scheduleMutex);
+        auto editCount = modelEditCount.load();
+        if (_data->scheduleEditCount != editCount)
+        {
+            _data->schedules.clear();
+            _data->scheduleEditCount = editCount;
+        }
+
+        auto& schedule = _data->schedules[key];
+        if (!schedule)
+        {
+            auto newSchedule = std::make_shared<NodeSchedule>();
+            VisitSubmodel(key, [&newSchedule](const Node& node) { newSchedule->push_back(&node); });
+            schedule = newSchedule;
+        }
+        return schedule;
+    }
+
+    void Model::InvalidateComputeSchedules()
+    {
+        ++modelEditCount;
+    }
+
     Node* Model::AddExistingNode(std::unique_ptr<Node> node)
     {
+        InvalidateComputeSchedules();
         std::shared_ptr<Node> sharedNode(std::move(node));
         EnsureNodeHasUniqueId(*sharedNode);
         sharedNode->UpdateInputPorts();
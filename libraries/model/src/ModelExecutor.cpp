@@ -0,0 +1,152 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ModelExecutor.cpp (model)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ModelExecutor.h"
+#include "Model.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace ell
+{
+namespace model
+{
+    ModelExecutor::ModelExecutor(const Model& model, const std::vector<const OutputPortBase*>& outputs, const ModelExecutorOptions& options) :
+        _outputs(outputs),
+        _options(options)
+    {
+        std::unordered_map<const Node*, size_t> scheduleIndex;
+        for (auto node : *model.GetComputeSchedule(outputs))
+        {
+            scheduleIndex[node] = _schedule.size();
+            _schedule.push_back(node);
+        }
+
+        const auto numNodes = _schedule.size();
+        _dependents.resize(numNodes);
+        _numParents.resize(numNodes);
+        for (size_t index = 0; index < numNodes; ++index)
+        {
+            std::unordered_set<size_t> parents;
+            for (auto parent : _schedule[index]->GetParentNodes())
+            {
+                auto parentIndex = scheduleIndex.find(parent);
+                if (parentIndex != scheduleIndex.end() && parents.insert(parentIndex->second).second)
+                {
+                    _dependents[parentIndex->second].push_back(index);
+                }
+            }
+            _numParents[index] = parents.size();
+        }
+
+        auto numThreads = _options.numThreads == 0 ? utilities::ThreadPool::GetNumHardwareThreads() : _options.numThreads;
+        if (!_options.deterministic && numThreads > 1 && numNodes > 1)
+        {
+            _threadPool = std::make_unique<utilities::ThreadPool>(numThreads);
+        }
+    }
+
+    void ModelExecutor::Compute() const
+    {
+        if (_threadPool)
+        {
+            ComputeParallel();
+        }
+        else
+        {
+            ComputeSequential();
+        }
+    }
+
+    void ModelExecutor::ComputeSequential() const
+    {
+        for (auto node : _schedule)
+        {
+            node->Compute();
+        }
+    }
+
+    void ModelExecutor::ComputeParallel() const
+    {
+        const auto numNodes = _schedule.size();
+        if (numNodes == 0)
+        {
+            return;
+        }
+
+        auto remainingParents = std::make_unique<std::atomic<size_t>[]>(numNodes);
+        for (size_t index = 0; index < numNodes; ++index)
+        {
+            remainingParents[index] = _numParents[index];
+        }
+
+        std::mutex mutex;
+        std::condition_variable allFinished;
+        size_t numFinished = 0;
+        std::atomic<bool> failed(false);
+        std::exception_ptr error;
+
+        // Computes a node, then schedules each dependent whose parents have now all finished. After a
+        // failure the remaining nodes are still visited (without being computed), so the count of finished
+        // nodes always reaches `numNodes`.
+        std::function<void(size_t)> computeNode = [&](size_t index) {
+            if (!failed)
+            {
+                try
+                {
+                    _schedule[index]->Compute();
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+                    failed = true;
+                }
+            }
+
+            for (auto dependent : _dependents[index])
+            {
+                if (--remainingParents[dependent] == 0)
+                {
+                    _threadPool->Run([&computeNode, dependent]() { computeNode(dependent); });
+                }
+            }
+
+            // Notify while holding the lock, so the waiting thread can't return (and destroy these locals) first
+            std::lock_guard<std::mutex> lock(mutex);
+            if (++numFinished == numNodes)
+            {
+                allFinished.notify_all();
+            }
+        };
+
+        for (size_t index = 0; index < numNodes; ++index)
+        {
+            if (_numParents[index] == 0)
+            {
+                _threadPool->Run([&computeNode, index]() { computeNode(index); });
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        allFinished.wait(lock, [&]() { return numFinished == numNodes; });
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+} // namespace model
+} // namespace ell
@@ -34,6 +34,7 @@ void TestCompilableAccumulatorNode();
 void TestCompilableDotProductNode();
 void TestCompilableDelayNode();
 void TestCompilableDTWDistanceNode();
+void TestCompilableFlatForestPredictorNode();
 void TestCompilableMulticlassDTW();
 void TestCompilableScalarSumNode();
 void TestCompilableSumNode();
@@ -95,8 +96,10 @@ void TestConvolutionalLayerNode(ConvolutionMethod convolutionMethod, size_t inpu
 void TestConvolutionalLayerNode2(ConvolutionMethod convolutionMethod, size_t inputPadding = 1, size_t outputPadding = 0);
 void TestConvolutionalLayerNode3(ConvolutionMethod convolutionMethod, size_t inputPadding = 1, size_t outputPadding = 0);
 void TestFullyConnectedLayerNode(size_t inputPadding = 0, size_t outputPadding = 0);
+void TestQuantizedFullyConnectedLayerNode();
 void TestMaxPoolingLayerNode(size_t inRows, size_t inCols, size_t numChannels, size_t outRows, size_t outCols, size_t poolingSize, size_t poolingStride, size_t inputPadding = 0, size_t outputPadding = 0);
 void TestMeanPoolingLayerNode(size_t inRows, size_t inCols, size_t numChannels, size_t outRows, size_t outCols, size_t poolingSize, size_t poolingStride, size_t inputPadding = 0, size_t outputPadding = 0);
+void TestReusePortBuffersWithPadding();
 void TestScalingLayerNode(size_t inputPadding = 0, size_t outputPadding = 0);
 void TestSoftmaxLayerNode(size_t inputPadding = 0, size_t outputPadding = 0);
 void TestFusedLinearLayerNodes(size_t rows, size_t columns, size_t channels);
@@ -55,6 +55,13 @@ void TestCombineOutputMap();
 void TestMultiOutputMap();
 void TestMultiSourceSinkMap();
 void TestCompiledMapMove();
+void TestComputeIntoBuffers();
+void TestReusePortBuffers();
+void TestReentrantMap();
+void TestJitObjectCache();
+void TestLazyJitObjectCache();
+void TestBackgroundJitting();
+void TestLazyJitWeightSwap();
 
 #pragma region implementation
 
@@ -10,6 +10,8 @@
 void TestMapCreate();
 void TestMapCompute();
 void TestMapComputeDataVector();
+void TestMapParallelCompute();
+void TestMapParallelComputeAfterRefine();
 void TestMapRefine();
 void TestMapSerialization();
 void TestMapClockNode();
@@ -8,6 +8,7 @@
 #pragma once
 
 void TestStaticModel();
+void TestComputeScheduleCache();
 void TestNodeIterator();
 void TestReverseNodeIterator();
 
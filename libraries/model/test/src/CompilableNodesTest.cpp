@@ -43,6 +43,7 @@
 #include <nodes/include/DotProductNode.h>
 #include <nodes/include/ExtremalValueNode.h>
 #include <nodes/include/FFTNode.h>
+#include <nodes/include/FlatForestPredictorNode.h>
 #include <nodes/include/FullyConnectedLayerNode.h>
 #include <nodes/include/IRNode.h>
 #include <nodes/include/L2NormSquaredNode.h>
@@ -52,6 +53,7 @@
 #include <nodes/include/MultiplexerNode.h>
 #include <nodes/include/NeuralNetworkPredictorNode.h>
 #include <nodes/include/PoolingLayerNode.h>
+#include <nodes/include/QuantizedFullyConnectedLayerNode.h>
 #include <nodes/include/ReceptiveFieldMatrixNode.h>
 #include <nodes/include/RegionDetectionLayerNode.h>
 #include <nodes/include/ReinterpretLayoutNode.h>
@@ -91,6 +93,7 @@
 #include <utilities/include/RandomEngines.h>
 
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <ostream>
 #include <sstream>
@@ -261,6 +264,54 @@ void TestCompilableDTWDistanceNode()
     });
 }
 
+void TestCompilableFlatForestPredictorNode()
+{
+    using SplitAction = predictors::SimpleForestPredictor::SplitAction;
+    using SplitRule = predictors::SingleElementThresholdPredictor;
+    using EdgePredictorVector = std::vector<predictors::ConstantPredictor>;
+
+    predictors::SimpleForestPredictor forest;
+    auto root = forest.Split(SplitAction{ forest.GetNewRootId(), SplitRule{ 0, 0.3 }, EdgePredictorVector{ -1.0, 1.0 } });
+    auto child1 = forest.Split(SplitAction{ forest.GetChildId(root, 0), SplitRule{ 1, 0.6 }, EdgePredictorVector{ -2.0, 2.0 } });
+    forest.Split(SplitAction{ forest.GetChildId(child1, 1), SplitRule{ 1, 0.7 }, EdgePredictorVector{ -2.2, 2.2 } });
+    forest.Split(SplitAction{ forest.GetChildId(root, 1), SplitRule{ 2, 0.9 }, EdgePredictorVector{ -4.0, 4.0 } });
+    auto root2 = forest.Split(SplitAction{ forest.GetNewRootId(), SplitRule{ 0, 0.2 }, EdgePredictorVector{ -3.0, 3.0 } });
+    forest.Split(SplitAction{ forest.GetChildId(root2, 1), SplitRule{ 1, 0.22 }, EdgePredictorVector{ -3.2, 3.2 } });
+    forest.AddToBias(0.5);
+
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<double>>(3);
+    auto forestNode = model.AddNode<nodes::FlatForestPredictorNode>(inputNode->output, forest);
+    // Compiled maps have a single output, so each output of the node gets its own map
+    auto outputMap = model::Map(model, { { "input", inputNode } }, { { "output", forestNode->output } });
+    auto treeOutputsMap = model::Map(model, { { "input", inputNode } }, { { "treeOutputs", forestNode->treeOutputs } });
+
+    std::vector<std::vector<double>> signal = { { 0.1, 0.5, 0.0 }, { 0.25, 0.65, 1.0 }, { 0.4, 0.8, 0.5 }, { 0.9, 0.1, 0.95 } };
+    std::string name = "FlatForestPredictorNode";
+    TestWithSerialization(outputMap, name, [&](model::Map& map, int iteration) {
+        model::IRMapCompiler compiler;
+        auto compiledMap = compiler.Compile(map);
+        for (const auto& input : signal)
+        {
+            auto computedOutput = map.Compute<double>(input);
+            auto compiledOutput = compiledMap.Compute<double>(input);
+            auto expectedOutput = forest.Predict(predictors::SimpleForestPredictor::DataVectorType(input));
+            testing::ProcessTest(utilities::FormatString("%s iteration %d (output)", name.c_str(), iteration), testing::IsEqual(computedOutput[0], expectedOutput) && testing::IsEqual(compiledOutput, computedOutput));
+        }
+    });
+
+    TestWithSerialization(treeOutputsMap, name, [&](model::Map& map, int iteration) {
+        model::IRMapCompiler compiler;
+        auto compiledMap = compiler.Compile(map);
+        for (const auto& input : signal)
+        {
+            auto computedTreeOutputs = map.Compute<double>(input);
+            auto compiledTreeOutputs = compiledMap.Compute<double>(input);
+            testing::ProcessTest(utilities::FormatString("%s iteration %d (treeOutputs)", name.c_str(), iteration), testing::IsEqual(compiledTreeOutputs, computedTreeOutputs));
+        }
+    });
+}
+
 class LabeledPrototype
 {
 public:
@@ -2886,6 +2937,64 @@ void TestFullyConnectedLayerNode(size_t inputPaddingSize, size_t outputPaddingSi
     VerifyArchiveAndUnarchivingMap<ElementType>(map, computeNode, inputWithPadding, output);
 }
 
+void TestQuantizedFullyConnectedLayerNode()
+{
+    using ElementType = float;
+    using LayerType = predictors::neural::FullyConnectedLayer<ElementType>;
+    using LayerParameters = typename LayerType::LayerParameters;
+    using TensorType = typename LayerType::TensorType;
+    using MatrixType = typename LayerType::MatrixType;
+    const size_t numInputs = 37; // not a multiple of the vector width
+    const size_t numOutputs = 6;
+
+    TensorType input(1, 1, numInputs);
+    LayerParameters parameters{ input, predictors::neural::NoPadding(), { numOutputs, 1, 1 }, predictors::neural::NoPadding() };
+    MatrixType weights(numOutputs, numInputs);
+    for (size_t row = 0; row < numOutputs; ++row)
+    {
+        for (size_t column = 0; column < numInputs; ++column)
+        {
+            weights(row, column) = static_cast<ElementType>(std::sin(row * numInputs + column));
+        }
+    }
+    LayerType layer(parameters, weights);
+
+    const ElementType inputRange = 4;
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<ElementType>>(numInputs);
+    auto computeNode = model.AddNode<nodes::QuantizedFullyConnectedLayerNode<ElementType>>(inputNode->output, layer, inputRange);
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", computeNode->output } });
+
+    std::vector<std::vector<ElementType>> signal;
+    for (int index = 0; index < 4; ++index)
+    {
+        std::vector<ElementType> entry(numInputs);
+        for (size_t column = 0; column < numInputs; ++column)
+        {
+            entry[column] = static_cast<ElementType>(inputRange * std::cos(0.3 * (index * numInputs + column)));
+        }
+        signal.push_back(entry);
+    }
+
+    // The quantized result should be close to the floating-point one
+    auto floatModel = model::Model();
+    auto floatInputNode = floatModel.AddNode<model::InputNode<ElementType>>(numInputs);
+    auto floatComputeNode = floatModel.AddNode<nodes::FullyConnectedLayerNode<ElementType>>(floatInputNode->output, layer);
+    auto floatMap = model::Map(floatModel, { { "input", floatInputNode } }, { { "output", floatComputeNode->output } });
+    bool ok = true;
+    for (const auto& entry : signal)
+    {
+        auto expected = floatMap.Compute<ElementType>(entry);
+        auto actual = map.Compute<ElementType>(entry);
+        ok = ok && testing::IsEqual(expected, actual, 0.5f);
+    }
+    testing::ProcessTest("Testing QuantizedFullyConnectedLayerNode against FullyConnectedLayerNode", ok);
+
+    model::IRMapCompiler compiler;
+    auto compiledMap = compiler.Compile(map);
+    VerifyCompiledOutput(map, compiledMap, signal, computeNode->GetRuntimeTypeName());
+}
+
 template <typename ElementType, template <typename> class PoolingFunction>
 void TestPoolingLayerNode(size_t inRows, size_t inCols, size_t numChannels, size_t outRows, size_t outCols, size_t poolingSize, size_t poolingStride, size_t inputPaddingSize, size_t outputPaddingSize, double epsilon)
 {
@@ -2945,6 +3054,62 @@ void TestMeanPoolingLayerNode(size_t inRows, size_t inCols, size_t numChannels,
     TestPoolingLayerNode<float, MeanPoolingFunction>(inRows, inCols, numChannels, outRows, outCols, poolingSize, poolingStride, inputPaddingSize, outputPaddingSize, 1e-5);
 }
 
+void TestReusePortBuffersWithPadding()
+{
+    // A pooling layer with a padded output feeds a convolutional layer that reads the padding. The first intermediate
+    // result is dead by the time the pooling output is allocated, so its (nonzero) buffer would be reused if padded
+    // ports could share buffers.
+    using ElementType = double;
+    using LayerParameters = typename Layer<ElementType>::LayerParameters;
+    using TensorType = typename Layer<ElementType>::TensorType;
+    using Shape = typename Layer<ElementType>::Shape;
+
+    const size_t numRows = 8;
+    const size_t numCols = 8;
+    const size_t numChannels = 2;
+    const size_t numFilters = 2;
+    const size_t padding = 1;
+    const size_t inputSize = numRows * numCols * numChannels;
+
+    auto rng = utilities::GetRandomEngine("123");
+    auto rand = [&rng]() { return (double)rng() / (double)(rng.max() - rng.min()); };
+
+    TensorType poolingInput(numRows, numCols, numChannels);
+    Shape poolingOutputShape = { numRows / 2 + 2 * padding, numCols / 2 + 2 * padding, numChannels };
+    LayerParameters poolingParameters{ poolingInput, NoPadding(), poolingOutputShape, ZeroPadding(padding) };
+    PoolingLayer<ElementType, MaxPoolingFunction> poolingLayer(poolingParameters, PoolingParameters{ 2, 2 });
+
+    LayerParameters convolutionalParameters{ poolingLayer.GetOutput(), ZeroPadding(padding), { numRows / 2, numCols / 2, numFilters }, NoPadding() };
+    ConvolutionalParameters convolutionalParams{ 3, 1, ConvolutionMethod::unrolled, 1 };
+    TensorType weights(convolutionalParams.receptiveField * numFilters, convolutionalParams.receptiveField, numChannels);
+    weights.Generate(rand);
+    ConvolutionalLayer<ElementType> convolutionalLayer(convolutionalParameters, convolutionalParams, weights);
+
+    std::vector<ElementType> offsets(inputSize);
+    std::generate(offsets.begin(), offsets.end(), [&rand]() { return rand() + 1; });
+
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<ElementType>>(inputSize);
+    auto constantNode = model.AddNode<nodes::ConstantNode<ElementType>>(offsets);
+    auto add1Node = model.AddNode<nodes::BinaryOperationNode<ElementType>>(inputNode->output, constantNode->output, nodes::BinaryOperationType::add);
+    auto add2Node = model.AddNode<nodes::BinaryOperationNode<ElementType>>(add1Node->output, constantNode->output, nodes::BinaryOperationType::add);
+    auto poolingNode = model.AddNode<nodes::PoolingLayerNode<ElementType, MaxPoolingFunction>>(add2Node->output, poolingLayer);
+    auto convolutionalNode = model.AddNode<nodes::ConvolutionalLayerNode<ElementType>>(poolingNode->output, convolutionalLayer);
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", convolutionalNode->output } });
+
+    model::MapCompilerOptions settings;
+    settings.reusePortBuffers = true;
+    model::IRMapCompiler compiler(settings);
+    auto compiledMap = compiler.Compile(map);
+
+    std::vector<std::vector<ElementType>> signal(2, std::vector<ElementType>(inputSize));
+    for (auto& input : signal)
+    {
+        std::generate(input.begin(), input.end(), [&rand]() { return rand() - 0.5; });
+    }
+    VerifyCompiledOutput(map, compiledMap, signal, "padded pooling output with reused port buffers");
+}
+
 void TestScalingLayerNode(size_t inputPaddingSize, size_t outputPaddingSize)
 {
     using ElementType = double;
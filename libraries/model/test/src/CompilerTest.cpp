@@ -37,19 +37,27 @@
 #include <emitters/include/IREmitter.h>
 #include <emitters/include/IRFunctionEmitter.h>
 #include <emitters/include/IRModuleEmitter.h>
+#include <emitters/include/IRObjectCache.h>
 #include <emitters/include/ScalarVariable.h>
 #include <emitters/include/VectorVariable.h>
 
 #include <predictors/include/LinearPredictor.h>
 #include <predictors/include/ProtoNNPredictor.h>
 
+#include <utilities/include/Files.h>
 #include <utilities/include/Logger.h>
 
 #include <testing/include/testing.h>
 
+#include <llvm/Target/TargetMachine.h>
+#include <llvm/Transforms/Utils/Cloning.h>
+
+#include <cstdio>
 #include <iostream>
 #include <ostream>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 
 using namespace ell;
@@ -335,6 +343,370 @@ void TestCompiledMapMove()
     VerifyCompiledOutput(map, compiledMap2, signal, " moved compiled map");
 }
 
+void TestComputeIntoBuffers()
+{
+    ModelMaker mb;
+    auto input = mb.Inputs<double>(4);
+    auto c1 = mb.Constant<double>({ 5, 10, 15, 20 });
+    auto addNode = mb.Add(c1->output, input->output);
+    model::Map map{ mb.Model, { { "input", input } }, { { "output", addNode->output } } };
+
+    model::IRMapCompiler compiler;
+    auto compiledMap = compiler.Compile(map);
+
+    std::vector<std::vector<double>> signal = { { 1, 2, 3, 4 }, { -5, 0, 5, 10 }, { 7, 8, 9, 10 } };
+    std::vector<double> output(4);
+    bool ok = true;
+    for (const auto& example : signal)
+    {
+        compiledMap.Compute(example.data(), output.data());
+        ok = ok && testing::IsEqual(output, map.Compute<double>(example));
+    }
+    testing::ProcessTest("Testing compute into caller-owned buffers", ok);
+
+    std::vector<float> floatOutput(4);
+    bool threw = false;
+    try
+    {
+        compiledMap.Compute(signal[0].data(), floatOutput.data());
+    }
+    catch (const utilities::InputException&)
+    {
+        threw = true;
+    }
+    testing::ProcessTest("Testing compute into caller-owned buffers with the wrong type", threw);
+}
+
+void TestReusePortBuffers()
+{
+    // A chain of elementwise operations, where each intermediate result is only needed by the next node
+    ModelMaker mb;
+    auto input = mb.Inputs<double>(4);
+    auto c1 = mb.Constant<double>({ 5, 10, 15, 20 });
+    auto c2 = mb.Constant<double>({ 1, 2, 3, 4 });
+    auto add1 = mb.Add(input->output, c1->output);
+    auto multiply1 = mb.Multiply(add1->output, c2->output);
+    auto add2 = mb.Add(multiply1->output, input->output);
+    auto multiply2 = mb.Multiply(add2->output, add1->output);
+    auto add3 = mb.Add(multiply2->output, c2->output);
+    model::Map map{ mb.Model, { { "input", input } }, { { "output", add3->output } } };
+
+    model::MapCompilerOptions settings;
+    settings.reusePortBuffers = true;
+    model::IRMapCompiler compiler(settings);
+    auto compiledMap = compiler.Compile(map);
+
+    std::vector<std::vector<double>> signal = { { 1, 2, 3, 4 }, { -4, 5, 0, 6 }, { 7, 8, 9, -1 } };
+    VerifyCompiledOutput(map, compiledMap, signal, " map with reused port buffers");
+
+    // without reuse, there's a global for each intermediate result. LLVM's optimizer removes the globals of a
+    // chain this short altogether, so the globals are counted in unoptimized modules
+    auto countGlobals = [&map](bool reusePortBuffers) {
+        model::MapCompilerOptions settings;
+        settings.reusePortBuffers = reusePortBuffers;
+        settings.compilerSettings.optimize = false;
+        model::IRMapCompiler compiler(settings);
+        auto compiledMap = compiler.Compile(map);
+        return compiledMap.GetModule().GetLLVMModule()->global_size();
+    };
+    testing::ProcessTest("Testing that port buffers were reused", countGlobals(true) < countGlobals(false));
+}
+
+void TestReentrantMap()
+{
+    // the reference map's delay state can't be reset, so each signal gets a fresh map
+    auto makeMap = []() {
+        ModelMaker mb;
+        auto input = mb.Inputs<double>(4);
+        auto delay = mb.Delay<double>(input->output, 2);
+        auto c1 = mb.Constant<double>({ 5, 10, 15, 20 });
+        auto addNode = mb.Add(delay->output, c1->output);
+        return model::Map{ mb.Model, { { "input", input } }, { { "output", addNode->output } } };
+    };
+    auto map = makeMap();
+
+    model::MapCompilerOptions settings;
+    settings.reentrant = true;
+    model::IRMapCompiler compiler(settings);
+    auto compiledMap = compiler.Compile(map);
+
+    auto header = compiledMap.GetCodeHeaderString();
+    testing::ProcessTest("Testing re-entrant map header declares context functions", header.find("_AllocateContext") != std::string::npos && header.find("_FreeContext") != std::string::npos);
+
+    std::vector<std::vector<std::vector<double>>> signals = {
+        { { 1, 2, 3, 4 }, { -5, 0, 5, 10 }, { 7, 8, 9, 10 }, { 3, 1, 4, 1 } },
+        { { 2, 7, 1, 8 }, { 0, 0, 0, 1 }, { -1, -2, -3, -4 }, { 5, 9, 2, 6 } }
+    };
+    std::vector<std::vector<std::vector<double>>> expected(signals.size());
+    for (size_t index = 0; index < signals.size(); ++index)
+    {
+        auto referenceMap = makeMap();
+        for (const auto& example : signals[index])
+        {
+            expected[index].push_back(referenceMap.Compute<double>(example));
+        }
+    }
+
+    // interleave the signals on one thread, each with its own state
+    std::vector<void*> contexts = { compiledMap.AllocateContext(), compiledMap.AllocateContext() };
+    bool ok = true;
+    std::vector<double> output(4);
+    for (size_t exampleIndex = 0; exampleIndex < signals[0].size(); ++exampleIndex)
+    {
+        for (size_t index = 0; index < signals.size(); ++index)
+        {
+            compiledMap.Compute(signals[index][exampleIndex].data(), output.data(), contexts[index]);
+            ok = ok && testing::IsEqual(output, expected[index][exampleIndex]);
+        }
+    }
+    testing::ProcessTest("Testing re-entrant map with interleaved contexts", ok);
+
+    // run the signals on separate threads, with fresh contexts
+    compiledMap.FinishJitting();
+    std::vector<std::vector<std::vector<double>>> threadOutputs(signals.size());
+    std::vector<std::thread> threads;
+    for (size_t index = 0; index < signals.size(); ++index)
+    {
+        compiledMap.FreeContext(contexts[index]);
+        contexts[index] = compiledMap.AllocateContext();
+        threads.emplace_back([&, index]() {
+            for (const auto& example : signals[index])
+            {
+                std::vector<double> threadOutput(4);
+                compiledMap.Compute(example.data(), threadOutput.data(), contexts[index]);
+                threadOutputs[index].push_back(threadOutput);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    for (auto context : contexts)
+    {
+        compiledMap.FreeContext(context);
+    }
+    testing::ProcessTest("Testing re-entrant map on concurrent threads", threadOutputs == expected);
+
+    // jit a fresh copy of the map from several threads at once, also with the lazyJit option
+    for (auto lazyJit : { false, true })
+    {
+        auto freshSettings = settings;
+        freshSettings.lazyJit = lazyJit;
+        model::IRMapCompiler freshCompiler(freshSettings);
+        auto freshMap = freshCompiler.Compile(map);
+        std::vector<std::vector<std::vector<double>>> freshOutputs(signals.size());
+        threads.clear();
+        for (size_t index = 0; index < signals.size(); ++index)
+        {
+            threads.emplace_back([&, index]() {
+                auto context = freshMap.AllocateContext();
+                for (const auto& example : signals[index])
+                {
+                    std::vector<double> threadOutput(4);
+                    freshMap.Compute(example.data(), threadOutput.data(), context);
+                    freshOutputs[index].push_back(threadOutput);
+                }
+                freshMap.FreeContext(context);
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+        testing::ProcessTest(std::string("Testing re-entrant map jitted from concurrent threads") + (lazyJit ? " with lazyJit" : ""), freshOutputs == expected);
+    }
+
+    // the calls that don't take a context use one owned by the map
+    auto referenceMap = makeMap();
+    VerifyCompiledOutput(referenceMap, compiledMap, signals[0], " re-entrant map with its default context");
+}
+
+void TestJitObjectCache()
+{
+    ModelMaker mb;
+    auto input = mb.Inputs<double>(4);
+    auto c1 = mb.Constant<double>({ 5, 10, 15, 20 });
+    auto addNode = mb.Add(c1->output, input->output);
+    model::Map map{ mb.Model, { { "input", input } }, { { "output", addNode->output } } };
+
+    auto cachePath = OutputPath("objectCache");
+    model::MapCompilerOptions settings;
+    settings.objectCachePath = cachePath;
+    model::IRMapCompiler compiler(settings);
+    auto compiledMap = compiler.Compile(map);
+
+    std::vector<std::vector<double>> signal = { { 1, 2, 3, 4 }, { -5, 0, 5, 10 }, { 7, 8, 9, 10 } };
+    VerifyCompiledOutput(map, compiledMap, signal, " map compiled with an object cache");
+
+    // the first engine to compile the module stores its machine code, and the next one loads it. The engine gives a
+    // module without a data layout the host's, so the modules get it up front, or they'd be cached under another name.
+    auto module = compiledMap.GetModule().GetLLVMModule();
+    auto dataLayout = std::unique_ptr<llvm::TargetMachine>(llvm::EngineBuilder().selectTarget())->createDataLayout();
+    auto copyModule = [module, &dataLayout]() {
+        auto moduleCopy = std::unique_ptr<llvm::Module>(llvm::CloneModule(module));
+        moduleCopy->setDataLayout(dataLayout);
+        return moduleCopy;
+    };
+    auto objectFilePath = emitters::IRObjectCache(cachePath).GetObjectFilePath(*copyModule());
+    std::remove(objectFilePath.c_str());
+
+    {
+        emitters::IRExecutionEngine engine(copyModule());
+        engine.SetObjectCache(std::make_unique<emitters::IRObjectCache>(cachePath));
+        engine.ResolveFunctionAddress(settings.mapFunctionName);
+    }
+    testing::ProcessTest("Testing JIT object cache stores compiled code", utilities::FileExists(objectFilePath));
+
+    auto cachedModule = copyModule();
+    auto cache = std::make_unique<emitters::IRObjectCache>(cachePath);
+    bool hit = cache->getObject(cachedModule.get()) != nullptr;
+    emitters::IRExecutionEngine engine(std::move(cachedModule));
+    engine.SetObjectCache(std::move(cache));
+    auto predict = reinterpret_cast<void (*)(void*, const double*, double*)>(engine.ResolveFunctionAddress(settings.mapFunctionName));
+    bool ok = hit;
+    std::vector<double> output(4);
+    for (const auto& example : signal)
+    {
+        predict(nullptr, example.data(), output.data());
+        ok = ok && testing::IsEqual(output, map.Compute<double>(example));
+    }
+    testing::ProcessTest("Testing JIT object cache loads compiled code", ok);
+}
+
+void TestLazyJitObjectCache()
+{
+    auto makeMap = [](const std::vector<double>& offsets, const std::vector<double>& scales) {
+        ModelMaker mb;
+        auto input = mb.Inputs<double>(4);
+        auto c1 = mb.Constant<double>(offsets);
+        auto c2 = mb.Constant<double>(scales);
+        auto addNode = mb.Add(c1->output, input->output);
+        auto multiplyNode = mb.Multiply(addNode->output, c2->output);
+        return model::Map{ mb.Model, { { "input", input } }, { { "output", multiplyNode->output } } };
+    };
+
+    // The nodes aren't inlined, so the lazy JIT compiles several functions, each in a module of its own. Two maps of
+    // the same shape share the cache, and each must get its own code back.
+    auto cachePath = OutputPath("lazyObjectCache");
+    model::MapCompilerOptions settings;
+    settings.lazyJit = true;
+    settings.inlineNodes = false;
+    settings.objectCachePath = cachePath;
+
+    std::vector<std::vector<double>> signal = { { 1, 2, 3, 4 }, { -5, 0, 5, 10 }, { 7, 8, 9, 10 } };
+    auto map1 = makeMap({ 5, 10, 15, 20 }, { 4, 4, 4, 4 });
+    auto map2 = makeMap({ -1, 2, -3, 4 }, { 2, 3, 2, 3 });
+    for (const auto& description : { " lazily jitted map that fills the object cache", " lazily jitted map loaded from the object cache" })
+    {
+        for (auto* map : { &map1, &map2 })
+        {
+            model::IRMapCompiler compiler(settings);
+            auto compiledMap = compiler.Compile(*map);
+            VerifyCompiledOutput(*map, compiledMap, signal, description);
+        }
+    }
+}
+
+void TestBackgroundJitting()
+{
+    ModelMaker mb;
+    auto input = mb.Inputs<double>(4);
+    auto c1 = mb.Constant<double>({ 5, 10, 15, 20 });
+    auto c2 = mb.Constant<double>({ 4, 4, 4, 4 });
+    auto addNode = mb.Add(c1->output, input->output);
+    auto multiplyNode = mb.Multiply(addNode->output, c2->output);
+    model::Map map{ mb.Model, { { "input", input } }, { { "output", multiplyNode->output } } };
+
+    // several code generation threads, so the module is compiled in parts
+    model::MapCompilerOptions settings;
+    settings.jitThreads = 4;
+    model::IRMapCompiler compiler(settings);
+    auto compiledMap = compiler.Compile(map);
+
+    std::vector<std::vector<double>> signal = { { 1, 2, 3, 4 }, { -5, 0, 5, 10 }, { 7, 8, 9, 10 } };
+    compiledMap.StartJitting();
+
+    // compute the reference map until the compiled code is ready
+    bool ok = true;
+    size_t index = 0;
+    while (!compiledMap.IsJitReady())
+    {
+        const auto& example = signal[index++ % signal.size()];
+        ok = ok && map.Compute<double>(example).size() == example.size();
+    }
+    testing::ProcessTest("Testing background jitting falls back to the reference map", ok);
+    VerifyCompiledOutput(map, compiledMap, signal, " map jitted in the background on several threads");
+
+    // the jitted code has an LLVM context of its own, so the map's module can be used while it is generated
+    model::IRMapCompiler secondCompiler(settings);
+    auto secondCompiledMap = secondCompiler.Compile(map);
+    secondCompiledMap.StartJitting();
+    auto header = secondCompiledMap.GetCodeHeaderString();
+    std::stringstream code;
+    secondCompiledMap.WriteCode(code, emitters::ModuleOutputFormat::ir);
+    testing::ProcessTest("Testing map's module is usable during background jitting", !header.empty() && !code.str().empty());
+    VerifyCompiledOutput(map, secondCompiledMap, signal, " map written out during background jitting");
+}
+
+void TestLazyJitWeightSwap()
+{
+    auto makeMap = [](const std::vector<double>& weights, bool add) {
+        ModelMaker mb;
+        auto input = mb.Inputs<double>(4);
+        auto c1 = mb.Constant<double>(weights);
+        const auto& output = add ? mb.Add(c1->output, input->output)->output : mb.Multiply(c1->output, input->output)->output;
+        return model::Map{ mb.Model, { { "input", input } }, { { "output", output } } };
+    };
+    auto map = makeMap({ 5, 10, 15, 20 }, false);
+    auto retrainedMap = makeMap({ -1, 2, -3, 4 }, false);
+    auto otherMap = makeMap({ 1, 1, 1, 1 }, true);
+
+    std::vector<std::vector<double>> signal = { { 1, 2, 3, 4 }, { -5, 0, 5, 10 }, { 7, 8, 9, 10 } };
+    {
+        model::MapCompilerOptions settings;
+        settings.lazyJit = true;
+        model::IRMapCompiler compiler(settings);
+        auto compiledMap = compiler.Compile(map);
+        VerifyCompiledOutput(map, compiledMap, signal, " map compiled lazily");
+    }
+
+    for (auto lazyJit : { false, true })
+    {
+        std::string description = lazyJit ? " with lazyJit" : "";
+        model::MapCompilerOptions settings;
+        settings.swappableWeights = true;
+        settings.lazyJit = lazyJit;
+        model::IRMapCompiler compiler(settings);
+        auto compiledMap = compiler.Compile(map);
+        VerifyCompiledOutput(map, compiledMap, signal, " map with swappable weights" + description);
+
+        {
+            model::IRMapCompiler retrainedCompiler(settings);
+            auto compiledRetrainedMap = retrainedCompiler.Compile(retrainedMap);
+            compiledMap.UpdateWeights(compiledRetrainedMap);
+        }
+        VerifyCompiledOutput(retrainedMap, compiledMap, signal, " map after swapping in retrained weights" + description);
+
+        // weights of the same shape from a map that computes something else are refused, and the map keeps its own
+        bool refused = false;
+        {
+            model::IRMapCompiler otherCompiler(settings);
+            auto compiledOtherMap = otherCompiler.Compile(otherMap);
+            try
+            {
+                compiledMap.UpdateWeights(compiledOtherMap);
+            }
+            catch (const utilities::InputException&)
+            {
+                refused = true;
+            }
+        }
+        testing::ProcessTest("Testing weights of a map with different code are refused" + description, refused);
+        VerifyCompiledOutput(retrainedMap, compiledMap, signal, " map after refusing weights" + description);
+    }
+}
+
 typedef void (*MapPredictFunction)(void* context, double*, double*);
 
 void TestBinaryVector(bool expanded, bool runJit)
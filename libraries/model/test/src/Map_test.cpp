@@ -17,6 +17,8 @@
 #include <model/include/InputNode.h>
 #include <model/include/Map.h>
 #include <model/include/Model.h>
+#include <model/include/ModelExecutor.h>
+#include <model/include/ModelTransformer.h>
 #include <model/include/OutputNode.h>
 #include <model/include/PortElements.h>
 
@@ -102,6 +104,72 @@ void TestMapComputeDataVector()
     testing::ProcessTest("Testing map compute 2", testing::IsEqual(resultValues[0], 8.5) && testing::IsEqual(resultValues[1], 10.5));
 }
 
+void TestMapParallelCompute()
+{
+    auto model = GetSimpleModel();
+    auto inputNodes = model.GetNodesByType<model::InputNode<double>>();
+    auto outputNodes = model.GetNodesByType<model::OutputNode<double>>();
+    auto map = model::Map(model, { { "doubleInput", inputNodes[0] } }, { { "doubleOutput", outputNodes[0]->output } });
+    auto parallelMap = map;
+    parallelMap.SetComputeOptions({ 4, false });
+    auto deterministicMap = map;
+    deterministicMap.SetComputeOptions({ 4, true });
+
+    auto signal = std::vector<std::vector<double>>{ { 1.0, 2.0, 3.0 },
+                                                    { 4.0, 5.0, 6.0 },
+                                                    { 7.0, 8.0, 9.0 },
+                                                    { 10.0, 11.0, 12.0 } };
+    bool ok = true;
+    for (const auto& sample : signal)
+    {
+        auto expected = map.Compute<double>(sample);
+        ok &= testing::IsEqual(parallelMap.Compute<double>(sample), expected);
+        ok &= testing::IsEqual(deterministicMap.Compute<double>(sample), expected);
+    }
+    testing::ProcessTest("Testing parallel map compute", ok);
+
+    // The executor's schedule contains each node needed for the output exactly once
+    const auto& mapModel = map.GetModel();
+    const model::OutputPortBase* outputPort = map.GetOutput(0).GetRanges()[0].ReferencedPort();
+    model::ModelExecutor executor(mapModel, { outputPort }, { 2, false });
+    size_t numNodes = 0;
+    mapModel.VisitSubmodel(outputPort, [&numNodes](const model::Node&) { ++numNodes; });
+    testing::ProcessTest("Testing model executor schedule", testing::IsEqual(executor.GetSchedule().size(), numNodes));
+}
+
+void TestMapParallelComputeAfterRefine()
+{
+    auto model = GetSimpleModel();
+    auto inputNodes = model.GetNodesByType<model::InputNode<double>>();
+    auto outputNodes = model.GetNodesByType<model::OutputNode<double>>();
+    auto referenceMap = model::Map(model, { { "doubleInput", inputNodes[0] } }, { { "doubleOutput", outputNodes[0]->output } });
+    auto map = referenceMap;
+    map.SetComputeOptions({ 4, false });
+
+    auto signal = std::vector<std::vector<double>>{ { 1.0, 2.0, 3.0 },
+                                                    { 4.0, 5.0, 6.0 },
+                                                    { 7.0, 8.0, 9.0 },
+                                                    { 10.0, 11.0, 12.0 } };
+    bool ok = true;
+
+    // Compute once so the map creates its executor, then replace the model underneath it. The reference map
+    // gets the same transformations, so both maps start over with the same node state.
+    ok &= testing::IsEqual(map.Compute<double>(signal[0]), referenceMap.Compute<double>(signal[0]));
+
+    model::TransformContext context;
+    map.Refine(context);
+    referenceMap.Refine(context);
+    ok &= testing::IsEqual(map.Compute<double>(signal[1]), referenceMap.Compute<double>(signal[1]));
+
+    auto copyNode = [](const model::Node& node, model::ModelTransformer& transformer) { transformer.CopyNode(node); };
+    map.Transform(copyNode);
+    referenceMap.Transform(copyNode);
+    ok &= testing::IsEqual(map.Compute<double>(signal[2]), referenceMap.Compute<double>(signal[2]));
+    ok &= testing::IsEqual(map.Compute<double>(signal[3]), referenceMap.Compute<double>(signal[3]));
+
+    testing::ProcessTest("Testing parallel map compute after refining the map", ok);
+}
+
 void TestMapRefine()
 {
     auto model = GetSimpleModel();
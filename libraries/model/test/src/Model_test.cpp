@@ -31,6 +31,7 @@
 
 #include <utilities/include/Unused.h>
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <unordered_map>
@@ -140,6 +141,38 @@ void TestStaticModel()
     testing::ProcessTest("Testing max index", testing::IsEqual(output4[0], 2));
 }
 
+void TestComputeScheduleCache()
+{
+    model::Model g;
+    auto in = g.AddNode<model::InputNode<double>>(3);
+    auto maxAndArgMax = g.AddNode<nodes::ArgMaxNode<double>>(in->output);
+    auto minAndArgMin = g.AddNode<nodes::ArgMinNode<double>>(in->output);
+    auto condition = g.AddNode<nodes::ConstantNode<bool>>(true);
+    auto valSelector = g.AddNode<nodes::ValueSelectorNode<double>>(condition->output, maxAndArgMax->val, minAndArgMin->val);
+
+    auto schedule1 = g.GetComputeSchedule({ &valSelector->output });
+    auto schedule2 = g.GetComputeSchedule({ &valSelector->output });
+    testing::ProcessTest("Testing compute schedule size", testing::IsEqual(schedule1->size(), static_cast<size_t>(5)));
+    testing::ProcessTest("Testing compute schedule is cached", schedule1 == schedule2);
+
+    std::vector<double> inputValues = { 0.5, 0.25, 0.75 };
+    in->SetInput(inputValues);
+    auto output = g.ComputeOutput(valSelector->output);
+    testing::ProcessTest("Testing compute with cached schedule", testing::IsEqual(output[0], 0.75));
+
+    // Editing the model must invalidate the cached schedule
+    auto falseCondition = g.AddNode<nodes::ConstantNode<bool>>(false);
+    auto schedule3 = g.GetComputeSchedule({ &valSelector->output });
+    testing::ProcessTest("Testing compute schedule invalidated by adding a node", schedule3 != schedule1 && testing::IsEqual(schedule3->size(), schedule1->size()));
+
+    model::ModelEditor::ResetInputPort(&valSelector->condition, falseCondition->output);
+    auto schedule4 = g.GetComputeSchedule({ &valSelector->output });
+    testing::ProcessTest("Testing compute schedule invalidated by rewiring", schedule4 != schedule3 && std::find(schedule4->begin(), schedule4->end(), falseCondition) != schedule4->end());
+
+    output = g.ComputeOutput(valSelector->output);
+    testing::ProcessTest("Testing compute after rewiring", testing::IsEqual(output[0], 0.25));
+}
+
 void TestNodeIterator()
 {
     TestNodeIterator_Full();
@@ -30,6 +30,7 @@ int main()
     {
         // Model tests
         TestStaticModel();
+        TestComputeScheduleCache();
         TestNodeIterator();
         TestReverseNodeIterator();
         TestModelSerialization();
@@ -51,6 +52,8 @@ int main()
         TestMapCreate();
         TestMapCompute();
         TestMapComputeDataVector();
+        TestMapParallelCompute();
+        TestMapParallelComputeAfterRefine();
         TestMapRefine();
         TestMapSerialization();
         TestMapClockNode();
@@ -45,6 +45,13 @@ void TestIRCompiler()
     TestSimpleMap(false);
     TestSimpleMap(true);
     TestCompiledMapMove();
+    TestComputeIntoBuffers();
+    TestReusePortBuffers();
+    TestReentrantMap();
+    TestJitObjectCache();
+    TestLazyJitObjectCache();
+    TestBackgroundJitting();
+    TestLazyJitWeightSwap();
     TestBinaryScalar();
     TestBinaryVector(true);
     TestBinaryVector(false);
@@ -88,6 +95,11 @@ void TestIRCompiler()
     TestOrderedMatrixMatrixMultiplyNode(4, 5, 6, false, true, true, false);
     TestOrderedMatrixMatrixMultiplyNode(4, 5, 6, true, true, true, false);
 
+    // Not using BLAS, with sizes that span several blocks of the native kernels and leave partial tiles
+    TestMatrixVectorMultiplyNode(7, 131, false);
+    TestMatrixMatrixMultiplyNode(2, 5, 130, false);
+    TestOrderedMatrixMatrixMultiplyNode(2, 5, 130, true, true, false, false);
+
     // TestMatrixMatrixMultiplyNode(15, 25600, 27, false); // Fails due to numerical  issues
 
     TestCompilableScalarOutputNode();
@@ -96,6 +108,7 @@ void TestIRCompiler()
     TestCompilableDotProductNode();
     TestCompilableDelayNode();
     TestCompilableDTWDistanceNode();
+    TestCompilableFlatForestPredictorNode();
     TestCompilableMulticlassDTW();
     TestCompilableScalarSumNode();
     TestCompilableSumNode();
@@ -191,6 +204,7 @@ void TestIRCompiler()
     // TestMeanPoolingLayerNode(8, 8, 16, 6, 6, 3, 1, 1, 0);
 
     // TestMeanPoolingLayerNode(8, 8, 16, 2, 1, 2, 1, 0, 0);
+    TestReusePortBuffersWithPadding();
 
     TestScalingLayerNode();
     TestScalingLayerNode(0, 1);
@@ -230,6 +244,7 @@ void TestIRCompiler()
     // TestFullyConnectedLayerNode(0, 1); // Fully-connected layer nodes can't have padding (yet)
     // TestFullyConnectedLayerNode(0, 2); // Fully-connected layer nodes can't have padding (yet)
     // TestFullyConnectedLayerNode(1, 1); // Fully-connected layer nodes can't have padding (yet)
+    TestQuantizedFullyConnectedLayerNode();
 
     TestProtoNNPredictorMap();
     TestMultiSourceSinkMap();
@@ -247,5 +247,59 @@ namespace nodes
         std::string GetRuntimeTypeName() const { return GetTypeName(); }
     };
 
+    /// <summary> A binary function that adds a bias to its input and applies an activation function to the sum,
+    /// so that a bias and the activation that follows it can be computed in a single pass over the data. </summary>
+    template <typename ValueType, typename ActivationFunctionType>
+    class BiasActivationFunction : public BroadcastBinaryFunction<ValueType>
+    {
+    public:
+        BiasActivationFunction() = default;
+
+        /// <summary> Constructor specifying the activation function. </summary>
+        ///
+        /// <param name="activation"> The activation function to apply after adding the bias. </param>
+        BiasActivationFunction(ActivationFunctionType activation) :
+            _activation(activation) {}
+
+        /// <summary> Computes the biased activation (on the host machine) </summary>
+        ///
+        /// <param name="x"> The value </param>
+        /// <param name="bias"> The bias </param>
+        /// <returns> The value of the function f(x + bias) </returns>
+        ValueType Compute(ValueType x, ValueType bias) const override { return _activation.Compute(x + bias); }
+        using BroadcastBinaryFunction<ValueType>::Compute;
+
+        /// <summary> Emits IR to compute the biased activation </summary>
+        ///
+        /// <param name="function"> The function being compiled. </param>
+        /// <param name="x"> The value </param>
+        /// <param name="bias"> The bias </param>
+        ///
+        /// <returns> The value of the function f(x + bias) </returns>
+        emitters::LLVMValue Compile(emitters::IRFunctionEmitter& function, emitters::LLVMValue x, emitters::LLVMValue bias) const override
+        {
+            return _activation.Compile(function, function.Operator(emitters::GetAddForValueType<ValueType>(), x, bias));
+        }
+        using BroadcastBinaryFunction<ValueType>::Compile;
+
+        /// <summary> Gets the activation function </summary>
+        ///
+        /// <returns> The activation function </returns>
+        const ActivationFunctionType& GetActivation() const { return _activation; }
+
+        /// <summary> Gets the name of this type (for serialization). </summary>
+        ///
+        /// <returns> The name of this type. </returns>
+        static std::string GetTypeName() { return utilities::GetCompositeTypeName<ValueType, ActivationFunctionType>("BiasActivationFunction"); }
+
+        /// <summary> Gets the name of this type (for serialization). </summary>
+        ///
+        /// <returns> The name of this type. </returns>
+        std::string GetRuntimeTypeName() const { return GetTypeName(); }
+
+    private:
+        ActivationFunctionType _activation;
+    };
+
 } // namespace nodes
 } // namespace ell
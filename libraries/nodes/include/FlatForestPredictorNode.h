@@ -0,0 +1,131 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     FlatForestPredictorNode.h (nodes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <model/include/CompilableNode.h>
+#include <model/include/IRMapCompiler.h>
+#include <model/include/InputPort.h>
+#include <model/include/ModelTransformer.h>
+#include <model/include/OutputPort.h>
+
+#include <predictors/include/ForestPredictor.h>
+
+#include <string>
+#include <vector>
+
+namespace ell
+{
+namespace nodes
+{
+    /// <summary> A flattened representation of a simple forest (binary trees with single-element threshold
+    /// split rules and constant edge predictors), stored in struct-of-arrays form. Interior node `i` owns the
+    /// two edges `2*i` (split rule is false) and `2*i+1` (split rule is true). </summary>
+    struct FlatForest
+    {
+        /// <summary> The input element tested by each interior node. </summary>
+        std::vector<int> featureIndices;
+
+        /// <summary> The threshold used by each interior node. </summary>
+        std::vector<double> thresholds;
+
+        /// <summary> The interior node that each edge points to, or -1 if the edge points to a leaf. </summary>
+        std::vector<int> edgeTargets;
+
+        /// <summary> The output value associated with each edge. </summary>
+        std::vector<double> edgeOutputs;
+
+        /// <summary> The index of the root interior node of each tree. </summary>
+        std::vector<int> rootIndices;
+
+        /// <summary> The forest bias term. </summary>
+        double bias = 0;
+
+        /// <summary> Returns the number of interior nodes in the forest. </summary>
+        size_t NumInteriorNodes() const { return thresholds.size(); }
+
+        /// <summary> Returns the number of edges in the forest. </summary>
+        size_t NumEdges() const { return edgeOutputs.size(); }
+
+        /// <summary> Returns the number of trees in the forest. </summary>
+        size_t NumTrees() const { return rootIndices.size(); }
+    };
+
+    /// <summary> Converts a simple forest predictor into its flattened array representation. </summary>
+    ///
+    /// <param name="forest"> The forest predictor. </param>
+    ///
+    /// <returns> The flattened forest. </returns>
+    FlatForest FlattenForest(const predictors::SimpleForestPredictor& forest);
+
+    /// <summary> A compilable node that evaluates a simple forest predictor with a tight traversal loop over a
+    /// flattened, array-based representation of the trees, instead of expanding each interior node into its
+    /// own sub-model. It has the same outputs as a `SimpleForestPredictorNode`. </summary>
+    class FlatForestPredictorNode : public model::CompilableNode
+    {
+    public:
+        /// @name Input and Output Ports
+        /// @{
+        static constexpr const char* treeOutputsPortName = "treeOutputs";
+        static constexpr const char* edgeIndicatorVectorPortName = "edgeIndicatorVector";
+        const model::InputPort<double>& input = _input;
+        const model::OutputPort<double>& output = _output;
+        const model::OutputPort<double>& treeOutputs = _treeOutputs;
+        const model::OutputPort<bool>& edgeIndicatorVector = _edgeIndicatorVector;
+        /// @}
+
+        using ForestPredictor = predictors::SimpleForestPredictor;
+
+        /// <summary> Default Constructor </summary>
+        FlatForestPredictorNode();
+
+        /// <summary> Constructor </summary>
+        ///
+        /// <param name="input"> The predictor's input. </param>
+        /// <param name="forest"> The forest predictor. </param>
+        FlatForestPredictorNode(const model::OutputPort<double>& input, const ForestPredictor& forest);
+
+        /// <summary> Gets the forest predictor. </summary>
+        ///
+        /// <returns> The forest predictor. </returns>
+        const ForestPredictor& GetForest() const { return _forest; }
+
+        /// <summary> Gets the name of this type (for serialization). </summary>
+        ///
+        /// <returns> The name of this type. </returns>
+        static std::string GetTypeName() { return "FlatForestPredictorNode"; }
+
+        /// <summary> Gets the name of this type (for serialization). </summary>
+        ///
+        /// <returns> The name of this type. </returns>
+        std::string GetRuntimeTypeName() const override { return GetTypeName(); }
+
+    protected:
+        void Compute() const override;
+        void Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function) override;
+        bool HasState() const override { return true; } // stored state: the flattened forest
+        void WriteToArchive(utilities::Archiver& archiver) const override;
+        void ReadFromArchive(utilities::Unarchiver& archiver) override;
+
+    private:
+        void Copy(model::ModelTransformer& transformer) const override;
+
+        // Input
+        model::InputPort<double> _input;
+
+        // Outputs
+        model::OutputPort<double> _output;
+        model::OutputPort<double> _treeOutputs;
+        model::OutputPort<bool> _edgeIndicatorVector;
+
+        // Forest
+        ForestPredictor _forest;
+        FlatForest _flatForest;
+    };
+} // namespace nodes
+} // namespace ell
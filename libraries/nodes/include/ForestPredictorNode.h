@@ -11,6 +11,7 @@
 #include "BinaryOperationNode.h"
 #include "ConstantNode.h"
 #include "DemultiplexerNode.h"
+#include "FlatForestPredictorNode.h"
 #include "ForestPredictorNode.h"
 #include "MultiplexerNode.h"
 #include "SingleElementThresholdNode.h"
@@ -25,6 +26,7 @@
 
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace ell
@@ -70,7 +72,9 @@ namespace nodes
         /// <returns> The name of this type. </returns>
         std::string GetRuntimeTypeName() const override { return GetTypeName(); }
 
-        /// <summary> Refines this node in the model being constructed by the transformer </summary>
+        /// <summary> Refines this node in the model being constructed by the transformer. Simple forests
+        /// are refined into a single `FlatForestPredictorNode`, other forests are expanded into a sub-model
+        /// per interior node. </summary>
         bool Refine(model::ModelTransformer& transformer) const override;
 
     protected:
@@ -80,6 +84,7 @@ namespace nodes
 
     private:
         void Copy(model::ModelTransformer& transformer) const override;
+        bool RefineIntoSubModels(model::ModelTransformer& transformer) const;
 
         // Input
         model::InputPort<double> _input;
@@ -156,6 +161,26 @@ namespace nodes
 
     template <typename SplitRuleType, typename EdgePredictorType>
     bool ForestPredictorNode<SplitRuleType, EdgePredictorType>::Refine(model::ModelTransformer& transformer) const
+    {
+        if constexpr (std::is_same_v<ForestPredictor, predictors::SimpleForestPredictor>)
+        {
+            const auto& newPortElements = transformer.GetCorrespondingInputs(_input);
+
+            // evaluate the whole forest with a single traversal loop over a flattened representation
+            auto flatForestNode = transformer.AddNode<FlatForestPredictorNode>(newPortElements, _forest);
+            transformer.MapNodeOutput(output, flatForestNode->output);
+            transformer.MapNodeOutput(treeOutputs, flatForestNode->treeOutputs);
+            transformer.MapNodeOutput(edgeIndicatorVector, flatForestNode->edgeIndicatorVector);
+            return true;
+        }
+        else
+        {
+            return RefineIntoSubModels(transformer);
+        }
+    }
+
+    template <typename SplitRuleType, typename EdgePredictorType>
+    bool ForestPredictorNode<SplitRuleType, EdgePredictorType>::RefineIntoSubModels(model::ModelTransformer& transformer) const
     {
         const auto& newPortElements = transformer.GetCorrespondingInputs(_input);
         const auto& interiorNodes = _forest.GetInteriorNodes();
@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     QuantizedFullyConnectedLayerNode.h (nodes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <model/include/CompilableNode.h>
+#include <model/include/IRMapCompiler.h>
+#include <model/include/InputPort.h>
+#include <model/include/ModelTransformer.h>
+#include <model/include/OutputPort.h>
+
+#include <predictors/neural/include/FullyConnectedLayer.h>
+
+#include <utilities/include/TypeName.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ell
+{
+namespace nodes
+{
+    /// <summary> A fully-connected layer that runs in 8-bit integer arithmetic. The weights are quantized
+    /// symmetrically to int8 with one scale per output, the input is quantized with a single scale derived from
+    /// its calibrated range, the dot products are accumulated in int32, and each output is scaled back to
+    /// `ValueType`. </summary>
+    template <typename ValueType>
+    class QuantizedFullyConnectedLayerNode : public model::CompilableNode
+    {
+    public:
+        /// @name Input and Output Ports
+        /// @{
+        const model::InputPort<ValueType>& input = _input;
+        const model::OutputPort<ValueType>& output = _output;
+        /// @}
+
+        /// <summary> Default Constructor </summary>
+        QuantizedFullyConnectedLayerNode();
+
+        /// <summary> Constructor from a fully-connected layer, quantizing its weights. </summary>
+        ///
+        /// <param name="input"> The layer's input. </param>
+        /// <param name="layer"> The fully-connected layer to quantize. The layer must not have any padding. </param>
+        /// <param name="inputRange"> The largest absolute value expected in the input, usually found by calibration. </param>
+        QuantizedFullyConnectedLayerNode(const model::OutputPort<ValueType>& input, const predictors::neural::FullyConnectedLayer<ValueType>& layer, ValueType inputRange);
+
+        /// <summary> Constructor from already-quantized weights. </summary>
+        ///
+        /// <param name="input"> The layer's input. </param>
+        /// <param name="weights"> The quantized weights matrix, in row-major order, with one row per output. </param>
+        /// <param name="weightScales"> The scale of each row of the weights matrix. </param>
+        /// <param name="inputScale"> The scale used to quantize the input. </param>
+        QuantizedFullyConnectedLayerNode(const model::OutputPort<ValueType>& input, std::vector<int8_t> weights, std::vector<ValueType> weightScales, ValueType inputScale);
+
+        /// <summary> Gets the quantized weights, in row-major order. </summary>
+        const std::vector<int8_t>& GetWeights() const { return _weights; }
+
+        /// <summary> Gets the scale of each row of the weights matrix. </summary>
+        const std::vector<ValueType>& GetWeightScales() const { return _weightScales; }
+
+        /// <summary> Gets the scale used to quantize the input. </summary>
+        ValueType GetInputScale() const { return _inputScale; }
+
+        /// <summary> Gets the name of this type (for serialization). </summary>
+        ///
+        /// <returns> The name of this type. </returns>
+        static std::string GetTypeName() { return utilities::GetCompositeTypeName<ValueType>("QuantizedFullyConnectedLayerNode"); }
+
+        /// <summary> Gets the name of this type (for serialization). </summary>
+        ///
+        /// <returns> The name of this type. </returns>
+        std::string GetRuntimeTypeName() const override { return GetTypeName(); }
+
+    protected:
+        void Compute() const override;
+        void Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function) override;
+        bool HasState() const override { return true; } // stored state: quantized weights and scales
+        void WriteToArchive(utilities::Archiver& archiver) const override;
+        void ReadFromArchive(utilities::Unarchiver& archiver) override;
+
+    private:
+        void Copy(model::ModelTransformer& transformer) const override;
+        size_t NumInputs() const { return _input.Size(); }
+        size_t NumOutputs() const { return _weightScales.size(); }
+
+        // Input
+        model::InputPort<ValueType> _input;
+
+        // Output
+        model::OutputPort<ValueType> _output;
+
+        std::vector<int8_t> _weights;
+        std::vector<ValueType> _weightScales;
+        ValueType _inputScale = 1;
+    };
+} // namespace nodes
+} // namespace ell
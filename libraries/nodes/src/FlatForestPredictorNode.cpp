@@ -0,0 +1,196 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     FlatForestPredictorNode.cpp (nodes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "FlatForestPredictorNode.h"
+
+#include <emitters/include/EmitterTypes.h>
+#include <emitters/include/IRLocalValue.h>
+
+#include <utilities/include/Exception.h>
+
+namespace ell
+{
+namespace nodes
+{
+    FlatForest FlattenForest(const predictors::SimpleForestPredictor& forest)
+    {
+        const auto& interiorNodes = forest.GetInteriorNodes();
+        const auto numInteriorNodes = interiorNodes.size();
+
+        FlatForest result;
+        result.featureIndices.reserve(numInteriorNodes);
+        result.thresholds.reserve(numInteriorNodes);
+        result.edgeTargets.reserve(2 * numInteriorNodes);
+        result.edgeOutputs.reserve(2 * numInteriorNodes);
+        for (size_t nodeIndex = 0; nodeIndex < numInteriorNodes; ++nodeIndex)
+        {
+            const auto& interiorNode = interiorNodes[nodeIndex];
+            const auto& edges = interiorNode.GetOutgoingEdges();
+            if (edges.size() != 2 || interiorNode.GetFirstEdgeIndex() != 2 * nodeIndex)
+            {
+                throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Flat forests require binary interior nodes stored in topological order");
+            }
+
+            const auto& splitRule = interiorNode.GetSplitRule();
+            result.featureIndices.push_back(static_cast<int>(splitRule.GetElementIndex()));
+            result.thresholds.push_back(splitRule.GetThreshold());
+            for (const auto& edge : edges)
+            {
+                result.edgeTargets.push_back(edge.IsTargetInterior() ? static_cast<int>(edge.GetTargetNodeIndex()) : -1);
+                result.edgeOutputs.push_back(edge.GetPredictor().GetValue());
+            }
+        }
+
+        for (auto rootIndex : forest.GetRootIndices())
+        {
+            result.rootIndices.push_back(static_cast<int>(rootIndex));
+        }
+        result.bias = forest.GetBias();
+        return result;
+    }
+
+    FlatForestPredictorNode::FlatForestPredictorNode() :
+        CompilableNode({ &_input }, { &_output, &_treeOutputs, &_edgeIndicatorVector }),
+        _input(this, {}, defaultInputPortName),
+        _output(this, defaultOutputPortName, 1),
+        _treeOutputs(this, treeOutputsPortName, 0),
+        _edgeIndicatorVector(this, edgeIndicatorVectorPortName, 0)
+    {
+    }
+
+    FlatForestPredictorNode::FlatForestPredictorNode(const model::OutputPort<double>& input, const ForestPredictor& forest) :
+        CompilableNode({ &_input }, { &_output, &_treeOutputs, &_edgeIndicatorVector }),
+        _input(this, input, defaultInputPortName),
+        _output(this, defaultOutputPortName, 1),
+        _treeOutputs(this, treeOutputsPortName, forest.NumTrees()),
+        _edgeIndicatorVector(this, edgeIndicatorVectorPortName, forest.NumEdges()),
+        _forest(forest),
+        _flatForest(FlattenForest(forest))
+    {
+    }
+
+    void FlatForestPredictorNode::Compute() const
+    {
+        const auto& input = _input.GetValue();
+        const auto numTrees = _flatForest.NumTrees();
+
+        double output = _flatForest.bias;
+        std::vector<double> treeOutputs(numTrees);
+        std::vector<bool> edgeIndicator(_flatForest.NumEdges());
+        for (size_t treeIndex = 0; treeIndex < numTrees; ++treeIndex)
+        {
+            double treeOutput = 0;
+            auto nodeIndex = _flatForest.rootIndices[treeIndex];
+            while (nodeIndex >= 0)
+            {
+                auto isGreater = input[_flatForest.featureIndices[nodeIndex]] > _flatForest.thresholds[nodeIndex];
+                auto edgeIndex = 2 * nodeIndex + (isGreater ? 1 : 0);
+                treeOutput += _flatForest.edgeOutputs[edgeIndex];
+                edgeIndicator[edgeIndex] = true;
+                nodeIndex = _flatForest.edgeTargets[edgeIndex];
+            }
+            treeOutputs[treeIndex] = treeOutput;
+            output += treeOutput;
+        }
+
+        _output.SetOutput({ output });
+        _treeOutputs.SetOutput(std::move(treeOutputs));
+        _edgeIndicatorVector.SetOutput(std::move(edgeIndicator));
+    }
+
+    void FlatForestPredictorNode::Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function)
+    {
+        using namespace std::string_literals;
+
+        auto& module = function.GetModule();
+        const auto numTrees = _flatForest.NumTrees();
+        const auto numEdges = _flatForest.NumEdges();
+
+        auto input = function.LocalArray(compiler.EnsurePortEmitted(_input));
+        auto pOutput = compiler.EnsurePortEmitted(_output);
+        auto pTreeOutputs = compiler.EnsurePortEmitted(_treeOutputs);
+        auto pEdgeIndicator = compiler.EnsurePortEmitted(_edgeIndicatorVector);
+
+        if (numTrees == 0)
+        {
+            function.SetValueAt(pOutput, function.Literal(0), function.Literal(_flatForest.bias));
+            return;
+        }
+
+        // Global constants for the flattened forest
+        auto featureIndices = function.LocalArray(module.ConstantArray("featureIndices_"s + GetInternalStateIdentifier(), _flatForest.featureIndices));
+        auto thresholds = function.LocalArray(module.ConstantArray("thresholds_"s + GetInternalStateIdentifier(), _flatForest.thresholds));
+        auto edgeTargets = function.LocalArray(module.ConstantArray("edgeTargets_"s + GetInternalStateIdentifier(), _flatForest.edgeTargets));
+        auto edgeOutputs = function.LocalArray(module.ConstantArray("edgeOutputs_"s + GetInternalStateIdentifier(), _flatForest.edgeOutputs));
+        auto rootIndices = function.LocalArray(module.ConstantArray("rootIndices_"s + GetInternalStateIdentifier(), _flatForest.rootIndices));
+        auto edgeIndicator = function.LocalArray(pEdgeIndicator);
+        auto treeOutputs = function.LocalArray(pTreeOutputs);
+
+        function.MemorySet<uint8_t>(pEdgeIndicator, 0, function.Literal<uint8_t>(0), static_cast<int>(numEdges));
+
+        auto nodeIndexVar = function.Variable(emitters::VariableType::Int32, "nodeIndex");
+        auto treeOutputVar = function.Variable(emitters::VariableType::Double, "treeOutput");
+        auto forestOutputVar = function.Variable(emitters::VariableType::Double, "forestOutput");
+        function.Store(forestOutputVar, function.Literal(_flatForest.bias));
+
+        function.For(static_cast<int>(numTrees), [=](emitters::IRFunctionEmitter& function, emitters::IRLocalScalar treeIndex) {
+            function.Store(nodeIndexVar, static_cast<emitters::IRLocalScalar>(rootIndices[treeIndex]));
+            function.StoreZero(treeOutputVar);
+
+            // Walk from the root to a leaf, one interior node per iteration
+            auto hasInteriorNode = [nodeIndexVar](emitters::IRFunctionEmitter& function) {
+                return function.Comparison(emitters::TypedComparison::greaterThanOrEquals, function.Load(nodeIndexVar), function.Literal<int>(0));
+            };
+            function.While(hasInteriorNode, [=](emitters::IRFunctionEmitter& function) {
+                auto nodeIndex = function.LocalScalar(function.Load(nodeIndexVar));
+                emitters::IRLocalScalar featureValue = input[featureIndices[nodeIndex]];
+                emitters::IRLocalScalar threshold = thresholds[nodeIndex];
+                auto isGreater = featureValue > threshold;
+                auto edgeIndex = (nodeIndex * 2) + function.LocalScalar(function.Select(isGreater, function.Literal<int>(1), function.Literal<int>(0)));
+
+                function.OperationAndUpdate(treeOutputVar, emitters::TypedOperator::addFloat, static_cast<emitters::IRLocalScalar>(edgeOutputs[edgeIndex]));
+                edgeIndicator[edgeIndex] = function.CastBoolToByte(function.TrueBit());
+                function.Store(nodeIndexVar, static_cast<emitters::IRLocalScalar>(edgeTargets[edgeIndex]));
+            });
+
+            auto treeOutput = function.Load(treeOutputVar);
+            treeOutputs[treeIndex] = treeOutput;
+            function.OperationAndUpdate(forestOutputVar, emitters::TypedOperator::addFloat, treeOutput);
+        });
+
+        function.SetValueAt(pOutput, function.Literal(0), function.Load(forestOutputVar));
+    }
+
+    void FlatForestPredictorNode::WriteToArchive(utilities::Archiver& archiver) const
+    {
+        Node::WriteToArchive(archiver);
+        archiver[defaultInputPortName] << _input;
+        archiver["forest"] << _forest;
+    }
+
+    void FlatForestPredictorNode::ReadFromArchive(utilities::Unarchiver& archiver)
+    {
+        Node::ReadFromArchive(archiver);
+        archiver[defaultInputPortName] >> _input;
+        archiver["forest"] >> _forest;
+
+        _flatForest = FlattenForest(_forest);
+        _treeOutputs.SetSize(_forest.NumTrees());
+        _edgeIndicatorVector.SetSize(_forest.NumEdges());
+    }
+
+    void FlatForestPredictorNode::Copy(model::ModelTransformer& transformer) const
+    {
+        const auto& newPortElements = transformer.GetCorrespondingInputs(_input);
+        auto newNode = transformer.AddNode<FlatForestPredictorNode>(newPortElements, _forest);
+        transformer.MapNodeOutput(output, newNode->output);
+        transformer.MapNodeOutput(treeOutputs, newNode->treeOutputs);
+        transformer.MapNodeOutput(edgeIndicatorVector, newNode->edgeIndicatorVector);
+    }
+} // namespace nodes
+} // namespace ell
@@ -0,0 +1,240 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     QuantizedFullyConnectedLayerNode.cpp (nodes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "QuantizedFullyConnectedLayerNode.h"
+
+#include <emitters/include/EmitterTypes.h>
+#include <emitters/include/IRMath.h>
+
+#include <utilities/include/Exception.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace ell
+{
+namespace nodes
+{
+    namespace
+    {
+        // Symmetric quantization maps [-range, range] onto [-127, 127], leaving -128 unused
+        const int maxQuantizedValue = 127;
+
+        template <typename ValueType>
+        ValueType GetQuantizationScale(ValueType range)
+        {
+            return range > 0 ? range / maxQuantizedValue : static_cast<ValueType>(1);
+        }
+
+        // Rounds half away from zero, the same way the emitted code does
+        template <typename ValueType>
+        int QuantizeValue(ValueType value, ValueType inverseScale)
+        {
+            const auto maxValue = static_cast<ValueType>(maxQuantizedValue);
+            auto scaled = std::max(std::min(value * inverseScale, maxValue), -maxValue);
+            return static_cast<int>(scaled >= 0 ? scaled + static_cast<ValueType>(0.5) : scaled - static_cast<ValueType>(0.5));
+        }
+    } // namespace
+
+    template <typename ValueType>
+    QuantizedFullyConnectedLayerNode<ValueType>::QuantizedFullyConnectedLayerNode() :
+        CompilableNode({ &_input }, { &_output }),
+        _input(this, {}, defaultInputPortName),
+        _output(this, defaultOutputPortName, 0)
+    {
+    }
+
+    template <typename ValueType>
+    QuantizedFullyConnectedLayerNode<ValueType>::QuantizedFullyConnectedLayerNode(const model::OutputPort<ValueType>& input, const predictors::neural::FullyConnectedLayer<ValueType>& layer, ValueType inputRange) :
+        CompilableNode({ &_input }, { &_output }),
+        _input(this, input, defaultInputPortName),
+        _output(this, defaultOutputPortName, layer.GetWeights().NumRows()),
+        _inputScale(GetQuantizationScale(inputRange))
+    {
+        const auto& layerParameters = layer.GetLayerParameters();
+        if (HasPadding(layerParameters.inputPaddingParameters) || HasPadding(layerParameters.outputPaddingParameters))
+        {
+            throw utilities::LogicException(utilities::LogicExceptionErrors::notImplemented, "QuantizedFullyConnectedLayerNode does not support inputs or outputs with padding");
+        }
+
+        const auto& weights = layer.GetWeights();
+        const auto numRows = weights.NumRows();
+        const auto numColumns = weights.NumColumns();
+        if (numColumns != input.Size())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch, "QuantizedFullyConnectedLayerNode: weights don't match the input size");
+        }
+
+        _weights.reserve(numRows * numColumns);
+        _weightScales.reserve(numRows);
+        for (size_t rowIndex = 0; rowIndex < numRows; ++rowIndex)
+        {
+            ValueType rowRange = 0;
+            for (size_t columnIndex = 0; columnIndex < numColumns; ++columnIndex)
+            {
+                rowRange = std::max(rowRange, std::abs(weights(rowIndex, columnIndex)));
+            }
+
+            auto rowScale = GetQuantizationScale(rowRange);
+            _weightScales.push_back(rowScale);
+            for (size_t columnIndex = 0; columnIndex < numColumns; ++columnIndex)
+            {
+                _weights.push_back(static_cast<int8_t>(QuantizeValue(weights(rowIndex, columnIndex), 1 / rowScale)));
+            }
+        }
+    }
+
+    template <typename ValueType>
+    QuantizedFullyConnectedLayerNode<ValueType>::QuantizedFullyConnectedLayerNode(const model::OutputPort<ValueType>& input, std::vector<int8_t> weights, std::vector<ValueType> weightScales, ValueType inputScale) :
+        CompilableNode({ &_input }, { &_output }),
+        _input(this, input, defaultInputPortName),
+        _output(this, defaultOutputPortName, weightScales.size()),
+        _weights(std::move(weights)),
+        _weightScales(std::move(weightScales)),
+        _inputScale(inputScale)
+    {
+        if (_weights.size() != NumInputs() * NumOutputs())
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::sizeMismatch, "QuantizedFullyConnectedLayerNode: weights don't match the input and output sizes");
+        }
+    }
+
+    template <typename ValueType>
+    void QuantizedFullyConnectedLayerNode<ValueType>::Compute() const
+    {
+        const auto numInputs = NumInputs();
+        const auto numOutputs = NumOutputs();
+
+        auto inputValues = _input.GetValue();
+        const auto inverseInputScale = 1 / _inputScale;
+        std::vector<int> quantizedInput(numInputs);
+        std::transform(inputValues.begin(), inputValues.end(), quantizedInput.begin(), [inverseInputScale](ValueType value) { return QuantizeValue(value, inverseInputScale); });
+
+        std::vector<ValueType> result(numOutputs);
+        for (size_t rowIndex = 0; rowIndex < numOutputs; ++rowIndex)
+        {
+            int32_t accumulator = 0;
+            const auto* row = _weights.data() + rowIndex * numInputs;
+            for (size_t columnIndex = 0; columnIndex < numInputs; ++columnIndex)
+            {
+                accumulator += static_cast<int32_t>(row[columnIndex]) * quantizedInput[columnIndex];
+            }
+            result[rowIndex] = static_cast<ValueType>(accumulator) * (_weightScales[rowIndex] * _inputScale);
+        }
+        _output.SetOutput(result);
+    }
+
+    template <typename ValueType>
+    void QuantizedFullyConnectedLayerNode<ValueType>::Compile(model::IRMapCompiler& compiler, emitters::IRFunctionEmitter& function)
+    {
+        using namespace std::string_literals;
+        using emitters::IRLocalScalar;
+
+        auto& module = function.GetModule();
+        const int numInputs = static_cast<int>(NumInputs());
+        const int numOutputs = static_cast<int>(NumOutputs());
+        const int tileWidth = std::max(1, module.GetCompilerOptions().vectorWidth);
+        const int numTiledColumns = (numInputs / tileWidth) * tileWidth;
+
+        std::vector<ValueType> outputScales(_weightScales);
+        for (auto& scale : outputScales)
+        {
+            scale *= _inputScale;
+        }
+
+        auto input = function.LocalArray(compiler.EnsurePortEmitted(_input));
+        auto output = function.LocalArray(compiler.EnsurePortEmitted(_output));
+        auto weights = function.LocalArray(module.ConstantArray("quantizedWeights_"s + GetInternalStateIdentifier(), _weights));
+        auto scales = function.LocalArray(module.ConstantArray("outputScales_"s + GetInternalStateIdentifier(), outputScales));
+
+        // Quantize the input once, rounding the same way as `Compute`
+        auto quantizedInput = function.LocalArray(function.Variable(emitters::VariableType::Char8, numInputs));
+        const auto inverseInputScale = 1 / _inputScale;
+        const auto maxValue = static_cast<ValueType>(maxQuantizedValue);
+        function.For(numInputs, [=](emitters::IRFunctionEmitter& function, IRLocalScalar index) {
+            IRLocalScalar value = input[index];
+            auto scaled = emitters::Min(emitters::Max(value * inverseInputScale, -maxValue), maxValue);
+            auto rounded = function.LocalScalar(function.Select(scaled >= static_cast<ValueType>(0), scaled + static_cast<ValueType>(0.5), scaled - static_cast<ValueType>(0.5)));
+            quantizedInput[index] = function.CastValue(rounded, emitters::VariableType::Char8);
+        });
+
+        // Each row is reduced into `tileWidth` independent int32 partial sums of sign-extended int8 products, which
+        // the vectorizer turns into widening multiply-adds, followed by a scalar loop over the remaining columns
+        auto accumulators = function.LocalArray(function.Variable(emitters::VariableType::Int32, tileWidth));
+        auto zero = function.Literal<int>(0);
+        auto product = [=](emitters::IRFunctionEmitter& function, IRLocalScalar weightIndex, IRLocalScalar inputIndex) {
+            auto weight = function.LocalScalar(function.CastValue(static_cast<IRLocalScalar>(weights[weightIndex]), emitters::VariableType::Int32));
+            auto x = function.LocalScalar(function.CastValue(static_cast<IRLocalScalar>(quantizedInput[inputIndex]), emitters::VariableType::Int32));
+            return weight * x;
+        };
+
+        function.For(numOutputs, [=](emitters::IRFunctionEmitter& function, IRLocalScalar rowIndex) {
+            for (int lane = 0; lane < tileWidth; ++lane)
+            {
+                accumulators[lane] = zero;
+            }
+
+            auto rowOffset = rowIndex * numInputs;
+            function.For(0, numTiledColumns, tileWidth, [=](emitters::IRFunctionEmitter& function, IRLocalScalar columnIndex) {
+                for (int lane = 0; lane < tileWidth; ++lane)
+                {
+                    auto column = columnIndex + lane;
+                    accumulators[lane] = static_cast<IRLocalScalar>(accumulators[lane]) + product(function, rowOffset + column, column);
+                }
+            });
+            function.For(numTiledColumns, numInputs, [=](emitters::IRFunctionEmitter& function, IRLocalScalar column) {
+                accumulators[0] = static_cast<IRLocalScalar>(accumulators[0]) + product(function, rowOffset + column, column);
+            });
+
+            IRLocalScalar sum = accumulators[0];
+            for (int lane = 1; lane < tileWidth; ++lane)
+            {
+                sum = sum + static_cast<IRLocalScalar>(accumulators[lane]);
+            }
+
+            auto floatSum = function.LocalScalar(function.CastValue(sum, emitters::GetVariableType<ValueType>()));
+            output[rowIndex] = floatSum * static_cast<IRLocalScalar>(scales[rowIndex]);
+        });
+    }
+
+    template <typename ValueType>
+    void QuantizedFullyConnectedLayerNode<ValueType>::WriteToArchive(utilities::Archiver& archiver) const
+    {
+        Node::WriteToArchive(archiver);
+        archiver[defaultInputPortName] << _input;
+        archiver["weights"] << std::vector<int>(_weights.begin(), _weights.end());
+        archiver["weightScales"] << _weightScales;
+        archiver["inputScale"] << _inputScale;
+    }
+
+    template <typename ValueType>
+    void QuantizedFullyConnectedLayerNode<ValueType>::ReadFromArchive(utilities::Unarchiver& archiver)
+    {
+        Node::ReadFromArchive(archiver);
+        archiver[defaultInputPortName] >> _input;
+        std::vector<int> weights;
+        archiver["weights"] >> weights;
+        _weights.assign(weights.begin(), weights.end());
+        archiver["weightScales"] >> _weightScales;
+        archiver["inputScale"] >> _inputScale;
+        _output.SetSize(_weightScales.size());
+    }
+
+    template <typename ValueType>
+    void QuantizedFullyConnectedLayerNode<ValueType>::Copy(model::ModelTransformer& transformer) const
+    {
+        const auto& newPortElements = transformer.GetCorrespondingInputs(_input);
+        auto newNode = transformer.AddNode<QuantizedFullyConnectedLayerNode<ValueType>>(newPortElements, _weights, _weightScales, _inputScale);
+        transformer.MapNodeOutput(output, newNode->output);
+    }
+
+    // Explicit specialization
+    template class QuantizedFullyConnectedLayerNode<float>;
+    template class QuantizedFullyConnectedLayerNode<double>;
+} // namespace nodes
+} // namespace ell
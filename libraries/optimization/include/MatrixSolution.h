@@ -70,6 +70,9 @@ namespace optimization
         /// <summary> Adds a scaled column vector to this solution. </summary>
         void operator+=(OuterProductExpression<IOElementType> expression);
 
+        /// <summary> Adds a scaled solution to this solution. </summary>
+        void operator+=(ScaledExpression<MatrixSolution<IOElementType, isBiased>> expression);
+
         /// <summary> Computes input * weights, or input * weights + bias (if a bias exists). </summary>
         math::RowVector<double> Multiply(const InputType& input) const;
 
@@ -226,6 +229,19 @@ namespace optimization
         }
     }
 
+    template <typename IOElementType, bool isBiased>
+    void MatrixSolution<IOElementType, isBiased>::operator+=(ScaledExpression<MatrixSolution<IOElementType, isBiased>> expression)
+    {
+        const auto& otherSolution = expression.lhs.get();
+        double otherScale = expression.rhs;
+        math::ScaleAddUpdate(otherScale, otherSolution._weights, 1.0, _weights);
+
+        if constexpr (isBiased)
+        {
+            math::ScaleAddUpdate(otherScale, otherSolution.GetBias(), 1.0, _bias);
+        }
+    }
+
     template <typename IOElementType, bool isBiased>
     void MatrixSolution<IOElementType, isBiased>::operator+=(OuterProductExpression<IOElementType> expression)
     {
@@ -265,8 +281,11 @@ namespace optimization
         }
         else
         {
-            _doubleInput.CopyFrom(input);
-            math::MultiplyScaleAddUpdate(1.0, _doubleInput, _weights, 1.0, result);
+            // convert into a buffer of the calling thread, so that threads can share one solution
+            thread_local math::RowVector<double> doubleInput;
+            doubleInput.Resize(input.Size());
+            doubleInput.CopyFrom(input);
+            math::MultiplyScaleAddUpdate(1.0, doubleInput, _weights, 1.0, result);
         }
 
         return result;
@@ -9,6 +9,8 @@
 
 #include <math/include/Vector.h>
 
+#include <utilities/include/ThreadPool.h>
+
 #include <cstddef>
 #include <memory>
 #include <random>
@@ -23,6 +25,12 @@ namespace optimization
     {
         double regularizationParameter;
         bool permuteData = true;
+
+        /// <summary> The number of threads. '1' performs sequential epochs, '0' means one thread per hardware thread. </summary>
+        size_t numThreads = 1;
+
+        /// <summary> The number of examples processed in parallel between synchronizations, when numThreads is not 1. </summary>
+        size_t miniBatchSize = 4096;
     };
 
     /// <summary> Information about the current solution found by SDCA. </summary>
@@ -99,6 +107,16 @@ namespace optimization
         void OneTimeSetup(std::shared_ptr<const DatasetType> examples, std::string randomSeedString);
         void InitializeDuals();
         void Step(ExampleType example, ExampleInfo& exampleInfo);
+        void ParallelEpoch(const std::vector<size_t>& permutation);
+        void LocalSteps(const std::vector<size_t>& permutation, size_t begin, size_t end, double scale, size_t threadIndex);
+
+        // per-thread state of a parallel epoch
+        struct LocalSolution
+        {
+            SolutionType w;
+            SolutionType v;
+            SolutionType deltaV;
+        };
 
         std::shared_ptr<const DatasetType> _examples;
         LossFunctionType _lossFunction;
@@ -116,6 +134,10 @@ namespace optimization
         double _normalizedInverseLambda = 1.0;
         bool _permuteData = true;
         bool _isInitialized = false;
+
+        size_t _miniBatchSize = 0;
+        std::unique_ptr<utilities::ThreadPool> _threadPool;
+        std::vector<LocalSolution> _localSolutions;
     };
 
     /// <summary> Convenience function for constructing an SDCA optimizer. </summary>
@@ -170,9 +192,16 @@ namespace optimization
             }
 
             // process each example
-            for (size_t index : permutation)
+            if (_threadPool)
+            {
+                ParallelEpoch(permutation);
+            }
+            else
             {
-                Step(_examples->Get(index), _exampleInfo[index]);
+                for (size_t index : permutation)
+                {
+                    Step(_examples->Get(index), _exampleInfo[index]);
+                }
             }
 
             _areObjectivesValid = false;
@@ -208,6 +237,34 @@ namespace optimization
         _lambda = parameters.regularizationParameter;
         _normalizedInverseLambda = 1.0 / (_examples->Size() * parameters.regularizationParameter);
         _permuteData = parameters.permuteData;
+        _miniBatchSize = parameters.miniBatchSize;
+
+        if (parameters.numThreads == 1)
+        {
+            _threadPool.reset();
+            _localSolutions.clear();
+        }
+        else
+        {
+            if (_miniBatchSize == 0)
+            {
+                throw OptimizationException("Mini-batch size must be positive");
+            }
+
+            auto numThreads = parameters.numThreads == 0 ? utilities::ThreadPool::GetNumHardwareThreads() : parameters.numThreads;
+            if (!_threadPool || _threadPool->NumThreads() != numThreads)
+            {
+                _threadPool = std::make_unique<utilities::ThreadPool>(numThreads);
+                auto firstExample = _examples->Get(0);
+                _localSolutions.resize(numThreads);
+                for (auto& localSolution : _localSolutions)
+                {
+                    localSolution.w.Resize(firstExample.input, firstExample.output);
+                    localSolution.v.Resize(firstExample.input, firstExample.output);
+                    localSolution.deltaV.Resize(firstExample.input, firstExample.output);
+                }
+            }
+        }
     }
 
     template <typename SolutionType, typename LossFunctionType, typename RegularizerType>
@@ -323,6 +380,71 @@ namespace optimization
         exampleInfo.dual = newDual;
     }
 
+    template <typename SolutionType, typename LossFunctionType, typename RegularizerType>
+    void SDCAOptimizer<SolutionType, LossFunctionType, RegularizerType>::ParallelEpoch(const std::vector<size_t>& permutation)
+    {
+        // Each mini-batch is split into one slice per thread. Every thread starts from the shared solution and runs
+        // sequential steps on its slice against a private copy, with the step size shrunk by the number of slices, so
+        // that adding up the changes that the threads made to v is a safe dual update (CoCoA+). The changes are added
+        // in thread order, so the result doesn't depend on thread scheduling.
+        for (size_t batchBegin = 0; batchBegin < permutation.size(); batchBegin += _miniBatchSize)
+        {
+            auto batchSize = std::min(_miniBatchSize, permutation.size() - batchBegin);
+            auto numSlices = std::min(_localSolutions.size(), batchSize);
+
+            _threadPool->ParallelFor(numSlices, [&](size_t threadIndex) {
+                auto begin = batchBegin + threadIndex * batchSize / numSlices;
+                auto end = batchBegin + (threadIndex + 1) * batchSize / numSlices;
+                LocalSteps(permutation, begin, end, static_cast<double>(numSlices), threadIndex);
+            });
+
+            for (size_t threadIndex = 0; threadIndex < numSlices; ++threadIndex)
+            {
+                _v = _v * 1.0 + _localSolutions[threadIndex].deltaV * 1.0;
+            }
+            _regularizer.ConjugateGradient(_v, _w);
+        }
+    }
+
+    template <typename SolutionType, typename LossFunctionType, typename RegularizerType>
+    void SDCAOptimizer<SolutionType, LossFunctionType, RegularizerType>::LocalSteps(const std::vector<size_t>& permutation, size_t begin, size_t end, double scale, size_t threadIndex)
+    {
+        const double tolerance = 1.0e-8;
+
+        auto& localSolution = _localSolutions[threadIndex];
+        localSolution.w = _w;
+        localSolution.v = _v;
+        localSolution.deltaV.Reset();
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            auto index = permutation[i];
+            auto example = _examples->Get(index);
+            auto& exampleInfo = _exampleInfo[index];
+            auto& dual = exampleInfo.dual;
+
+            auto lipschitz = exampleInfo.norm2Squared * _normalizedInverseLambda * scale;
+            if (lipschitz < tolerance)
+            {
+                continue;
+            }
+
+            auto prediction = example.input * localSolution.w;
+            prediction /= lipschitz;
+            prediction += dual;
+
+            auto newDual = _lossFunction.ConjugateProx(1.0 / lipschitz, prediction, example.output);
+            dual -= newDual;
+            dual *= _normalizedInverseLambda;
+
+            localSolution.deltaV += Transpose(example.input) * dual;
+            dual *= scale;
+            localSolution.v += Transpose(example.input) * dual;
+            _regularizer.ConjugateGradient(localSolution.v, localSolution.w);
+            exampleInfo.dual = newDual;
+        }
+    }
+
     template <typename SolutionType, typename LossFunctionType, typename RegularizerType>
     SDCAOptimizer<SolutionType, LossFunctionType, RegularizerType> MakeSDCAOptimizer(std::shared_ptr<const typename SolutionType::DatasetType> examples, LossFunctionType lossFunction, RegularizerType regularizer, SDCAOptimizerParameters parameters, std::string randomSeedString)
     {
@@ -7,9 +7,12 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include <utilities/include/ThreadPool.h>
+
 #include <cstddef>
 #include <memory>
 #include <random>
+#include <vector>
 
 namespace ell
 {
@@ -20,6 +23,12 @@ namespace optimization
     {
         double regularizationParameter;
         std::string randomSeedString = "abc123";
+
+        /// <summary> The number of threads. '1' performs sequential epochs, '0' means one thread per hardware thread. </summary>
+        size_t numThreads = 1;
+
+        /// <summary> The number of examples whose gradients are averaged in each step, when numThreads is not 1. </summary>
+        size_t miniBatchSize = 256;
     };
 
     /// <summary> Stochastic gradient descent optimizer. </summary>
@@ -50,6 +59,7 @@ namespace optimization
 
     private:
         void Step(ExampleType example);
+        void MiniBatchStep(const std::vector<size_t>& permutation, size_t begin, size_t end);
 
         std::shared_ptr<const DatasetType> _examples;
         LossFunctionType _lossFunction;
@@ -58,6 +68,10 @@ namespace optimization
         SolutionType _averagedW;
         double _t = 0;
         double _lambda;
+
+        size_t _miniBatchSize = 0;
+        std::unique_ptr<utilities::ThreadPool> _threadPool;
+        std::vector<SolutionType> _localGradients;
     };
 
     /// <summary> Convenience function for constructing an SGD optimizer. </summary>
@@ -85,7 +99,8 @@ namespace optimization
     SGDOptimizer<SolutionType, LossFunctionType>::SGDOptimizer(std::shared_ptr<const DatasetType> examples, LossFunctionType lossFunction, SGDOptimizerParameters parameters) :
         _examples(examples),
         _lossFunction(std::move(lossFunction)),
-        _lambda(parameters.regularizationParameter)
+        _lambda(parameters.regularizationParameter),
+        _miniBatchSize(parameters.miniBatchSize)
     {
         if (examples.get() == nullptr || examples->Size() == 0)
         {
@@ -110,6 +125,21 @@ namespace optimization
         auto example = examples->Get(0);
         _lastW.Resize(example.input, example.output);
         _averagedW.Resize(example.input, example.output);
+
+        if (parameters.numThreads != 1)
+        {
+            if (_miniBatchSize == 0)
+            {
+                throw OptimizationException("Mini-batch size must be positive");
+            }
+
+            _threadPool = std::make_unique<utilities::ThreadPool>(parameters.numThreads);
+            _localGradients.resize(_threadPool->NumThreads());
+            for (auto& localGradient : _localGradients)
+            {
+                localGradient.Resize(example.input, example.output);
+            }
+        }
     }
 
     template <typename SolutionType, typename LossFunctionType>
@@ -125,9 +155,19 @@ namespace optimization
             std::shuffle(permutation.begin(), permutation.end(), _randomEngine);
 
             // process each example
-            for (size_t index : permutation)
+            if (_threadPool)
+            {
+                for (size_t begin = 0; begin < permutation.size(); begin += _miniBatchSize)
+                {
+                    MiniBatchStep(permutation, begin, std::min(begin + _miniBatchSize, permutation.size()));
+                }
+            }
+            else
             {
-                Step(_examples->Get(index));
+                for (size_t index : permutation)
+                {
+                    Step(_examples->Get(index));
+                }
             }
         }
     }
@@ -154,6 +194,40 @@ namespace optimization
         _averagedW = _averagedW * (1.0 - inverseT) + _lastW * inverseT;
     }
 
+    template <typename SolutionType, typename LossFunctionType>
+    void SGDOptimizer<SolutionType, LossFunctionType>::MiniBatchStep(const std::vector<size_t>& permutation, size_t begin, size_t end)
+    {
+        // each thread sums the loss gradients of one slice of the mini-batch; the solution is only read until all threads finish
+        auto batchSize = end - begin;
+        auto numSlices = std::min(_localGradients.size(), batchSize);
+        _threadPool->ParallelFor(numSlices, [&](size_t threadIndex) {
+            auto& localGradient = _localGradients[threadIndex];
+            localGradient.Reset();
+
+            auto sliceEnd = begin + (threadIndex + 1) * batchSize / numSlices;
+            for (size_t i = begin + threadIndex * batchSize / numSlices; i < sliceEnd; ++i)
+            {
+                auto example = _examples->Get(permutation[i]);
+                auto p = example.input * _lastW;
+                auto derivative = _lossFunction.Derivative(p, example.output);
+                derivative *= -example.weight;
+                localGradient += Transpose(example.input) * derivative;
+            }
+        });
+
+        ++_t;
+
+        // update the solution with the average gradient, adding the per-thread sums in thread order
+        double inverseT = 1.0 / _t;
+        double gradientScale = inverseT / (_lambda * batchSize);
+        _lastW = _lastW * (1.0 - inverseT) + _localGradients[0] * gradientScale;
+        for (size_t threadIndex = 1; threadIndex < numSlices; ++threadIndex)
+        {
+            _lastW += _localGradients[threadIndex] * gradientScale;
+        }
+        _averagedW = _averagedW * (1.0 - inverseT) + _lastW * inverseT;
+    }
+
     template <typename SolutionType, typename LossFunctionType>
     SGDOptimizer<SolutionType, LossFunctionType> MakeSGDOptimizer(std::shared_ptr<const typename SolutionType::DatasetType> examples, LossFunctionType lossFunction, SGDOptimizerParameters parameters)
     {
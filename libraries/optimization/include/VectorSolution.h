@@ -79,6 +79,9 @@ namespace optimization
         /// <summary> Adds a scaled column vector to this solution. </summary>
         void operator+=(ScaledColumnVectorExpression<IOElementType> expression);
 
+        /// <summary> Adds a scaled solution to this solution. </summary>
+        void operator+=(ScaledExpression<VectorSolution<IOElementType, isBiased>> expression);
+
         /// <summary> Computes input * weights, or input * weights + bias (if a bias exists). </summary>
         double Multiply(const InputType& input) const;
 
@@ -227,6 +230,19 @@ namespace optimization
         }
     }
 
+    template <typename IOElementType, bool isBiased>
+    void VectorSolution<IOElementType, isBiased>::operator+=(ScaledExpression<VectorSolution<IOElementType, isBiased>> expression)
+    {
+        const auto& otherSolution = expression.lhs.get();
+        double otherScale = expression.rhs;
+        math::ScaleAddUpdate(otherScale, otherSolution.GetVector(), 1.0, _weights);
+
+        if constexpr (isBiased)
+        {
+            _bias += otherScale * otherSolution.GetBias();
+        }
+    }
+
     template <typename IOElementType, bool isBiased>
     void VectorSolution<IOElementType, isBiased>::operator+=(ScaledColumnVectorExpression<IOElementType> expression)
     {
@@ -261,8 +277,11 @@ namespace optimization
         }
         else
         {
-            _doubleInput.CopyFrom(input);
-            result = math::Dot(_doubleInput, _weights);
+            // convert into a buffer of the calling thread, so that threads can share one solution
+            thread_local math::RowVector<double> doubleInput;
+            doubleInput.Resize(input.Size());
+            doubleInput.CopyFrom(input);
+            result = math::Dot(doubleInput, _weights);
         }
 
         if constexpr (isBiased)
@@ -9,6 +9,7 @@
 #pragma once
 
 #include <optimization/include/SDCAOptimizer.h>
+#include <optimization/include/SGDOptimizer.h>
 
 /// <summary> Tests that the SDCA duality gap tends to zero in a regression setting after a sufficient number of epochs.</summary>
 template <typename LossFunctionType, typename RegularizerType>
@@ -22,6 +23,14 @@ void TestSDCAClassificationConvergence(LossFunctionType lossFunction, Regularize
 template <typename LossFunctionType, typename RegularizerType>
 void TestSDCAReset(LossFunctionType lossFunction, RegularizerType regularizer);
 
+/// <summary> Tests that parallel SDCA with single-example mini-batches matches sequential SDCA, and that parallel SDCA with larger mini-batches converges and is deterministic.</summary>
+template <typename LossFunctionType, typename RegularizerType>
+void TestSDCAParallel(LossFunctionType lossFunction, RegularizerType regularizer, double regularizationParameter, size_t numThreads);
+
+/// <summary> Tests that mini-batch SGD with single-example mini-batches matches sequential SGD, and that mini-batch SGD is deterministic.</summary>
+template <typename LossFunctionType>
+void TestSGDParallel(LossFunctionType lossFunction, double regularizationParameter, size_t numThreads);
+
 #pragma region implementation
 
 #include "../include/RandomDataset.h"
@@ -156,6 +165,98 @@ void TestSDCAReset(LossFunctionType lossFunction, RegularizerType regularizer)
     testing::ProcessTest("TestSDCAReset <" + lossName + ", " + regularizerName + ">", vector1 == vector2 && vector1 == vector3);
 }
 
+template <typename LossFunctionType, typename RegularizerType>
+void TestSDCAParallel(LossFunctionType lossFunction, RegularizerType regularizer, double regularizationParameter, size_t numThreads)
+{
+    size_t count = 500;
+    size_t size = 17;
+    size_t epochs = 3;
+
+    std::string randomSeedString = "GoodLuckMan";
+    std::seed_seq seed(randomSeedString.begin(), randomSeedString.end());
+    std::default_random_engine randomEngine(seed);
+
+    // create random solution
+    VectorSolution<double, true> solution(size);
+    solution.GetBias() = 0.5;
+    std::uniform_int_distribution<int> vectorDistribution(-1, 1);
+    solution.GetVector().Generate([&]() { return vectorDistribution(randomEngine); });
+
+    // create random dataset
+    auto examples = GetClassificationDataset(count, 1.0, 1.0, solution, randomEngine);
+
+    // sequential SDCA and parallel SDCA with mini-batches of one example
+    auto sequentialOptimizer = MakeSDCAOptimizer<VectorSolution<double, true>>(examples, lossFunction, regularizer, { regularizationParameter });
+    sequentialOptimizer.Update(epochs);
+    const auto& sequentialVector = sequentialOptimizer.GetSolution().GetVector();
+
+    auto singleExampleOptimizer = MakeSDCAOptimizer<VectorSolution<double, true>>(examples, lossFunction, regularizer, { regularizationParameter, true, numThreads, 1 });
+    singleExampleOptimizer.Update(epochs);
+    const auto& singleExampleVector = singleExampleOptimizer.GetSolution().GetVector();
+
+    // two identical runs of parallel SDCA with larger mini-batches
+    double earlyStopping = 1.0e-4;
+    auto optimizer1 = MakeSDCAOptimizer<VectorSolution<double, true>>(examples, lossFunction, regularizer, { regularizationParameter, true, numThreads, 64 });
+    optimizer1.Update(200, earlyStopping);
+    double dualityGap = optimizer1.GetSolutionInfo().DualityGap();
+
+    auto optimizer2 = MakeSDCAOptimizer<VectorSolution<double, true>>(examples, lossFunction, regularizer, { regularizationParameter, true, numThreads, 64 });
+    optimizer2.Update(optimizer1.GetSolutionInfo().numEpochsPerformed);
+
+    std::string lossName = typeid(LossFunctionType).name();
+    lossName = lossName.substr(lossName.find_last_of(":") + 1);
+    std::string regularizerName = typeid(RegularizerType).name();
+    regularizerName = regularizerName.substr(regularizerName.find_last_of(":") + 1);
+    std::string name = "<" + lossName + ", " + regularizerName + ", " + std::to_string(numThreads) + " threads>";
+
+    testing::ProcessTest("TestSDCAParallel single example mini-batches " + name, singleExampleVector.IsEqual(sequentialVector, 1.0e-8));
+    testing::ProcessTest("TestSDCAParallel convergence " + name, dualityGap <= earlyStopping);
+    testing::ProcessTest("TestSDCAParallel determinism " + name, optimizer1.GetSolution().GetVector() == optimizer2.GetSolution().GetVector());
+}
+
+template <typename LossFunctionType>
+void TestSGDParallel(LossFunctionType lossFunction, double regularizationParameter, size_t numThreads)
+{
+    size_t count = 500;
+    size_t size = 17;
+    size_t epochs = 3;
+
+    std::string randomSeedString = "GoodLuckMan";
+    std::seed_seq seed(randomSeedString.begin(), randomSeedString.end());
+    std::default_random_engine randomEngine(seed);
+
+    // create random solution
+    VectorSolution<double, true> solution(size);
+    solution.GetBias() = 0.5;
+    std::uniform_int_distribution<int> vectorDistribution(-1, 1);
+    solution.GetVector().Generate([&]() { return vectorDistribution(randomEngine); });
+
+    // create random dataset
+    auto examples = GetClassificationDataset(count, 1.0, 1.0, solution, randomEngine);
+
+    // sequential SGD and mini-batch SGD with mini-batches of one example
+    auto sequentialOptimizer = MakeSGDOptimizer<VectorSolution<double, true>>(examples, lossFunction, { regularizationParameter });
+    sequentialOptimizer.Update(epochs);
+    const auto& sequentialVector = sequentialOptimizer.GetSolution().GetVector();
+
+    auto singleExampleOptimizer = MakeSGDOptimizer<VectorSolution<double, true>>(examples, lossFunction, { regularizationParameter, "abc123", numThreads, 1 });
+    singleExampleOptimizer.Update(epochs);
+    const auto& singleExampleVector = singleExampleOptimizer.GetSolution().GetVector();
+
+    // two identical runs of mini-batch SGD with larger mini-batches
+    auto optimizer1 = MakeSGDOptimizer<VectorSolution<double, true>>(examples, lossFunction, { regularizationParameter, "abc123", numThreads, 32 });
+    optimizer1.Update(epochs);
+    auto optimizer2 = MakeSGDOptimizer<VectorSolution<double, true>>(examples, lossFunction, { regularizationParameter, "abc123", numThreads, 32 });
+    optimizer2.Update(epochs);
+
+    std::string lossName = typeid(LossFunctionType).name();
+    lossName = lossName.substr(lossName.find_last_of(":") + 1);
+    std::string name = "<" + lossName + ", " + std::to_string(numThreads) + " threads>";
+
+    testing::ProcessTest("TestSGDParallel single example mini-batches " + name, singleExampleVector.IsEqual(sequentialVector, 1.0e-8));
+    testing::ProcessTest("TestSGDParallel determinism " + name, optimizer1.GetSolution().GetVector() == optimizer2.GetSolution().GetVector());
+}
+
 template <typename LossFunctionType>
 void TestGetSparseSolution(LossFunctionType lossFunction, double regularizationParameter)
 {
@@ -135,6 +135,13 @@ int main()
     TestSDCAReset(SquaredHingeLoss{}, L2Regularizer{});
     TestGetSparseSolution(SmoothedHingeLoss{}, 0.01);
 
+    // Parallel SDCA and mini-batch SGD
+    TestSDCAParallel(LogisticLoss{}, L2Regularizer{}, 0.1, 4);
+    TestSDCAParallel(SmoothedHingeLoss{}, ElasticNetRegularizer{ 0.1 }, 0.1, 4);
+    TestSDCAParallel(SquaredHingeLoss{}, L2Regularizer{}, 0.1, 2);
+    TestSGDParallel(LogisticLoss{}, 0.01, 4);
+    TestSGDParallel(HingeLoss{}, 0.01, 2);
+
     // SGD solution equivalence tests, confirms that the four solution types behave identically when given equivalent problems
 
     TestSolutionEquivalenceSGD<double, AbsoluteLoss, L2Regularizer>(0.001);
@@ -0,0 +1,38 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     FuseConvolutionLayersPass.h (passes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <model/include/Model.h>
+
+#include <model/optimizer/include/ModelOptimizer.h>
+#include <model/optimizer/include/OptimizationPass.h>
+
+namespace ell
+{
+namespace passes
+{
+    /// <summary> An optimization pass that fuses the per-channel operations following a convolution into fewer
+    /// passes over its output. A constant per-channel scale (from batch normalization or a scaling layer) is folded
+    /// into the convolution's filter weights, and a constant per-channel bias followed by an activation function is
+    /// replaced by a single node that adds the bias and applies the activation to each element. </summary>
+    class FuseConvolutionLayersPass : public model::NodeLocalOptimizationPass
+    {
+    public:
+        /// <summary> Fuse a linear function node into its convolution, or a bias into its activation, if possible. </summary>
+        ///
+        /// <param name="node"> The current node being visited. </param>
+        /// <param name="settings"> The current compiler settings. </param>
+        /// <param name="context"> The optimizer context, which holds the transformer operating on the model. </param>
+        void OptimizeNode(const model::Node& node, const model::MapCompilerOptions& settings, model::ModelOptimizerContext& context) const override;
+
+        /// <summary> Add this pass type to the global pass registry. </summary>
+        static void AddToRegistry();
+    };
+} // namespace passes
+} // namespace ell
@@ -0,0 +1,50 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     QuantizeNeuralNetworkLayersPass.h (passes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <model/include/Map.h>
+#include <model/include/Model.h>
+
+#include <model/optimizer/include/ModelOptimizer.h>
+#include <model/optimizer/include/OptimizationPass.h>
+
+#include <vector>
+
+namespace ell
+{
+namespace passes
+{
+    /// <summary> The node metadata key holding the calibrated input range of a layer node. </summary>
+    constexpr const char* quantizationInputRangeKey = "quantizationInputRange";
+
+    /// <summary> Calibrates a map for quantization by running it over a set of representative inputs and
+    /// recording the largest absolute value seen at the input of each fully-connected layer node. The range is
+    /// stored in the node's metadata, so it is saved along with the model. </summary>
+    ///
+    /// <param name="map"> The map to calibrate. </param>
+    /// <param name="calibrationInputs"> The inputs to run the map over. </param>
+    template <typename ValueType>
+    void CalibrateQuantization(model::Map& map, const std::vector<std::vector<ValueType>>& calibrationInputs);
+
+    /// <summary> An optimization pass that replaces calibrated fully-connected layer nodes with 8-bit integer versions. </summary>
+    class QuantizeNeuralNetworkLayersPass : public model::NodeLocalOptimizationPass
+    {
+    public:
+        /// <summary> Replace a fully-connected layer node with its quantized version, if it has been calibrated. </summary>
+        ///
+        /// <param name="node"> The current node being visited. </param>
+        /// <param name="settings"> The current compiler settings. </param>
+        /// <param name="context"> The context for the optimizer, including the model transformer. </param>
+        void OptimizeNode(const model::Node& node, const model::MapCompilerOptions& settings, model::ModelOptimizerContext& context) const override;
+
+        /// <summary> Add this pass type to the global pass registry. </summary>
+        static void AddToRegistry();
+    };
+} // namespace passes
+} // namespace ell
@@ -0,0 +1,216 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     FuseConvolutionLayersPass.cpp (passes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "FuseConvolutionLayersPass.h"
+
+#include <model/include/ModelTransformer.h>
+
+#include <model/optimizer/include/OptimizationPassRegistry.h>
+
+#include <nodes/include/ActivationFunctions.h>
+#include <nodes/include/BroadcastFunctionNode.h>
+#include <nodes/include/ConstantNode.h>
+#include <nodes/include/ConvolutionalLayerNode.h>
+
+#include <predictors/neural/include/ConvolutionalLayer.h>
+
+#include <vector>
+
+namespace ell
+{
+namespace passes
+{
+    //
+    // Implementation
+    //
+    namespace
+    {
+        // The channel dimension of a convolution's output, which per-channel operations broadcast over
+        const size_t channelDimension = 2;
+
+        // Returns true if `consumer` is the only node that uses the output of `producer`. Earlier passes can leave
+        // behind nodes that nothing uses (they are only pruned at the end of optimization), so dependents without
+        // dependents of their own are ignored. If one of those turns out to be an output of the map, it still reads
+        // the original, unfused node, so the result stays correct.
+        bool IsOnlyLiveDependent(const model::Node& producer, const model::Node& consumer)
+        {
+            for (auto dependent : producer.GetDependentNodes())
+            {
+                if (dependent != &consumer && !dependent->GetDependentNodes().empty())
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        template <typename ValueType>
+        const nodes::ConstantNode<ValueType>* GetConstantInputNode(const model::InputPort<ValueType>& input)
+        {
+            if (input.Size() == 0)
+            {
+                return nullptr;
+            }
+            return dynamic_cast<const nodes::ConstantNode<ValueType>*>(input.GetReferencedPort().GetNode());
+        }
+
+        // Folds a constant per-channel scale into the weights of the convolution that feeds a linear function node,
+        // leaving only the bias (if any) to be applied to the convolution's output.
+        // Returns 'true' if we handled the situation, else 'false'. If we return 'false', keep trying other options.
+        template <typename ValueType>
+        bool TryFoldScaleIntoConvolution(const model::Node& node, model::ModelTransformer& transformer)
+        {
+            auto linearNode = dynamic_cast<const nodes::BroadcastLinearFunctionNode<ValueType>*>(&node);
+            if (linearNode == nullptr || linearNode->GetBroadcastDimension() != channelDimension)
+            {
+                return false;
+            }
+
+            auto convNode = dynamic_cast<const nodes::ConvolutionalLayerNode<ValueType>*>(linearNode->primaryInput.GetReferencedPort().GetNode());
+            if (convNode == nullptr || !IsOnlyLiveDependent(*convNode, node))
+            {
+                return false;
+            }
+
+            if (linearNode->GetInputMemoryLayout() != convNode->GetOutputMemoryLayout())
+            {
+                return false;
+            }
+
+            auto scaleNode = GetConstantInputNode(linearNode->secondaryInput1);
+            auto biasNode = GetConstantInputNode(linearNode->secondaryInput2);
+            if (scaleNode == nullptr || (linearNode->secondaryInput2.Size() != 0 && biasNode == nullptr))
+            {
+                return false; // nothing to fold, or a bias that isn't constant
+            }
+
+            const auto& layer = convNode->GetLayer();
+            const auto filterSize = layer.GetConvolutionalParameters().receptiveField;
+            auto weights = layer.GetWeights();
+            const auto numFilters = weights.NumRows() / filterSize;
+            const auto& scale = scaleNode->GetValues();
+            if (scale.size() != numFilters || (biasNode != nullptr && biasNode->GetValues().size() != numFilters))
+            {
+                return false;
+            }
+
+            // Filter `f` occupies rows [f * filterSize, (f+1) * filterSize) of the weights tensor
+            for (size_t row = 0; row < weights.NumRows(); ++row)
+            {
+                const auto filterScale = scale[row / filterSize];
+                for (size_t column = 0; column < weights.NumColumns(); ++column)
+                {
+                    for (size_t channel = 0; channel < weights.NumChannels(); ++channel)
+                    {
+                        weights(row, column, channel) *= filterScale;
+                    }
+                }
+            }
+
+            predictors::neural::ConvolutionalLayer<ValueType> newLayer = { layer.GetLayerParameters(), layer.GetConvolutionalParameters(), weights };
+            const auto& newInput = transformer.GetCorrespondingInputs(convNode->input);
+            auto newConvNode = transformer.AddNode<nodes::ConvolutionalLayerNode<ValueType>>(newInput, newLayer);
+
+            if (biasNode == nullptr && linearNode->GetInputMemoryLayout() == linearNode->GetOutputMemoryLayout())
+            {
+                transformer.MapNodeOutput(linearNode->output, newConvNode->output);
+                return true;
+            }
+
+            auto newScaleNode = transformer.AddNode<nodes::ConstantNode<ValueType>>(std::vector<ValueType>{});
+            auto newBiasNode = transformer.AddNode<nodes::ConstantNode<ValueType>>(biasNode == nullptr ? std::vector<ValueType>{} : biasNode->GetValues());
+            auto newNode = transformer.AddNode<nodes::BroadcastLinearFunctionNode<ValueType>>(newConvNode->output,
+                                                                                              linearNode->GetInputMemoryLayout(),
+                                                                                              newScaleNode->output,
+                                                                                              newBiasNode->output,
+                                                                                              channelDimension,
+                                                                                              linearNode->GetOutputMemoryLayout());
+            transformer.MapNodeOutput(linearNode->output, newNode->output);
+            return true;
+        }
+
+        // Replaces a bias-only linear function node followed by an activation function with a single node that
+        // computes both.
+        // Returns 'true' if we handled the situation, else 'false'. If we return 'false', keep trying other options.
+        template <typename ValueType, typename ActivationFunctionType>
+        bool TryFuseBiasWithActivation(const model::Node& node, model::ModelTransformer& transformer)
+        {
+            using FunctionType = nodes::BiasActivationFunction<ValueType, ActivationFunctionType>;
+
+            auto activationNode = dynamic_cast<const nodes::BroadcastUnaryFunctionNode<ValueType, ActivationFunctionType>*>(&node);
+            if (activationNode == nullptr || !IsOnlyLiveDependent(*activationNode->primaryInput.GetReferencedPort().GetNode(), node))
+            {
+                return false;
+            }
+
+            // Look at the already-transformed input, which may be the bias left over from folding a scale into a convolution
+            const auto& newInput = transformer.GetCorrespondingInputs(activationNode->primaryInput);
+            auto linearNode = dynamic_cast<const nodes::BroadcastLinearFunctionNode<ValueType>*>(newInput.GetNode());
+            if (linearNode == nullptr || linearNode->secondaryInput1.Size() != 0 || linearNode->secondaryInput2.Size() == 0)
+            {
+                return false;
+            }
+
+            if (linearNode->GetOutputMemoryLayout() != activationNode->GetInputMemoryLayout())
+            {
+                return false;
+            }
+
+            auto newNode = transformer.AddNode<nodes::BroadcastBinaryFunctionNode<ValueType, FunctionType>>(linearNode->primaryInput.GetReferencedPort(),
+                                                                                                           linearNode->GetInputMemoryLayout(),
+                                                                                                           linearNode->secondaryInput2.GetReferencedPort(),
+                                                                                                           linearNode->GetBroadcastDimension(),
+                                                                                                           activationNode->GetOutputMemoryLayout(),
+                                                                                                           FunctionType(activationNode->GetFunction()));
+            transformer.MapNodeOutput(activationNode->output, newNode->output);
+            return true;
+        }
+
+        template <typename ValueType>
+        bool TryFuseBiasActivation(const model::Node& node, model::ModelTransformer& transformer)
+        {
+            return TryFuseBiasWithActivation<ValueType, nodes::ReLUActivationFunction<ValueType>>(node, transformer) ||
+                   TryFuseBiasWithActivation<ValueType, nodes::LeakyReLUActivationFunction<ValueType>>(node, transformer) ||
+                   TryFuseBiasWithActivation<ValueType, nodes::SigmoidActivationFunction<ValueType>>(node, transformer) ||
+                   TryFuseBiasWithActivation<ValueType, nodes::HardSigmoidActivationFunction<ValueType>>(node, transformer) ||
+                   TryFuseBiasWithActivation<ValueType, nodes::TanhActivationFunction<ValueType>>(node, transformer);
+        }
+
+        void FuseConvolutionLayers(const model::Node& node, model::ModelTransformer& transformer)
+        {
+            if (TryFoldScaleIntoConvolution<float>(node, transformer) || TryFoldScaleIntoConvolution<double>(node, transformer))
+            {
+                return;
+            }
+            if (TryFuseBiasActivation<float>(node, transformer) || TryFuseBiasActivation<double>(node, transformer))
+            {
+                return;
+            }
+            transformer.CopyNode(node);
+        }
+    } // namespace
+
+    //
+    // FuseConvolutionLayersPass methods
+    //
+    void FuseConvolutionLayersPass::OptimizeNode(const model::Node& node, const model::MapCompilerOptions& settings, model::ModelOptimizerContext& context) const
+    {
+        FuseConvolutionLayers(node, context.GetTransformer());
+    }
+
+    void FuseConvolutionLayersPass::AddToRegistry()
+    {
+        model::OptimizationPassInfo info = {
+            "FuseConvolutionLayersPass",
+            [](const model::ModelOptimizerOptions& settings) { return settings.phase == model::OptimizerPhase::optimize && settings.fuseConvolutionLayers; },
+            []() { return std::make_unique<FuseConvolutionLayersPass>(); }
+        };
+        model::OptimizationPassRegistry::AddPass(info);
+    }
+} // namespace passes
+} // namespace ell
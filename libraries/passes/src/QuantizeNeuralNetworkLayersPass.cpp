@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     QuantizeNeuralNetworkLayersPass.cpp (passes)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "QuantizeNeuralNetworkLayersPass.h"
+
+#include <model/include/ModelTransformer.h>
+
+#include <model/optimizer/include/OptimizationPassRegistry.h>
+
+#include <nodes/include/FullyConnectedLayerNode.h>
+#include <nodes/include/QuantizedFullyConnectedLayerNode.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace ell
+{
+namespace passes
+{
+    namespace
+    {
+        // returns 'true' if we handled the situation, else 'false'. If we return 'false', keep trying other ValueTypes.
+        template <typename ValueType>
+        bool TryQuantizeLayer(const model::Node& node, model::ModelTransformer& transformer)
+        {
+            auto thisNode = dynamic_cast<const nodes::FullyConnectedLayerNode<ValueType>*>(&node);
+            if (thisNode == nullptr || !node.GetMetadata().HasEntry(quantizationInputRangeKey))
+            {
+                return false;
+            }
+
+            // the quantized node reads and writes dense vectors, so layers with padding are left as they are
+            const auto& layerParameters = thisNode->GetLayer().GetLayerParameters();
+            if (predictors::neural::HasPadding(layerParameters.inputPaddingParameters) || predictors::neural::HasPadding(layerParameters.outputPaddingParameters))
+            {
+                return false;
+            }
+
+            auto inputRange = static_cast<ValueType>(node.GetMetadata().GetEntry<double>(quantizationInputRangeKey));
+            const auto& newInput = transformer.GetCorrespondingInputs(thisNode->input);
+            auto newNode = transformer.AddNode<nodes::QuantizedFullyConnectedLayerNode<ValueType>>(newInput, thisNode->GetLayer(), inputRange);
+            transformer.MapNodeOutput(thisNode->output, newNode->output);
+            return true;
+        }
+    } // namespace
+
+    template <typename ValueType>
+    void CalibrateQuantization(model::Map& map, const std::vector<std::vector<ValueType>>& calibrationInputs)
+    {
+        auto& model = map.GetModel();
+        std::vector<const nodes::FullyConnectedLayerNode<ValueType>*> layerNodes;
+        model.Visit([&layerNodes](const model::Node& node) {
+            if (auto layerNode = dynamic_cast<const nodes::FullyConnectedLayerNode<ValueType>*>(&node))
+            {
+                layerNodes.push_back(layerNode);
+            }
+        });
+
+        // Computing the map leaves each layer's input values in the output ports that feed it
+        std::vector<double> inputRanges(layerNodes.size(), 0);
+        for (const auto& input : calibrationInputs)
+        {
+            map.Compute<ValueType>(input);
+            for (size_t index = 0; index < layerNodes.size(); ++index)
+            {
+                for (auto value : layerNodes[index]->input.GetValue())
+                {
+                    inputRanges[index] = std::max(inputRanges[index], static_cast<double>(std::abs(value)));
+                }
+            }
+        }
+
+        for (size_t index = 0; index < layerNodes.size(); ++index)
+        {
+            model.GetNode(layerNodes[index]->GetId())->GetMetadata().SetEntry(quantizationInputRangeKey, inputRanges[index]);
+        }
+    }
+
+    //
+    // QuantizeNeuralNetworkLayersPass methods
+    //
+    void QuantizeNeuralNetworkLayersPass::OptimizeNode(const model::Node& node, const model::MapCompilerOptions& settings, model::ModelOptimizerContext& context) const
+    {
+        auto& transformer = context.GetTransformer();
+        if (TryQuantizeLayer<float>(node, transformer))
+        {
+            return;
+        }
+        if (TryQuantizeLayer<double>(node, transformer))
+        {
+            return;
+        }
+
+        transformer.CopyNode(node);
+    }
+
+    void QuantizeNeuralNetworkLayersPass::AddToRegistry()
+    {
+        model::OptimizationPassInfo info = {
+            "QuantizeNeuralNetworkLayersPass",
+            [](const model::ModelOptimizerOptions& settings) { return settings.phase == model::OptimizerPhase::optimize && settings.quantizeNeuralNetworkLayers; },
+            [] { return std::make_unique<QuantizeNeuralNetworkLayersPass>(); }
+        };
+        model::OptimizationPassRegistry::AddPass(info);
+    }
+
+    // Explicit instantiations
+    template void CalibrateQuantization<float>(model::Map& map, const std::vector<std::vector<float>>& calibrationInputs);
+    template void CalibrateQuantization<double>(model::Map& map, const std::vector<std::vector<double>>& calibrationInputs);
+} // namespace passes
+} // namespace ell
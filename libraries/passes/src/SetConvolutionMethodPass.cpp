@@ -8,6 +8,10 @@
 
 #include "SetConvolutionMethodPass.h"
 
+#include <model/include/IRCompiledMap.h>
+#include <model/include/IRMapCompiler.h>
+#include <model/include/InputNode.h>
+#include <model/include/Map.h>
 #include <model/include/ModelTransformer.h>
 
 #include <model/optimizer/include/OptimizationPassRegistry.h>
@@ -17,6 +21,19 @@
 #include <predictors/neural/include/ConvolutionalLayer.h>
 
 #include <utilities/include/Exception.h>
+#include <utilities/include/TypeName.h>
+
+#include <llvm/Support/Host.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
 
 namespace ell
 {
@@ -57,9 +74,177 @@ namespace passes
             return true;
         }
 
+        //
+        // Autotuning
+        //
+
+        // The methods tried by the autotuner, and their names in the tuning cache file
+        const std::vector<std::pair<model::PreferredConvolutionMethod, std::string>> autotuneCandidates = {
+            { model::PreferredConvolutionMethod::unrolled, "unrolled" },
+            { model::PreferredConvolutionMethod::simple, "simple" },
+            { model::PreferredConvolutionMethod::diagonal, "diagonal" },
+            { model::PreferredConvolutionMethod::winograd, "winograd" }
+        };
+
+        constexpr int autotuneWarmupIterations = 2;
+        constexpr int autotuneTimedIterations = 10;
+
+        // Tuning results for each cache file that has been used in this process, keyed by layer description.
+        // The empty path holds results that aren't persisted.
+        using TuningResults = std::map<std::string, model::PreferredConvolutionMethod>;
+        std::mutex tuningCacheMutex;
+        std::map<std::string, TuningResults> tuningCaches;
+
+        // Note: must be called with tuningCacheMutex held
+        TuningResults& GetTuningResults(const std::string& cachePath)
+        {
+            auto it = tuningCaches.find(cachePath);
+            if (it != tuningCaches.end())
+            {
+                return it->second;
+            }
+
+            auto& results = tuningCaches[cachePath];
+            if (!cachePath.empty())
+            {
+                // Each line of the file is "<layer description> <method name>". Later lines override earlier ones.
+                std::ifstream cacheFile(cachePath);
+                std::string key;
+                std::string methodName;
+                while (cacheFile >> key >> methodName)
+                {
+                    auto candidate = std::find_if(autotuneCandidates.begin(), autotuneCandidates.end(), [&methodName](const auto& c) { return c.second == methodName; });
+                    if (candidate != autotuneCandidates.end())
+                    {
+                        results[key] = candidate->first;
+                    }
+                }
+            }
+            return results;
+        }
+
+        // Note: must be called with tuningCacheMutex held
+        void AddTuningResult(const std::string& cachePath, const std::string& key, model::PreferredConvolutionMethod method)
+        {
+            GetTuningResults(cachePath)[key] = method;
+            if (!cachePath.empty())
+            {
+                auto candidate = std::find_if(autotuneCandidates.begin(), autotuneCandidates.end(), [method](const auto& c) { return c.first == method; });
+                std::ofstream cacheFile(cachePath, std::ios::app);
+                cacheFile << key << " " << candidate->second << std::endl;
+            }
+        }
+
+        // Returns a string that identifies the shape of a convolutional layer and the settings that affect the speed of
+        // each method, for looking up tuning results. The candidates are timed on the host, so its CPU is part of the key.
+        template <typename ValueType>
+        std::string GetLayerTuningKey(const predictors::neural::ConvolutionalLayer<ValueType>& layer, const model::MapCompilerOptions& settings)
+        {
+            const auto& layerParameters = layer.GetLayerParameters();
+            const auto& convolutionalParameters = layer.GetConvolutionalParameters();
+            const auto& compilerSettings = settings.compilerSettings;
+            const auto& targetDevice = compilerSettings.targetDevice;
+            auto inputShape = layer.GetInputShape();
+            auto outputShape = layer.GetOutputShape();
+
+            std::stringstream key;
+            key << utilities::GetTypeName<ValueType>()
+                << "_in" << inputShape.NumRows() << "x" << inputShape.NumColumns() << "x" << inputShape.NumChannels()
+                << "p" << layerParameters.inputPaddingParameters.paddingSize
+                << "_out" << outputShape.NumRows() << "x" << outputShape.NumColumns() << "x" << outputShape.NumChannels()
+                << "p" << layerParameters.outputPaddingParameters.paddingSize
+                << "_f" << convolutionalParameters.receptiveField
+                << "_s" << convolutionalParameters.stride
+                << "_blas" << compilerSettings.useBlas << static_cast<int>(compilerSettings.blasType)
+                << "_v" << compilerSettings.vectorWidth
+                << "_par" << compilerSettings.parallelize
+                << "_target" << targetDevice.deviceName << ":" << targetDevice.triple << ":" << targetDevice.cpu
+                << "_host" << llvm::sys::getHostCPUName().str();
+            return key.str();
+        }
+
+        // Compiles a single convolutional layer with the given method for the host and returns its average running time in seconds
+        template <typename ValueType>
+        double TimeConvolutionMethod(const predictors::neural::ConvolutionalLayer<ValueType>& layer, size_t inputSize, model::PreferredConvolutionMethod method, const model::MapCompilerOptions& settings)
+        {
+            auto convolutionalParameters = layer.GetConvolutionalParameters();
+            convolutionalParameters.method = GetConvolutionMethod(method);
+            predictors::neural::ConvolutionalLayer<ValueType> candidateLayer = { layer.GetLayerParameters(), convolutionalParameters, layer.GetWeights() };
+
+            model::Model model;
+            auto inputNode = model.AddNode<model::InputNode<ValueType>>(inputSize);
+            auto convolutionNode = model.AddNode<nodes::ConvolutionalLayerNode<ValueType>>(inputNode->output, candidateLayer);
+            model::Map map(model, { { "input", inputNode } }, { { "output", convolutionNode->output } });
+
+            // The candidate always runs on the host, with the layer's method already chosen
+            auto candidateSettings = settings;
+            candidateSettings.moduleName = "ConvolutionAutotune";
+            candidateSettings.mapFunctionName = "ConvolutionAutotune";
+            candidateSettings.profile = false;
+            candidateSettings.optimizerSettings.preferredConvolutionMethod = model::PreferredConvolutionMethod::automatic;
+            candidateSettings.compilerSettings.profile = false;
+            candidateSettings.compilerSettings.targetDevice = {};
+            candidateSettings.compilerSettings.targetDevice.deviceName = "host";
+
+            model::IRMapCompiler compiler(candidateSettings);
+            auto compiledMap = compiler.Compile(map);
+
+            std::vector<ValueType> input(inputSize, static_cast<ValueType>(1));
+            for (int iteration = 0; iteration < autotuneWarmupIterations; ++iteration)
+            {
+                compiledMap.Compute<ValueType>(input);
+            }
+
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int iteration = 0; iteration < autotuneTimedIterations; ++iteration)
+            {
+                compiledMap.Compute<ValueType>(input);
+            }
+            std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+            return elapsed.count() / autotuneTimedIterations;
+        }
+
+        // Returns the fastest method for the given layer, benchmarking the candidates if the layer's shape hasn't been seen before
+        template <typename ValueType>
+        model::PreferredConvolutionMethod GetTunedConvolutionMethod(const nodes::ConvolutionalLayerNode<ValueType>& node, const model::MapCompilerOptions& settings)
+        {
+            const auto& layer = node.GetLayer();
+            const auto& cachePath = settings.optimizerSettings.convolutionTuningCachePath;
+            auto key = GetLayerTuningKey(layer, settings);
+
+            std::lock_guard<std::mutex> lock(tuningCacheMutex);
+            auto& results = GetTuningResults(cachePath);
+            auto it = results.find(key);
+            if (it != results.end())
+            {
+                return it->second;
+            }
+
+            auto bestMethod = model::PreferredConvolutionMethod::automatic;
+            auto bestTime = std::numeric_limits<double>::max();
+            for (const auto& candidate : autotuneCandidates)
+            {
+                auto convolutionalParameters = layer.GetConvolutionalParameters();
+                if (!IsMethodCompatible(GetConvolutionMethod(candidate.first), convolutionalParameters))
+                {
+                    continue;
+                }
+
+                auto time = TimeConvolutionMethod(layer, node.input.Size(), candidate.first, settings);
+                if (time < bestTime)
+                {
+                    bestTime = time;
+                    bestMethod = candidate.first;
+                }
+            }
+
+            AddTuningResult(cachePath, key, bestMethod);
+            return bestMethod;
+        }
+
         // returns 'true' if we handled the situation, else 'false'. If we return 'false', keep trying other ValueTypes.
         template <typename ValueType>
-        bool TrySetConvolutionMethod(const model::Node& node, model::ModelTransformer& transformer, model::PreferredConvolutionMethod preferredMethod)
+        bool TrySetConvolutionMethod(const model::Node& node, model::ModelTransformer& transformer, model::PreferredConvolutionMethod preferredMethod, const model::MapCompilerOptions& settings)
         {
             auto thisNode = dynamic_cast<const nodes::ConvolutionalLayerNode<ValueType>*>(&node);
             if (thisNode == nullptr)
@@ -67,6 +252,11 @@ namespace passes
                 return false;
             }
 
+            if (preferredMethod == model::PreferredConvolutionMethod::autotune)
+            {
+                preferredMethod = GetTunedConvolutionMethod(*thisNode, settings);
+            }
+
             const auto& newInput = transformer.GetCorrespondingInputs(thisNode->input);
             const auto& layer = thisNode->GetLayer();
 
@@ -87,15 +277,15 @@ namespace passes
             return true;
         }
 
-        void SetConvolutionMethod(const model::Node& node, model::ModelTransformer& transformer, model::PreferredConvolutionMethod preferredMethod)
+        void SetConvolutionMethod(const model::Node& node, model::ModelTransformer& transformer, model::PreferredConvolutionMethod preferredMethod, const model::MapCompilerOptions& settings)
         {
             if (preferredMethod != model::PreferredConvolutionMethod::automatic)
             {
-                if (TrySetConvolutionMethod<float>(node, transformer, preferredMethod))
+                if (TrySetConvolutionMethod<float>(node, transformer, preferredMethod, settings))
                 {
                     return;
                 }
-                if (TrySetConvolutionMethod<double>(node, transformer, preferredMethod))
+                if (TrySetConvolutionMethod<double>(node, transformer, preferredMethod, settings))
                 {
                     return;
                 }
@@ -111,7 +301,7 @@ namespace passes
     void SetConvolutionMethodPass::OptimizeNode(const model::Node& node, const model::MapCompilerOptions& settings, model::ModelOptimizerContext& context) const
     {
         auto preferredMethod = settings.optimizerSettings.preferredConvolutionMethod;
-        SetConvolutionMethod(node, context.GetTransformer(), preferredMethod);
+        SetConvolutionMethod(node, context.GetTransformer(), preferredMethod, settings);
     }
 
     void SetConvolutionMethodPass::AddToRegistry()
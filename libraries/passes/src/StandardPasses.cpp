@@ -6,8 +6,10 @@
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include "FuseConvolutionLayersPass.h"
 #include "FuseLinearOperationsPass.h"
 #include "OptimizeReorderDataNodes.h"
+#include "QuantizeNeuralNetworkLayersPass.h"
 #include "SetConvolutionMethodPass.h"
 
 #include <model/include/OutputNode.h>
@@ -25,7 +27,9 @@ namespace passes
     void AddStandardPassesToRegistry()
     {
         SetConvolutionMethodPass::AddToRegistry();
+        QuantizeNeuralNetworkLayersPass::AddToRegistry();
         FuseLinearOperationsPass::AddToRegistry();
+        FuseConvolutionLayersPass::AddToRegistry();
         OptimizeReorderDataNodes::AddToRegistry();
     }
 } // namespace passes
@@ -14,3 +14,10 @@ void TestOptimizeReorderDataNodes1();
 void TestOptimizeReorderDataNodes2();
 void TestOptimizeReorderDataNodes3();
 void TestOptimizeReorderDataNodes4();
+
+void TestConvolutionAutotuning();
+
+void TestFuseConvolutionLayersPass();
+void TestFusedBiasActivationArchiving();
+
+void TestQuantizeNeuralNetworkLayersPass();
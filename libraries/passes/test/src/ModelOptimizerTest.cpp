@@ -8,6 +8,8 @@
 
 // #include "ModelTestUtilities.h"
 
+#include <common/include/LoadModel.h>
+
 #include <model/optimizer/include/ModelOptimizer.h>
 
 #include <model/include/IRMapCompiler.h>
@@ -16,18 +18,29 @@
 #include <model/include/MapCompilerOptions.h>
 #include <model/include/PortMemoryLayout.h>
 
+#include <nodes/include/ActivationFunctions.h>
 #include <nodes/include/BroadcastFunctionNode.h>
 #include <nodes/include/ConstantNode.h>
+#include <nodes/include/ConvolutionalLayerNode.h>
+#include <nodes/include/FullyConnectedLayerNode.h>
+#include <nodes/include/QuantizedFullyConnectedLayerNode.h>
 #include <nodes/include/MatrixMatrixMultiplyNode.h>
 #include <nodes/include/ReorderDataNode.h>
 
 #include <passes/include/FuseLinearOperationsPass.h>
+#include <passes/include/QuantizeNeuralNetworkLayersPass.h>
 #include <passes/include/StandardPasses.h>
 
 #include <testing/include/testing.h>
 
+#include <utilities/include/JsonArchiver.h>
+
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
+#include <sstream>
+#include <string>
 
 // set to 1 to print models
 #define PRINT_MODELS 0
@@ -400,3 +413,233 @@ void TestOptimizeReorderDataNodes4()
 
     testing::ProcessTest("Testing compiled model optimizer", oldSize == 9 && newSize == 4);
 }
+
+void TestConvolutionAutotuning()
+{
+    using ValueType = float;
+    using namespace predictors::neural;
+    using LayerParameters = typename Layer<ValueType>::LayerParameters;
+    using TensorType = typename Layer<ValueType>::TensorType;
+    constexpr size_t numRows = 6, numColumns = 6, numChannels = 2, numFilters = 3, filterSize = 3, padding = 1;
+
+    TensorType inputWithPadding(numRows + 2 * padding, numColumns + 2 * padding, numChannels);
+    LayerParameters layerParameters{ inputWithPadding, ZeroPadding(padding), { numRows, numColumns, numFilters }, NoPadding() };
+    ConvolutionalParameters convolutionalParameters{ filterSize, 1, ConvolutionMethod::automatic, numFilters };
+    TensorType weights(numFilters * filterSize, filterSize, numChannels);
+    weights.Generate(Increment(static_cast<ValueType>(-1), static_cast<ValueType>(0.01)));
+    ConvolutionalLayer<ValueType> layer(layerParameters, convolutionalParameters, weights);
+
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<ValueType>>(inputWithPadding.Size());
+    auto convolutionNode = model.AddNode<nodes::ConvolutionalLayerNode<ValueType>>(inputNode->output, layer);
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", convolutionNode->output } });
+
+    std::vector<ValueType> input(inputWithPadding.Size());
+    std::generate(input.begin(), input.end(), Increment(static_cast<ValueType>(0), static_cast<ValueType>(0.1)));
+    auto expected = map.Compute<ValueType>(input);
+
+    // Initialize pass registry
+    passes::AddStandardPassesToRegistry();
+
+    const std::string cachePath = "convolutionTuningCache.txt";
+    std::remove(cachePath.c_str());
+    auto countCacheEntries = [&cachePath]() {
+        std::ifstream cacheFile(cachePath);
+        std::string line;
+        int count = 0;
+        while (std::getline(cacheFile, line))
+        {
+            ++count;
+        }
+        return count;
+    };
+
+    model::MapCompilerOptions settings;
+    settings.optimizerSettings.preferredConvolutionMethod = model::PreferredConvolutionMethod::autotune;
+    settings.optimizerSettings.convolutionTuningCachePath = cachePath;
+    model::IRMapCompiler compiler(settings);
+    auto compiledMap = compiler.Compile(map);
+    auto result = compiledMap.Compute<ValueType>(input);
+    auto numEntries = countCacheEntries();
+
+    // A second compile of the same layer shape should reuse the stored result
+    model::IRMapCompiler compiler2(settings);
+    auto compiledMap2 = compiler2.Compile(map);
+    auto result2 = compiledMap2.Compute<ValueType>(input);
+
+    testing::ProcessTest("Testing autotuned convolution output", testing::IsEqual(result, expected, 1e-4f) && testing::IsEqual(result2, expected, 1e-4f));
+    testing::ProcessTest("Testing convolution tuning cache", numEntries == 1 && countCacheEntries() == 1);
+    std::remove(cachePath.c_str());
+}
+
+void TestQuantizeNeuralNetworkLayersPass()
+{
+    using ValueType = float;
+    using namespace predictors::neural;
+    using LayerType = FullyConnectedLayer<ValueType>;
+    using TensorType = typename LayerType::TensorType;
+    using MatrixType = typename LayerType::MatrixType;
+    constexpr size_t numInputs = 20, numOutputs = 5;
+
+    TensorType layerInput(1, 1, numInputs);
+    typename LayerType::LayerParameters layerParameters{ layerInput, NoPadding(), { numOutputs, 1, 1 }, NoPadding() };
+    MatrixType weights(numOutputs, numInputs);
+    weights.Generate(Increment(static_cast<ValueType>(-1), static_cast<ValueType>(0.02)));
+    LayerType layer(layerParameters, weights);
+
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<ValueType>>(numInputs);
+    auto layerNode = model.AddNode<nodes::FullyConnectedLayerNode<ValueType>>(inputNode->output, layer);
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", layerNode->output } });
+
+    std::vector<std::vector<ValueType>> calibrationInputs;
+    for (int index = 0; index < 3; ++index)
+    {
+        std::vector<ValueType> input(numInputs);
+        std::generate(input.begin(), input.end(), Increment(static_cast<ValueType>(index - 2), static_cast<ValueType>(0.1)));
+        calibrationInputs.push_back(input);
+    }
+    passes::CalibrateQuantization(map, calibrationInputs);
+
+    // Initialize pass registry
+    passes::AddStandardPassesToRegistry();
+
+    model::MapCompilerOptions settings;
+    settings.optimizerSettings.quantizeNeuralNetworkLayers = true;
+    model::IRMapCompiler compiler(settings);
+    auto compiledMap = compiler.Compile(map);
+
+    int numQuantizedNodes = 0;
+    compiledMap.GetModel().Visit([&numQuantizedNodes](const model::Node& node) {
+        if (dynamic_cast<const nodes::QuantizedFullyConnectedLayerNode<ValueType>*>(&node) != nullptr)
+        {
+            ++numQuantizedNodes;
+        }
+    });
+
+    bool ok = true;
+    for (const auto& input : calibrationInputs)
+    {
+        auto expected = map.Compute<ValueType>(input);
+        auto actual = compiledMap.Compute<ValueType>(input);
+        ok = ok && testing::IsEqual(expected, actual, 0.25f);
+    }
+
+    testing::ProcessTest("Testing quantization pass replaces calibrated layers", numQuantizedNodes == 1);
+    testing::ProcessTest("Testing quantized layer output", ok);
+}
+
+void TestFuseConvolutionLayersPass()
+{
+    using ValueType = float;
+    using namespace predictors::neural;
+    using LayerParameters = typename Layer<ValueType>::LayerParameters;
+    using TensorType = typename Layer<ValueType>::TensorType;
+    using FusedNodeType = nodes::BroadcastBinaryFunctionNode<ValueType, nodes::BiasActivationFunction<ValueType, nodes::ReLUActivationFunction<ValueType>>>;
+    constexpr size_t numRows = 6, numColumns = 6, numChannels = 2, numFilters = 3, filterSize = 3, padding = 1;
+
+    TensorType inputWithPadding(numRows + 2 * padding, numColumns + 2 * padding, numChannels);
+    LayerParameters layerParameters{ inputWithPadding, ZeroPadding(padding), { numRows, numColumns, numFilters }, NoPadding() };
+    ConvolutionalParameters convolutionalParameters{ filterSize, 1, ConvolutionMethod::automatic, numFilters };
+    TensorType weights(numFilters * filterSize, filterSize, numChannels);
+    weights.Generate(Increment(static_cast<ValueType>(-1), static_cast<ValueType>(0.01)));
+    ConvolutionalLayer<ValueType> layer(layerParameters, convolutionalParameters, weights);
+
+    // conv -> batch normalization (as a refined linear function) -> ReLU
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<ValueType>>(inputWithPadding.Size());
+    auto convolutionNode = model.AddNode<nodes::ConvolutionalLayerNode<ValueType>>(inputNode->output, layer);
+    auto layout = convolutionNode->GetOutputMemoryLayout();
+    auto scaleNode = model.AddNode<nodes::ConstantNode<ValueType>>(std::vector<ValueType>{ 0.5, -2.0, 1.5 });
+    auto biasNode = model.AddNode<nodes::ConstantNode<ValueType>>(std::vector<ValueType>{ 0.25, 1.0, -3.0 });
+    auto linearNode = model.AddNode<nodes::BroadcastLinearFunctionNode<ValueType>>(convolutionNode->output, layout, scaleNode->output, biasNode->output, 2, layout);
+    auto activationNode = model.AddNode<nodes::BroadcastUnaryFunctionNode<ValueType, nodes::ReLUActivationFunction<ValueType>>>(linearNode->output, layout, layout);
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", activationNode->output } });
+
+    // Only the active area gets data, since the layer expects its input padding to be zero
+    std::vector<ValueType> input(inputWithPadding.Size());
+    auto nextValue = Increment(static_cast<ValueType>(-3), static_cast<ValueType>(0.1));
+    for (size_t row = padding; row < numRows + padding; ++row)
+    {
+        for (size_t column = padding; column < numColumns + padding; ++column)
+        {
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                input[(row * (numColumns + 2 * padding) + column) * numChannels + channel] = nextValue();
+            }
+        }
+    }
+    auto expected = map.Compute<ValueType>(input);
+
+    // Initialize pass registry
+    passes::AddStandardPassesToRegistry();
+
+    model::MapCompilerOptions settings;
+    settings.optimizerSettings.fuseConvolutionLayers = true;
+    model::IRMapCompiler compiler(settings);
+    auto compiledMap = compiler.Compile(map);
+    auto result = compiledMap.Compute<ValueType>(input);
+
+    int numFusedNodes = 0;
+    int numLinearNodes = 0;
+    compiledMap.GetModel().Visit([&numFusedNodes, &numLinearNodes](const model::Node& node) {
+        if (dynamic_cast<const FusedNodeType*>(&node) != nullptr)
+        {
+            ++numFusedNodes;
+        }
+        if (dynamic_cast<const nodes::BroadcastLinearFunctionNode<ValueType>*>(&node) != nullptr)
+        {
+            ++numLinearNodes;
+        }
+    });
+
+    testing::ProcessTest("Testing convolution layer fusion", numFusedNodes == 1 && numLinearNodes == 0);
+    testing::ProcessTest("Testing fused convolution output", testing::IsEqual(result, expected, 1e-4f));
+}
+
+template <typename ValueType, typename ActivationFunctionType>
+void VerifyFusedBiasActivationArchiving()
+{
+    using FusedNodeType = nodes::BroadcastBinaryFunctionNode<ValueType, nodes::BiasActivationFunction<ValueType, ActivationFunctionType>>;
+
+    model::PortMemoryLayout layout(model::MemoryShape{ 2, 2, 3 });
+    model::Model model;
+    auto inputNode = model.AddNode<model::InputNode<ValueType>>(layout.GetMemorySize());
+    auto biasNode = model.AddNode<nodes::ConstantNode<ValueType>>(std::vector<ValueType>{ 0.25, 1.0, -3.0 });
+    auto fusedNode = model.AddNode<FusedNodeType>(inputNode->output, layout, biasNode->output, 2, layout);
+    auto map = model::Map(model, { { "input", inputNode } }, { { "output", fusedNode->output } });
+
+    utilities::SerializationContext context;
+    common::RegisterNodeTypes(context);
+    std::stringstream stream;
+    utilities::JsonArchiver archiver(stream);
+    archiver << map;
+    utilities::JsonUnarchiver unarchiver(stream, context);
+    model::Map unarchivedMap;
+    unarchiver >> unarchivedMap;
+
+    int numFusedNodes = 0;
+    unarchivedMap.GetModel().Visit([&numFusedNodes](const model::Node& node) {
+        if (dynamic_cast<const FusedNodeType*>(&node) != nullptr)
+        {
+            ++numFusedNodes;
+        }
+    });
+
+    std::vector<ValueType> input(layout.GetMemorySize());
+    std::generate(input.begin(), input.end(), Increment(static_cast<ValueType>(-3), static_cast<ValueType>(0.5)));
+    auto expected = map.Compute<ValueType>(input);
+    auto result = unarchivedMap.Compute<ValueType>(input);
+    testing::ProcessTest("Testing archiving of " + FusedNodeType::GetTypeName(), numFusedNodes == 1 && testing::IsEqual(result, expected));
+}
+
+void TestFusedBiasActivationArchiving()
+{
+    VerifyFusedBiasActivationArchiving<float, nodes::ReLUActivationFunction<float>>();
+    VerifyFusedBiasActivationArchiving<float, nodes::LeakyReLUActivationFunction<float>>();
+    VerifyFusedBiasActivationArchiving<float, nodes::SigmoidActivationFunction<float>>();
+    VerifyFusedBiasActivationArchiving<float, nodes::HardSigmoidActivationFunction<float>>();
+    VerifyFusedBiasActivationArchiving<float, nodes::TanhActivationFunction<float>>();
+    VerifyFusedBiasActivationArchiving<double, nodes::ReLUActivationFunction<double>>();
+    VerifyFusedBiasActivationArchiving<double, nodes::TanhActivationFunction<double>>();
+}
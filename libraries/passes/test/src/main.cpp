@@ -30,6 +30,13 @@ int main()
         TestOptimizeReorderDataNodes2();
         TestOptimizeReorderDataNodes3();
         TestOptimizeReorderDataNodes4();
+
+        TestConvolutionAutotuning();
+
+        TestFuseConvolutionLayersPass();
+        TestFusedBiasActivationArchiving();
+
+        TestQuantizeNeuralNetworkLayersPass();
     }
     catch (const utilities::Exception& exception)
     {
@@ -0,0 +1,409 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     BinnedForestTrainer.h (trainers)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "ForestTrainer.h"
+
+#include <predictors/include/ConstantPredictor.h>
+#include <predictors/include/SingleElementThresholdPredictor.h>
+
+#include <utilities/include/ThreadPool.h>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace ell
+{
+namespace trainers
+{
+    /// <summary> Parameters for the binned forest trainer. </summary>
+    struct BinnedForestTrainerParameters : public virtual ForestTrainerParameters
+    {
+        size_t maxBinsPerFeature = 256;
+        size_t binningSampleSize = 100000;
+        size_t numThreads = 0;
+    };
+
+    /// <summary> A trainer for binary decision forests with threshold split rules and constant outputs. The values of
+    /// each feature are bucketized once, into at most 256 bins, and split rules are found by scanning histograms of the
+    /// weak labels over the bins. Histograms are built in parallel over blocks of features, and the histogram of the
+    /// larger child of each split is computed by subtracting the histogram of its smaller sibling from the histogram of
+    /// its parent. </summary>
+    ///
+    /// <typeparam name="LossFunctionType"> The loss function type. </typeparam>
+    /// <typeparam name="BoosterType"> The booster type. </typeparam>
+    template <typename LossFunctionType, typename BoosterType>
+    class BinnedForestTrainer : public ForestTrainer<predictors::SingleElementThresholdPredictor, predictors::ConstantPredictor, BoosterType>
+    {
+    public:
+        /// <summary> Constructs an instance of BinnedForestTrainer. </summary>
+        ///
+        /// <param name="lossFunction"> The loss function. </param>
+        /// <param name="booster"> The booster. </param>
+        /// <param name="parameters"> Training Parameters. </param>
+        BinnedForestTrainer(const LossFunctionType& lossFunction, const BoosterType& booster, const BinnedForestTrainerParameters& parameters);
+
+        using SplitRuleType = predictors::SingleElementThresholdPredictor;
+        using EdgePredictorType = predictors::ConstantPredictor;
+        using typename ForestTrainer<SplitRuleType, EdgePredictorType, BoosterType>::SplitCandidate;
+        using typename ForestTrainer<SplitRuleType, EdgePredictorType, BoosterType>::SplittableNodeId;
+        using typename ForestTrainer<SplitRuleType, EdgePredictorType, BoosterType>::NodeStats;
+        using typename ForestTrainer<SplitRuleType, EdgePredictorType, BoosterType>::Range;
+        using typename ForestTrainer<SplitRuleType, EdgePredictorType, BoosterType>::Sums;
+
+        /// <summary> Sets the trainer's dataset and bucketizes its features. </summary>
+        ///
+        /// <param name="anyDataset"> A dataset. </param>
+        void SetDataset(const data::AnyDataset& anyDataset) override;
+
+    protected:
+        using ForestTrainer<SplitRuleType, EdgePredictorType, BoosterType>::_dataset;
+        SplitCandidate GetBestSplitRuleAtNode(SplittableNodeId nodeId, Range range, Sums sums) override;
+        std::vector<EdgePredictorType> GetEdgePredictors(const NodeStats& nodeStats) override;
+        void DiscardSplitCandidate(const SplitCandidate& splitCandidate) override;
+
+    private:
+        using BinIndexType = uint8_t;
+
+        struct HistogramBin
+        {
+            Sums sums;
+            size_t count = 0;
+        };
+
+        // one block of _maxBinsPerFeature bins per feature
+        using Histogram = std::vector<HistogramBin>;
+
+        // the histogram of a node whose best split has been found, kept until its children ask for it or the split is discarded
+        struct ParentHistogram
+        {
+            Histogram histogram;
+            Range childRange0;
+            Range childRange1;
+        };
+
+        using RangeKey = std::pair<size_t, size_t>;
+        static RangeKey GetRangeKey(const Range& range) { return { range.firstIndex, range.size }; }
+
+        void BucketizeFeatures();
+        Histogram GetNodeHistogram(const Range& range);
+        Histogram BuildHistogram(const Range& range);
+        double CalculateGain(const Sums& sums, const Sums& sums0, const Sums& sums1) const;
+
+        // member variables
+        LossFunctionType _lossFunction;
+        size_t _maxBinsPerFeature;
+        size_t _binningSampleSize;
+        std::unique_ptr<utilities::ThreadPool> _threadPool;
+
+        // bin upper bounds for each feature: a value v falls in bin b if _binUpperBounds[f][b-1] < v <= _binUpperBounds[f][b]
+        size_t _numFeatures = 0;
+        std::vector<std::vector<double>> _binUpperBounds;
+
+        // the bin index of every feature of every example, one row per example, indexed by TrainerMetadata::exampleIndex
+        std::vector<BinIndexType> _bins;
+
+        // histograms kept for the sibling-subtraction trick, keyed by node range
+        std::map<RangeKey, ParentHistogram> _parentHistograms;
+        std::map<RangeKey, Histogram> _siblingHistograms;
+    };
+
+    /// <summary> Makes a binned forest trainer. </summary>
+    ///
+    /// <typeparam name="LossFunctionType"> Type of loss function to use. </typeparam>
+    /// <typeparam name="BoosterType"> Type of booster to use. </typeparam>
+    /// <param name="lossFunction"> The loss function. </param>
+    /// <param name="booster"> The booster. </param>
+    /// <param name="parameters"> The trainer parameters. </param>
+    ///
+    /// <returns> A unique_ptr to a binned forest trainer. </returns>
+    template <typename LossFunctionType, typename BoosterType>
+    std::unique_ptr<ITrainer<predictors::SimpleForestPredictor>> MakeBinnedForestTrainer(const LossFunctionType& lossFunction, const BoosterType& booster, const BinnedForestTrainerParameters& parameters);
+} // namespace trainers
+} // namespace ell
+
+#pragma region implementation
+
+#include <utilities/include/Exception.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace ell
+{
+namespace trainers
+{
+    template <typename LossFunctionType, typename BoosterType>
+    BinnedForestTrainer<LossFunctionType, BoosterType>::BinnedForestTrainer(const LossFunctionType& lossFunction, const BoosterType& booster, const BinnedForestTrainerParameters& parameters) :
+        ForestTrainer<SplitRuleType, EdgePredictorType, BoosterType>(booster, parameters),
+        _lossFunction(lossFunction),
+        _maxBinsPerFeature(parameters.maxBinsPerFeature),
+        _binningSampleSize(parameters.binningSampleSize),
+        _threadPool(std::make_unique<utilities::ThreadPool>(parameters.numThreads))
+    {
+        if (_maxBinsPerFeature < 2 || _maxBinsPerFeature > std::numeric_limits<BinIndexType>::max() + size_t{ 1 })
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "maxBinsPerFeature must be between 2 and 256");
+        }
+    }
+
+    template <typename LossFunctionType, typename BoosterType>
+    void BinnedForestTrainer<LossFunctionType, BoosterType>::SetDataset(const data::AnyDataset& anyDataset)
+    {
+        ForestTrainer<SplitRuleType, EdgePredictorType, BoosterType>::SetDataset(anyDataset);
+        BucketizeFeatures();
+    }
+
+    template <typename LossFunctionType, typename BoosterType>
+    void BinnedForestTrainer<LossFunctionType, BoosterType>::BucketizeFeatures()
+    {
+        _numFeatures = _dataset.NumFeatures();
+        const auto numExamples = _dataset.NumExamples();
+        _parentHistograms.clear();
+        _siblingHistograms.clear();
+
+        // choose the bin upper bounds of each feature from the quantiles of an evenly spaced sample of the examples
+        const auto sampleSize = _binningSampleSize == 0 ? numExamples : std::min(numExamples, _binningSampleSize);
+        _binUpperBounds.assign(_numFeatures, {});
+        _threadPool->ParallelFor(_numFeatures, [&](size_t featureIndex) {
+            std::vector<double> values(sampleSize);
+            for (size_t sampleIndex = 0; sampleIndex < sampleSize; ++sampleIndex)
+            {
+                values[sampleIndex] = _dataset[sampleIndex * numExamples / sampleSize].GetDataVector()[featureIndex];
+            }
+            std::sort(values.begin(), values.end());
+            values.erase(std::unique(values.begin(), values.end()), values.end());
+
+            // the last bin has no upper bound, so there are at most _maxBinsPerFeature - 1 bounds
+            auto& upperBounds = _binUpperBounds[featureIndex];
+            auto numBins = std::min(values.size(), _maxBinsPerFeature);
+            for (size_t binIndex = 1; binIndex < numBins; ++binIndex)
+            {
+                auto valueIndex = binIndex * values.size() / numBins;
+                auto upperBound = 0.5 * (values[valueIndex - 1] + values[valueIndex]);
+                if (upperBounds.empty() || upperBound > upperBounds.back())
+                {
+                    upperBounds.push_back(upperBound);
+                }
+            }
+        });
+
+        // store the bin index of each feature value
+        _bins.resize(numExamples * _numFeatures);
+        _threadPool->ParallelFor(numExamples, [&](size_t rowIndex) {
+            const auto& dataVector = _dataset[rowIndex].GetDataVector();
+            auto exampleBins = _bins.data() + _dataset[rowIndex].GetMetadata().exampleIndex * _numFeatures;
+            for (size_t featureIndex = 0; featureIndex < _numFeatures; ++featureIndex)
+            {
+                const auto& upperBounds = _binUpperBounds[featureIndex];
+                auto bin = std::lower_bound(upperBounds.begin(), upperBounds.end(), dataVector[featureIndex]) - upperBounds.begin();
+                exampleBins[featureIndex] = static_cast<BinIndexType>(bin);
+            }
+        });
+    }
+
+    template <typename LossFunctionType, typename BoosterType>
+    auto BinnedForestTrainer<LossFunctionType, BoosterType>::GetBestSplitRuleAtNode(SplittableNodeId nodeId, Range range, Sums sums) -> SplitCandidate
+    {
+        SplitCandidate bestSplitCandidate(nodeId, range, sums);
+        auto histogram = GetNodeHistogram(range);
+
+        size_t bestFeatureIndex = 0;
+        size_t bestBinIndex = 0;
+        size_t bestSize0 = 0;
+        Sums bestSums0;
+        for (size_t featureIndex = 0; featureIndex < _numFeatures; ++featureIndex)
+        {
+            const auto featureBins = histogram.data() + featureIndex * _maxBinsPerFeature;
+            const auto numBounds = _binUpperBounds[featureIndex].size();
+
+            // a split at bin b sends bins 0..b to child 0
+            Sums sums0;
+            size_t size0 = 0;
+            for (size_t binIndex = 0; binIndex < numBounds; ++binIndex)
+            {
+                sums0.sumWeights += featureBins[binIndex].sums.sumWeights;
+                sums0.sumWeightedLabels += featureBins[binIndex].sums.sumWeightedLabels;
+                size0 += featureBins[binIndex].count;
+                if (size0 == 0 || size0 == range.size || featureBins[binIndex].count == 0)
+                {
+                    continue;
+                }
+
+                Sums sums1 = sums - sums0;
+                double gain = CalculateGain(sums, sums0, sums1);
+                if (gain > bestSplitCandidate.gain)
+                {
+                    bestSplitCandidate.gain = gain;
+                    bestFeatureIndex = featureIndex;
+                    bestBinIndex = binIndex;
+                    bestSize0 = size0;
+                    bestSums0 = sums0;
+                }
+            }
+        }
+
+        if (bestSplitCandidate.gain > 0)
+        {
+            bestSplitCandidate.splitRule = SplitRuleType{ bestFeatureIndex, _binUpperBounds[bestFeatureIndex][bestBinIndex] };
+            bestSplitCandidate.ranges.SplitChildRange(0, bestSize0);
+            bestSplitCandidate.stats.SetChildSums({ bestSums0, sums - bestSums0 });
+
+            // keep the histogram, so that the histogram of one child can be derived from the other
+            ParentHistogram parentHistogram{ std::move(histogram), bestSplitCandidate.ranges.GetChildRange(0), bestSplitCandidate.ranges.GetChildRange(1) };
+            auto key = GetRangeKey(parentHistogram.childRange0);
+            _parentHistograms[key] = std::move(parentHistogram);
+        }
+
+        return bestSplitCandidate;
+    }
+
+    template <typename LossFunctionType, typename BoosterType>
+    void BinnedForestTrainer<LossFunctionType, BoosterType>::DiscardSplitCandidate(const SplitCandidate& splitCandidate)
+    {
+        // only candidates with a positive gain have a split, and a histogram kept under their first child's range
+        if (splitCandidate.gain > 0)
+        {
+            _parentHistograms.erase(GetRangeKey(splitCandidate.ranges.GetChildRange(0)));
+        }
+    }
+
+    template <typename LossFunctionType, typename BoosterType>
+    auto BinnedForestTrainer<LossFunctionType, BoosterType>::GetNodeHistogram(const Range& range) -> Histogram
+    {
+        // a new root: histograms from the previous boosting round are stale, since the weak labels have changed
+        if (range.firstIndex == 0 && range.size == _dataset.NumExamples())
+        {
+            _parentHistograms.clear();
+            _siblingHistograms.clear();
+            return BuildHistogram(range);
+        }
+
+        // the second child of a split, whose histogram was computed along with its sibling's
+        auto siblingIterator = _siblingHistograms.find(GetRangeKey(range));
+        if (siblingIterator != _siblingHistograms.end())
+        {
+            auto histogram = std::move(siblingIterator->second);
+            _siblingHistograms.erase(siblingIterator);
+            return histogram;
+        }
+
+        // the first child of a split: build the smaller child's histogram and subtract it from the parent's
+        auto parentIterator = _parentHistograms.find(GetRangeKey(range));
+        if (parentIterator == _parentHistograms.end())
+        {
+            return BuildHistogram(range);
+        }
+
+        auto parent = std::move(parentIterator->second);
+        _parentHistograms.erase(parentIterator);
+
+        bool isFirstSmaller = parent.childRange0.size <= parent.childRange1.size;
+        auto smallHistogram = BuildHistogram(isFirstSmaller ? parent.childRange0 : parent.childRange1);
+        auto& largeHistogram = parent.histogram;
+        for (size_t index = 0; index < largeHistogram.size(); ++index)
+        {
+            largeHistogram[index].sums = largeHistogram[index].sums - smallHistogram[index].sums;
+            largeHistogram[index].count -= smallHistogram[index].count;
+        }
+
+        if (isFirstSmaller)
+        {
+            _siblingHistograms[GetRangeKey(parent.childRange1)] = std::move(largeHistogram);
+            return smallHistogram;
+        }
+        _siblingHistograms[GetRangeKey(parent.childRange1)] = std::move(smallHistogram);
+        return std::move(largeHistogram);
+    }
+
+    template <typename LossFunctionType, typename BoosterType>
+    auto BinnedForestTrainer<LossFunctionType, BoosterType>::BuildHistogram(const Range& range) -> Histogram
+    {
+        struct RowStats
+        {
+            const BinIndexType* bins;
+            double weight;
+            double weightedLabel;
+        };
+
+        // gather the rows once, so that each thread reads only the bins and the weak labels
+        std::vector<RowStats> rows;
+        rows.reserve(range.size);
+        for (size_t rowIndex = range.firstIndex; rowIndex < range.firstIndex + range.size; ++rowIndex)
+        {
+            const auto& metadata = _dataset[rowIndex].GetMetadata();
+            rows.push_back({ _bins.data() + metadata.exampleIndex * _numFeatures, metadata.weak.weight, metadata.weak.weight * metadata.weak.label });
+        }
+
+        // each thread fills the bins of a contiguous block of features
+        Histogram histogram(_numFeatures * _maxBinsPerFeature);
+        auto buildFeatureBlock = [&](size_t blockIndex, size_t numBlocks) {
+            const auto firstFeature = blockIndex * _numFeatures / numBlocks;
+            const auto endFeature = (blockIndex + 1) * _numFeatures / numBlocks;
+            for (const auto& row : rows)
+            {
+                for (auto featureIndex = firstFeature; featureIndex < endFeature; ++featureIndex)
+                {
+                    auto& bin = histogram[featureIndex * _maxBinsPerFeature + row.bins[featureIndex]];
+                    bin.sums.sumWeights += row.weight;
+                    bin.sums.sumWeightedLabels += row.weightedLabel;
+                    ++bin.count;
+                }
+            }
+        };
+
+        // small nodes aren't worth the cost of waking up the threads
+        const size_t minParallelWork = 1 << 16;
+        const auto numBlocks = std::min(_numFeatures, _threadPool->NumThreads());
+        if (numBlocks <= 1 || range.size * _numFeatures < minParallelWork)
+        {
+            buildFeatureBlock(0, 1);
+        }
+        else
+        {
+            _threadPool->ParallelFor(numBlocks, [&](size_t blockIndex) { buildFeatureBlock(blockIndex, numBlocks); });
+        }
+
+        return histogram;
+    }
+
+    template <typename LossFunctionType, typename BoosterType>
+    auto BinnedForestTrainer<LossFunctionType, BoosterType>::GetEdgePredictors(const NodeStats& nodeStats) -> std::vector<EdgePredictorType>
+    {
+        double output = nodeStats.GetTotalSums().GetMeanLabel();
+        double output0 = nodeStats.GetChildSums(0).GetMeanLabel() - output;
+        double output1 = nodeStats.GetChildSums(1).GetMeanLabel() - output;
+        return std::vector<EdgePredictorType>{ output0, output1 };
+    }
+
+    template <typename LossFunctionType, typename BoosterType>
+    double BinnedForestTrainer<LossFunctionType, BoosterType>::CalculateGain(const Sums& sums, const Sums& sums0, const Sums& sums1) const
+    {
+        if (sums0.sumWeights == 0 || sums1.sumWeights == 0)
+        {
+            return 0;
+        }
+
+        return sums0.sumWeights * _lossFunction.BregmanGenerator(sums0.sumWeightedLabels / sums0.sumWeights) +
+               sums1.sumWeights * _lossFunction.BregmanGenerator(sums1.sumWeightedLabels / sums1.sumWeights) -
+               sums.sumWeights * _lossFunction.BregmanGenerator(sums.sumWeightedLabels / sums.sumWeights);
+    }
+
+    template <typename LossFunctionType, typename BoosterType>
+    std::unique_ptr<ITrainer<predictors::SimpleForestPredictor>> MakeBinnedForestTrainer(const LossFunctionType& lossFunction, const BoosterType& booster, const BinnedForestTrainerParameters& parameters)
+    {
+        return std::make_unique<BinnedForestTrainer<LossFunctionType, BoosterType>>(lossFunction, booster, parameters);
+    }
+} // namespace trainers
+} // namespace ell
+
+#pragma endregion implementation
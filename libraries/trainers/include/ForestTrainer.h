@@ -84,6 +84,9 @@ namespace trainers
 
             // the output of the forest on this example
             double currentOutput = 0;
+
+            // the position of this example in the dataset given to SetDataset, which doesn't change when the dataset is sorted
+            size_t exampleIndex = 0;
         };
 
         // keeps statistics about tree nodes
@@ -187,6 +190,9 @@ namespace trainers
         virtual SplitCandidate GetBestSplitRuleAtNode(SplittableNodeId nodeId, Range range, Sums sums) = 0;
         virtual std::vector<EdgePredictorType> GetEdgePredictors(const NodeStats& nodeStats) = 0;
 
+        // called for each split candidate that won't be split, so a derived class can free what it keeps for the candidate
+        virtual void DiscardSplitCandidate(const SplitCandidate& /*splitCandidate*/) {}
+
         //
         // member variables
         //
@@ -238,6 +244,7 @@ namespace trainers
             auto& metadata = example.GetMetadata();
             metadata.currentOutput = prediction;
             metadata.weak = _booster.GetWeakWeightLabel(metadata.strong, prediction);
+            metadata.exampleIndex = rowIndex;
         }
     }
 
@@ -265,6 +272,7 @@ namespace trainers
             // check for positive gain
             if (rootSplit.gain < _parameters.minSplitGain || _parameters.maxSplitsPerRound == 0)
             {
+                DiscardSplitCandidate(rootSplit);
                 return;
             }
 
@@ -366,9 +374,15 @@ namespace trainers
             VERBOSE_MODE(std::cout << "\n");
             VERBOSE_MODE(_forest.PrintLine(std::cout, 1));
 
-            // if max number of splits reached, exit the loop
+            // if max number of splits reached, exit the loop, discarding this split's children and the queued candidates
             if (++splitCount >= maxSplits)
             {
+                DiscardSplitCandidate(splitCandidate);
+                while (!_queue.empty())
+                {
+                    DiscardSplitCandidate(_queue.top());
+                    _queue.pop();
+                }
                 break;
             }
 
@@ -380,6 +394,10 @@ namespace trainers
                 {
                     _queue.push(std::move(splitCandidate));
                 }
+                else
+                {
+                    DiscardSplitCandidate(splitCandidate);
+                }
             }
         }
     }
@@ -10,14 +10,50 @@
 
 #include <math/include/Matrix.h>
 
+#include <utilities/include/ThreadPool.h>
+
 #include <cstddef>
 #include <map>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace ell
 {
 namespace trainers
 {
+    /// <summary> The algorithms that KMeansTrainer can use to refine the cluster means. </summary>
+    enum class KMeansAlgorithm
+    {
+        /// <summary> Computes the distance from every point to every mean in every iteration. </summary>
+        lloyd,
+
+        /// <summary> Gives the same result as lloyd, but skips the distance computations that the triangle inequality
+        /// proves unnecessary, using Hamerly's upper bound on the distance to the closest mean and lower bound on the
+        /// distance to the second closest mean. </summary>
+        hamerly,
+
+        /// <summary> Updates the means from a small random sample of the points in each iteration (Sculley 2010).
+        /// An approximation that is much faster than the exact algorithms on very large inputs. </summary>
+        miniBatch
+    };
+
+    /// <summary> Parameters for the KMeansTrainer. </summary>
+    struct KMeansTrainerParameters
+    {
+        /// <summary> The algorithm used to refine the cluster means. </summary>
+        KMeansAlgorithm algorithm = KMeansAlgorithm::hamerly;
+
+        /// <summary> The number of threads used to assign points to means. '0' means one thread per hardware thread. </summary>
+        size_t numThreads = 1;
+
+        /// <summary> The number of points sampled in each iteration of the miniBatch algorithm. </summary>
+        size_t miniBatchSize = 1024;
+
+        /// <summary> The random seed string used to sample the mini-batches. </summary>
+        std::string randomSeedString = "KMeans";
+    };
+
     /// <summary> Impements KMeansTrainer++ algorithm </summary>
     ///
     class KMeansTrainer
@@ -32,16 +68,18 @@ namespace trainers
         /// <param name="dimension"> The input dimension. </param>
         /// <param name="numClusters"> The number of clusters. </param>
         /// <param name="iterations"> The number of iterations. </param>
+        /// <param name="parameters"> The algorithm parameters. </param>
         ///
-        KMeansTrainer(size_t dimension, size_t numClusters, size_t iterations);
+        KMeansTrainer(size_t dimension, size_t numClusters, size_t iterations, const KMeansTrainerParameters& parameters = {});
 
         /// <summary> Constructs an instance of KMeansTrainer trainer </summary>
         ///
         /// <param name="numClusters"> The number of clusters. </param>
         /// <param name="iterations"> The number of iterations. </param>
         /// <param name="means"> The cluster means. </param>
+        /// <param name="parameters"> The algorithm parameters. </param>
         ///
-        KMeansTrainer(size_t numClusters, size_t iters, math::ColumnMatrix<double> means);
+        KMeansTrainer(size_t numClusters, size_t iters, math::ColumnMatrix<double> means, const KMeansTrainerParameters& parameters = {});
 
         /// <summary> Runs the KMeansTrainer algorithm. </summary>
         ///
@@ -59,18 +97,29 @@ namespace trainers
         /// <returns> The underlying cluster assignment matrix. </returns>
         const math::ColumnVector<double>& GetClusterAssignment() const { return _clusterAssignment; }
 
+        /// <summary> Returns the number of point-to-mean and mean-to-mean distances computed by the last call to RunKMeans. </summary>
+        ///
+        /// <returns> The number of distance computations. </returns>
+        size_t GetNumDistanceComputations() const { return _numDistanceComputations; }
+
     private:
         // Initializes the cluster means using the KMeansTrainer++ strategy.
         void initializeMeans(math::ConstMatrixReference<double, math::MatrixLayout::columnMajor> X);
 
-        // Distance of points to all the cluster means.
-        math::RowMatrix<double> pairwiseDistance(math::ConstMatrixReference<double, math::MatrixLayout::columnMajor> X, math::ConstMatrixReference<double, math::MatrixLayout::columnMajor> mu);
+        // The refinement algorithms.
+        void runLloyd(math::ConstMatrixReference<double, math::MatrixLayout::columnMajor> X, std::vector<size_t>& clusterAssignment);
+        void runHamerly(math::ConstMatrixReference<double, math::MatrixLayout::columnMajor> X, std::vector<size_t>& clusterAssignment);
+        void runMiniBatch(math::ConstMatrixReference<double, math::MatrixLayout::columnMajor> X, std::vector<size_t>& clusterAssignment);
 
-        // Assign each point to the closest mean.
-        double assignClosestCenter(math::ConstMatrixReference<double, math::MatrixLayout::columnMajor> X, math::VectorReference<size_t, math::VectorOrientation::column> clusterAssignment);
+        // Assign each point to the closest mean, and return the number of points whose assignment changed.
+        size_t assignClosestCenter(math::ConstMatrixReference<double, math::MatrixLayout::columnMajor> X, std::vector<size_t>& clusterAssignment);
 
-        // Recompute the cluster means.
-        void recomputeMeans(math::ConstMatrixReference<double, math::MatrixLayout::columnMajor> X, const math::ColumnVector<size_t> clusterAssignment);
+        // Recompute the cluster means. The mean of an empty cluster doesn't move.
+        void recomputeMeans(math::ConstMatrixReference<double, math::MatrixLayout::columnMajor> X, const std::vector<size_t>& clusterAssignment);
+
+        // Calls function(blockIndex, begin, end) on one contiguous block of [0, count) per thread.
+        template <typename FunctionType>
+        void forEachBlock(size_t count, FunctionType function);
 
         // Weighted sampling.
         size_t weightedSample(math::ColumnVector<double> weights);
@@ -89,6 +138,15 @@ namespace trainers
 
         // Number of clusters.
         size_t _numClusters = 0;
+
+        // The algorithm parameters.
+        KMeansTrainerParameters _parameters;
+
+        // Thread pool for the parallel steps, null when single-threaded.
+        std::unique_ptr<utilities::ThreadPool> _threadPool;
+
+        // Number of distances computed by the last run.
+        size_t _numDistanceComputations = 0;
     };
 } // namespace trainers
 } // namespace ell
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include "KMeansTrainer.h"
+
 #include <math/include/Matrix.h>
 
 #include <cstddef>
@@ -24,7 +26,7 @@ namespace trainers
         /// <summary> Returns the underlying projection matrix. </summary>
         ///
         /// <returns> The underlying projection matrix. </returns>
-        ProtoNNInit(size_t dim, size_t numLabels, size_t numPrototypesPerLabel);
+        ProtoNNInit(size_t dim, size_t numLabels, size_t numPrototypesPerLabel, const KMeansTrainerParameters& kMeansParameters = {});
 
         /// <summary> Returns the underlying projection matrix. </summary>
         ///
@@ -50,6 +52,7 @@ namespace trainers
         size_t _dim;
 
         size_t _numPrototypesPerLabel;
+        KMeansTrainerParameters _kMeansParameters;
 
         // Returns the underlying projection matrix.
         math::ColumnMatrix<double> _B;
@@ -68,6 +68,12 @@ namespace trainers
 
         ///<summary>Whether to output diagnostic information to std::cout.</summary>
         bool verbose;
+
+        ///<summary>The number of threads used to compute the similarity kernels, the gradients, and the k-means initialization of the prototypes. '0' means one thread per hardware thread.</summary>
+        size_t numThreads = 1;
+
+        ///<summary>The number of examples in each SGD mini-batch. Memory used by the kernel matrices grows with the batch size, not with the size of the dataset.</summary>
+        size_t batchSize = 256;
     };
 
 } // namespace trainers
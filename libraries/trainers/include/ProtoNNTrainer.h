@@ -20,6 +20,8 @@
 #include <data/include/Dataset.h>
 #include <data/include/Example.h>
 
+#include <utilities/include/ThreadPool.h>
+
 #include <cstddef>
 #include <map>
 #include <memory>
@@ -84,6 +86,15 @@ namespace trainers
         // The Objective function value.
         double ComputeObjective(ConstColumnMatrixReference X, ConstColumnMatrixReference Y, math::ColumnMatrixReference<double> WX, double gamma, bool recomputeWX = false);
 
+        // The gradient w.r.t. a model parameter on the examples [begin, end), summed over blocks of examples computed in parallel.
+        math::ColumnMatrix<double> Gradient(ProtoNNParameterIndex parameterIndex, ConstColumnMatrixReference X, ConstColumnMatrixReference Y, math::ColumnMatrixReference<double> WX, double gamma, size_t begin, size_t end);
+
+        // Computes WX = W * X, in parallel over blocks of examples.
+        void Project(ConstColumnMatrixReference W, ConstColumnMatrixReference X, math::ColumnMatrixReference<double> WX);
+
+        // The number of blocks to split a range of examples into, one per thread but not too small to be worth it.
+        size_t GetNumBlocks(size_t numExamples) const;
+
         // Performs Accelerated Proximal Gradient w.r.t. input model parameter.
         void AcceleratedProximalGradient(ProtoNNParameterIndex parameterIndex, std::function<math::ColumnMatrix<double>(const ConstColumnMatrixReference, const size_t, const size_t)> gradf, std::function<void(math::MatrixReference<double, math::MatrixLayout::columnMajor>)> prox, math::MatrixReference<double, math::MatrixLayout::columnMajor> param, const size_t& epochs, const size_t& n, const size_t& batchSize, const double& eta, const int& eta_update);
 
@@ -117,6 +128,8 @@ namespace trainers
 
         math::ColumnMatrix<double> _X;
         math::ColumnMatrix<double> _Y;
+
+        std::unique_ptr<utilities::ThreadPool> _threadPool;
     };
 
     /// <summary>
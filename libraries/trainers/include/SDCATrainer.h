@@ -17,12 +17,26 @@
 
 #include <math/include/Vector.h>
 
+#include <utilities/include/ThreadPool.h>
+
+#include <memory>
 #include <random>
+#include <vector>
 
 namespace ell
 {
 namespace trainers
 {
+    /// <summary> How the SDCA trainer spreads an epoch over several threads. </summary>
+    enum class SDCAParallelMode
+    {
+        /// <summary> Threads start each mini-batch from the same model and their updates are added in a fixed order. Suits dense data. </summary>
+        miniBatch,
+
+        /// <summary> Threads update the shared weights without locks (Hogwild), and keep their own copies of the bias until the end of the epoch. Suits sparse data, where threads rarely touch the same weights. </summary>
+        hogwild
+    };
+
     /// <summary> Parameters for the stochastic dual coordinate ascent trainer. </summary>
     struct SDCATrainerParameters
     {
@@ -31,6 +45,15 @@ namespace trainers
         size_t maxEpochs;
         bool permute;
         std::string randomSeedString;
+
+        /// <summary> The number of threads. '1' performs sequential epochs, '0' means one thread per hardware thread. </summary>
+        size_t numThreads = 1;
+
+        /// <summary> The parallel update mode, used when numThreads is not 1. </summary>
+        SDCAParallelMode parallelMode = SDCAParallelMode::miniBatch;
+
+        /// <summary> The number of examples processed between synchronizations in miniBatch mode. </summary>
+        size_t miniBatchSize = 4096;
     };
 
     /// <summary> Information about the result of an SDCA training session. </summary>
@@ -41,7 +64,8 @@ namespace trainers
         size_t numEpochsPerformed = 0;
     };
 
-    /// <summary> Implements the stochastic dual coordinate ascent linear trainer. </summary>
+    /// <summary> Implements the stochastic dual coordinate ascent linear trainer. When more than one thread is used, the
+    /// regularizer must be coordinate-separable (as L2Regularizer and ElasticNetRegularizer are). </summary>
     ///
     /// <typeparam name="LossFunctionType"> Loss function type. </typeparam>
     /// <typeparam name="RegularizerType"> Regularizer type. </typeparam>
@@ -92,7 +116,31 @@ namespace trainers
         using DataVectorType = typename predictors::LinearPredictor<double>::DataVectorType;
         using TrainerExampleType = data::Example<DataVectorType, TrainerMetadata>;
 
+        // per-thread state of a miniBatch epoch
+        struct LocalModel
+        {
+            math::ColumnVector<double> v;
+            math::ColumnVector<double> w;
+            math::ColumnVector<double> deltaV;
+            double d = 0;
+            double b = 0;
+            double deltaD = 0;
+        };
+
+        // per-thread bias state of a hogwild epoch
+        struct LocalBias
+        {
+            double scale = 1;
+            double d = 0;
+            double b = 0;
+            double deltaD = 0;
+        };
+
         void Step(TrainerExampleType& x);
+        void HogwildEpoch();
+        void HogwildStep(TrainerExampleType& x, LocalBias& localBias);
+        void MiniBatchEpoch();
+        void LocalSteps(size_t begin, size_t end, double scale, LocalModel& localModel);
         void ComputeObjectives();
         void ResizeTo(const data::AutoDataVector& x);
 
@@ -110,6 +158,9 @@ namespace trainers
         math::ColumnVector<double> _v;
         double _d = 0;
         math::RowVector<double> _a;
+
+        std::unique_ptr<utilities::ThreadPool> _threadPool;
+        std::vector<LocalModel> _localModels;
     };
 
     //
@@ -132,8 +183,11 @@ namespace trainers
 
 #include <data/include/DataVectorOperations.h>
 
+#include <utilities/include/Exception.h>
 #include <utilities/include/RandomEngines.h>
 
+#include <algorithm>
+
 namespace ell
 {
 namespace trainers
@@ -145,6 +199,15 @@ namespace trainers
         _parameters(parameters)
     {
         _random = utilities::GetRandomEngine(parameters.randomSeedString);
+
+        if (parameters.numThreads != 1)
+        {
+            if (parameters.parallelMode == SDCAParallelMode::miniBatch && parameters.miniBatchSize == 0)
+            {
+                throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "Mini-batch size must be positive");
+            }
+            _threadPool = std::make_unique<utilities::ThreadPool>(parameters.numThreads);
+        }
     }
 
     template <typename LossFunctionType, typename RegularizerType>
@@ -159,15 +222,27 @@ namespace trainers
         _predictorInfo.primalObjective = 0;
         _predictorInfo.dualObjective = 0;
 
-        // precompute the norm of each example
+        // precompute the norm of each example, and size the model to fit all the examples (threads can't resize it)
         for (size_t rowIndex = 0; rowIndex < numExamples; ++rowIndex)
         {
             auto& example = _dataset[rowIndex];
             example.GetMetadata().norm2Squared = example.GetDataVector().Norm2Squared();
+            ResizeTo(example.GetDataVector());
 
             auto label = example.GetMetadata().weightLabel.label;
             _predictorInfo.primalObjective += _lossFunction(0, label) / numExamples;
         }
+
+        if (_threadPool && _parameters.parallelMode == SDCAParallelMode::miniBatch)
+        {
+            _localModels.resize(_threadPool->NumThreads());
+            for (auto& localModel : _localModels)
+            {
+                localModel.v.Resize(_v.Size());
+                localModel.w.Resize(_v.Size());
+                localModel.deltaV.Resize(_v.Size());
+            }
+        }
     }
 
     template <typename LossFunctionType, typename RegularizerType>
@@ -179,9 +254,20 @@ namespace trainers
         }
 
         // Iterate
-        for (size_t i = 0; i < _dataset.NumExamples(); ++i)
+        if (!_threadPool)
+        {
+            for (size_t i = 0; i < _dataset.NumExamples(); ++i)
+            {
+                Step(_dataset[i]);
+            }
+        }
+        else if (_parameters.parallelMode == SDCAParallelMode::hogwild)
         {
-            Step(_dataset[i]);
+            HogwildEpoch();
+        }
+        else
+        {
+            MiniBatchEpoch();
         }
 
         // Finish
@@ -221,23 +307,199 @@ namespace trainers
         }
     }
 
+    template <typename LossFunctionType, typename RegularizerType>
+    void SDCATrainer<LossFunctionType, RegularizerType>::HogwildEpoch()
+    {
+        // Each thread runs over one contiguous block of examples. The weights are shared and updated without locks, but
+        // every example touches the bias, so each thread steps against a private copy of d and of the bias, and the
+        // changes that the threads made to d are added up at the end of the epoch, in thread order. As in
+        // MiniBatchEpoch, the threads' bias steps are shrunk by the number of threads so that their sum is safe.
+        auto numExamples = _dataset.NumExamples();
+        auto numBlocks = std::min(_threadPool->NumThreads(), numExamples);
+        std::vector<double> deltaDs(numBlocks, 0);
+        _threadPool->ParallelFor(numBlocks, [&](size_t blockIndex) {
+            LocalBias localBias;
+            localBias.scale = static_cast<double>(numBlocks);
+            localBias.d = _d;
+            localBias.b = _predictor.GetBias();
+            for (size_t i = blockIndex * numExamples / numBlocks; i < (blockIndex + 1) * numExamples / numBlocks; ++i)
+            {
+                HogwildStep(_dataset[i], localBias);
+            }
+            deltaDs[blockIndex] = localBias.deltaD;
+        });
+
+        for (auto deltaD : deltaDs)
+        {
+            _d += deltaD;
+        }
+        _regularizer.ConjugateGradient(_v.GetSubVector(0, 0), _d, _predictor.GetWeights().GetSubVector(0, 0), _predictor.GetBias());
+    }
+
+    template <typename LossFunctionType, typename RegularizerType>
+    void SDCATrainer<LossFunctionType, RegularizerType>::HogwildStep(TrainerExampleType& example, LocalBias& localBias)
+    {
+        // Same as Step, but the shared weights are read and written without locks. Since the regularizer is
+        // coordinate-separable, only the weights of the nonzero coordinates of the example need to be recomputed, so
+        // on sparse data threads rarely touch the same weights. An update that races with another one can be lost.
+        const auto& dataVector = example.GetDataVector();
+
+        auto weightLabel = example.GetMetadata().weightLabel;
+        auto norm2Squared = example.GetMetadata().norm2Squared + localBias.scale; // add the scaled bias term
+        auto lipschitz = norm2Squared * _inverseScaledRegularization;
+        auto dual = example.GetMetadata().dualVariable;
+
+        if (lipschitz > 0)
+        {
+            auto& weights = _predictor.GetWeights();
+            auto prediction = dataVector.Dot(weights) + localBias.b;
+
+            auto newDual = _lossFunction.ConjugateProx(1.0 / lipschitz, dual + prediction / lipschitz, weightLabel.label);
+            auto dualDiff = newDual - dual;
+
+            if (dualDiff != 0)
+            {
+                auto scale = -dualDiff * _inverseScaledRegularization;
+
+                // visit the nonzeros of the example, add them to v, and recompute the matching weights
+                dataVector.template AddTransformedTo<data::IterationPolicy::skipZeros>(_v.Transpose(), [&](data::IndexValue x) {
+                    auto delta = scale * x.value;
+                    double newV = _v[x.index] + delta;
+                    _regularizer.ConjugateGradient(math::ConstColumnVectorReference<double>(&newV, 1), weights.GetSubVector(x.index, 1));
+                    return delta;
+                });
+
+                // recompute the thread's copy of the bias alone
+                localBias.d += scale * localBias.scale;
+                localBias.deltaD += scale;
+                _regularizer.ConjugateGradient(_v.GetSubVector(0, 0), localBias.d, weights.GetSubVector(0, 0), localBias.b);
+                example.GetMetadata().dualVariable = newDual;
+            }
+        }
+    }
+
+    template <typename LossFunctionType, typename RegularizerType>
+    void SDCATrainer<LossFunctionType, RegularizerType>::MiniBatchEpoch()
+    {
+        // Each mini-batch is split into one slice per thread. Every thread starts from the shared model and runs
+        // sequential steps on its slice against a private copy, with the step size shrunk by the number of slices, so
+        // that adding up the changes that the threads made to v is a safe dual update (CoCoA+). The changes are added
+        // in thread order, so the result doesn't depend on thread scheduling.
+        auto numExamples = _dataset.NumExamples();
+        auto dimension = _v.Size();
+        for (size_t batchBegin = 0; batchBegin < numExamples; batchBegin += _parameters.miniBatchSize)
+        {
+            auto batchSize = std::min(_parameters.miniBatchSize, numExamples - batchBegin);
+            auto numSlices = std::min(_localModels.size(), batchSize);
+
+            _threadPool->ParallelFor(numSlices, [&](size_t threadIndex) {
+                auto begin = batchBegin + threadIndex * batchSize / numSlices;
+                auto end = batchBegin + (threadIndex + 1) * batchSize / numSlices;
+                LocalSteps(begin, end, static_cast<double>(numSlices), _localModels[threadIndex]);
+            });
+
+            // each thread reduces one block of coordinates
+            auto numBlocks = _localModels.size();
+            _threadPool->ParallelFor(numBlocks, [&](size_t blockIndex) {
+                auto blockBegin = blockIndex * dimension / numBlocks;
+                auto blockSize = (blockIndex + 1) * dimension / numBlocks - blockBegin;
+                auto v = _v.GetSubVector(blockBegin, blockSize);
+                for (size_t threadIndex = 0; threadIndex < numSlices; ++threadIndex)
+                {
+                    v += _localModels[threadIndex].deltaV.GetSubVector(blockBegin, blockSize);
+                }
+            });
+
+            for (size_t threadIndex = 0; threadIndex < numSlices; ++threadIndex)
+            {
+                _d += _localModels[threadIndex].deltaD;
+            }
+            _regularizer.ConjugateGradient(_v, _d, _predictor.GetWeights(), _predictor.GetBias());
+        }
+    }
+
+    template <typename LossFunctionType, typename RegularizerType>
+    void SDCATrainer<LossFunctionType, RegularizerType>::LocalSteps(size_t begin, size_t end, double scale, LocalModel& localModel)
+    {
+        localModel.v.CopyFrom(_v);
+        localModel.w.CopyFrom(_predictor.GetWeights());
+        localModel.deltaV.Reset();
+        localModel.d = _d;
+        localModel.b = _predictor.GetBias();
+        localModel.deltaD = 0;
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            auto& example = _dataset[i];
+            const auto& dataVector = example.GetDataVector();
+
+            auto weightLabel = example.GetMetadata().weightLabel;
+            auto norm2Squared = example.GetMetadata().norm2Squared + 1; // add one because of bias term
+            auto lipschitz = norm2Squared * _inverseScaledRegularization * scale;
+            auto dual = example.GetMetadata().dualVariable;
+
+            if (lipschitz > 0)
+            {
+                auto prediction = dataVector.Dot(localModel.w) + localModel.b;
+
+                auto newDual = _lossFunction.ConjugateProx(1.0 / lipschitz, dual + prediction / lipschitz, weightLabel.label);
+                auto dualDiff = newDual - dual;
+
+                if (dualDiff != 0)
+                {
+                    auto delta = -dualDiff * _inverseScaledRegularization;
+                    localModel.deltaV.Transpose() += delta * dataVector;
+                    localModel.deltaD += delta;
+                    localModel.v.Transpose() += (delta * scale) * dataVector;
+                    localModel.d += delta * scale;
+                    _regularizer.ConjugateGradient(localModel.v, localModel.d, localModel.w, localModel.b);
+                    example.GetMetadata().dualVariable = newDual;
+                }
+            }
+        }
+    }
+
     template <typename LossFunctionType, typename RegularizerType>
     void SDCATrainer<LossFunctionType, RegularizerType>::ComputeObjectives()
     {
-        double invSize = 1.0 / _dataset.NumExamples();
+        auto numExamples = _dataset.NumExamples();
+        double invSize = 1.0 / numExamples;
+
+        // sums the primal and dual losses of a contiguous range of examples
+        auto sumLosses = [&](size_t begin, size_t end, double& primalSum, double& dualSum) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                const auto& example = _dataset.GetExample(i);
+                auto label = example.GetMetadata().weightLabel.label;
+                auto prediction = _predictor.Predict(example.GetDataVector());
+                auto dualVariable = example.GetMetadata().dualVariable;
+
+                primalSum += invSize * _lossFunction(prediction, label);
+                dualSum -= invSize * _lossFunction.Conjugate(dualVariable, label);
+            }
+        };
 
         _predictorInfo.primalObjective = 0;
         _predictorInfo.dualObjective = 0;
 
-        for (size_t i = 0; i < _dataset.NumExamples(); ++i)
+        if (_threadPool)
         {
-            const auto& example = _dataset.GetExample(i);
-            auto label = example.GetMetadata().weightLabel.label;
-            auto prediction = _predictor.Predict(example.GetDataVector());
-            auto dualVariable = example.GetMetadata().dualVariable;
-
-            _predictorInfo.primalObjective += invSize * _lossFunction(prediction, label);
-            _predictorInfo.dualObjective -= invSize * _lossFunction.Conjugate(dualVariable, label);
+            auto numBlocks = _threadPool->NumThreads();
+            std::vector<double> primalSums(numBlocks, 0);
+            std::vector<double> dualSums(numBlocks, 0);
+            _threadPool->ParallelFor(numBlocks, [&](size_t blockIndex) {
+                sumLosses(blockIndex * numExamples / numBlocks, (blockIndex + 1) * numExamples / numBlocks, primalSums[blockIndex], dualSums[blockIndex]);
+            });
+
+            for (size_t blockIndex = 0; blockIndex < numBlocks; ++blockIndex)
+            {
+                _predictorInfo.primalObjective += primalSums[blockIndex];
+                _predictorInfo.dualObjective += dualSums[blockIndex];
+            }
+        }
+        else
+        {
+            sumLosses(0, numExamples, _predictorInfo.primalObjective, _predictorInfo.dualObjective);
         }
 
         _predictorInfo.primalObjective += _parameters.regularization * _regularizer(_predictor.GetWeights(), _predictor.GetBias());
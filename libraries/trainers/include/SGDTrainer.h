@@ -14,6 +14,7 @@
 
 #include <data/include/Dataset.h>
 #include <data/include/Example.h>
+#include <data/include/ExampleIterator.h>
 
 #include <cstddef>
 #include <memory>
@@ -48,6 +49,15 @@ namespace trainers
         /// <summary> Updates the state of the trainer by performing a learning epoch. </summary>
         void Update() override;
 
+        /// <summary>
+        /// Updates the state of the trainer by performing a learning epoch over the examples of an iterator, instead of
+        /// the dataset set by SetDataset. The examples are visited in the iterator's order. This is how to train on data
+        /// that doesn't fit in memory, for example with the iterators returned by data::ShardedDataset.
+        /// </summary>
+        ///
+        /// <param name="exampleIterator"> An example iterator. </param>
+        void Update(data::AutoSupervisedExampleIterator exampleIterator);
+
         /// <summary> Returns The averaged predictor. </summary>
         ///
         /// <returns> A const reference to the averaged predictor. </returns>
@@ -60,6 +70,9 @@ namespace trainers
         virtual void DoNextStep(const data::AutoDataVector& x, double y, double weight) = 0;
         virtual const PredictorType& GetAveragedPredictor() const = 0;
 
+        template <typename ExampleIteratorType>
+        void UpdateFromIterator(ExampleIteratorType& exampleIterator);
+
         data::AutoSupervisedDataset _dataset;
         std::default_random_engine _random;
         bool _firstIteration = true;
@@ -15,6 +15,8 @@
 
 #include <evaluators/include/Evaluator.h>
 
+#include <utilities/include/ThreadPool.h>
+
 #include <memory>
 #include <random>
 #include <string>
@@ -25,7 +27,23 @@ namespace ell
 {
 namespace trainers
 {
-    /// <summary> A class that runs multiple internal trainers and chooses the best performing predictor. </summary>
+    /// <summary> Parameters for the sweeping trainer. </summary>
+    struct SweepingTrainerParameters
+    {
+        /// <summary> The number of internal trainers updated concurrently. '0' means one thread per hardware thread. </summary>
+        size_t numThreads = 1;
+
+        /// <summary> The number of updates after which losing trainers start being dropped from the sweep. '0' means never. </summary>
+        size_t pruneAfterUpdates = 0;
+
+        /// <summary> A trainer is dropped once its evaluation goodness falls short of the best goodness in the sweep by more than this margin. </summary>
+        double pruningMargin = 0.05;
+    };
+
+    /// <summary>
+    /// A class that runs multiple internal trainers and chooses the best performing predictor, the one whose evaluator
+    /// reports the highest goodness. The internal trainers share the dataset and are updated concurrently.
+    /// </summary>
     ///
     /// <typeparam name="PredictorType"> The type of predictor returned by this trainer. </typeparam>
     template <typename PredictorType>
@@ -38,7 +56,8 @@ namespace trainers
         /// <summary> Constructs an instance of SweepingTrainer. </summary>
         ///
         /// <param name="evaluatingTrainers"> A vector of evaluating trainers. </param>
-        SweepingTrainer(std::vector<EvaluatingTrainerType>&& evaluatingTrainers);
+        /// <param name="parameters"> The sweeping trainer parameters. </param>
+        SweepingTrainer(std::vector<EvaluatingTrainerType>&& evaluatingTrainers, const SweepingTrainerParameters& parameters = {});
 
         /// <summary> Sets the trainer's dataset. </summary>
         ///
@@ -53,55 +72,158 @@ namespace trainers
         /// <returns> A const reference to the current predictor. </returns>
         const PredictorType& GetPredictor() const override;
 
+        /// <summary> Checks if an internal trainer is still being updated, or if it was dropped from the sweep. </summary>
+        ///
+        /// <param name="index"> Zero-based index of the internal trainer. </param>
+        ///
+        /// <returns> true if the trainer is still active. </returns>
+        bool IsActive(size_t index) const { return _isActive[index]; }
+
+        /// <summary> Gets the number of internal trainers that are still being updated. </summary>
+        ///
+        /// <returns> The number of active trainers. </returns>
+        size_t NumActiveTrainers() const;
+
     private:
+        template <typename FunctionType>
+        void ForEachActiveTrainer(FunctionType function);
+        size_t GetBestTrainerIndex() const;
+        void PruneTrainers();
+
+        SweepingTrainerParameters _parameters;
         data::Dataset<ExampleType> _dataset;
         std::vector<EvaluatingTrainerType> _evaluatingTrainers;
+        std::vector<bool> _isActive;
+        size_t _numUpdates = 0;
+        std::unique_ptr<utilities::ThreadPool> _threadPool;
     };
 
     /// <summary> Makes an incremental trainer that runs multiple internal trainers and chooses the best performing predictor. </summary>
     ///
     /// <typeparam name="PredictorType"> Type of the predictor returned by this trainer. </typeparam>
     /// <param name="evaluatingTrainers"> A vector of evaluating trainers. </param>
+    /// <param name="parameters"> The sweeping trainer parameters. </param>
     ///
     /// <returns> A unique_ptr to a sweeping trainer. </returns>
     template <typename PredictorType>
-    std::unique_ptr<ITrainer<PredictorType>> MakeSweepingTrainer(std::vector<EvaluatingTrainer<PredictorType>>&& evaluatingTrainers);
+    std::unique_ptr<ITrainer<PredictorType>> MakeSweepingTrainer(std::vector<EvaluatingTrainer<PredictorType>>&& evaluatingTrainers, const SweepingTrainerParameters& parameters = {});
 } // namespace trainers
 } // namespace ell
 
 #pragma region implementation
 
+#include <algorithm>
+#include <exception>
+#include <future>
+
 namespace ell
 {
 namespace trainers
 {
     template <typename PredictorType>
-    SweepingTrainer<PredictorType>::SweepingTrainer(std::vector<EvaluatingTrainerType>&& evaluatingTrainers) :
-        _evaluatingTrainers(std::move(evaluatingTrainers))
+    SweepingTrainer<PredictorType>::SweepingTrainer(std::vector<EvaluatingTrainerType>&& evaluatingTrainers, const SweepingTrainerParameters& parameters) :
+        _parameters(parameters),
+        _evaluatingTrainers(std::move(evaluatingTrainers)),
+        _isActive(_evaluatingTrainers.size(), true)
     {
         assert(_evaluatingTrainers.size() > 0);
+        if (_parameters.numThreads != 1)
+        {
+            _threadPool = std::make_unique<utilities::ThreadPool>(_parameters.numThreads);
+        }
     }
 
     template <typename PredictorType>
     void SweepingTrainer<PredictorType>::SetDataset(const data::AnyDataset& anyDataset)
     {
+        // the internal trainers all copy their examples from this one dataset, so they share its data vectors
         _dataset = data::Dataset<ExampleType>(anyDataset);
+        std::fill(_isActive.begin(), _isActive.end(), true);
+        _numUpdates = 0;
+
+        auto sharedDataset = _dataset.GetAnyDataset();
+        ForEachActiveTrainer([&sharedDataset](EvaluatingTrainerType& trainer) { trainer.SetDataset(sharedDataset); });
     }
 
     template <typename PredictorType>
     void SweepingTrainer<PredictorType>::Update()
     {
-        for (size_t i = 0; i < _evaluatingTrainers.size(); ++i)
+        ForEachActiveTrainer([](EvaluatingTrainerType& trainer) { trainer.Update(); });
+        ++_numUpdates;
+
+        if (_parameters.pruneAfterUpdates > 0 && _numUpdates >= _parameters.pruneAfterUpdates)
         {
-            _evaluatingTrainers[i].Update();
+            PruneTrainers();
         }
     }
 
     template <typename PredictorType>
     const PredictorType& SweepingTrainer<PredictorType>::GetPredictor() const
     {
-        double bestGoodness = _evaluatingTrainers[0].GetEvaluator()->GetGoodness();
+        return _evaluatingTrainers[GetBestTrainerIndex()].GetPredictor();
+    }
+
+    template <typename PredictorType>
+    size_t SweepingTrainer<PredictorType>::NumActiveTrainers() const
+    {
+        return static_cast<size_t>(std::count(_isActive.begin(), _isActive.end(), true));
+    }
+
+    template <typename PredictorType>
+    template <typename FunctionType>
+    void SweepingTrainer<PredictorType>::ForEachActiveTrainer(FunctionType function)
+    {
+        if (_threadPool == nullptr)
+        {
+            for (size_t i = 0; i < _evaluatingTrainers.size(); ++i)
+            {
+                if (_isActive[i])
+                {
+                    function(_evaluatingTrainers[i]);
+                }
+            }
+            return;
+        }
+
+        // one task per trainer, rather than one block of trainers per thread, since trainers with different
+        // hyperparameters can take very different amounts of time
+        std::vector<std::future<void>> tasks;
+        for (size_t i = 0; i < _evaluatingTrainers.size(); ++i)
+        {
+            if (_isActive[i])
+            {
+                auto& trainer = _evaluatingTrainers[i];
+                tasks.push_back(_threadPool->Run([&function, &trainer]() { function(trainer); }));
+            }
+        }
+
+        // wait for all the tasks before rethrowing the first exception, since they reference this object
+        std::exception_ptr exception;
+        for (auto& task : tasks)
+        {
+            try
+            {
+                task.get();
+            }
+            catch (...)
+            {
+                if (!exception)
+                {
+                    exception = std::current_exception();
+                }
+            }
+        }
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+
+    template <typename PredictorType>
+    size_t SweepingTrainer<PredictorType>::GetBestTrainerIndex() const
+    {
         size_t bestIndex = 0;
+        double bestGoodness = _evaluatingTrainers[0].GetEvaluator()->GetGoodness();
         for (size_t i = 1; i < _evaluatingTrainers.size(); ++i)
         {
             double goodness = _evaluatingTrainers[i].GetEvaluator()->GetGoodness();
@@ -111,14 +233,27 @@ namespace trainers
                 bestIndex = i;
             }
         }
+        return bestIndex;
+    }
 
-        return _evaluatingTrainers[bestIndex].GetPredictor();
+    template <typename PredictorType>
+    void SweepingTrainer<PredictorType>::PruneTrainers()
+    {
+        // pruned trainers keep their predictors and their last evaluations, so GetPredictor still considers them
+        double bestGoodness = _evaluatingTrainers[GetBestTrainerIndex()].GetEvaluator()->GetGoodness();
+        for (size_t i = 0; i < _evaluatingTrainers.size(); ++i)
+        {
+            if (_isActive[i] && _evaluatingTrainers[i].GetEvaluator()->GetGoodness() < bestGoodness - _parameters.pruningMargin)
+            {
+                _isActive[i] = false;
+            }
+        }
     }
 
     template <typename PredictorType>
-    std::unique_ptr<ITrainer<PredictorType>> MakeSweepingTrainer(std::vector<EvaluatingTrainer<PredictorType>>&& evaluatingTrainers)
+    std::unique_ptr<ITrainer<PredictorType>> MakeSweepingTrainer(std::vector<EvaluatingTrainer<PredictorType>>&& evaluatingTrainers, const SweepingTrainerParameters& parameters)
     {
-        return std::make_unique<SweepingTrainer<PredictorType>>(std::move(evaluatingTrainers));
+        return std::make_unique<SweepingTrainer<PredictorType>>(std::move(evaluatingTrainers), parameters);
     }
 } // namespace trainers
 } // namespace ell
@@ -10,38 +10,131 @@
 #include <math/include/MatrixOperations.h>
 #include <math/include/VectorOperations.h>
 
+#include <utilities/include/Exception.h>
+#include <utilities/include/RandomEngines.h>
+
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <random>
 
 namespace ell
 {
 namespace trainers
 {
-    KMeansTrainer::KMeansTrainer(size_t dim, size_t numClusters, size_t iterations) :
+    namespace
+    {
+        // the columns of a column-major matrix are contiguous
+        const double* GetColumnData(math::ConstMatrixReference<double, math::MatrixLayout::columnMajor> matrix, size_t index)
+        {
+            return matrix.GetColumn(index).GetConstDataPointer();
+        }
+
+        double SquaredDistance(const double* x, const double* y, size_t size)
+        {
+            double sum = 0;
+            for (size_t i = 0; i < size; ++i)
+            {
+                double diff = x[i] - y[i];
+                sum += diff * diff;
+            }
+            return sum;
+        }
+
+        struct ClosestMeans
+        {
+            size_t closest = 0;
+            double closestDistance = std::numeric_limits<double>::max();
+            double secondClosestDistance = std::numeric_limits<double>::max();
+        };
+
+        // Squared distances to the closest and second closest means
+        ClosestMeans FindClosestMeans(const double* x, math::ConstMatrixReference<double, math::MatrixLayout::columnMajor> means)
+        {
+            ClosestMeans result;
+            for (size_t j = 0; j < means.NumColumns(); ++j)
+            {
+                auto distance = SquaredDistance(x, GetColumnData(means, j), means.NumRows());
+                if (distance < result.closestDistance)
+                {
+                    result.secondClosestDistance = result.closestDistance;
+                    result.closestDistance = distance;
+                    result.closest = j;
+                }
+                else if (distance < result.secondClosestDistance)
+                {
+                    result.secondClosestDistance = distance;
+                }
+            }
+            return result;
+        }
+    } // namespace
+
+    KMeansTrainer::KMeansTrainer(size_t dim, size_t numClusters, size_t iterations, const KMeansTrainerParameters& parameters) :
         _means(dim, numClusters),
         _isInitialized(false),
         _iterations(iterations),
-        _numClusters(numClusters) {}
+        _numClusters(numClusters),
+        _parameters(parameters)
+    {
+        if (_parameters.numThreads != 1)
+        {
+            _threadPool = std::make_unique<utilities::ThreadPool>(_parameters.numThreads);
+        }
+    }
 
-    KMeansTrainer::KMeansTrainer(size_t numClusters, size_t iters, math::ColumnMatrix<double> means) :
+    KMeansTrainer::KMeansTrainer(size_t numClusters, size_t iters, math::ColumnMatrix<double> means, const KMeansTrainerParameters& parameters) :
         _means(means),
         _isInitialized(true),
         _iterations(iters),
-        _numClusters(numClusters) {}
+        _numClusters(numClusters),
+        _parameters(parameters)
+    {
+        if (_parameters.numThreads != 1)
+        {
+            _threadPool = std::make_unique<utilities::ThreadPool>(_parameters.numThreads);
+        }
+    }
+
+    template <typename FunctionType>
+    void KMeansTrainer::forEachBlock(size_t count, FunctionType function)
+    {
+        if (_threadPool == nullptr)
+        {
+            function(0, 0, count);
+            return;
+        }
+
+        auto numBlocks = _threadPool->NumThreads();
+        _threadPool->ParallelFor(numBlocks, [&](size_t block) {
+            function(block, block * count / numBlocks, (block + 1) * count / numBlocks);
+        });
+    }
 
     void KMeansTrainer::RunKMeans(math::ConstMatrixReference<double, math::MatrixLayout::columnMajor> X)
     {
+        _numDistanceComputations = 0;
         if (false == _isInitialized)
             initializeMeans(X);
 
-        math::ColumnVector<size_t> clusterAssignment(X.NumColumns());
-        double prevDistance = 0.0;
-        for (size_t i = 0; i < _iterations; ++i)
+        std::vector<size_t> clusterAssignment(X.NumColumns());
+        switch (_parameters.algorithm)
         {
-            auto totalDistance = assignClosestCenter(X, clusterAssignment);
-            if (totalDistance == prevDistance)
-                break;
-            recomputeMeans(X, clusterAssignment);
-            prevDistance = totalDistance;
+        case KMeansAlgorithm::lloyd:
+            runLloyd(X, clusterAssignment);
+            break;
+        case KMeansAlgorithm::hamerly:
+            runHamerly(X, clusterAssignment);
+            break;
+        case KMeansAlgorithm::miniBatch:
+            runMiniBatch(X, clusterAssignment);
+            break;
+        }
+
+        _clusterAssignment.Resize(clusterAssignment.size());
+        for (size_t i = 0; i < clusterAssignment.size(); ++i)
+        {
+            _clusterAssignment[i] = static_cast<double>(clusterAssignment[i]);
         }
     }
 
@@ -53,104 +146,271 @@ namespace trainers
         _means.GetColumn(0).CopyFrom(X.GetColumn(choice));
 
         math::ColumnVector<double> minimumDistance(X.NumColumns());
+        minimumDistance.Fill(std::numeric_limits<double>::max());
         for (size_t k = 1; k < _numClusters; ++k)
         {
-            // distance to previously selected mean
-            auto D = pairwiseDistance(X, _means.GetSubMatrix(0, k - 1, _means.NumRows(), 1));
-            auto distanceToPreviousMean = D.GetColumn(0);
-
-            if (k == 1)
-            {
-                minimumDistance.CopyFrom(distanceToPreviousMean);
-            }
-            else
-            {
-                // distance to closest center
-                for (size_t i = 0; i < minimumDistance.Size(); ++i)
+            // distance to closest center, updated with the distance to the previously selected mean
+            const double* previousMean = GetColumnData(_means, k - 1);
+            forEachBlock(N, [&](size_t, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
                 {
-                    minimumDistance[i] = std::min(minimumDistance[i], distanceToPreviousMean[i]);
+                    minimumDistance[i] = std::min(minimumDistance[i], SquaredDistance(GetColumnData(X, i), previousMean, X.NumRows()));
                 }
-            }
+            });
+            _numDistanceComputations += N;
 
             choice = weightedSample(minimumDistance);
             _means.GetColumn(k).CopyFrom(X.GetColumn(choice));
         }
     }
 
-    /// D_ij = || X_i - mu_j || ^ 2   (Distance of ith point to jth cluster)
-    /// distance = ||X||^2 + ||means||^2 - 2 *  means * X'
-    math::RowMatrix<double> KMeansTrainer::pairwiseDistance(math::ConstMatrixReference<double, math::MatrixLayout::columnMajor> X, math::ConstMatrixReference<double, math::MatrixLayout::columnMajor> means)
+    void KMeansTrainer::runLloyd(math::ConstMatrixReference<double, math::MatrixLayout::columnMajor> X, std::vector<size_t>& clusterAssignment)
+    {
+        for (size_t i = 0; i < _iterations; ++i)
+        {
+            auto numChanged = assignClosestCenter(X, clusterAssignment);
+            if (i > 0 && numChanged == 0)
+                break;
+            recomputeMeans(X, clusterAssignment);
+        }
+    }
+
+    /// Hamerly, "Making k-means even faster", SDM 2010. For each point we keep an upper bound u on the distance to
+    /// its mean and a lower bound l on the distance to every other mean. The point keeps its mean without computing any
+    /// distances if u <= max(l, s), where s is half the distance from its mean to the closest other mean. When the
+    /// means move, u grows by the distance its mean moved and l shrinks by the largest distance any other mean moved.
+    void KMeansTrainer::runHamerly(math::ConstMatrixReference<double, math::MatrixLayout::columnMajor> X, std::vector<size_t>& clusterAssignment)
     {
-        auto n = X.NumColumns();
-        auto k = means.NumColumns();
+        const auto n = X.NumColumns();
+        const auto dim = X.NumRows();
+        std::vector<double> upperBound(n);
+        std::vector<double> lowerBound(n);
+        std::vector<double> halfDistanceToClosestMean(_numClusters);
+        std::vector<double> meanDrift(_numClusters);
+        math::ColumnMatrix<double> previousMeans(_means.NumRows(), _means.NumColumns());
+
+        std::vector<size_t> blockNumChanged(_threadPool ? _threadPool->NumThreads() : 1);
+        std::vector<size_t> blockNumDistances(blockNumChanged.size());
+
+        for (size_t iteration = 0; iteration < _iterations; ++iteration)
+        {
+            std::fill(blockNumChanged.begin(), blockNumChanged.end(), 0);
+            std::fill(blockNumDistances.begin(), blockNumDistances.end(), 0);
+            if (iteration == 0)
+            {
+                forEachBlock(n, [&](size_t block, size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        auto closest = FindClosestMeans(GetColumnData(X, i), _means);
+                        clusterAssignment[i] = closest.closest;
+                        upperBound[i] = std::sqrt(closest.closestDistance);
+                        lowerBound[i] = std::sqrt(closest.secondClosestDistance);
+                    }
+                    blockNumChanged[block] = end - begin;
+                    blockNumDistances[block] = (end - begin) * _numClusters;
+                });
+            }
+            else
+            {
+                for (size_t j = 0; j < _numClusters; ++j)
+                {
+                    halfDistanceToClosestMean[j] = std::numeric_limits<double>::max();
+                }
+                for (size_t j = 0; j < _numClusters; ++j)
+                {
+                    for (size_t k = j + 1; k < _numClusters; ++k)
+                    {
+                        auto halfDistance = 0.5 * std::sqrt(SquaredDistance(GetColumnData(_means, j), GetColumnData(_means, k), dim));
+                        halfDistanceToClosestMean[j] = std::min(halfDistanceToClosestMean[j], halfDistance);
+                        halfDistanceToClosestMean[k] = std::min(halfDistanceToClosestMean[k], halfDistance);
+                    }
+                }
+                _numDistanceComputations += _numClusters * (_numClusters - 1) / 2;
+
+                forEachBlock(n, [&](size_t block, size_t begin, size_t end) {
+                    size_t numChanged = 0;
+                    size_t numDistances = 0;
+                    for (size_t i = begin; i < end; ++i)
+                    {
+                        auto assigned = clusterAssignment[i];
+                        auto bound = std::max(halfDistanceToClosestMean[assigned], lowerBound[i]);
+                        if (upperBound[i] <= bound)
+                        {
+                            continue;
+                        }
+
+                        // tighten the upper bound and try again before looking at all the means
+                        const double* x = GetColumnData(X, i);
+                        upperBound[i] = std::sqrt(SquaredDistance(x, GetColumnData(_means, assigned), dim));
+                        ++numDistances;
+                        if (upperBound[i] <= bound)
+                        {
+                            continue;
+                        }
+
+                        auto closest = FindClosestMeans(x, _means);
+                        numDistances += _numClusters;
+                        if (closest.closest != assigned)
+                        {
+                            clusterAssignment[i] = closest.closest;
+                            ++numChanged;
+                        }
+                        upperBound[i] = std::sqrt(closest.closestDistance);
+                        lowerBound[i] = std::sqrt(closest.secondClosestDistance);
+                    }
+                    blockNumChanged[block] = numChanged;
+                    blockNumDistances[block] = numDistances;
+                });
+            }
 
-        math::ColumnMatrix<double> xSq(X.NumRows(), n);
-        math::ElementwiseMultiplySet(X, X, xSq);
+            for (auto numDistances : blockNumDistances)
+            {
+                _numDistanceComputations += numDistances;
+            }
+            if (iteration > 0 && std::all_of(blockNumChanged.begin(), blockNumChanged.end(), [](size_t numChanged) { return numChanged == 0; }))
+            {
+                break;
+            }
 
-        math::ColumnMatrix<double> muSq(means.NumRows(), k);
-        math::ElementwiseMultiplySet(means, means, muSq);
+            previousMeans.CopyFrom(_means);
+            recomputeMeans(X, clusterAssignment);
 
-        math::ColumnMatrix<double> xSqNorm(1, xSq.NumColumns());
-        math::ColumnwiseSum(xSq, xSqNorm.GetRow(0));
+            size_t maxDriftIndex = 0;
+            for (size_t j = 0; j < _numClusters; ++j)
+            {
+                meanDrift[j] = std::sqrt(SquaredDistance(GetColumnData(_means, j), GetColumnData(previousMeans, j), dim));
+                if (meanDrift[j] > meanDrift[maxDriftIndex])
+                {
+                    maxDriftIndex = j;
+                }
+            }
+            _numDistanceComputations += _numClusters;
 
-        math::ColumnMatrix<double> muSqNorm(1, muSq.NumColumns());
-        math::ColumnwiseSum(muSq, muSqNorm.GetRow(0));
+            // the lower bound of a point assigned to the mean that moved the most shrinks by the second largest drift
+            double secondMaxDrift = 0;
+            for (size_t j = 0; j < _numClusters; ++j)
+            {
+                if (j != maxDriftIndex)
+                {
+                    secondMaxDrift = std::max(secondMaxDrift, meanDrift[j]);
+                }
+            }
+
+            forEachBlock(n, [&](size_t, size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    auto assigned = clusterAssignment[i];
+                    upperBound[i] += meanDrift[assigned];
+                    lowerBound[i] -= (assigned == maxDriftIndex) ? secondMaxDrift : meanDrift[maxDriftIndex];
+                }
+            });
+        }
+    }
 
-        math::RowMatrix<double> onesMultiplier(k, 1);
-        onesMultiplier.Fill(1.0);
-        math::RowMatrix<double> distFactor1(k, n);
-        math::MultiplyScaleAddUpdate(1.0, onesMultiplier, xSqNorm, 0.0, distFactor1);
+    void KMeansTrainer::runMiniBatch(math::ConstMatrixReference<double, math::MatrixLayout::columnMajor> X, std::vector<size_t>& clusterAssignment)
+    {
+        const auto n = X.NumColumns();
+        const auto batchSize = _parameters.miniBatchSize;
+        if (batchSize == 0)
+        {
+            throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "KMeans mini-batch size must be positive");
+        }
 
-        math::ColumnMatrix<double> onesMultiplier1 = math::ColumnMatrix<double>(n, 1);
-        onesMultiplier1.Fill(1.0);
-        math::ColumnMatrix<double> distFactor2(n, k);
-        math::MultiplyScaleAddUpdate(1.0, onesMultiplier1, muSqNorm, 0.0, distFactor2);
+        auto randomEngine = utilities::GetRandomEngine(_parameters.randomSeedString);
+        std::uniform_int_distribution<size_t> pointDistribution(0, n - 1);
+        std::vector<size_t> batch(batchSize);
+        std::vector<size_t> batchAssignment(batchSize);
+        std::vector<double> numPointsPerCluster(_numClusters);
 
-        math::RowMatrix<double> muX(n, k);
-        math::MultiplyScaleAddUpdate(1.0, X.Transpose(), means, 1.0, muX);
+        for (size_t iteration = 0; iteration < _iterations; ++iteration)
+        {
+            for (auto& index : batch)
+            {
+                index = pointDistribution(randomEngine);
+            }
 
-        math::ColumnMatrix<double> tempD(n, k);
-        math::ScaleAddSet(1.0, distFactor1.Transpose(), -2.0, muX, tempD);
+            forEachBlock(batchSize, [&](size_t, size_t begin, size_t end) {
+                for (size_t b = begin; b < end; ++b)
+                {
+                    batchAssignment[b] = FindClosestMeans(GetColumnData(X, batch[b]), _means).closest;
+                }
+            });
+            _numDistanceComputations += batchSize * _numClusters;
 
-        math::ColumnMatrix<double> distance(n, k);
-        math::ScaleAddSet(1.0, tempD, 1.0, distFactor2, distance);
+            // each mean moves toward its points with a step size that decays with the number of points it has seen
+            for (size_t b = 0; b < batchSize; ++b)
+            {
+                auto cluster = batchAssignment[b];
+                numPointsPerCluster[cluster] += 1;
+                auto stepSize = 1.0 / numPointsPerCluster[cluster];
+                auto mean = _means.GetColumn(cluster);
+                math::ScaleAddUpdate(stepSize, X.GetColumn(batch[b]), 1.0 - stepSize, mean);
+            }
+        }
 
-        return distance;
+        assignClosestCenter(X, clusterAssignment);
     }
 
-    double KMeansTrainer::assignClosestCenter(math::ConstMatrixReference<double, math::MatrixLayout::columnMajor> X, math::VectorReference<size_t, math::VectorOrientation::column> clusterAssignment)
+    size_t KMeansTrainer::assignClosestCenter(math::ConstMatrixReference<double, math::MatrixLayout::columnMajor> X, std::vector<size_t>& clusterAssignment)
     {
-        auto D = pairwiseDistance(X, _means);
+        std::vector<size_t> blockNumChanged(_threadPool ? _threadPool->NumThreads() : 1);
+        forEachBlock(X.NumColumns(), [&](size_t block, size_t begin, size_t end) {
+            size_t numChanged = 0;
+            for (size_t i = begin; i < end; ++i)
+            {
+                auto closest = FindClosestMeans(GetColumnData(X, i), _means).closest;
+                if (closest != clusterAssignment[i])
+                {
+                    clusterAssignment[i] = closest;
+                    ++numChanged;
+                }
+            }
+            blockNumChanged[block] = numChanged;
+        });
+        _numDistanceComputations += X.NumColumns() * _numClusters;
 
-        double totalDist = 0;
-        for (size_t i = 0; i < D.NumRows(); ++i)
+        size_t numChanged = 0;
+        for (auto blockChanged : blockNumChanged)
         {
-            auto dist = D.GetRow(i);
-            auto minElement = std::min_element(dist.GetDataPointer(), dist.GetDataPointer() + dist.Size());
-            clusterAssignment[i] = minElement - dist.GetDataPointer();
-            totalDist += *minElement;
+            numChanged += blockChanged;
         }
-
-        return totalDist;
+        return numChanged;
     }
 
-    void KMeansTrainer::recomputeMeans(math::ConstMatrixReference<double, math::MatrixLayout::columnMajor> X, const math::ColumnVector<size_t> clusterAssignment)
+    void KMeansTrainer::recomputeMeans(math::ConstMatrixReference<double, math::MatrixLayout::columnMajor> X, const std::vector<size_t>& clusterAssignment)
     {
-        math::ColumnMatrix<double> clusterSum(X.NumRows(), _numClusters);
-        math::ColumnVector<double> numPointsPerCluster(_numClusters);
-        for (size_t i = 0; i < X.NumColumns(); ++i)
+        // each thread sums its own block of points, and the partial sums are added in a fixed order
+        size_t numBlocks = _threadPool ? _threadPool->NumThreads() : 1;
+        std::vector<math::ColumnMatrix<double>> clusterSums(numBlocks, math::ColumnMatrix<double>(X.NumRows(), _numClusters));
+        std::vector<std::vector<double>> numPointsPerCluster(numBlocks, std::vector<double>(_numClusters));
+        forEachBlock(X.NumColumns(), [&](size_t block, size_t begin, size_t end) {
+            auto& clusterSum = clusterSums[block];
+            auto& numPoints = numPointsPerCluster[block];
+            for (size_t i = begin; i < end; ++i)
+            {
+                auto idx = clusterAssignment[i];
+                clusterSum.GetColumn(idx) += X.GetColumn(i);
+                numPoints[idx] += 1;
+            }
+        });
+
+        for (size_t block = 1; block < numBlocks; ++block)
         {
-            auto idx = clusterAssignment[i];
-            clusterSum.GetColumn(idx) += X.GetColumn(i);
-            numPointsPerCluster[idx] += 1;
+            clusterSums[0] += clusterSums[block];
+            for (size_t i = 0; i < _numClusters; ++i)
+            {
+                numPointsPerCluster[0][i] += numPointsPerCluster[block][i];
+            }
         }
 
         for (size_t i = 0; i < _numClusters; i++)
         {
-            clusterSum.GetColumn(i) /= numPointsPerCluster[i];
+            if (numPointsPerCluster[0][i] > 0)
+            {
+                _means.GetColumn(i).CopyFrom(clusterSums[0].GetColumn(i));
+                _means.GetColumn(i) /= numPointsPerCluster[0][i];
+            }
         }
-
-        _means.CopyFrom(clusterSum);
     }
 
     size_t KMeansTrainer::weightedSample(math::ColumnVector<double> weights)
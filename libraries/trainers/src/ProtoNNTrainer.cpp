@@ -17,6 +17,7 @@
 
 #include <utilities/include/Unused.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <ctime>
@@ -31,6 +32,12 @@ namespace trainers
         constexpr double ArmijoStepTolerance = 0.02;
 
         constexpr double DefaultStepSize = 0.2;
+
+        // the smallest number of examples worth sending to a separate thread
+        constexpr size_t MinExamplesPerBlock = 32;
+
+        // gamma is initialized from the median similarity on at most this many (evenly spaced) examples
+        constexpr size_t MaxGammaInitExamples = 4096;
     } // namespace
 
     double safe_div(const double& num, const double& den)
@@ -48,6 +55,10 @@ namespace trainers
         _X(0, 0),
         _Y(0, 0)
     {
+        if (_parameters.numThreads != 1)
+        {
+            _threadPool = std::make_unique<utilities::ThreadPool>(_parameters.numThreads);
+        }
     }
 
     void ProtoNNTrainer::SetDataset(const data::AnyDataset& anyDataset)
@@ -92,9 +103,11 @@ namespace trainers
         W.Generate(generator);
 
         math::ColumnMatrix<double> WX(W.NumRows(), n);
-        math::MultiplyScaleAddUpdate(1.0, W, _X, 0.0, WX);
+        Project(W, _X, WX);
 
-        ProtoNNInit protonnInit(d, _parameters.numLabels, _parameters.numPrototypesPerLabel);
+        KMeansTrainerParameters kMeansParameters;
+        kMeansParameters.numThreads = _parameters.numThreads;
+        ProtoNNInit protonnInit(d, _parameters.numLabels, _parameters.numPrototypesPerLabel, kMeansParameters);
         protonnInit.Initialize(WX, _Y);
 
         math::ColumnMatrix<double> B = protonnInit.GetPrototypeMatrix();
@@ -111,10 +124,17 @@ namespace trainers
         // Initializing gamma
         if (-1.0 == _parameters.gamma)
         {
+            // the full kernel matrix is numExamples x numPrototypes, so large datasets are subsampled
             auto gammaInit = 0.01;
-            math::ColumnMatrix<double> WXupdate(W.NumRows(), n);
-            math::MultiplyScaleAddUpdate(1.0, W, _X, 0.0, WXupdate);
-            _parameters.gamma = protonnInit.InitializeGamma(SimilarityKernel(_X, WXupdate, gammaInit), gammaInit);
+            auto stride = (n + MaxGammaInitExamples - 1) / MaxGammaInitExamples;
+            math::ColumnMatrix<double> xSample(D, (n + stride - 1) / stride);
+            for (size_t i = 0; i < xSample.NumColumns(); ++i)
+            {
+                xSample.GetColumn(i).CopyFrom(_X.GetColumn(i * stride));
+            }
+            math::ColumnMatrix<double> WXupdate(W.NumRows(), xSample.NumColumns());
+            Project(W, xSample, WXupdate);
+            _parameters.gamma = protonnInit.InitializeGamma(SimilarityKernel(xSample, WXupdate, gammaInit), gammaInit);
         }
 
         _stepSize[ProtoNNParameterIndex::W] = DefaultStepSize;
@@ -140,8 +160,8 @@ namespace trainers
     math::ColumnMatrix<double> ProtoNNTrainer::SimilarityKernel(ConstColumnMatrixReference X, math::ColumnMatrixReference<double> WX, const double gamma, const size_t begin, const size_t end, bool recomputeWX)
     {
         assert(begin < end);
-        auto B = (_modelMap[ProtoNNParameterIndex::B])->GetData();
-        auto W = (_modelMap[ProtoNNParameterIndex::W])->GetData();
+        auto B = (_modelMap.at(ProtoNNParameterIndex::B))->GetData();
+        auto W = (_modelMap.at(ProtoNNParameterIndex::W))->GetData();
 
         auto wx = WX.GetSubMatrix(0, begin, WX.NumRows(), end - begin);
 
@@ -209,7 +229,7 @@ namespace trainers
     {
         assert(end - begin == D.NumRows());
 
-        auto Z = (_modelMap[ProtoNNParameterIndex::Z])->GetData();
+        auto Z = (_modelMap.at(ProtoNNParameterIndex::Z))->GetData();
 
         // residual = y - ZD'
         math::ColumnMatrix<double> ZD(Z.NumRows(), D.NumRows());
@@ -264,9 +284,9 @@ namespace trainers
         size_t batchSize = maxBatchSize;
         size_t numBatches = (n + batchSize - 1) / batchSize;
 
-        // Aggregate loss over the batches
-        for (size_t i = 0; i < numBatches; ++i)
-        {
+        // Compute the loss of each batch, in parallel if there is a thread pool
+        std::vector<double> batchLosses(numBatches);
+        auto computeBatchLoss = [&](size_t i) {
             size_t idx1 = (i * batchSize) % n;
             size_t idx2 = ((i + 1) * (batchSize) % n);
             if (idx2 <= idx1) idx2 = n;
@@ -277,12 +297,85 @@ namespace trainers
             auto D = SimilarityKernel(X, WX, gamma, idx1, idx2, recomputeWX);
             auto y = Y.GetSubMatrix(0, idx1, Y.NumRows(), idx2 - idx1);
 
-            objective += Loss(y, D);
+            batchLosses[i] = Loss(y, D);
+        };
+
+        if (_threadPool)
+        {
+            _threadPool->ParallelFor(numBatches, computeBatchLoss);
+        }
+        else
+        {
+            for (size_t i = 0; i < numBatches; ++i)
+            {
+                computeBatchLoss(i);
+            }
+        }
+
+        // Aggregate loss over the batches
+        for (auto loss : batchLosses)
+        {
+            objective += loss;
         }
 
         return objective;
     }
 
+    math::ColumnMatrix<double> ProtoNNTrainer::Gradient(ProtoNNParameterIndex parameterIndex, ConstColumnMatrixReference X, ConstColumnMatrixReference Y, math::ColumnMatrixReference<double> WX, double gamma, size_t begin, size_t end)
+    {
+        auto parameter = _modelMap.at(parameterIndex);
+        auto recomputeWX = _recomputeWX.at(parameterIndex);
+        auto numBlocks = GetNumBlocks(end - begin);
+        if (numBlocks == 1)
+        {
+            return parameter->gradient(_modelMap, X, Y, WX, SimilarityKernel(X, WX, gamma, begin, end, recomputeWX), gamma, begin, end, _parameters.lossFunction);
+        }
+
+        // The loss is a sum over the examples, so the gradient is the sum of the gradients of the blocks. Each block
+        // only reads and writes its own columns of WX.
+        std::vector<math::ColumnMatrix<double>> blockGradients(numBlocks, math::ColumnMatrix<double>(0, 0));
+        _threadPool->ParallelFor(numBlocks, [&](size_t block) {
+            size_t blockBegin = begin + block * (end - begin) / numBlocks;
+            size_t blockEnd = begin + (block + 1) * (end - begin) / numBlocks;
+            auto D = SimilarityKernel(X, WX, gamma, blockBegin, blockEnd, recomputeWX);
+            blockGradients[block] = parameter->gradient(_modelMap, X, Y, WX, D, gamma, blockBegin, blockEnd, _parameters.lossFunction);
+        });
+
+        auto gradient = std::move(blockGradients[0]);
+        for (size_t block = 1; block < numBlocks; ++block)
+        {
+            math::AddUpdate(blockGradients[block], gradient);
+        }
+        return gradient;
+    }
+
+    void ProtoNNTrainer::Project(ConstColumnMatrixReference W, ConstColumnMatrixReference X, math::ColumnMatrixReference<double> WX)
+    {
+        auto n = X.NumColumns();
+        auto numBlocks = GetNumBlocks(n);
+        if (numBlocks == 1)
+        {
+            math::MultiplyScaleAddUpdate(1.0, W, X, 0.0, WX);
+            return;
+        }
+
+        _threadPool->ParallelFor(numBlocks, [&](size_t block) {
+            size_t begin = block * n / numBlocks;
+            size_t end = (block + 1) * n / numBlocks;
+            auto wx = WX.GetSubMatrix(0, begin, WX.NumRows(), end - begin);
+            math::MultiplyScaleAddUpdate(1.0, W, X.GetSubMatrix(0, begin, X.NumRows(), end - begin), 0.0, wx);
+        });
+    }
+
+    size_t ProtoNNTrainer::GetNumBlocks(size_t numExamples) const
+    {
+        if (!_threadPool)
+        {
+            return 1;
+        }
+        return std::max<size_t>(1, std::min(_threadPool->NumThreads(), numExamples / MinExamplesPerBlock));
+    }
+
     //See https://blogs.princeton.edu/imabandit/2013/04/01/acceleratedgradientdescent/ for the accelerated gradient_paramS descent version we use
     //We use stochastic version of the above algorithm
     //paramQ_new[t+1]=paramS[t]-stepSize*gradient_paramS(paramS[t]) //gradient_paramS descent update
@@ -385,7 +478,7 @@ namespace trainers
         size_t n = X.NumColumns(); //numTrainPoints
         size_t epochs = _parameters.numInnerIterations; // number of SGD iterations(epochs) over each of the parameters
 
-        size_t sgdBatchSize = 1 << 8 < n ? 1 << 8 : n; //expose to user parameter structure, default is sqrt(n)
+        size_t sgdBatchSize = std::max<size_t>(1, std::min(_parameters.batchSize, n));
 
         double armijoStepTolerance = ArmijoStepTolerance;
 
@@ -399,7 +492,7 @@ namespace trainers
         //Projection onto low-d space
         auto projectionMatrix = _modelMap[m_projectionIndex]->GetData();
         math::ColumnMatrix<double> WX(projectionMatrix.NumRows(), n);
-        math::MultiplyScaleAddUpdate(1.0, projectionMatrix, X, 0.0, WX);
+        Project(projectionMatrix, X, WX);
 
         fCur = ComputeObjective(X, Y, WX, gamma, false);
 
@@ -426,7 +519,7 @@ namespace trainers
                 if (idx2 <= idx1) idx2 = n;
 
                 // gradient_paramS at current parameter
-                currentGradient = _modelMap[parameterIndex]->gradient(_modelMap, X, Y, WX, SimilarityKernel(X, WX, gamma, idx1, idx2, _recomputeWX[parameterIndex]), gamma, idx1, idx2, _parameters.lossFunction);
+                currentGradient = Gradient(parameterIndex, X, Y, WX, gamma, idx1, idx2);
 
                 math::ColumnMatrix<double> thresholdedGradient(parameterMatrix.NumRows(), parameterMatrix.NumColumns());
 
@@ -444,10 +537,10 @@ namespace trainers
                 _modelMap[parameterIndex]->GetData() = perturbedParameter;
 
                 // Compute gradient_paramS with updated parameter
-                math::MultiplyScaleAddUpdate(1.0, _modelMap[m_projectionIndex]->GetData(), X, 0.0, WX);
+                Project(_modelMap[m_projectionIndex]->GetData(), X, WX);
 
                 math::ColumnMatrix<double> gradientEstimate(parameterMatrix.NumRows(), parameterMatrix.NumColumns());
-                auto grad = _modelMap[parameterIndex]->gradient(_modelMap, X, Y, WX, SimilarityKernel(X, WX, gamma, idx1, idx2, _recomputeWX[parameterIndex]), gamma, idx1, idx2, _parameters.lossFunction);
+                auto grad = Gradient(parameterIndex, X, Y, WX, gamma, idx1, idx2);
                 math::ScaleAddSet(1.0, currentGradient, -1.0, grad, gradientEstimate);
 
                 currentGradient = gradientEstimate;
@@ -476,9 +569,9 @@ namespace trainers
             paramStepSize = _stepSize[parameterIndex] * etaVector[4];
 
             // Call the accelerated proximal gradient_paramS method for optimizing this parameter
-            AcceleratedProximalGradient(parameterIndex, [&](ConstColumnMatrixReference /*W*/, const size_t begin, const size_t end) -> math::ColumnMatrix<double> { return _modelMap[parameterIndex]->gradient(_modelMap, X, Y, WX, SimilarityKernel(X, WX, gamma, begin, end, _recomputeWX[parameterIndex]), gamma, begin, end, _parameters.lossFunction); }, [&](auto arg) { ProtoNNTrainerUtils::HardThresholding(arg, _sparsity[parameterIndex]); }, parameterMatrix, epochs, n, sgdBatchSize, paramStepSize, eta_update);
+            AcceleratedProximalGradient(parameterIndex, [&](ConstColumnMatrixReference /*W*/, const size_t begin, const size_t end) -> math::ColumnMatrix<double> { return Gradient(parameterIndex, X, Y, WX, gamma, begin, end); }, [&](auto arg) { ProtoNNTrainerUtils::HardThresholding(arg, _sparsity[parameterIndex]); }, parameterMatrix, epochs, n, sgdBatchSize, paramStepSize, eta_update);
 
-            math::MultiplyScaleAddUpdate(1.0, _modelMap[m_projectionIndex]->GetData(), X, 0.0, WX);
+            Project(_modelMap[m_projectionIndex]->GetData(), X, WX);
             fOld = fCur;
             fCur = ComputeObjective(X, Y, WX, gamma, _recomputeWX[parameterIndex]);
 
@@ -513,9 +606,9 @@ namespace trainers
         UNUSED(WX);
         assert(end - begin == D.NumRows());
 
-        auto W = modelMap[ProtoNNParameterIndex::W]->GetData();
-        auto B = modelMap[ProtoNNParameterIndex::B]->GetData();
-        auto Z = modelMap[ProtoNNParameterIndex::Z]->GetData();
+        auto W = modelMap.at(ProtoNNParameterIndex::W)->GetData();
+        auto B = modelMap.at(ProtoNNParameterIndex::B)->GetData();
+        auto Z = modelMap.at(ProtoNNParameterIndex::Z)->GetData();
 
         auto y = Y.GetSubMatrix(0, begin, Y.NumRows(), end - begin).Transpose();
 
@@ -592,7 +685,7 @@ namespace trainers
 
         assert(end - begin == Similarity.NumRows());
 
-        auto Z = modelMap[ProtoNNParameterIndex::Z]->GetData();
+        auto Z = modelMap.at(ProtoNNParameterIndex::Z)->GetData();
 
         auto y = Y.GetSubMatrix(0, begin, Y.NumRows(), end - begin);
 
@@ -640,8 +733,8 @@ namespace trainers
         UNUSED(X, WX);
         assert(end - begin == Similarity.NumRows());
 
-        auto B = modelMap[ProtoNNParameterIndex::B]->GetData();
-        auto Z = modelMap[ProtoNNParameterIndex::Z]->GetData();
+        auto B = modelMap.at(ProtoNNParameterIndex::B)->GetData();
+        auto Z = modelMap.at(ProtoNNParameterIndex::Z)->GetData();
 
         auto y = Y.GetSubMatrix(0, begin, Y.NumRows(), end - begin).Transpose();
         auto wx = WX.GetSubMatrix(0, begin, WX.NumRows(), end - begin);
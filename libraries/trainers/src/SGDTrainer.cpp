@@ -12,20 +12,9 @@ namespace ell
 {
 namespace trainers
 {
-
-    void SGDTrainerBase::SetDataset(const data::AnyDataset& anyDataset)
-    {
-        _dataset = data::Dataset<data::AutoSupervisedExample>(anyDataset);
-    }
-
-    void SGDTrainerBase::Update()
+    template <typename ExampleIteratorType>
+    void SGDTrainerBase::UpdateFromIterator(ExampleIteratorType& exampleIterator)
     {
-        // permute the data
-        _dataset.RandomPermute(_random);
-
-        // get example iterator
-        auto exampleIterator = _dataset.GetExampleReferenceIterator();
-
         // first iteration handled separately
         if (_firstIteration && exampleIterator.IsValid())
         {
@@ -56,6 +45,26 @@ namespace trainers
         }
     }
 
+    void SGDTrainerBase::SetDataset(const data::AnyDataset& anyDataset)
+    {
+        _dataset = data::Dataset<data::AutoSupervisedExample>(anyDataset);
+    }
+
+    void SGDTrainerBase::Update()
+    {
+        // permute the data
+        _dataset.RandomPermute(_random);
+
+        // get example iterator
+        auto exampleIterator = _dataset.GetExampleReferenceIterator();
+        UpdateFromIterator(exampleIterator);
+    }
+
+    void SGDTrainerBase::Update(data::AutoSupervisedExampleIterator exampleIterator)
+    {
+        UpdateFromIterator(exampleIterator);
+    }
+
     SGDTrainerBase::SGDTrainerBase(std::string randomSeedString)
     {
         std::seed_seq seed(randomSeedString.begin(), randomSeedString.end());
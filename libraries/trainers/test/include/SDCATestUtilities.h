@@ -0,0 +1,21 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     SDCATestUtilities.h (trainers)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <data/include/Dataset.h>
+
+#include <trainers/include/SDCATrainer.h>
+
+#include <cstddef>
+
+/// <summary> Makes a dataset of sparse examples labeled by a random linear separator. </summary>
+ell::data::AutoSupervisedDataset GetSparseClassificationDataset(size_t numExamples, size_t dimension, size_t numNonzeros);
+
+/// <summary> Trains an SDCA trainer with log loss and L2 regularization, and returns the predictor info. </summary>
+ell::trainers::SDCAPredictorInfo TrainSDCA(const ell::data::AutoSupervisedDataset& dataset, const ell::trainers::SDCATrainerParameters& parameters, size_t numEpochs);
@@ -0,0 +1,59 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     SDCATestUtilities.cpp (trainers)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "SDCATestUtilities.h"
+
+#include <functions/include/L2Regularizer.h>
+#include <functions/include/LogLoss.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace ell;
+
+data::AutoSupervisedDataset GetSparseClassificationDataset(size_t numExamples, size_t dimension, size_t numNonzeros)
+{
+    std::default_random_engine random(123);
+    std::normal_distribution<double> normal(0, 1);
+    std::uniform_int_distribution<size_t> indexDistribution(0, dimension - 1);
+
+    std::vector<double> separator(dimension);
+    std::generate(separator.begin(), separator.end(), [&]() { return normal(random); });
+
+    data::AutoSupervisedDataset dataset;
+    for (size_t i = 0; i < numExamples; ++i)
+    {
+        std::vector<size_t> indices(numNonzeros);
+        std::generate(indices.begin(), indices.end(), [&]() { return indexDistribution(random); });
+        std::sort(indices.begin(), indices.end());
+        indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+
+        std::vector<data::IndexValue> entries;
+        double margin = 0;
+        for (auto index : indices)
+        {
+            auto value = normal(random);
+            entries.push_back({ index, value });
+            margin += value * separator[index];
+        }
+        dataset.AddExample({ data::AutoDataVector(entries), { 1.0, margin > 0 ? 1.0 : -1.0 } });
+    }
+    return dataset;
+}
+
+trainers::SDCAPredictorInfo TrainSDCA(const data::AutoSupervisedDataset& dataset, const trainers::SDCATrainerParameters& parameters, size_t numEpochs)
+{
+    trainers::SDCATrainer<functions::LogLoss, functions::L2Regularizer> trainer(functions::LogLoss(), functions::L2Regularizer(), parameters);
+    trainer.SetDataset(dataset.GetAnyDataset());
+    for (size_t epoch = 0; epoch < numEpochs; ++epoch)
+    {
+        trainer.Update();
+    }
+    return trainer.GetPredictorInfo();
+}
@@ -6,18 +6,39 @@
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include "SDCATestUtilities.h"
+
 #include <data/include/Dataset.h>
+#include <data/include/ShardedDataset.h>
 
 #include <functions/include/L2Regularizer.h>
 #include <functions/include/LogLoss.h>
 #include <functions/include/SquaredLoss.h>
 
+#include <trainers/include/BinnedForestTrainer.h>
+#include <trainers/include/HistogramForestTrainer.h>
+#include <trainers/include/KMeansTrainer.h>
+#include <trainers/include/LogitBooster.h>
 #include <trainers/include/MeanCalculator.h>
+#include <trainers/include/ProtoNNTrainer.h>
 #include <trainers/include/SDCATrainer.h>
 #include <trainers/include/SGDTrainer.h>
+#include <trainers/include/SweepingTrainer.h>
+
+#include <evaluators/include/AUCAggregator.h>
+#include <evaluators/include/BinaryErrorAggregator.h>
+#include <evaluators/include/Evaluator.h>
 
 #include <testing/include/testing.h>
 
+#include <utilities/include/MillisecondTimer.h>
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
 using namespace ell;
 
 /// Runs all tests
@@ -59,6 +80,31 @@ void TestSDCATrainer()
     return;
 }
 
+void TestParallelSDCATrainer()
+{
+    auto dataset = GetSparseClassificationDataset(2000, 200, 10);
+    trainers::SDCATrainerParameters parameters{ 1.0e-3, 1.0e-8, 50, true, "XYZ" };
+    auto sequentialInfo = TrainSDCA(dataset, parameters, 50);
+
+    parameters.numThreads = 4;
+    parameters.parallelMode = trainers::SDCAParallelMode::hogwild;
+    auto hogwildInfo = TrainSDCA(dataset, parameters, 50);
+
+    parameters.parallelMode = trainers::SDCAParallelMode::miniBatch;
+    parameters.miniBatchSize = 256;
+    auto miniBatchInfo1 = TrainSDCA(dataset, parameters, 50);
+    auto miniBatchInfo2 = TrainSDCA(dataset, parameters, 50);
+
+    printf("TestParallelSDCATrainer primal objectives: sequential %f, hogwild %f, miniBatch %f\n", sequentialInfo.primalObjective, hogwildInfo.primalObjective, miniBatchInfo1.primalObjective);
+
+    auto isConverged = [&](const trainers::SDCAPredictorInfo& info) {
+        return info.primalObjective - info.dualObjective < 1.0e-3 && std::abs(info.primalObjective - sequentialInfo.primalObjective) < 1.0e-3;
+    };
+    testing::ProcessTest("TestParallelSDCATrainer, hogwild converges", isConverged(hogwildInfo));
+    testing::ProcessTest("TestParallelSDCATrainer, miniBatch converges", isConverged(miniBatchInfo1));
+    testing::ProcessTest("TestParallelSDCATrainer, miniBatch is deterministic", miniBatchInfo1.primalObjective == miniBatchInfo2.primalObjective && miniBatchInfo1.dualObjective == miniBatchInfo2.dualObjective);
+}
+
 void TestSGDTrainer()
 {
     data::AutoSupervisedDataset dataset;
@@ -117,6 +163,286 @@ void TestSGDTrainer()
     return;
 }
 
+void TestOutOfCoreSGDTrainer()
+{
+    auto dataset = GetSparseClassificationDataset(2000, 100, 10);
+    const size_t numShards = 4;
+    const size_t numEpochs = 3;
+    auto loadShard = [&dataset, numShards](size_t shardIndex) {
+        auto begin = shardIndex * dataset.NumExamples() / numShards;
+        auto end = (shardIndex + 1) * dataset.NumExamples() / numShards;
+        return data::AutoSupervisedDataset(dataset.GetExampleIterator(begin, end - begin));
+    };
+
+    auto getError = [&dataset](const predictors::LinearPredictor<double>& predictor) {
+        size_t numErrors = 0;
+        for (size_t i = 0; i < dataset.NumExamples(); ++i)
+        {
+            const auto& example = dataset[i];
+            numErrors += (predictor.Predict(example.GetDataVector()) > 0) != (example.GetMetadata().label > 0) ? 1 : 0;
+        }
+        return static_cast<double>(numErrors) / dataset.NumExamples();
+    };
+
+    // streaming the shards in order is the same as streaming the whole dataset
+    trainers::SGDTrainer<functions::LogLoss> inMemoryTrainer(functions::LogLoss(), { 1.0e-3, "XYZ" });
+    trainers::SGDTrainer<functions::LogLoss> orderedTrainer(functions::LogLoss(), { 1.0e-3, "XYZ" });
+    data::ShardedDataset<data::AutoSupervisedExample> orderedDataset(numShards, loadShard, { 1, false, false, "XYZ" });
+    for (size_t epoch = 0; epoch < numEpochs; ++epoch)
+    {
+        inMemoryTrainer.Update(dataset.GetExampleIterator());
+        orderedTrainer.Update(orderedDataset.GetExampleIterator());
+    }
+    testing::ProcessTest("TestOutOfCoreSGDTrainer, ordered shards match in-memory data", inMemoryTrainer.GetPredictor().GetWeights() == orderedTrainer.GetPredictor().GetWeights());
+
+    // shuffled shards train as well as the shuffled in-memory dataset
+    trainers::SGDTrainer<functions::LogLoss> permutingTrainer(functions::LogLoss(), { 1.0e-3, "XYZ" });
+    trainers::SGDTrainer<functions::LogLoss> shardedTrainer(functions::LogLoss(), { 1.0e-3, "XYZ" });
+    data::ShardedDataset<data::AutoSupervisedExample> shardedDataset(numShards, loadShard, { 2, true, true, "XYZ" });
+    permutingTrainer.SetDataset(dataset.GetAnyDataset());
+    for (size_t epoch = 0; epoch < numEpochs; ++epoch)
+    {
+        permutingTrainer.Update();
+        shardedTrainer.Update(shardedDataset.GetExampleIterator());
+    }
+    auto inMemoryError = getError(permutingTrainer.GetPredictor());
+    auto shardedError = getError(shardedTrainer.GetPredictor());
+    std::cout << "TestOutOfCoreSGDTrainer, in-memory error " << inMemoryError << ", sharded error " << shardedError << std::endl;
+    testing::ProcessTest("TestOutOfCoreSGDTrainer, shuffled shards", shardedError < inMemoryError + 0.02);
+}
+
+using SweepingSGDTrainerType = trainers::SweepingTrainer<predictors::LinearPredictor<double>>;
+
+template <typename AggregatorType = evaluators::BinaryErrorAggregator>
+std::unique_ptr<SweepingSGDTrainerType> MakeSweepingSGDTrainer(const data::AutoSupervisedDataset& dataset, const std::vector<double>& regularization, const trainers::SweepingTrainerParameters& parameters, AggregatorType aggregator = {})
+{
+    using PredictorType = predictors::LinearPredictor<double>;
+    std::vector<trainers::EvaluatingTrainer<PredictorType>> evaluatingTrainers;
+    for (auto lambda : regularization)
+    {
+        auto evaluator = evaluators::MakeEvaluator<PredictorType>(dataset.GetAnyDataset(), { 1, false }, aggregator);
+        evaluatingTrainers.push_back(trainers::MakeEvaluatingTrainer(trainers::MakeSGDTrainer(functions::LogLoss(), { lambda, "XYZ" }), evaluator));
+    }
+    return std::make_unique<SweepingSGDTrainerType>(std::move(evaluatingTrainers), parameters);
+}
+
+void TestSweepingTrainer()
+{
+    auto dataset = GetSparseClassificationDataset(2000, 100, 10);
+    std::vector<double> regularization{ 1.0e-4, 1.0e-3, 1.0e-2, 1.0e-1, 1.0, 10.0, 100.0 };
+
+    auto sequentialTrainer = MakeSweepingSGDTrainer(dataset, regularization, {});
+    auto parallelTrainer = MakeSweepingSGDTrainer(dataset, regularization, { 4, 0, 0.0 });
+    sequentialTrainer->SetDataset(dataset.GetAnyDataset());
+    parallelTrainer->SetDataset(dataset.GetAnyDataset());
+    for (size_t epoch = 0; epoch < 3; ++epoch)
+    {
+        sequentialTrainer->Update();
+        parallelTrainer->Update();
+    }
+
+    const auto& sequentialWeights = sequentialTrainer->GetPredictor().GetWeights();
+    const auto& parallelWeights = parallelTrainer->GetPredictor().GetWeights();
+    testing::ProcessTest("TestSweepingTrainer, parallel sweep matches sequential sweep", sequentialWeights.Size() > 0 && sequentialWeights == parallelWeights);
+
+    // the chosen predictor is the one with the lowest training error
+    auto getError = [&dataset](const predictors::LinearPredictor<double>& predictor) {
+        size_t numErrors = 0;
+        for (size_t i = 0; i < dataset.NumExamples(); ++i)
+        {
+            const auto& example = dataset[i];
+            numErrors += (predictor.Predict(example.GetDataVector()) > 0) != (example.GetMetadata().label > 0) ? 1 : 0;
+        }
+        return static_cast<double>(numErrors) / dataset.NumExamples();
+    };
+    double bestError = 1.0;
+    for (auto lambda : regularization)
+    {
+        auto trainer = trainers::MakeSGDTrainer(functions::LogLoss(), { lambda, "XYZ" });
+        trainer->SetDataset(dataset.GetAnyDataset());
+        for (size_t epoch = 0; epoch < 3; ++epoch)
+        {
+            trainer->Update();
+        }
+        bestError = std::min(bestError, getError(trainer->GetPredictor()));
+    }
+    testing::ProcessTest("TestSweepingTrainer, chooses the lowest error predictor", testing::IsEqual(getError(parallelTrainer->GetPredictor()), bestError));
+
+    // with a margin of 0, every trainer that isn't tied for the best error is dropped after the first update
+    auto pruningTrainer = MakeSweepingSGDTrainer(dataset, regularization, { 4, 1, 0.0 });
+    pruningTrainer->SetDataset(dataset.GetAnyDataset());
+    pruningTrainer->Update();
+    auto numActive = pruningTrainer->NumActiveTrainers();
+    pruningTrainer->Update();
+    std::cout << "TestSweepingTrainer, " << numActive << " of " << regularization.size() << " trainers left after pruning" << std::endl;
+    testing::ProcessTest("TestSweepingTrainer, prunes losing trainers", numActive > 0 && numActive < regularization.size() && pruningTrainer->NumActiveTrainers() <= numActive);
+}
+
+void TestSweepingTrainerWithAUC()
+{
+    using PredictorType = predictors::LinearPredictor<double>;
+    auto dataset = GetSparseClassificationDataset(2000, 100, 10);
+    std::vector<double> regularization{ 1.0e-4, 1.0e-2, 1.0, 100.0 };
+
+    // AUC is a goodness where higher is better, unlike the error rate
+    auto getAUC = [&dataset](const PredictorType& predictor) {
+        auto evaluator = evaluators::MakeEvaluator<PredictorType>(dataset.GetAnyDataset(), { 1, false }, evaluators::AUCAggregator());
+        evaluator->Evaluate(predictor);
+        return evaluator->GetGoodness();
+    };
+    auto getAUCs = [&](size_t numEpochs) {
+        std::vector<double> aucs;
+        for (auto lambda : regularization)
+        {
+            auto trainer = trainers::MakeSGDTrainer(functions::LogLoss(), { lambda, "XYZ" });
+            trainer->SetDataset(dataset.GetAnyDataset());
+            for (size_t epoch = 0; epoch < numEpochs; ++epoch)
+            {
+                trainer->Update();
+            }
+            aucs.push_back(getAUC(trainer->GetPredictor()));
+        }
+        return aucs;
+    };
+
+    auto sweepingTrainer = MakeSweepingSGDTrainer(dataset, regularization, { 4, 0, 0.0 }, evaluators::AUCAggregator());
+    sweepingTrainer->SetDataset(dataset.GetAnyDataset());
+    for (size_t epoch = 0; epoch < 3; ++epoch)
+    {
+        sweepingTrainer->Update();
+    }
+    auto aucs = getAUCs(3);
+    auto bestAUC = *std::max_element(aucs.begin(), aucs.end());
+    std::cout << "TestSweepingTrainerWithAUC, AUCs between " << *std::min_element(aucs.begin(), aucs.end()) << " and " << bestAUC << std::endl;
+    testing::ProcessTest("TestSweepingTrainerWithAUC, chooses the highest AUC predictor", testing::IsEqual(getAUC(sweepingTrainer->GetPredictor()), bestAUC));
+
+    // with a margin of 0, the trainer with the highest AUC survives pruning
+    auto pruningTrainer = MakeSweepingSGDTrainer(dataset, regularization, { 4, 1, 0.0 }, evaluators::AUCAggregator());
+    pruningTrainer->SetDataset(dataset.GetAnyDataset());
+    pruningTrainer->Update();
+    auto firstEpochAUCs = getAUCs(1);
+    auto bestIndex = static_cast<size_t>(std::max_element(firstEpochAUCs.begin(), firstEpochAUCs.end()) - firstEpochAUCs.begin());
+    testing::ProcessTest("TestSweepingTrainerWithAUC, keeps the highest AUC trainer", pruningTrainer->IsActive(bestIndex) && pruningTrainer->NumActiveTrainers() < regularization.size());
+}
+
+// points drawn from well separated spherical gaussians
+math::ColumnMatrix<double> GetClusteredPoints(size_t numPoints, size_t dimension, size_t numClusters)
+{
+    std::default_random_engine random(123);
+    std::normal_distribution<double> normal(0, 1);
+    math::ColumnMatrix<double> centers(dimension, numClusters);
+    centers.Generate([&]() { return 3 * normal(random); });
+
+    math::ColumnMatrix<double> points(dimension, numPoints);
+    for (size_t i = 0; i < numPoints; ++i)
+    {
+        auto center = centers.GetColumn(i % numClusters);
+        for (size_t j = 0; j < dimension; ++j)
+        {
+            points(j, i) = center[j] + normal(random);
+        }
+    }
+    return points;
+}
+
+double GetKMeansObjective(const math::ColumnMatrix<double>& points, const trainers::KMeansTrainer& kMeans)
+{
+    const auto& means = kMeans.GetClusterMeans();
+    const auto& assignment = kMeans.GetClusterAssignment();
+    double objective = 0;
+    for (size_t i = 0; i < points.NumColumns(); ++i)
+    {
+        auto mean = means.GetColumn(static_cast<size_t>(assignment[i]));
+        for (size_t j = 0; j < points.NumRows(); ++j)
+        {
+            objective += (points(j, i) - mean[j]) * (points(j, i) - mean[j]);
+        }
+    }
+    return objective;
+}
+
+void TestKMeansTrainer()
+{
+    const size_t numPoints = 100000;
+    const size_t dimension = 8;
+    const size_t numClusters = 32;
+    auto points = GetClusteredPoints(numPoints, dimension, numClusters);
+
+    // the same initial means for every run, so the exact algorithms must agree
+    math::ColumnMatrix<double> initialMeans(dimension, numClusters);
+    for (size_t j = 0; j < numClusters; ++j)
+    {
+        initialMeans.GetColumn(j).CopyFrom(points.GetColumn(j * 7));
+    }
+
+    auto runKMeans = [&](trainers::KMeansAlgorithm algorithm, size_t numThreads, size_t numIterations) {
+        trainers::KMeansTrainerParameters parameters;
+        parameters.algorithm = algorithm;
+        parameters.numThreads = numThreads;
+        parameters.miniBatchSize = 1000;
+        trainers::KMeansTrainer kMeans(numClusters, numIterations, initialMeans, parameters);
+        utilities::MillisecondTimer timer;
+        kMeans.RunKMeans(points);
+        std::cout << "TestKMeansTrainer, algorithm " << static_cast<int>(algorithm) << ", " << numThreads << " threads: " << timer.Elapsed() << " ms, "
+                  << kMeans.GetNumDistanceComputations() << " distance computations, objective " << GetKMeansObjective(points, kMeans) << std::endl;
+        return kMeans;
+    };
+
+    auto lloyd = runKMeans(trainers::KMeansAlgorithm::lloyd, 1, 100);
+    auto hamerly = runKMeans(trainers::KMeansAlgorithm::hamerly, 1, 100);
+    auto parallelHamerly = runKMeans(trainers::KMeansAlgorithm::hamerly, 4, 100);
+    auto miniBatch = runKMeans(trainers::KMeansAlgorithm::miniBatch, 4, 100);
+
+    testing::ProcessTest("TestKMeansTrainer, hamerly matches lloyd", lloyd.GetClusterAssignment() == hamerly.GetClusterAssignment() && testing::IsEqual(lloyd.GetClusterMeans().ToArray(), hamerly.GetClusterMeans().ToArray(), 1e-8));
+    testing::ProcessTest("TestKMeansTrainer, hamerly avoids distance computations", 2 * hamerly.GetNumDistanceComputations() < lloyd.GetNumDistanceComputations());
+    testing::ProcessTest("TestKMeansTrainer, parallel hamerly matches sequential", hamerly.GetClusterAssignment() == parallelHamerly.GetClusterAssignment() && testing::IsEqual(hamerly.GetClusterMeans().ToArray(), parallelHamerly.GetClusterMeans().ToArray(), 1e-8));
+    testing::ProcessTest("TestKMeansTrainer, mini-batch is close to lloyd", GetKMeansObjective(points, miniBatch) < 1.05 * GetKMeansObjective(points, lloyd));
+}
+
+void TestProtoNNTrainer()
+{
+    const size_t numExamples = 3000;
+    const size_t dimension = 8;
+    const size_t numLabels = 3;
+    auto points = GetClusteredPoints(numExamples, dimension, 2 * numLabels);
+
+    data::AutoSupervisedDataset dataset;
+    for (size_t i = 0; i < numExamples; ++i)
+    {
+        auto column = points.GetColumn(i);
+        std::vector<double> features(column.GetConstDataPointer(), column.GetConstDataPointer() + dimension);
+        dataset.AddExample({ data::AutoDataVector(features), { 1.0, static_cast<double>(i % numLabels) } });
+    }
+
+    auto train = [&](size_t numThreads) {
+        trainers::ProtoNNTrainerParameters parameters{ dimension, numLabels, 4, 2, 1.0, 1.0, 1.0, -1.0, trainers::ProtoNNLossFunction::L2, 5, 1, false, numThreads, 128 };
+        trainers::ProtoNNTrainer trainer(parameters);
+        trainer.SetDataset(dataset.GetAnyDataset(0, dataset.NumExamples()));
+        utilities::MillisecondTimer timer;
+        for (size_t iteration = 0; iteration < parameters.numIterations; ++iteration)
+        {
+            trainer.Update();
+        }
+
+        size_t numErrors = 0;
+        for (size_t i = 0; i < numExamples; ++i)
+        {
+            auto column = points.GetColumn(i);
+            auto scores = trainer.GetPredictor().Predict(std::vector<double>(column.GetConstDataPointer(), column.GetConstDataPointer() + dimension));
+            auto prediction = static_cast<size_t>(std::max_element(scores.GetDataPointer(), scores.GetDataPointer() + scores.Size()) - scores.GetDataPointer());
+            numErrors += prediction != i % numLabels ? 1 : 0;
+        }
+        auto error = static_cast<double>(numErrors) / numExamples;
+        std::cout << "TestProtoNNTrainer, " << numThreads << " threads: " << timer.Elapsed() << " ms, error " << error << std::endl;
+        return error;
+    };
+
+    auto sequentialError = train(1);
+    auto parallelError = train(4);
+    testing::ProcessTest("TestProtoNNTrainer, sequential", sequentialError < 0.1);
+    testing::ProcessTest("TestProtoNNTrainer, parallel", parallelError < 0.1 && std::abs(parallelError - sequentialError) < 0.02);
+}
+
 void TestMeanCalculator()
 {
     data::AutoSupervisedDataset dataset;
@@ -131,9 +457,53 @@ void TestMeanCalculator()
     testing::ProcessTest("TestMeanCalculator", mean == r);
 }
 
+void TestBinnedForestTrainer()
+{
+    // the label is a step function of the first feature, and the second feature is noise (the features are
+    // nonzero, so that the dense data vectors all have both features)
+    data::AutoSupervisedDataset dataset;
+    for (int i = 0; i < 200; ++i)
+    {
+        double x = 1.0 + (i % 50) / 10.0;
+        double noise = 1.0 + (i * 37 % 23) / 7.0;
+        double label = x < 2.5 ? -1.0 : (x < 4.5 ? 1.0 : 2.0);
+        dataset.AddExample({ { x, noise }, { 1.0, label } });
+    }
+
+    trainers::BinnedForestTrainerParameters parameters;
+    parameters.numRounds = 1;
+    parameters.maxSplitsPerRound = 4;
+    parameters.maxBinsPerFeature = 64;
+    parameters.numThreads = 2;
+    auto trainer = trainers::MakeBinnedForestTrainer(functions::SquaredLoss(), trainers::LogitBooster(), parameters);
+    trainer->SetDataset(dataset.GetAnyDataset());
+    trainer->Update();
+
+    functions::SquaredLoss lossFunction;
+    double error = 0;
+    const auto& predictor = trainer->GetPredictor();
+    for (size_t i = 0; i < dataset.NumExamples(); ++i)
+    {
+        const auto& example = dataset[i];
+        auto dataVector = example.GetDataVector().CopyAs<data::FloatDataVector>();
+        error += lossFunction(predictor.Predict(dataVector), example.GetMetadata().label);
+    }
+    printf("TestBinnedForestTrainer error is %f\n", error);
+
+    testing::ProcessTest("TestBinnedForestTrainer, fits step function", error < 1.0e-6);
+    testing::ProcessTest("TestBinnedForestTrainer, splits only on informative feature", predictor.NumInteriorNodes() == 2 && predictor.GetInteriorNodes()[0].GetSplitRule().GetElementIndex() == 0);
+}
+
 int main()
 {
     TestSDCATrainer();
+    TestParallelSDCATrainer();
     TestSGDTrainer();
+    TestOutOfCoreSGDTrainer();
+    TestSweepingTrainer();
+    TestSweepingTrainerWithAUC();
+    TestKMeansTrainer();
+    TestProtoNNTrainer();
     TestMeanCalculator();
+    TestBinnedForestTrainer();
 }
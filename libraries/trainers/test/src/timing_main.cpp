@@ -0,0 +1,51 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     timing_main.cpp (trainers)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "SDCATestUtilities.h"
+
+#include <testing/include/testing.h>
+
+#include <utilities/include/MillisecondTimer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+using namespace ell;
+
+void TestParallelSDCATrainerScaling()
+{
+    const size_t numExamples = 20000;
+    const size_t numEpochs = 3;
+    auto dataset = GetSparseClassificationDataset(numExamples, 1000, 20);
+
+    bool ok = true;
+    for (auto mode : { trainers::SDCAParallelMode::hogwild, trainers::SDCAParallelMode::miniBatch })
+    {
+        for (size_t numThreads : { 1, 2, 4, 8, 16, 32 })
+        {
+            trainers::SDCATrainerParameters parameters{ 1.0e-4, 1.0e-8, numEpochs, true, "XYZ", numThreads, mode };
+
+            utilities::MillisecondTimer timer;
+            auto info = TrainSDCA(dataset, parameters, numEpochs);
+            auto time = static_cast<double>(timer.Elapsed());
+
+            ok = ok && info.primalObjective < std::log(2.0);
+            std::cout << "SDCA " << (mode == trainers::SDCAParallelMode::hogwild ? "hogwild" : "miniBatch") << ", " << numThreads << " threads: "
+                      << time << " ms (" << 1000 * numExamples * numEpochs / std::max(time, 1.0) << " examples/s), primal objective " << info.primalObjective << std::endl;
+        }
+    }
+    testing::ProcessTest("TestParallelSDCATrainerScaling", ok);
+}
+
+int main()
+{
+    TestParallelSDCATrainerScaling();
+
+    return testing::DidTestFail() ? 1 : 0;
+}
@@ -8,8 +8,10 @@
 
 #pragma once
 
+#include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <vector>
 
 namespace ell
@@ -36,8 +38,8 @@ namespace utilities
             /// <returns> true if it succeeds, false if it fails. </returns>
             bool IsValid() const { return _iter < _end; }
 
-            /// <summary> Proceeds to the Next iterate. </summary>
-            void Next();
+            /// <summary> Proceeds to the Next iterate. Defined inline, since it sits in the inner loop of every sparse vector operation. </summary>
+            inline void Next();
 
             /// <summary> Returns the value of the current iterate. </summary>
             ///
@@ -102,3 +104,45 @@ namespace utilities
     };
 } // namespace utilities
 } // namespace ell
+
+#pragma region implementation
+
+namespace ell
+{
+namespace utilities
+{
+    void CompressedIntegerList::Iterator::Next()
+    {
+        _iter += _iter_increment;
+        uint8_t first_val = *_iter;
+
+        // chop off top 2 bits --- they encode the # of bytes needed for this delta
+        // 00 = 1 byte, 01 = 2 bytes, 10 = 4 bytes, 11 = 8 bytes
+        int log2bytes = (first_val >> 6) & 0x03;
+        int total_bytes = 1 << log2bytes;
+
+        // read in the Next bytes, shift them over to fit the 6 bits of first_val we're using, and Add first_val.
+        // Away from the end of the list, this reads 8 bytes at once and masks off the ones that belong to this
+        // delta, which avoids a data-dependent branch in the inner loop of every sparse vector operation.
+        size_t delta;
+        if (_end - _iter >= 8)
+        {
+            static constexpr uint64_t masks[] = { 0, 0xff, 0xffffff, 0xffffffffffffff };
+            uint64_t bytes;
+            std::memcpy(&bytes, _iter, 8);
+            delta = static_cast<size_t>((((bytes >> 8) & masks[log2bytes]) << 6) | (first_val & 0x3f));
+        }
+        else
+        {
+            delta = 0;
+            std::memcpy(&delta, _iter + 1, total_bytes - 1);
+            delta = (delta << 6) | (first_val & 0x3f);
+        }
+
+        _iter_increment = total_bytes;
+        _value += delta;
+    }
+} // namespace utilities
+} // namespace ell
+
+#pragma endregion implementation
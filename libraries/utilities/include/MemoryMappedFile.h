@@ -0,0 +1,55 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     MemoryMappedFile.h (utilities)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace ell
+{
+namespace utilities
+{
+    /// <summary> A read-only view of a file's contents, mapped into the address space of the process. Pages are
+    /// loaded by the operating system as they are touched, so files larger than physical memory can be mapped. </summary>
+    class MemoryMappedFile
+    {
+    public:
+        /// <summary> Maps a file into memory. Throws an exception if the file can't be opened or mapped. </summary>
+        ///
+        /// <param name="filepath"> The path of the file to map. </param>
+        MemoryMappedFile(const std::string& filepath);
+
+        MemoryMappedFile(const MemoryMappedFile&) = delete;
+        MemoryMappedFile(MemoryMappedFile&& other);
+        MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+        MemoryMappedFile& operator=(MemoryMappedFile&& other);
+        ~MemoryMappedFile();
+
+        /// <summary> Gets a pointer to the start of the file's contents. </summary>
+        ///
+        /// <returns> Pointer to the mapped memory, or nullptr if the file is empty. </returns>
+        const char* GetData() const { return _data; }
+
+        /// <summary> Gets the size of the file, in bytes. </summary>
+        ///
+        /// <returns> The size of the file. </returns>
+        size_t Size() const { return _size; }
+
+    private:
+        void Unmap();
+
+        const char* _data = nullptr;
+        size_t _size = 0;
+#ifdef WIN32
+        void* _fileHandle = nullptr;
+        void* _mappingHandle = nullptr;
+#endif
+    };
+} // namespace utilities
+} // namespace ell
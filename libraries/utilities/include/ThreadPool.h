@@ -0,0 +1,102 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ThreadPool.h (utilities)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ell
+{
+namespace utilities
+{
+    /// <summary> A fixed set of worker threads that run tasks from a shared queue. </summary>
+    class ThreadPool
+    {
+    public:
+        /// <summary> Constructor </summary>
+        ///
+        /// <param name="numThreads"> The number of worker threads. '0' means one thread per hardware thread. </param>
+        ThreadPool(size_t numThreads = 0);
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /// <summary> Destructor. Finishes the tasks already in the queue, then joins the worker threads. </summary>
+        ~ThreadPool();
+
+        /// <summary> Gets the number of worker threads. </summary>
+        ///
+        /// <returns> The number of worker threads. </returns>
+        size_t NumThreads() const { return _threads.size(); }
+
+        /// <summary> Adds a task to the queue. </summary>
+        ///
+        /// <param name="task"> The function to run on a worker thread. </param>
+        ///
+        /// <returns> A future holding the result of the task (or the exception it threw). </returns>
+        template <typename FunctionType>
+        auto Run(FunctionType&& task) -> std::future<std::invoke_result_t<FunctionType>>;
+
+        /// <summary> Calls a function for each index in [0, count), splitting the range into one contiguous block
+        /// per worker thread, and waits for all the calls to finish. Must not be called from a task running on the same pool. </summary>
+        ///
+        /// <param name="count"> The number of indices. </param>
+        /// <param name="body"> The function to call, with signature `void(size_t index)`. </param>
+        void ParallelFor(size_t count, const std::function<void(size_t)>& body);
+
+        /// <summary> Gets the number of hardware threads, or 1 if it can't be determined. </summary>
+        ///
+        /// <returns> The number of hardware threads. </returns>
+        static size_t GetNumHardwareThreads();
+
+    private:
+        void WorkerThread();
+
+        std::vector<std::thread> _threads;
+        std::queue<std::function<void()>> _tasks;
+        std::mutex _mutex;
+        std::condition_variable _workAvailable;
+        bool _shutDown = false;
+    };
+} // namespace utilities
+} // namespace ell
+
+#pragma region implementation
+
+namespace ell
+{
+namespace utilities
+{
+    template <typename FunctionType>
+    auto ThreadPool::Run(FunctionType&& task) -> std::future<std::invoke_result_t<FunctionType>>
+    {
+        using ResultType = std::invoke_result_t<FunctionType>;
+
+        // std::function requires a copyable target, so the packaged task is held through a shared_ptr
+        auto packagedTask = std::make_shared<std::packaged_task<ResultType()>>(std::forward<FunctionType>(task));
+        auto result = packagedTask->get_future();
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _tasks.emplace([packagedTask]() { (*packagedTask)(); });
+        }
+        _workAvailable.notify_one();
+        return result;
+    }
+} // namespace utilities
+} // namespace ell
+
+#pragma endregion implementation
@@ -17,33 +17,6 @@ namespace ell
 {
 namespace utilities
 {
-    void CompressedIntegerList::Iterator::Next()
-    {
-        size_t delta;
-        _iter += _iter_increment;
-        uint8_t first_val = *_iter;
-
-        // chop off top 2 bits --- they encode the # of bytes needed for this delta
-        // 00 = 1 byte, 01 = 2 bytes, 10 = 4 bytes, 11 = 8 bytes
-        int total_bytes = 1 << ((first_val >> 6) & 0x03);
-        assert(total_bytes <= 8);
-        if (total_bytes == 1)
-        {
-            // first_val &= 0x3f; // this is commented out because we don't need to strip off the top 2 bits of first_val in this case, because they're always zero
-            delta = first_val;
-        }
-        else
-        {
-            // read in the Next bytes, shift them over to fit the 6 bits of first_val we're using, and Add first_val
-            delta = 0;
-            std::memcpy(&delta, _iter + 1, total_bytes - 1);
-            delta = (delta << 6) | (first_val & 0x3f);
-        }
-
-        _iter_increment = total_bytes;
-        _value += delta;
-    }
-
     CompressedIntegerList::Iterator::Iterator(const uint8_t* iter, const uint8_t* end) :
         _iter(iter),
         _end(end),
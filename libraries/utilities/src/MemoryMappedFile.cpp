@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     MemoryMappedFile.cpp (utilities)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "MemoryMappedFile.h"
+#include "Exception.h"
+
+#include <utility>
+#ifdef WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // WIN32
+
+namespace ell
+{
+namespace utilities
+{
+#ifdef WIN32
+    MemoryMappedFile::MemoryMappedFile(const std::string& filepath)
+    {
+        auto fileHandle = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE)
+        {
+            throw utilities::InputException(InputExceptionErrors::invalidArgument, "error opening file " + filepath);
+        }
+        _fileHandle = fileHandle;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(fileHandle, &size))
+        {
+            Unmap();
+            throw utilities::SystemException(SystemExceptionErrors::fileNotFound, "error getting the size of file " + filepath);
+        }
+        _size = static_cast<size_t>(size.QuadPart);
+        if (_size == 0)
+        {
+            return;
+        }
+
+        _mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (_mappingHandle == nullptr)
+        {
+            Unmap();
+            throw utilities::SystemException(SystemExceptionErrors::fileNotFound, "error mapping file " + filepath);
+        }
+
+        _data = static_cast<const char*>(MapViewOfFile(_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+        if (_data == nullptr)
+        {
+            Unmap();
+            throw utilities::SystemException(SystemExceptionErrors::fileNotFound, "error mapping file " + filepath);
+        }
+    }
+
+    void MemoryMappedFile::Unmap()
+    {
+        if (_data != nullptr)
+        {
+            UnmapViewOfFile(_data);
+        }
+        if (_mappingHandle != nullptr)
+        {
+            CloseHandle(_mappingHandle);
+        }
+        if (_fileHandle != nullptr)
+        {
+            CloseHandle(_fileHandle);
+        }
+        _data = nullptr;
+        _size = 0;
+        _mappingHandle = nullptr;
+        _fileHandle = nullptr;
+    }
+#else
+    MemoryMappedFile::MemoryMappedFile(const std::string& filepath)
+    {
+        auto fileDescriptor = open(filepath.c_str(), O_RDONLY);
+        if (fileDescriptor < 0)
+        {
+            throw utilities::InputException(InputExceptionErrors::invalidArgument, "error opening file " + filepath);
+        }
+
+        struct stat fileStatus;
+        if (fstat(fileDescriptor, &fileStatus) != 0)
+        {
+            close(fileDescriptor);
+            throw utilities::SystemException(SystemExceptionErrors::fileNotFound, "error getting the size of file " + filepath);
+        }
+
+        _size = static_cast<size_t>(fileStatus.st_size);
+        if (_size > 0)
+        {
+            auto data = mmap(nullptr, _size, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+            if (data == MAP_FAILED)
+            {
+                close(fileDescriptor);
+                throw utilities::SystemException(SystemExceptionErrors::fileNotFound, "error mapping file " + filepath);
+            }
+            _data = static_cast<const char*>(data);
+        }
+
+        // The mapping stays valid after the file is closed
+        close(fileDescriptor);
+    }
+
+    void MemoryMappedFile::Unmap()
+    {
+        if (_data != nullptr)
+        {
+            munmap(const_cast<char*>(_data), _size);
+        }
+        _data = nullptr;
+        _size = 0;
+    }
+#endif // WIN32
+
+    MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& other)
+    {
+        *this = std::move(other);
+    }
+
+    MemoryMappedFile& MemoryMappedFile::operator=(MemoryMappedFile&& other)
+    {
+        if (this != &other)
+        {
+            Unmap();
+            std::swap(_data, other._data);
+            std::swap(_size, other._size);
+#ifdef WIN32
+            std::swap(_fileHandle, other._fileHandle);
+            std::swap(_mappingHandle, other._mappingHandle);
+#endif
+        }
+        return *this;
+    }
+
+    MemoryMappedFile::~MemoryMappedFile()
+    {
+        Unmap();
+    }
+} // namespace utilities
+} // namespace ell
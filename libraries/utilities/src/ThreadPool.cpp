@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ThreadPool.cpp (utilities)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace ell
+{
+namespace utilities
+{
+    ThreadPool::ThreadPool(size_t numThreads)
+    {
+        if (numThreads == 0)
+        {
+            numThreads = GetNumHardwareThreads();
+        }
+
+        _threads.reserve(numThreads);
+        for (size_t index = 0; index < numThreads; ++index)
+        {
+            _threads.emplace_back([this]() { WorkerThread(); });
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _shutDown = true;
+        }
+        _workAvailable.notify_all();
+
+        for (auto& thread : _threads)
+        {
+            thread.join();
+        }
+    }
+
+    void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t)>& body)
+    {
+        const auto numBlocks = std::min(count, NumThreads());
+        if (numBlocks <= 1)
+        {
+            for (size_t index = 0; index < count; ++index)
+            {
+                body(index);
+            }
+            return;
+        }
+
+        std::vector<std::future<void>> blocks;
+        blocks.reserve(numBlocks);
+        for (size_t blockIndex = 0; blockIndex < numBlocks; ++blockIndex)
+        {
+            const auto begin = blockIndex * count / numBlocks;
+            const auto end = (blockIndex + 1) * count / numBlocks;
+            blocks.push_back(Run([begin, end, &body]() {
+                for (auto index = begin; index < end; ++index)
+                {
+                    body(index);
+                }
+            }));
+        }
+
+        // Wait for every block before rethrowing, since the blocks refer to `body`
+        for (auto& block : blocks)
+        {
+            block.wait();
+        }
+        for (auto& block : blocks)
+        {
+            block.get();
+        }
+    }
+
+    size_t ThreadPool::GetNumHardwareThreads()
+    {
+        return std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    void ThreadPool::WorkerThread()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _workAvailable.wait(lock, [this]() { return _shutDown || !_tasks.empty(); });
+                if (_tasks.empty())
+                {
+                    return; // shut down, and no work left
+                }
+
+                task = std::move(_tasks.front());
+                _tasks.pop();
+            }
+            task();
+        }
+    }
+} // namespace utilities
+} // namespace ell
@@ -0,0 +1,61 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     ThreadPool_test.cpp (utilities)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "ThreadPool_test.h"
+
+#include <testing/include/testing.h>
+
+#include <utilities/include/ThreadPool.h>
+
+#include <future>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace ell
+{
+void TestThreadPoolRun()
+{
+    utilities::ThreadPool pool(4);
+    std::vector<std::future<int>> results;
+    for (int index = 0; index < 100; ++index)
+    {
+        results.push_back(pool.Run([index]() { return index * index; }));
+    }
+
+    bool ok = true;
+    for (int index = 0; index < 100; ++index)
+    {
+        ok &= results[index].get() == index * index;
+    }
+    testing::ProcessTest("ThreadPool::Run results", ok);
+
+    auto failed = pool.Run([]() -> int { throw std::runtime_error("task failed"); });
+    bool threw = false;
+    try
+    {
+        failed.get();
+    }
+    catch (const std::runtime_error&)
+    {
+        threw = true;
+    }
+    testing::ProcessTest("ThreadPool::Run propagates exceptions", threw);
+}
+
+void TestThreadPoolParallelFor()
+{
+    utilities::ThreadPool pool(3);
+    for (size_t count : { 0, 1, 2, 3, 10, 1000 })
+    {
+        std::vector<int> visits(count, 0);
+        pool.ParallelFor(count, [&visits](size_t index) { ++visits[index]; });
+        testing::ProcessTest("ThreadPool::ParallelFor visits each index once", testing::IsEqual(visits, std::vector<int>(count, 1)));
+    }
+}
+} // namespace ell
@@ -15,6 +15,7 @@
 #include "MemoryLayout_test.h"
 #include "ObjectArchive_test.h"
 #include "PropertyBag_test.h"
+#include "ThreadPool_test.h"
 #include "TypeFactory_test.h"
 #include "TypeName_test.h"
 #include "Variant_test.h"
@@ -109,6 +110,10 @@ int main(int argc, char* argv[])
 
         // PropertyBag tests
         TestPropertyBag();
+
+        // ThreadPool tests
+        TestThreadPoolRun();
+        TestThreadPoolParallelFor();
     }
     catch (const utilities::Exception& exception)
     {
@@ -15,6 +15,8 @@
 
 #include <utilities/include/StringUtil.h>
 
+#include <llvm/IR/DataLayout.h>
+
 using namespace std::string_literals;
 
 namespace ell
@@ -187,6 +189,35 @@ namespace value
 
         LLVMValue ToLLVMValue(Value value) { return value.Get<Emittable>().GetDataAs<LLVMValue>(); }
 
+        // Returns the emitter runtime's native implementation of a BLAS function, if there is one and the module
+        // is being compiled without BLAS
+        LLVMFunction GetNativeBlasFunction(IRModuleEmitter& module, const std::string& name)
+        {
+            if (module.GetCompilerOptions().useBlas)
+            {
+                return nullptr;
+            }
+
+            auto& runtime = module.GetRuntime();
+            if (name == "cblas_sgemm")
+            {
+                return runtime.GetGEMMFunction<float>(false);
+            }
+            else if (name == "cblas_dgemm")
+            {
+                return runtime.GetGEMMFunction<double>(false);
+            }
+            else if (name == "cblas_sgemv")
+            {
+                return runtime.GetGEMVFunction<float>(false);
+            }
+            else if (name == "cblas_dgemv")
+            {
+                return runtime.GetGEMVFunction<double>(false);
+            }
+            return nullptr;
+        }
+
         auto SimpleNumericalFunctionIntrinsic(IRFunctionEmitter& fnEmitter, LLVMFunction (IRRuntime::*intrinsicFn)(VariableType)) -> std::function<Value(std::vector<Value>)>
         {
             return [&fnEmitter, intrinsicFn](std::vector<Value> args) -> Value {
@@ -477,8 +508,16 @@ namespace value
 
     Value LLVMContext::AllocateImpl(ValueType type, MemoryLayout layout)
     {
-        auto llvmType = ValueTypeToLLVMType(GetFnEmitter().GetEmitter(), { type, 0 });
-        return { Emittable{ GetFnEmitter().Variable(llvmType, layout.GetMemorySize()) }, layout };
+        auto& fn = GetFnEmitter();
+        auto llvmType = ValueTypeToLLVMType(fn.GetEmitter(), { type, 0 });
+        auto variable = fn.Variable(llvmType, layout.GetMemorySize());
+
+        // Allocations start out zeroed, like ComputeContext's, since accumulating code relies on it
+        const auto& dataLayout = _emitter.GetLLVMModule()->getDataLayout();
+        auto byteCount = static_cast<int64_t>(dataLayout.getTypeAllocSize(llvmType) * layout.GetMemorySize());
+        fn.GetEmitter().MemorySet(variable, fn.Literal<uint8_t>(0), fn.Literal(byteCount));
+
+        return { Emittable{ variable }, layout };
     }
 
     std::optional<Value> LLVMContext::GetGlobalValue(GlobalAllocationScope scope, std::string name)
@@ -709,9 +748,12 @@ namespace value
                 auto srcValue = ToLLVMValue(source);
                 if (auto& layout = source.GetLayout(); layout.IsContiguous())
                 {
+                    // MemoryCopy takes a byte count, not an element count
+                    const auto& dataLayout = _emitter.GetLLVMModule()->getDataLayout();
+                    auto elementSize = dataLayout.getTypeAllocSize(srcValue->getType()->getPointerElementType());
                     irEmitter.MemoryCopy(srcValue,
                                          destValue,
-                                         irEmitter.Literal(static_cast<int64_t>(layout.GetMemorySize())));
+                                         irEmitter.Literal(static_cast<int64_t>(layout.GetMemorySize() * elementSize)));
                 }
                 else
                 {
@@ -1179,11 +1221,15 @@ namespace value
             return ValueTypeToLLVMType(irEmitter, { value.GetBaseType(), value.PointerLevel() });
         });
 
-        // Create external function declaration
+        // Create external function declaration, unless the runtime provides a native replacement
         const auto& fnName = externalFunc.GetFunctionName();
-        auto fnType = llvm::FunctionType::get(resultType, paramTypes, false);
-        _emitter.DeclareFunction(fnName, fnType);
-        auto fn = _emitter.GetFunction(fnName);
+        auto fn = GetNativeBlasFunction(_emitter, fnName);
+        if (fn == nullptr)
+        {
+            auto fnType = llvm::FunctionType::get(resultType, paramTypes, false);
+            _emitter.DeclareFunction(fnName, fnType);
+            fn = _emitter.GetFunction(fnName);
+        }
 
         // as a first approximation, if the corresponding arg type has a pointer level that's one less
         // than the passed in value, we dereference it. if it's the same, we pass it in as is. if it's anything else,
@@ -1301,15 +1347,19 @@ namespace value
                 }
                 else
                 {
+                    // The data is copied into the function's own variable from a constant global, since memcpy
+                    // needs a pointer to copy from
                     auto& fn = GetFnEmitter();
-                    llvm::Constant* constant = nullptr;
+                    std::string constantName =
+                        GetCurrentFunctionScopedName("_"s + std::to_string(_promotedConstantStack.top().size()));
+                    llvm::GlobalVariable* constant = nullptr;
                     if constexpr (std::is_same_v<DataType, Boolean>)
                     {
-                        constant = fn.GetEmitter().Literal(std::vector<uint8_t>(data.begin(), data.end()));
+                        constant = _emitter.ConstantArray(constantName, std::vector<uint8_t>(data.begin(), data.end()));
                     }
                     else
                     {
-                        constant = fn.GetEmitter().Literal(data);
+                        constant = _emitter.ConstantArray(constantName, data);
                     }
 
                     auto varType =
@@ -7,9 +7,16 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 #include "MatrixOperations.h"
+#include "ComputeContext.h"
 #include "EmitterContext.h"
+#include "FunctionDeclaration.h"
+#include "LLVMContext.h"
 #include "Matrix.h"
 #include "Scalar.h"
+#include "Vector.h"
+#include "VectorOperations.h"
+
+#include <math/include/MatrixOperations.h>
 
 namespace ell
 {
@@ -42,9 +49,170 @@ namespace value
         });
     }
 
-    Matrix GEMM(Matrix m1, Matrix m2) { throw LogicException(LogicExceptionErrors::notImplemented); }
+    namespace
+    {
+        // CBLAS enumeration values
+        constexpr int CblasRowMajor = 101;
+        constexpr int CblasNoTrans = 111;
+
+        int GetLeadingDimension(Matrix matrix)
+        {
+            auto layout = matrix.GetValue().GetLayout();
+            if (!layout.IsCanonicalOrder())
+            {
+                throw InputException(InputExceptionErrors::invalidArgument, "Matrix must be in row-major order");
+            }
+            return static_cast<int>(layout.GetCumulativeIncrement(0));
+        }
+
+        // Calls the BLAS-style GEMM function `name`. When running in a ComputeContext, this runs the math library's
+        // matrix multiplication (OpenBLAS if available, otherwise the native blocked kernel). When emitting LLVM IR,
+        // this calls the BLAS function, which LLVMContext replaces with the emitter runtime's native blocked kernel
+        // when the module is compiled without BLAS.
+        template <typename T>
+        void CallGEMM(std::string name, Matrix A, Matrix B, Matrix C)
+        {
+            constexpr auto type = GetValueType<T>();
+            auto fn = DeclareFunction(name)
+                          .Parameters(
+                              Value({ ValueType::Int32, 0 }, ScalarLayout), /*order*/
+                              Value({ ValueType::Int32, 0 }, ScalarLayout), /*transposeA*/
+                              Value({ ValueType::Int32, 0 }, ScalarLayout), /*transposeB*/
+                              Value({ ValueType::Int32, 0 }, ScalarLayout), /*m*/
+                              Value({ ValueType::Int32, 0 }, ScalarLayout), /*n*/
+                              Value({ ValueType::Int32, 0 }, ScalarLayout), /*k*/
+                              Value({ type, 0 }, ScalarLayout), /*alpha*/
+                              Value({ type, 1 }, A.GetValue().GetLayout()), /*A*/
+                              Value({ ValueType::Int32, 0 }, ScalarLayout), /*lda*/
+                              Value({ type, 1 }, B.GetValue().GetLayout()), /*B*/
+                              Value({ ValueType::Int32, 0 }, ScalarLayout), /*ldb*/
+                              Value({ type, 0 }, ScalarLayout), /*beta*/
+                              Value({ type, 1 }, C.GetValue().GetLayout()), /*C*/
+                              Value({ ValueType::Int32, 0 }, ScalarLayout)); /*ldc*/
+
+            const auto m = static_cast<int>(A.Rows());
+            const auto n = static_cast<int>(B.Columns());
+            const auto k = static_cast<int>(A.Columns());
+            std::vector<Value> args{ CblasRowMajor, CblasNoTrans, CblasNoTrans, m, n, k, static_cast<T>(1), A.GetValue(), GetLeadingDimension(A), B.GetValue(), GetLeadingDimension(B), static_cast<T>(0), C.GetValue(), GetLeadingDimension(C) };
+
+            auto computed = InvokeForContext<ComputeContext>([&](auto&) {
+                auto wrapper = fn.Define([](Scalar, Scalar, Scalar, Scalar m, Scalar n, Scalar k, Scalar alpha, Matrix A, Scalar lda, Matrix B, Scalar ldb, Scalar beta, Matrix C, Scalar ldc) {
+                    math::ConstRowMatrixReference<T> matrixA(A.GetValue().Get<T*>(), m.Get<int>(), k.Get<int>(), lda.Get<int>());
+                    math::ConstRowMatrixReference<T> matrixB(B.GetValue().Get<T*>(), k.Get<int>(), n.Get<int>(), ldb.Get<int>());
+                    math::RowMatrixReference<T> matrixC(C.GetValue().Get<T*>(), m.Get<int>(), n.Get<int>(), ldc.Get<int>());
+                    math::MultiplyScaleAddUpdate<math::ImplementationType::openBlas>(alpha.Get<T>(), matrixA, matrixB, beta.Get<T>(), matrixC);
+                });
+                wrapper(args[0], args[1], args[2], args[3], args[4], args[5], args[6], A, args[8], B, args[10], args[11], C, args[13]);
+                return true;
+            });
+
+            if (!computed)
+            {
+                InvokeForContext<LLVMContext>([&](auto&) { fn.Decorated(FunctionDecorated::No).Call(args); });
+            }
+        }
+
+        // Calls the BLAS-style GEMV function `name`, in the same manner as `CallGEMM`
+        template <typename T>
+        void CallGEMV(std::string name, Matrix A, Vector x, Vector y)
+        {
+            constexpr auto type = GetValueType<T>();
+            auto fn = DeclareFunction(name)
+                          .Parameters(
+                              Value({ ValueType::Int32, 0 }, ScalarLayout), /*order*/
+                              Value({ ValueType::Int32, 0 }, ScalarLayout), /*transpose*/
+                              Value({ ValueType::Int32, 0 }, ScalarLayout), /*m*/
+                              Value({ ValueType::Int32, 0 }, ScalarLayout), /*n*/
+                              Value({ type, 0 }, ScalarLayout), /*alpha*/
+                              Value({ type, 1 }, A.GetValue().GetLayout()), /*A*/
+                              Value({ ValueType::Int32, 0 }, ScalarLayout), /*lda*/
+                              Value({ type, 1 }, x.GetValue().GetLayout()), /*x*/
+                              Value({ ValueType::Int32, 0 }, ScalarLayout), /*incx*/
+                              Value({ type, 0 }, ScalarLayout), /*beta*/
+                              Value({ type, 1 }, y.GetValue().GetLayout()), /*y*/
+                              Value({ ValueType::Int32, 0 }, ScalarLayout)); /*incy*/
+
+            const auto m = static_cast<int>(A.Rows());
+            const auto n = static_cast<int>(A.Columns());
+            const auto incx = static_cast<int>(x.GetValue().GetLayout().GetCumulativeIncrement(0));
+            const auto incy = static_cast<int>(y.GetValue().GetLayout().GetCumulativeIncrement(0));
+            std::vector<Value> args{ CblasRowMajor, CblasNoTrans, m, n, static_cast<T>(1), A.GetValue(), GetLeadingDimension(A), x.GetValue(), incx, static_cast<T>(0), y.GetValue(), incy };
+
+            auto computed = InvokeForContext<ComputeContext>([&](auto&) {
+                auto wrapper = fn.Define([](Scalar, Scalar, Scalar m, Scalar n, Scalar alpha, Matrix A, Scalar lda, Vector x, Scalar incx, Scalar beta, Vector y, Scalar incy) {
+                    math::ConstRowMatrixReference<T> matrixA(A.GetValue().Get<T*>(), m.Get<int>(), n.Get<int>(), lda.Get<int>());
+                    math::ConstColumnVectorReference<T> vectorX(x.GetValue().Get<T*>(), n.Get<int>(), incx.Get<int>());
+                    math::ColumnVectorReference<T> vectorY(y.GetValue().Get<T*>(), m.Get<int>(), incy.Get<int>());
+                    math::MultiplyScaleAddUpdate<math::ImplementationType::openBlas>(alpha.Get<T>(), matrixA, vectorX, beta.Get<T>(), vectorY);
+                });
+                wrapper(args[0], args[1], args[2], args[3], args[4], A, args[6], x, args[8], args[9], y, args[11]);
+                return true;
+            });
+
+            if (!computed)
+            {
+                InvokeForContext<LLVMContext>([&](auto&) { fn.Decorated(FunctionDecorated::No).Call(args); });
+            }
+        }
+    } // namespace
+
+    Matrix GEMM(Matrix m1, Matrix m2)
+    {
+        if (m1.Columns() != m2.Rows())
+        {
+            throw InputException(InputExceptionErrors::sizeMismatch);
+        }
+        if (m1.Type() != m2.Type())
+        {
+            throw InputException(InputExceptionErrors::typeMismatch);
+        }
+
+        Matrix result = Allocate(m1.Type(), MemoryLayout({ static_cast<int>(m1.Rows()), static_cast<int>(m2.Columns()) }));
+        switch (m1.Type())
+        {
+        case ValueType::Float:
+            CallGEMM<float>("cblas_sgemm", m1, m2, result);
+            break;
+        case ValueType::Double:
+            CallGEMM<double>("cblas_dgemm", m1, m2, result);
+            break;
+        default:
+            For(result, [&](Scalar row, Scalar column) {
+                result(row, column) = Dot(m1.Row(row), m2.Column(column));
+            });
+            break;
+        }
+        return result;
+    }
+
+    Vector GEMV(Matrix m, Vector v)
+    {
+        if (m.Columns() != v.Size())
+        {
+            throw InputException(InputExceptionErrors::sizeMismatch);
+        }
+        if (m.Type() != v.GetType())
+        {
+            throw InputException(InputExceptionErrors::typeMismatch);
+        }
 
-    Vector GEMV(Matrix m, Vector v) { throw LogicException(LogicExceptionErrors::notImplemented); }
+        Vector result = Allocate(m.Type(), m.Rows());
+        switch (m.Type())
+        {
+        case ValueType::Float:
+            CallGEMV<float>("cblas_sgemv", m, v, result);
+            break;
+        case ValueType::Double:
+            CallGEMV<double>("cblas_dgemv", m, v, result);
+            break;
+        default:
+            For(result, [&](Scalar row) {
+                result(row) = Dot(m.Row(row), v);
+            });
+            break;
+        }
+        return result;
+    }
 
     Matrix operator+(Matrix m1, Matrix m2)
     {
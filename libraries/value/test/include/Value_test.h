@@ -30,6 +30,8 @@ void Casting_test1();
 void If_test1();
 void Accumulate_test();
 void Dot_test();
+void GEMM_test();
+void GEMV_test();
 void Intrinsics_test1();
 void Intrinsics_test2();
 
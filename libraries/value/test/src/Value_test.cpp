@@ -16,6 +16,7 @@
 #include <value/include/Value.h>
 #include <value/include/Vector.h>
 
+#include <emitters/include/IRExecutionEngine.h>
 #include <emitters/include/IRModuleEmitter.h>
 
 #include <math/include/Matrix.h>
@@ -1026,6 +1027,183 @@ void Dot_test()
     InvokeForContext<ComputeContext>([&](auto&) { fn(); });
 }
 
+namespace
+{
+    // Small integers, so that the products and sums are exact in either precision
+    template <typename T>
+    std::vector<T> GetMultiplicationTestData(int size, int modulus)
+    {
+        std::vector<T> data(size);
+        for (int index = 0; index < size; ++index)
+        {
+            data[index] = static_cast<T>((index % modulus) - (modulus / 2));
+        }
+        return data;
+    }
+
+    // Emits a function that computes C = A x B with GEMM into a module compiled without BLAS, so that it runs the
+    // emitter runtime's native kernel, then jits it and compares its result with a reference
+    template <typename T>
+    bool VerifyJittedGEMM(int m, int n, int k)
+    {
+        auto A = GetMultiplicationTestData<T>(m * k, 7);
+        auto B = GetMultiplicationTestData<T>(k * n, 5);
+        std::vector<T> reference(m * n);
+        for (int i = 0; i < m; ++i)
+        {
+            for (int j = 0; j < n; ++j)
+            {
+                for (int p = 0; p < k; ++p)
+                {
+                    reference[i * n + j] += A[i * k + p] * B[p * n + j];
+                }
+            }
+        }
+
+        CompilerOptions options;
+        options.useBlas = false;
+        IRModuleEmitter module("GEMM_jit_test", options);
+        auto& testContext = GetContext();
+        {
+            LLVMContext context(module);
+            ContextGuard guard(context);
+            constexpr auto type = GetValueType<T>();
+            (void)DeclareFunction("GEMM_jit")
+                .Decorated(FunctionDecorated::No)
+                .Parameters(
+                    Value{ type, MemoryLayout{ { m, k } } },
+                    Value{ type, MemoryLayout{ { k, n } } },
+                    Value{ type, MemoryLayout{ { m, n } } })
+                .Define([](Matrix A, Matrix B, Matrix C) {
+                    Matrix result = GEMM(A, B);
+                    For(C, [&](Scalar row, Scalar column) { C(row, column) = result(row, column); });
+                });
+        }
+
+        // ContextGuard clears the global context on the way out, so give the caller's back
+        SetContext(testContext);
+
+        // LLVMContext leaves the functions it defines open and internal to the module, so finish this one and
+        // export it before jitting
+        module.EndFunction();
+        module.GetFunction("GEMM_jit")->setLinkage(llvm::GlobalValue::ExternalLinkage);
+
+        IRExecutionEngine engine(std::move(module));
+        auto fn = reinterpret_cast<void (*)(T*, T*, T*)>(engine.ResolveFunctionAddress("GEMM_jit"));
+        std::vector<T> C(m * n, static_cast<T>(-1));
+        fn(A.data(), B.data(), C.data());
+        return C == reference;
+    }
+
+    // The GEMV counterpart of `VerifyJittedGEMM`, computing y = A x
+    template <typename T>
+    bool VerifyJittedGEMV(int m, int n)
+    {
+        auto A = GetMultiplicationTestData<T>(m * n, 7);
+        auto x = GetMultiplicationTestData<T>(n, 5);
+        std::vector<T> reference(m);
+        for (int i = 0; i < m; ++i)
+        {
+            for (int j = 0; j < n; ++j)
+            {
+                reference[i] += A[i * n + j] * x[j];
+            }
+        }
+
+        CompilerOptions options;
+        options.useBlas = false;
+        IRModuleEmitter module("GEMV_jit_test", options);
+        auto& testContext = GetContext();
+        {
+            LLVMContext context(module);
+            ContextGuard guard(context);
+            constexpr auto type = GetValueType<T>();
+            (void)DeclareFunction("GEMV_jit")
+                .Decorated(FunctionDecorated::No)
+                .Parameters(
+                    Value{ type, MemoryLayout{ { m, n } } },
+                    Value{ type, MemoryLayout{ { n } } },
+                    Value{ type, MemoryLayout{ { m } } })
+                .Define([](Matrix A, Vector x, Vector y) {
+                    Vector result = GEMV(A, x);
+                    For(y, [&](Scalar row) { y(row) = result(row); });
+                });
+        }
+
+        // ContextGuard clears the global context on the way out, so give the caller's back
+        SetContext(testContext);
+
+        // LLVMContext leaves the functions it defines open and internal to the module, so finish this one and
+        // export it before jitting
+        module.EndFunction();
+        module.GetFunction("GEMV_jit")->setLinkage(llvm::GlobalValue::ExternalLinkage);
+
+        IRExecutionEngine engine(std::move(module));
+        auto fn = reinterpret_cast<void (*)(T*, T*, T*)>(engine.ResolveFunctionAddress("GEMV_jit"));
+        std::vector<T> y(m, static_cast<T>(-1));
+        fn(A.data(), x.data(), y.data());
+        return y == reference;
+    }
+} // namespace
+
+void GEMM_test()
+{
+    auto fn = DeclareFunction("GEMM_test").Define([]() -> void {
+        bool ok = true;
+        std::vector<std::vector<float>> data1{ { 1, 2, 3 }, { 4, 5, 6 } };
+        std::vector<std::vector<float>> data2{ { 1, 2 }, { 3, 4 }, { 5, 6 } };
+        std::vector<std::vector<float>> reference{ { 22, 28 }, { 49, 64 } };
+
+        Matrix m1(data1), m2(data2);
+        Matrix result = GEMM(m1, m2);
+        for (int row = 0; row < 2; ++row)
+        {
+            for (int column = 0; column < 2; ++column)
+            {
+                If(result(row, column) != reference[row][column],
+                   [&] { InvokeForContext<ComputeContext>([&](auto&) { ok = false; }); });
+            }
+        }
+        testing::ProcessTest("GEMM test", ok);
+    });
+
+    InvokeForContext<ComputeContext>([&](auto&) { fn(); });
+
+    // The same cases, emitted without BLAS and jitted. The larger size spans two blocks of the shared dimension and
+    // leaves a partial tile of columns.
+    InvokeForContext<TestLLVMContext>([&](auto&) {
+        testing::ProcessTest("GEMM test (LLVM)", VerifyJittedGEMM<float>(2, 2, 3));
+        testing::ProcessTest("GEMM test (LLVM, multiple blocks)", VerifyJittedGEMM<float>(9, 13, 130) && VerifyJittedGEMM<double>(9, 13, 130));
+    });
+}
+
+void GEMV_test()
+{
+    auto fn = DeclareFunction("GEMV_test").Define([]() -> void {
+        bool ok = true;
+        std::vector<std::vector<float>> data{ { 1, 2, 3 }, { 4, 5, 6 } };
+        std::vector<float> reference{ 14, 32 };
+
+        Matrix m(data);
+        Vector v = MakeVector<float>(3);
+        v = std::vector<float>{ 1, 2, 3 };
+        Vector result = GEMV(m, v);
+        for (int row = 0; row < 2; ++row)
+        {
+            If(result(row) != reference[row],
+               [&] { InvokeForContext<ComputeContext>([&](auto&) { ok = false; }); });
+        }
+        testing::ProcessTest("GEMV test", ok);
+    });
+
+    InvokeForContext<ComputeContext>([&](auto&) { fn(); });
+
+    InvokeForContext<TestLLVMContext>([&](auto&) {
+        testing::ProcessTest("GEMV test (LLVM)", VerifyJittedGEMV<float>(2, 3));
+        testing::ProcessTest("GEMV test (LLVM, partial tiles)", VerifyJittedGEMV<float>(7, 131) && VerifyJittedGEMV<double>(7, 131));
+    });
+}
+
 namespace
 {
     const std::vector<float> intrinsics_data{ 0.1f, 1.2f, 2.3f, 3.4f, 4.5f, 5.6f, 6.7f, 7.8f, 8.9f, 9.10f };
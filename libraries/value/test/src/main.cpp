@@ -40,6 +40,8 @@ int main()
             Casting_test1();
             Accumulate_test();
             Dot_test();
+            GEMM_test();
+            GEMV_test();
             Intrinsics_test1();
             Intrinsics_test2();
         }
@@ -73,9 +73,7 @@ int main(int argc, char* argv[])
 
         // load dataset
         if (trainerArguments.verbose) std::cout << "Loading data ..." << std::endl;
-        auto stream = utilities::OpenIfstream(dataLoadArguments.inputDataFilename);
-        auto parsedDataset = common::GetDataset(stream);
-        auto mappedDataset = common::TransformDataset(parsedDataset, map);
+        auto mappedDataset = common::LoadTransformedDataset(dataLoadArguments.inputDataFilename, map);
 
         // predictor type
         using PredictorType = predictors::SimpleForestPredictor;
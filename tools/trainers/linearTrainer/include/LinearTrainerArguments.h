@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <trainers/include/SDCATrainer.h>
+
 #include <utilities/include/CommandLineParser.h>
 
 namespace ell
@@ -29,6 +31,10 @@ struct LinearTrainerArguments
     size_t maxEpochs;
     bool permute;
     std::string randomSeedString;
+    size_t numThreads;
+    trainers::SDCAParallelMode parallelMode;
+    size_t miniBatchSize;
+    std::string inputDataShards;
 };
 
 /// <summary> Parsed version of LinearTrainerArguments. </summary>
@@ -55,5 +55,31 @@ void ParsedLinearTrainerArguments::AddArgs(utilities::CommandLineParser& parser)
                      "seed",
                      "The random seed string",
                      "ABCDEFG");
+
+    parser.AddOption(numThreads,
+                     "numThreads",
+                     "nt",
+                     "The number of SDCA training threads (0 = one per hardware thread)",
+                     1);
+
+    parser.AddOption(
+        parallelMode,
+        "parallelMode",
+        "pm",
+        "How multithreaded SDCA shares the model: synchronized mini-batches (dense data) or lock-free Hogwild updates (sparse data)",
+        { { "miniBatch", trainers::SDCAParallelMode::miniBatch }, { "hogwild", trainers::SDCAParallelMode::hogwild } },
+        "miniBatch");
+
+    parser.AddOption(miniBatchSize,
+                     "miniBatchSize",
+                     "mbs",
+                     "The number of examples between synchronizations of multithreaded SDCA in miniBatch mode",
+                     4096);
+
+    parser.AddOption(inputDataShards,
+                     "inputDataShards",
+                     "ids",
+                     "Comma-separated list of data files to train on one shard at a time, instead of loading the whole input data file, for datasets that don't fit in memory (SGD and SparseDataSGD only; requires dataDimension or an input map)",
+                     "");
 }
 } // namespace ell
@@ -12,6 +12,7 @@
 #include <utilities/include/Exception.h>
 #include <utilities/include/Files.h>
 #include <utilities/include/OutputStreamImpostor.h>
+#include <utilities/include/StringUtil.h>
 
 #include <data/include/Dataset.h>
 
@@ -32,6 +33,7 @@
 #include <nodes/include/LinearPredictorNode.h>
 
 #include <trainers/include/MeanCalculator.h>
+#include <trainers/include/SGDTrainer.h>
 
 #include <evaluators/include/Evaluator.h>
 
@@ -59,6 +61,69 @@ model::Map AppendTrainedLinearPredictorToMap(const predictors::LinearPredictor<E
     return outputMap;
 }
 
+void SaveTrainedLinearPredictorMap(const predictors::LinearPredictor<double>& trainedPredictor, model::Map& map, size_t dimension, const std::string& filename)
+{
+    // Create a new map with the linear predictor appended.
+    switch (map.GetOutputType())
+    {
+    case model::Port::PortType::smallReal:
+    {
+        auto outputMap = AppendTrainedLinearPredictorToMap<float>(trainedPredictor, map, dimension);
+        common::SaveMap(outputMap, filename);
+    }
+    break;
+    case model::Port::PortType::real:
+    {
+        auto outputMap = AppendTrainedLinearPredictorToMap<double>(trainedPredictor, map, dimension);
+        common::SaveMap(outputMap, filename);
+    }
+    break;
+    default:
+        std::cerr << "Unexpected output type for model. Should be double or float." << std::endl;
+        break;
+    };
+}
+
+// Trains with SGD on a list of data files that are loaded and run through the map one shard at a time, so the
+// dataset never has to fit in memory
+predictors::LinearPredictor<double> TrainOnShards(const model::Map& map, const LinearTrainerArguments& linearTrainerArguments, const common::TrainerArguments& trainerArguments)
+{
+    if (linearTrainerArguments.normalize)
+    {
+        throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "normalization isn't supported when training on shards");
+    }
+    if (map.GetInputSize(0) == 0)
+    {
+        throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "training on shards requires a data dimension or an input map");
+    }
+
+    std::unique_ptr<trainers::ITrainer<predictors::LinearPredictor<double>>> trainer;
+    switch (linearTrainerArguments.algorithm)
+    {
+    case LinearTrainerArguments::Algorithm::SGD:
+        trainer = common::MakeSGDTrainer(trainerArguments.lossFunctionArguments, { linearTrainerArguments.regularization, linearTrainerArguments.randomSeedString });
+        break;
+    case LinearTrainerArguments::Algorithm::SparseDataSGD:
+        trainer = common::MakeSparseDataSGDTrainer(trainerArguments.lossFunctionArguments, { linearTrainerArguments.regularization, linearTrainerArguments.randomSeedString });
+        break;
+    default:
+        throw utilities::InputException(utilities::InputExceptionErrors::invalidArgument, "training on shards requires the SGD or SparseDataSGD algorithm");
+    }
+
+    data::ShardedDatasetParameters parameters;
+    parameters.permuteShards = linearTrainerArguments.permute;
+    parameters.permuteExamples = linearTrainerArguments.permute;
+    parameters.randomSeedString = linearTrainerArguments.randomSeedString;
+    auto shardedDataset = common::LoadTransformedShardedDataset(utilities::Split(linearTrainerArguments.inputDataShards, ','), map, parameters);
+
+    auto& sgdTrainer = dynamic_cast<trainers::SGDTrainerBase&>(*trainer);
+    for (size_t epoch = 0; epoch < trainerArguments.numEpochs; ++epoch)
+    {
+        sgdTrainer.Update(shardedDataset.GetExampleIterator());
+    }
+    return trainer->GetPredictor();
+}
+
 int main(int argc, char* argv[])
 {
     try
@@ -90,7 +155,7 @@ int main(int argc, char* argv[])
             std::cout << commandLineParser.GetCurrentValuesString() << std::endl;
         }
 
-        if (dataLoadArguments.inputDataFilename.empty())
+        if (dataLoadArguments.inputDataFilename.empty() && linearTrainerArguments.inputDataShards.empty())
         {
             throw utilities::CommandLineParserPrintHelpException(commandLineParser.GetHelpString());
         }
@@ -111,11 +176,21 @@ int main(int argc, char* argv[])
             map = model::Map(model, { { "input", input } }, { { "output", output->output } });
         }
 
+        // train out of core, without loading the whole dataset
+        if (!linearTrainerArguments.inputDataShards.empty())
+        {
+            if (trainerArguments.verbose) std::cout << "Training on shards ..." << std::endl;
+            auto predictor = TrainOnShards(map, linearTrainerArguments, trainerArguments);
+            if (modelSaveArguments.outputModelFilename != "")
+            {
+                SaveTrainedLinearPredictorMap(predictor, map, map.GetOutput(0).Size(), modelSaveArguments.outputModelFilename);
+            }
+            return 0;
+        }
+
         // load dataset
         if (trainerArguments.verbose) std::cout << "Loading data ..." << std::endl;
-        auto stream = utilities::OpenIfstream(dataLoadArguments.inputDataFilename);
-        auto parsedDataset = common::GetDataset(stream);
-        auto mappedDataset = common::TransformDataset(parsedDataset, map);
+        auto mappedDataset = common::LoadTransformedDataset(dataLoadArguments.inputDataFilename, map);
         auto mappedDatasetDimension = map.GetOutput(0).Size();
 
         // normalize data
@@ -132,9 +207,7 @@ int main(int argc, char* argv[])
             auto normalizer = predictors::MakeTransformationNormalizer<data::IterationPolicy::skipZeros>(coordinateTransformation);
 
             // apply normalizer to data
-            auto normalizedDataset = common::TransformDataset(mappedDataset, normalizer);
-
-            mappedDataset.Swap(normalizedDataset);
+            mappedDataset = common::LoadedDataset(common::TransformDataset(mappedDataset, normalizer));
         }
 
         // predictor type
@@ -158,7 +231,7 @@ int main(int argc, char* argv[])
         }
         case LinearTrainerArguments::Algorithm::SDCA:
         {
-            trainer = common::MakeSDCATrainer(trainerArguments.lossFunctionArguments, { linearTrainerArguments.regularization, linearTrainerArguments.desiredPrecision, linearTrainerArguments.maxEpochs, linearTrainerArguments.permute, linearTrainerArguments.randomSeedString });
+            trainer = common::MakeSDCATrainer(trainerArguments.lossFunctionArguments, { linearTrainerArguments.regularization, linearTrainerArguments.desiredPrecision, linearTrainerArguments.maxEpochs, linearTrainerArguments.permute, linearTrainerArguments.randomSeedString, linearTrainerArguments.numThreads, linearTrainerArguments.parallelMode, linearTrainerArguments.miniBatchSize });
             break;
         }
         default:
@@ -192,25 +265,7 @@ int main(int argc, char* argv[])
         // Save predictor model
         if (modelSaveArguments.outputModelFilename != "")
         {
-            // Create a new map with the linear predictor appended.
-            switch (map.GetOutputType())
-            {
-            case model::Port::PortType::smallReal:
-            {
-                auto outputMap = AppendTrainedLinearPredictorToMap<float>(trainer->GetPredictor(), map, mappedDatasetDimension);
-                common::SaveMap(outputMap, modelSaveArguments.outputModelFilename);
-            }
-            break;
-            case model::Port::PortType::real:
-            {
-                auto outputMap = AppendTrainedLinearPredictorToMap<double>(trainer->GetPredictor(), map, mappedDatasetDimension);
-                common::SaveMap(outputMap, modelSaveArguments.outputModelFilename);
-            }
-            break;
-            default:
-                std::cerr << "Unexpected output type for model. Should be double or float." << std::endl;
-                break;
-            };
+            SaveTrainedLinearPredictorMap(trainer->GetPredictor(), map, mappedDatasetDimension, modelSaveArguments.outputModelFilename);
         }
     }
     catch (const utilities::CommandLineParserPrintHelpException& exception)
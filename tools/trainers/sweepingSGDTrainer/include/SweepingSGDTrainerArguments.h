@@ -0,0 +1,30 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     SweepingSGDTrainerArguments.h (sweepingSGDTrainer)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <trainers/include/SweepingTrainer.h>
+
+#include <utilities/include/CommandLineParser.h>
+
+namespace ell
+{
+struct SweepingSGDTrainerArguments : public trainers::SweepingTrainerParameters
+{
+};
+
+/// <summary> Parsed version of SweepingSGDTrainerArguments. </summary>
+struct ParsedSweepingSGDTrainerArguments : public SweepingSGDTrainerArguments
+    , public utilities::ParsedArgSet
+{
+    /// <summary> Adds the arguments to the command line parser. </summary>
+    ///
+    /// <param name="parser"> [in,out] The command line parser. </param>
+    void AddArgs(utilities::CommandLineParser& parser) override;
+};
+} // namespace ell
@@ -0,0 +1,33 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     SweepingSGDTrainerArguments.cpp (sweepingSGDTrainer)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "SweepingSGDTrainerArguments.h"
+
+namespace ell
+{
+void ParsedSweepingSGDTrainerArguments::AddArgs(utilities::CommandLineParser& parser)
+{
+    parser.AddOption(numThreads,
+                     "numThreads",
+                     "nt",
+                     "The number of trainers to update concurrently (0 = one per hardware thread)",
+                     0);
+
+    parser.AddOption(pruneAfterUpdates,
+                     "pruneAfterUpdates",
+                     "pau",
+                     "The number of epochs after which losing trainers are dropped from the sweep (0 = never)",
+                     0);
+
+    parser.AddOption(pruningMargin,
+                     "pruningMargin",
+                     "pm",
+                     "How much higher than the best error a trainer's error must be for it to be dropped from the sweep",
+                     0.05);
+}
+} // namespace ell
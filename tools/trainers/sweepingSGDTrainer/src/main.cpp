@@ -6,6 +6,8 @@
 //
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include "SweepingSGDTrainerArguments.h"
+
 #include <utilities/include/CommandLineParser.h>
 #include <utilities/include/Exception.h>
 #include <utilities/include/Files.h>
@@ -53,11 +55,13 @@ int main(int argc, char* argv[])
         common::ParsedDataLoadArguments dataLoadArguments;
         common::ParsedMapLoadArguments mapLoadArguments;
         common::ParsedModelSaveArguments modelSaveArguments;
+        ParsedSweepingSGDTrainerArguments sweepingTrainerArguments;
 
         commandLineParser.AddOptionSet(trainerArguments);
         commandLineParser.AddOptionSet(dataLoadArguments);
         commandLineParser.AddOptionSet(mapLoadArguments);
         commandLineParser.AddOptionSet(modelSaveArguments);
+        commandLineParser.AddOptionSet(sweepingTrainerArguments);
 
         // parse command line
         commandLineParser.Parse();
@@ -81,9 +85,7 @@ int main(int argc, char* argv[])
 
         // load dataset
         if (trainerArguments.verbose) std::cout << "Loading data ..." << std::endl;
-        auto stream = utilities::OpenIfstream(dataLoadArguments.inputDataFilename);
-        auto parsedDataset = common::GetDataset(stream);
-        auto mappedDataset = common::TransformDataset(parsedDataset, map);
+        auto mappedDataset = common::LoadTransformedDataset(dataLoadArguments.inputDataFilename, map);
         auto mappedDatasetDimension = map.GetOutput(0).Size();
 
         // get predictor type
@@ -105,12 +107,15 @@ int main(int argc, char* argv[])
         }
 
         // create meta trainer
-        auto trainer = trainers::MakeSweepingTrainer(std::move(evaluatingTrainers));
+        auto trainer = trainers::MakeSweepingTrainer(std::move(evaluatingTrainers), sweepingTrainerArguments);
 
         // train
         if (trainerArguments.verbose) std::cout << "Training ..." << std::endl;
         trainer->SetDataset(mappedDataset.GetAnyDataset());
-        trainer->Update();
+        for (size_t epoch = 0; epoch < trainerArguments.numEpochs; ++epoch)
+        {
+            trainer->Update();
+        }
         PredictorType predictor(trainer->GetPredictor());
         predictor.Resize(mappedDatasetDimension);
 
@@ -0,0 +1,27 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     MakeBinaryDatasetArguments.cpp (makeBinaryDataset)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "MakeBinaryDatasetArguments.h"
+
+namespace ell
+{
+void ParsedMakeBinaryDatasetArguments::AddArgs(utilities::CommandLineParser& parser)
+{
+    parser.AddOption(outputDataFilename, "outputDataFilename", "odf", "Path to the output binary dataset file", "");
+}
+
+utilities::CommandLineParseResult ParsedMakeBinaryDatasetArguments::PostProcess(const utilities::CommandLineParser& parser)
+{
+    std::vector<std::string> parseErrorMessages;
+    if (outputDataFilename.empty())
+    {
+        parseErrorMessages.push_back("An output data filename must be specified");
+    }
+    return parseErrorMessages;
+}
+} // namespace ell
@@ -0,0 +1,68 @@
+////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  Project:  Embedded Learning Library (ELL)
+//  File:     main.cpp (makeBinaryDataset)
+//  Authors:  agent
+//
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+#include "MakeBinaryDatasetArguments.h"
+
+#include <common/include/DataLoadArguments.h>
+#include <common/include/DataLoaders.h>
+
+#include <data/include/MappedDataset.h>
+
+#include <utilities/include/CommandLineParser.h>
+#include <utilities/include/Exception.h>
+#include <utilities/include/Files.h>
+
+#include <iostream>
+#include <utility>
+
+using namespace ell;
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        // create a command line parser
+        utilities::CommandLineParser commandLineParser(argc, argv);
+
+        // add arguments to the command line parser
+        common::ParsedDataLoadArguments dataLoadArguments;
+        ParsedMakeBinaryDatasetArguments makeBinaryDatasetArguments;
+        commandLineParser.AddOptionSet(dataLoadArguments);
+        commandLineParser.AddOptionSet(makeBinaryDatasetArguments);
+        commandLineParser.Parse();
+
+        // stream the text dataset into the binary file, one example at a time
+        auto inputStream = utilities::OpenIfstream(dataLoadArguments.GetDataFilePath());
+        auto exampleIterator = common::GetAutoSupervisedExampleIterator(inputStream);
+        auto outputStream = utilities::OpenBinaryOfstream(makeBinaryDatasetArguments.outputDataFilename);
+        auto numExamples = data::WriteBinaryDataset(std::move(exampleIterator), outputStream);
+
+        std::cout << "Wrote " << numExamples << " examples to " << makeBinaryDatasetArguments.outputDataFilename << std::endl;
+    }
+    catch (const utilities::CommandLineParserPrintHelpException& exception)
+    {
+        std::cout << exception.GetHelpText() << std::endl;
+        return 0;
+    }
+    catch (const utilities::CommandLineParserErrorException& exception)
+    {
+        std::cerr << "Command line parse error:" << std::endl;
+        for (const auto& error : exception.GetParseErrors())
+        {
+            std::cerr << error.GetMessage() << std::endl;
+        }
+        return 1;
+    }
+    catch (const utilities::Exception& exception)
+    {
+        std::cerr << "exception: " << exception.GetMessage() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
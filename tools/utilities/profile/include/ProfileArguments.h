@@ -29,6 +29,7 @@ struct ProfileArguments
     int numBurnInIterations = 0;
     bool filterTrivialNodes = true;
     bool summaryOnly = false;
+    bool compareParallelSchedules = false;
 
     // TODO: something about regions
 };
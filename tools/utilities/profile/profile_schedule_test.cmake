@@ -0,0 +1,13 @@
+# Create the models to test on
+message(STATUS "Generating test models")
+execute_process(COMMAND ${MAKE_MODELS_EXE} RESULT_VARIABLE COMMAND_RESULT WORKING_DIRECTORY ${BUILD_DIR})
+if(COMMAND_RESULT)
+  message(FATAL_ERROR "Error generating profile models: " ${COMMAND_RESULT})
+endif()
+
+# Time the model with each parallel loop schedule
+message(STATUS "Comparing parallel loop schedules")
+execute_process(COMMAND ${PROFILE_EXE} --inputMapFilename ${MODEL_FILE} --compareSchedules --burnIn 2 --numIterations 10 --threads 4 RESULT_VARIABLE COMMAND_RESULT WORKING_DIRECTORY ${BUILD_DIR})
+if(COMMAND_RESULT)
+  message(FATAL_ERROR "Error comparing parallel loop schedules: " ${COMMAND_RESULT})
+endif()
@@ -78,5 +78,12 @@ void ParsedProfileArguments::AddArgs(utilities::CommandLineParser& parser)
         "",
         "Print timing summary only",
         false);
+
+    parser.AddOption(
+        compareParallelSchedules,
+        "compareSchedules",
+        "",
+        "Time the model, compiled with parallelization, once with each parallel loop schedule (blocks and dynamic)",
+        false);
 }
 } // namespace ell
@@ -38,6 +38,7 @@
 #include <iostream>
 #include <random>
 #include <string>
+#include <utility>
 #include <vector>
 
 using namespace ell;
@@ -235,25 +236,20 @@ void WarmUpModel(model::IRCompiledMap& map, const std::vector<InputType>& input,
     }
 }
 
-template <typename InputType, typename OutputType>
-void TimeModel(model::Map& map, const std::vector<InputType>& input, const ProfileArguments& profileArguments, const common::MapCompilerArguments& mapCompilerArguments)
+model::MapCompilerOptions GetTimingCompilerOptions(const common::MapCompilerArguments& mapCompilerArguments)
 {
-    // Get output stream
-    auto outputStream = GetOutputStream(profileArguments.outputFilename);
-
-    ReplaceSourceAndSinkNodes(map);
-
-    // Initialize pass registry
-    passes::AddStandardPassesToRegistry();
-
-    // Compile map
     model::MapCompilerOptions settings = mapCompilerArguments.GetMapCompilerOptions("");
     settings.profile = false;
     settings.compilerSettings.profile = false;
     settings.optimizerSettings.fuseLinearFunctionNodes = true;
-    model::IRMapCompiler compiler(settings);
+    return settings;
+}
 
-    std::cout << "Compiling model" << std::endl;
+// Compiles the map without profiling code and returns the total time, in milliseconds, of the timed iterations
+template <typename InputType, typename OutputType>
+float TimeCompiledModel(const model::Map& map, const std::vector<InputType>& input, const model::MapCompilerOptions& settings, const ProfileArguments& profileArguments)
+{
+    model::IRMapCompiler compiler(settings);
     auto compiledMap = compiler.Compile(map);
 
     // Warm up the system by evaluating the model some number of times
@@ -265,7 +261,22 @@ void TimeModel(model::Map& map, const std::vector<InputType>& input, const Profi
     {
         auto output = compiledMap.Compute<OutputType>(input);
     }
-    float totalTime = static_cast<float>(timer.Elapsed());
+    return static_cast<float>(timer.Elapsed());
+}
+
+template <typename InputType, typename OutputType>
+void TimeModel(model::Map& map, const std::vector<InputType>& input, const ProfileArguments& profileArguments, const common::MapCompilerArguments& mapCompilerArguments)
+{
+    // Get output stream
+    auto outputStream = GetOutputStream(profileArguments.outputFilename);
+
+    ReplaceSourceAndSinkNodes(map);
+
+    // Initialize pass registry
+    passes::AddStandardPassesToRegistry();
+
+    std::cout << "Compiling model" << std::endl;
+    float totalTime = TimeCompiledModel<InputType, OutputType>(map, input, GetTimingCompilerOptions(mapCompilerArguments), profileArguments);
 
     if (profileArguments.outputFormat == ProfileOutputFormat::text)
     {
@@ -283,6 +294,45 @@ void TimeModel(model::Map& map, const std::vector<InputType>& input, const Profi
     }
 }
 
+template <typename InputType, typename OutputType>
+void CompareParallelSchedules(model::Map& map, const std::vector<InputType>& input, const ProfileArguments& profileArguments, const common::MapCompilerArguments& mapCompilerArguments)
+{
+    auto outputStream = GetOutputStream(profileArguments.outputFilename);
+
+    const std::vector<std::pair<std::string, emitters::ParallelLoopSchedule>> schedules = { { "blocks", emitters::ParallelLoopSchedule::fixedBlocks },
+                                                                                            { "dynamic", emitters::ParallelLoopSchedule::dynamicChunks } };
+    std::vector<float> totalTimes;
+    for (const auto& schedule : schedules)
+    {
+        auto settings = GetTimingCompilerOptions(mapCompilerArguments);
+        settings.compilerSettings.parallelize = true;
+        settings.compilerSettings.parallelLoopSchedule = schedule.second;
+
+        std::cout << "Compiling model with the " << schedule.first << " schedule" << std::endl;
+        totalTimes.push_back(TimeCompiledModel<InputType, OutputType>(map, input, settings, profileArguments));
+    }
+
+    if (profileArguments.outputFormat == ProfileOutputFormat::text)
+    {
+        outputStream << "Num iterations: " << profileArguments.numIterations << std::endl;
+        for (size_t index = 0; index < schedules.size(); ++index)
+        {
+            outputStream << schedules[index].first << " schedule: total time " << totalTimes[index] << " ms, average time " << totalTimes[index] / profileArguments.numIterations << " ms" << std::endl;
+        }
+        outputStream << "Speedup of dynamic over blocks: " << totalTimes[0] / totalTimes[1] << std::endl;
+    }
+    else // json
+    {
+        outputStream << "{\n";
+        for (size_t index = 0; index < schedules.size(); ++index)
+        {
+            outputStream << "\"" << schedules[index].first << "\": { \"total_time\": " << totalTimes[index] << ", \"average_time\": " << totalTimes[index] / profileArguments.numIterations << " },\n";
+        }
+        outputStream << "\"count\": " << profileArguments.numIterations << "\n";
+        outputStream << "}\n";
+    }
+}
+
 template <typename InputType, typename OutputType>
 void ProfileModel(model::Map& map, const ProfileArguments& profileArguments, const common::MapCompilerArguments& mapCompilerArguments, const std::vector<std::string>& converterArgs)
 {
@@ -298,6 +348,12 @@ void ProfileModel(model::Map& map, const ProfileArguments& profileArguments, con
     // Initialize the pass registry
     passes::AddStandardPassesToRegistry();
 
+    if (profileArguments.compareParallelSchedules)
+    {
+        CompareParallelSchedules<InputType, OutputType>(map, input, profileArguments, mapCompilerArguments);
+        return;
+    }
+
     // In "summary only" mode, we don't compile the model with profiling enabled
     // (because we just want the overall run time), so we have a separate codepath
     // for that option